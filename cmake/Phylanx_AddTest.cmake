@@ -97,3 +97,6 @@ macro(add_phylanx_regression_test category name)
   add_phylanx_test("tests.regressions.${category}" ${name} ${ARGN})
 endmacro()
 
+macro(add_phylanx_performance_test category name)
+  add_phylanx_test("tests.performance.${category}" ${name} ${ARGN})
+endmacro()
@@ -10,8 +10,12 @@
 #include <hpx/hpx_main.hpp>
 
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -83,13 +87,163 @@ std::vector<phylanx::ast::expression> load_ast_dump(std::string const& path)
     }
 
     // Allocate all the memory needed to load the AST upfront
-    std::vector<char> bytes;
-    bytes.reserve(data_size);
+    std::vector<char> bytes(static_cast<std::size_t>(data_size));
+    if (!ast_stream.read(bytes.data(), bytes.size()))
+    {
+        HPX_THROW_EXCEPTION(hpx::filesystem_error,
+            "load_ast",
+            "Failed to read the specified file: " + path);
+    }
 
     return phylanx::util::unserialize<std::vector<phylanx::ast::expression>>(
         std::move(bytes));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// The AST cache stores the AST generated (and transformed) from a script in
+// a file named after a hash of the script, the transformation rules, and the
+// Phylanx version. Running the same script again loads the AST from there
+// instead of parsing and transforming the code.
+std::uint64_t hash_string(std::string const& str,
+    std::uint64_t hash = 14695981039346656037ull)
+{
+    // 64 bit FNV-1a
+    for (char c : str)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+fs::path get_cache_dir(po::variables_map const& vm)
+{
+    if (vm.count("no-cache") != 0)
+    {
+        return fs::path();
+    }
+    if (vm.count("cache-dir") != 0)
+    {
+        return fs::path(vm["cache-dir"].as<std::string>());
+    }
+
+    char const* cache_dir = std::getenv("PHYSL_CACHE_DIR");
+    if (cache_dir != nullptr && *cache_dir != '\0')
+    {
+        return fs::path(cache_dir);
+    }
+    return fs::path();
+}
+
+// The header identifies the cached AST, it is compared when loading to guard
+// against hash collisions and files written by other Phylanx versions
+std::string ast_cache_header(std::string const& user_code,
+    std::string const& transform_rules, bool optimize)
+{
+    std::ostringstream header;
+    header << "physl-ast-cache 2 " << phylanx::full_version_as_string() << " "
+           << user_code.size() << " " << transform_rules.size() << " "
+           << (optimize ? "optimized" : "plain") << "\n";
+    return header.str();
+}
+
+fs::path get_ast_cache_file(fs::path const& cache_dir,
+    std::string const& user_code, std::string const& transform_rules,
+    bool optimize)
+{
+    std::uint64_t hash = hash_string(phylanx::full_version_as_string());
+    hash = hash_string(optimize ? "optimized" : "plain", hash);
+    hash = hash_string(user_code, hash_string("\n", hash));
+    hash = hash_string(transform_rules, hash_string("\n", hash));
+
+    std::ostringstream file_name;
+    file_name << std::hex << std::setw(16) << std::setfill('0') << hash
+              << ".ast";
+    return cache_dir / file_name.str();
+}
+
+bool load_cached_ast(fs::path const& cache_file, std::string const& header,
+    std::vector<phylanx::ast::expression>& ast)
+{
+    std::ifstream ast_stream(cache_file.string(), std::ios::binary);
+    if (!ast_stream.good())
+    {
+        return false;
+    }
+
+    std::string file_header(header.size(), '\0');
+    if (!ast_stream.read(&file_header[0], file_header.size()) ||
+        file_header != header)
+    {
+        return false;
+    }
+
+    std::vector<char> bytes((std::istreambuf_iterator<char>(ast_stream)),
+        std::istreambuf_iterator<char>());
+    if (bytes.empty())
+    {
+        return false;
+    }
+
+    // A damaged cache file is treated as if it didn't exist
+    try
+    {
+        ast = phylanx::util::unserialize<
+            std::vector<phylanx::ast::expression>>(std::move(bytes));
+    }
+    catch (std::exception const&)
+    {
+        return false;
+    }
+    return true;
+}
+
+// Failing to write the cache is not an error, the AST will be generated again
+// next time
+void store_cached_ast(fs::path const& cache_file, std::string const& header,
+    std::vector<phylanx::ast::expression> const& ast)
+{
+    boost::system::error_code ec;
+    fs::create_directories(cache_file.parent_path(), ec);
+    if (ec)
+    {
+        return;
+    }
+
+    // Write to a unique temporary file first and rename it afterwards, this
+    // way concurrent runs never see partially written files
+    fs::path const temp_file =
+        fs::unique_path(cache_file.string() + ".%%%%-%%%%-%%%%", ec);
+    if (ec)
+    {
+        return;
+    }
+
+    {
+        std::ofstream ast_stream(temp_file.string(), std::ios::binary);
+        if (!ast_stream.good())
+        {
+            return;
+        }
+
+        std::vector<char> bytes = phylanx::util::serialize(ast);
+        if (!ast_stream.write(header.data(), header.size()) ||
+            !ast_stream.write(bytes.data(), bytes.size()))
+        {
+            ast_stream.close();
+            fs::remove(temp_file, ec);
+            return;
+        }
+    }
+
+    fs::rename(temp_file, cache_file, ec);
+    if (ec)
+    {
+        fs::remove(temp_file, ec);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
 std::vector<phylanx::execution_tree::primitive_argument_type>
 read_arguments(std::vector<std::string> const& args)
 {
@@ -106,7 +260,8 @@ read_arguments(std::vector<std::string> const& args)
 void print_performance_counter_data_csv()
 {
     // CSV Header
-    std::cout << "primitive_instance,display_name,count,time,eval_direct\n";
+    std::cout << "primitive_instance,display_name,count,time,eval_direct,"
+                 "bytes_allocated,bytes_copied,copies,max_allocated_per_eval\n";
 
     // List of existing primitive instances
     std::vector<std::string> existing_primitive_instances;
@@ -120,7 +275,8 @@ void print_performance_counter_data_csv()
 
     // Print performance data
     std::vector<std::string> const counter_names{
-        "count/eval", "time/eval", "eval_direct"
+        "count/eval", "time/eval", "eval_direct", "memory/allocated",
+        "memory/copied", "count/copies", "memory/max_allocated_per_eval"
     };
 
     for (auto const& entry : phylanx::util::retrieve_counter_data(
@@ -157,12 +313,25 @@ int handle_command_line(int argc, char* argv[], po::variables_map& vm)
             ("performance", "Print the topology of the created execution "
                 "tree and the corresponding performance counter results")
             ("transform,t", po::value<std::string>(),
-                "file to read transformation rules from")
+                "file to read transformation rules from (the rules are "
+                "applied until none of them matches anymore)")
             ("dump-ast,d", po::value<std::string>()->implicit_value("<none>"),
                 "file to dump AST to")
             ("load-ast,l", po::value<std::string>(),
                 "file to dump AST to. If none path is provided, use the base "
                 "file name of the input file replacing the extension to .ast")
+            ("cache-dir", po::value<std::string>(),
+                "directory used to cache the AST generated from the PhySL "
+                "code (default: $PHYSL_CACHE_DIR, if set)")
+            ("no-cache", "do not use the AST cache")
+            ("optimize,O", "fold constant subexpressions and eliminate "
+                "common subexpressions before compiling the code")
+            ("optimization-report", "print the changes applied by "
+                "'--optimize'")
+            ("trace", po::value<std::string>(),
+                "record the evaluation of all primitives and write the "
+                "events to the given file in the Chrome trace event format "
+                "(view with chrome://tracing or https://ui.perfetto.dev)")
         ;
 
         po::positional_options_description pd;
@@ -221,6 +390,20 @@ std::string get_dump_file(po::variables_map const& vm,
     return dump_file;
 }
 
+std::vector<phylanx::ast::expression> optimize_ast(po::variables_map const& vm,
+    std::vector<phylanx::ast::expression> const& ast)
+{
+    phylanx::execution_tree::optimization_report report;
+    auto result = phylanx::execution_tree::optimize_ast(
+        ast, phylanx::execution_tree::optimization_options{}, &report);
+
+    if (vm.count("optimization-report") != 0)
+    {
+        std::cerr << report;
+    }
+    return result;
+}
+
 std::vector<phylanx::ast::expression> ast_from_code_or_dump(po::variables_map const& vm,
     std::vector<std::string>& positional_args, std::string& code_source_name)
 {
@@ -245,6 +428,20 @@ std::vector<phylanx::ast::expression> ast_from_code_or_dump(po::variables_map co
         std::string ast_dump_file = vm["load-ast"].as<std::string>();
         ast = load_ast_dump(ast_dump_file);
         code_source_name = fs::path(ast_dump_file).filename().string();
+
+        // Apply transformation rules to AST, if requested
+        if (vm.count("transform") != 0)
+        {
+            ast = phylanx::ast::rewrite_ast(ast,
+                phylanx::ast::generate_transform_rules(
+                    read_user_code(vm["transform"].as<std::string>())));
+        }
+
+        // Simplify the AST before it is compiled, if requested
+        if (vm.count("optimize") != 0)
+        {
+            ast = optimize_ast(vm, ast);
+        }
     }
     // Read PhySL source code from a file or the provided argument
     else
@@ -274,18 +471,51 @@ std::vector<phylanx::ast::expression> ast_from_code_or_dump(po::variables_map co
                 "No code was provided.");
         }
 
-        // Compile the given code into AST
-        ast = phylanx::ast::generate_ast(user_code);
-    }
+        bool const has_transform_rules = vm.count("transform") != 0;
+        std::string transform_rules;
+        if (has_transform_rules)
+        {
+            transform_rules = read_user_code(vm["transform"].as<std::string>());
+        }
 
-    // Apply transformation rules to AST, if requested
-    if (vm.count("transform") != 0)
-    {
-        std::string const transform_rules =
-            read_user_code(vm["transform"].as<std::string>());
+        // Reuse the AST generated by an earlier run of the same code, if
+        // possible
+        fs::path const cache_dir = get_cache_dir(vm);
+        fs::path cache_file;
+        std::string cache_header;
+        bool const optimize = vm.count("optimize") != 0;
+        if (!cache_dir.empty() && vm.count("optimization-report") == 0)
+        {
+            cache_file = get_ast_cache_file(
+                cache_dir, user_code, transform_rules, optimize);
+            cache_header =
+                ast_cache_header(user_code, transform_rules, optimize);
+        }
 
-        ast = phylanx::ast::transform_ast(
-            ast, phylanx::ast::generate_transform_rules(transform_rules));
+        if (cache_file.empty() ||
+            !load_cached_ast(cache_file, cache_header, ast))
+        {
+            // Compile the given code into AST
+            ast = phylanx::ast::generate_ast(user_code);
+
+            // Apply transformation rules to AST, if requested
+            if (has_transform_rules)
+            {
+                ast = phylanx::ast::rewrite_ast(ast,
+                    phylanx::ast::generate_transform_rules(transform_rules));
+            }
+
+            // Simplify the AST before it is compiled, if requested
+            if (optimize)
+            {
+                ast = optimize_ast(vm, ast);
+            }
+
+            if (!cache_file.empty())
+            {
+                store_cached_ast(cache_file, cache_header, ast);
+            }
+        }
     }
 
     // Dump the AST to a file, if requested
@@ -360,10 +590,23 @@ void interpreter(po::variables_map vm)
     std::vector<phylanx::ast::expression> ast =
         ast_from_code_or_dump(vm, positional_args, code_source_name);
 
+    bool const trace = vm.count("trace") != 0;
+    if (trace)
+    {
+        phylanx::util::event_tracer::enable(true);
+    }
+
     phylanx::execution_tree::compiler::function_list snippets;
     auto const result = compile_and_run(
         std::move(ast), std::move(positional_args), snippets, code_source_name);
 
+    if (trace)
+    {
+        phylanx::util::event_tracer::enable(false);
+        phylanx::util::event_tracer::write_chrome_trace(
+            vm["trace"].as<std::string>());
+    }
+
     // Print the result of the last PhySL expression, if requested
     if (vm.count("print") != 0)
     {
@@ -9,6 +9,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/ast/node.hpp>
 
+#include <cstddef>
 #include <vector>
 #include <utility>
 
@@ -37,6 +38,24 @@ namespace phylanx { namespace ast
     PHYLANX_EXPORT std::vector<expression> transform_ast(
         std::vector<expression> const& in,
         std::vector<transform_rule> const& rules);
+
+    /// Rewrite the given AST expression using all of the given rules until
+    /// none of them applies anymore. The rules are indexed by the shape of
+    /// their left hand side, the tree is rewritten bottom-up in a single
+    /// traversal. If more than one rule matches a node, the first one is
+    /// applied, the result of a rewrite is rewritten again. Subtrees which
+    /// are not modified are not copied. Throws if more than the given number
+    /// of rewrites is applied, as the rules possibly do not terminate.
+    PHYLANX_EXPORT expression rewrite_ast(expression const& in,
+        std::vector<transform_rule> const& rules,
+        std::size_t max_rewrites = 100000);
+
+    /// Rewrite all of the given AST expressions using all of the given rules
+    /// until none of them applies anymore (see above).
+    PHYLANX_EXPORT std::vector<expression> rewrite_ast(
+        std::vector<expression> const& in,
+        std::vector<transform_rule> const& rules,
+        std::size_t max_rewrites = 100000);
 }}
 
 #endif
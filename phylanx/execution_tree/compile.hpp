@@ -13,6 +13,8 @@
 
 #include <hpx/include/naming.hpp>
 
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -20,9 +22,27 @@ namespace phylanx { namespace execution_tree
 {
     ///////////////////////////////////////////////////////////////////////////
     /// Retrieve the full list of known patterns to be used with any of the
-    /// \a generate_tree functions below.
+    /// \a generate_tree functions below. The returned list stays valid but
+    /// does not include patterns registered later on, use
+    /// \a get_all_known_patterns_snapshot to hold on to a consistent list
+    /// while patterns may be registered concurrently.
     PHYLANX_EXPORT pattern_list const& get_all_known_patterns();
 
+    /// Retrieve a shared snapshot of the list of known patterns, the
+    /// snapshot is replaced (not modified) when new patterns are registered.
+    PHYLANX_EXPORT std::shared_ptr<pattern_list const>
+        get_all_known_patterns_snapshot();
+
+    /// Retrieve the list of all known patterns in the form used by the
+    /// compiler. The list is generated once and is regenerated only if new
+    /// patterns were registered (see \a register_pattern) since.
+    PHYLANX_EXPORT std::shared_ptr<compiler::expression_pattern_list const>
+        get_all_known_expression_patterns();
+
+    /// Return the current version of the list of known patterns, the version
+    /// is incremented whenever a new pattern is registered.
+    PHYLANX_EXPORT std::size_t get_patterns_version();
+
     namespace  detail
     {
         /// Compile a given expressions into a function, which when invoked will
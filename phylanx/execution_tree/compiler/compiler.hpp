@@ -22,6 +22,7 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -34,8 +35,172 @@ namespace phylanx { namespace execution_tree { namespace compiler
     ///////////////////////////////////////////////////////////////////////////
     using expression_pattern = hpx::util::tuple<
         std::string, ast::expression, factory_function_type>;
-    using expression_pattern_list =
-        std::multimap<std::string, expression_pattern>;
+
+    /// The list of all known patterns, keyed by the name of the primitive
+    /// they create. Additionally, the patterns are indexed by the shape of
+    /// their top-level AST node (the kind of operator, the name and the
+    /// number of arguments of a function call, etc.). This allows to limit
+    /// pattern matching to those patterns which can possibly match a given
+    /// expression. Modifying an indexed list updates its index.
+    class expression_pattern_list
+    {
+        using map_type = std::multimap<std::string, expression_pattern>;
+
+    public:
+        using value_type = map_type::value_type;
+        using const_iterator = map_type::const_iterator;
+        using iterator = const_iterator;
+        using size_type = map_type::size_type;
+
+        struct indexed_pattern
+        {
+            const_iterator pattern;
+            std::size_t ordinal;        // position in the list of patterns
+            std::size_t num_args;       // number of function call arguments
+            bool variadic;              // function call has ellipses argument
+        };
+        using indexed_patterns = std::vector<indexed_pattern>;
+
+        expression_pattern_list() = default;
+
+        expression_pattern_list(expression_pattern_list const& rhs)
+          : patterns_(rhs.patterns_)
+        {
+            if (rhs.indexed_)
+            {
+                build_index();
+            }
+        }
+        expression_pattern_list(expression_pattern_list && rhs)
+          : patterns_(std::move(rhs.patterns_))
+          , index_(std::move(rhs.index_))
+          , wildcards_(std::move(rhs.wildcards_))
+          , indexed_(rhs.indexed_)
+        {
+            rhs.clear_index();
+        }
+
+        expression_pattern_list& operator=(expression_pattern_list const& rhs)
+        {
+            if (this != &rhs)
+            {
+                patterns_ = rhs.patterns_;
+                clear_index();
+                if (rhs.indexed_)
+                {
+                    build_index();
+                }
+            }
+            return *this;
+        }
+        expression_pattern_list& operator=(expression_pattern_list && rhs)
+        {
+            patterns_ = std::move(rhs.patterns_);
+            index_ = std::move(rhs.index_);
+            wildcards_ = std::move(rhs.wildcards_);
+            indexed_ = rhs.indexed_;
+            rhs.clear_index();
+            return *this;
+        }
+
+        // read access to the patterns
+        const_iterator begin() const { return patterns_.begin(); }
+        const_iterator end() const { return patterns_.end(); }
+
+        size_type size() const { return patterns_.size(); }
+        bool empty() const { return patterns_.empty(); }
+
+        const_iterator find(std::string const& name) const
+        {
+            return patterns_.find(name);
+        }
+        const_iterator lower_bound(std::string const& name) const
+        {
+            return patterns_.lower_bound(name);
+        }
+
+        /// Add or remove patterns, the index is rebuilt if the list was
+        /// indexed.
+        const_iterator insert(value_type const& value)
+        {
+            const_iterator it = patterns_.insert(value);
+            update_index();
+            return it;
+        }
+        template <typename Iterator>
+        void insert(Iterator first, Iterator last)
+        {
+            patterns_.insert(first, last);
+            update_index();
+        }
+
+        const_iterator erase(const_iterator it)
+        {
+            const_iterator next = patterns_.erase(it);
+            update_index();
+            return next;
+        }
+        size_type erase(std::string const& name)
+        {
+            size_type count = patterns_.erase(name);
+            update_index();
+            return count;
+        }
+
+        void clear()
+        {
+            patterns_.clear();
+            clear_index();
+        }
+
+        /// Build the index, from now on the index is kept up to date when
+        /// the list is modified.
+        PHYLANX_EXPORT void build_index();
+
+        /// Drop the index, this makes the compiler match expressions against
+        /// all patterns.
+        void clear_index()
+        {
+            index_.clear();
+            wildcards_.clear();
+            indexed_ = false;
+        }
+
+        bool indexed() const
+        {
+            return indexed_;
+        }
+
+        /// Return the patterns which could match the given expression (in
+        /// the order of this list). Returns nullptr if all patterns have to
+        /// be considered. For function calls, num_args and variadic are set
+        /// to the number of arguments and whether one of the arguments is an
+        /// ellipses placeholder.
+        PHYLANX_EXPORT indexed_patterns const* candidates(
+            ast::expression const& expr, std::size_t& num_args,
+            bool& variadic) const;
+
+        indexed_patterns const* candidates(ast::expression const& expr) const
+        {
+            std::size_t num_args = 0;
+            bool variadic = false;
+            return candidates(expr, num_args, variadic);
+        }
+
+    private:
+        void update_index()
+        {
+            if (indexed_)
+            {
+                build_index();
+            }
+        }
+
+        map_type patterns_;
+        std::map<std::string, indexed_patterns> index_;
+        indexed_patterns wildcards_;
+        bool indexed_ = false;
+    };
 
     PHYLANX_EXPORT expression_pattern_list generate_patterns(
         pattern_list const& patterns_list);
@@ -50,6 +215,15 @@ namespace phylanx { namespace execution_tree { namespace compiler
     PHYLANX_EXPORT environment default_environment(
         hpx::id_type const& default_locality = hpx::find_here());
 
+    /// Enable or disable the fusion of connected element-wise operations
+    /// (arithmetics, comparisons, unary math functions) into a single
+    /// primitive, return the previous setting. The initial value is taken
+    /// from the configuration entry 'phylanx.fuse_elementwise' (default: 0).
+    PHYLANX_EXPORT bool enable_elementwise_fusion(bool enable);
+
+    /// Return whether element-wise fusion is currently enabled.
+    PHYLANX_EXPORT bool elementwise_fusion_enabled();
+
     ///////////////////////////////////////////////////////////////////////////
     // compiled functions
     template <typename Derived>
@@ -355,6 +529,7 @@ namespace phylanx { namespace execution_tree { namespace compiler
             {
                 definitions_.erase(existing);
             }
+            builtins_.erase(name);
 
             auto result = definitions_.emplace(value_type(
                 std::move(name), compiled_function(std::forward<F>(f))));
@@ -369,6 +544,31 @@ namespace phylanx { namespace execution_tree { namespace compiler
             return &result.first->second;
         }
 
+        // define a function which directly corresponds to a built-in
+        // primitive, those may be subject to compiler optimizations
+        template <typename F>
+        compiled_function* define_builtin(std::string name, F && f)
+        {
+            compiled_function* result = define(name, std::forward<F>(f));
+            builtins_.insert(std::move(name));
+            return result;
+        }
+
+        // return whether the given name (as visible from this environment)
+        // refers to a built-in primitive
+        bool is_builtin(std::string const& name) const
+        {
+            if (definitions_.find(name) != definitions_.end())
+            {
+                return builtins_.find(name) != builtins_.end();
+            }
+            if (outer_ != nullptr)
+            {
+                return outer_->is_builtin(name);
+            }
+            return false;
+        }
+
         compiled_function* find(std::string const& name)
         {
             iterator it = definitions_.find(name);
@@ -401,6 +601,7 @@ namespace phylanx { namespace execution_tree { namespace compiler
     private:
         environment* outer_;
         std::map<std::string, compiled_function> definitions_;
+        std::set<std::string> builtins_;
         std::size_t base_arg_num_;
     };
 
@@ -0,0 +1,70 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_OPTIMIZE_AUG_08_2018_0207PM)
+#define PHYLANX_EXECUTION_TREE_OPTIMIZE_AUG_08_2018_0207PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Select the transformations applied by \a optimize_ast
+    struct optimization_options
+    {
+        /// Replace side-effect free subexpressions whose operands are
+        /// literals by the value they evaluate to
+        bool fold_constants = true;
+
+        /// Evaluate side-effect free subexpressions which are repeated inside
+        /// the same expression only once
+        bool eliminate_common_subexpressions = true;
+
+        /// Subexpressions are not folded if the value they evaluate to, or
+        /// any value created while evaluating them, may have more elements
+        /// than this. The sizes are estimated from the literal arguments
+        /// before anything is evaluated, subexpressions creating values of
+        /// unknown size (e.g. constant(0.0, shape(x))) are never folded.
+        std::size_t max_folded_size = 4096;
+    };
+
+    /// Describe the changes applied by \a optimize_ast
+    struct optimization_report
+    {
+        std::size_t folded_constants = 0;
+        std::size_t eliminated_subexpressions = 0;
+        std::size_t generated_functions = 0;
+
+        /// One human readable line per applied change
+        std::vector<std::string> changes;
+    };
+
+    PHYLANX_EXPORT std::ostream& operator<<(
+        std::ostream& os, optimization_report const& report);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Optimize the given AST before it is compiled into an execution tree.
+    ///
+    /// Constant folding evaluates subexpressions consisting of built-in,
+    /// side-effect free primitives applied to literals and replaces them with
+    /// the resulting literal. Common subexpression elimination finds function
+    /// calls which occur more than once inside the same side-effect free
+    /// expression. Those are evaluated once and passed to a generated
+    /// function (named __cse<N>) that computes the original expression. The
+    /// definitions of the generated functions are prepended to the returned
+    /// list of expressions.
+    PHYLANX_EXPORT std::vector<ast::expression> optimize_ast(
+        std::vector<ast::expression> const& exprs,
+        optimization_options const& options = optimization_options{},
+        optimization_report* report = nullptr);
+}}
+
+#endif
@@ -12,6 +12,7 @@
 #include <phylanx/ast/node.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/ir/partitioned_array.hpp>
 #include <phylanx/ir/ranges.hpp>
 
 #include <hpx/include/runtime.hpp>
@@ -149,6 +150,7 @@ namespace phylanx { namespace execution_tree
           , primitive
           , std::vector<ast::expression>
           , ir::range
+          , ir::partitioned_array
         >;
 
     struct primitive_argument_type : argument_value_type
@@ -286,6 +288,13 @@ namespace phylanx { namespace execution_tree
           : argument_value_type{std::move(val)}
         {}
 
+        primitive_argument_type(ir::partitioned_array const& val)
+          : argument_value_type{val}
+        {}
+        primitive_argument_type(ir::partitioned_array&& val)
+          : argument_value_type{std::move(val)}
+        {}
+
         primitive_argument_type(argument_value_type const& val)
           : argument_value_type{val}
         {}
@@ -756,6 +765,20 @@ namespace phylanx { namespace execution_tree
     PHYLANX_EXPORT bool is_list_operand_strict(
         primitive_argument_type const& val);
 
+    // Extract a partitioned array from a given primitive_argument_type,
+    // throw if it doesn't hold one.
+    PHYLANX_EXPORT ir::partitioned_array extract_partitioned_array_value(
+        primitive_argument_type const& val,
+        std::string const& name = "",
+        std::string const& codename = "<unknown>");
+    PHYLANX_EXPORT ir::partitioned_array extract_partitioned_array_value(
+        primitive_argument_type&& val,
+        std::string const& name = "",
+        std::string const& codename = "<unknown>");
+
+    PHYLANX_EXPORT bool is_partitioned_array_operand(
+        primitive_argument_type const& val);
+
     ///////////////////////////////////////////////////////////////////////////
     // Extract a primitive from a given primitive_argument_type, throw
     // if it doesn't hold one.
@@ -793,6 +816,17 @@ namespace phylanx { namespace execution_tree
         std::string const& name = "",
         std::string const& codename = "<unknown>");
 
+    /// Enable or disable evaluating the iterations of loops (for, while) and
+    /// the statements of blocks in place as long as the evaluated operands
+    /// are ready, return the previous setting. If disabled, each step is
+    /// attached as a continuation to the future of the previous one. The
+    /// initial value is taken from the configuration entry
+    /// 'phylanx.trampoline_loops' (default: 1).
+    PHYLANX_EXPORT bool enable_loop_trampolining(bool enable);
+
+    /// Return whether loops are evaluated in place while possible.
+    PHYLANX_EXPORT bool loop_trampolining_enabled();
+
     namespace functional
     {
         struct value_operand
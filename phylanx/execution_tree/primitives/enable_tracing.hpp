@@ -17,6 +17,12 @@
 
 namespace phylanx { namespace execution_tree { namespace primitives
 {
+    /// enable_tracing(flag[, kind])
+    ///
+    /// Enable or disable tracing the evaluation of the execution tree. The
+    /// kind of tracing is either "text" (the default), which logs the result
+    /// of every evaluation, or "events", which records the evaluations using
+    /// the low-overhead util::event_tracer.
     class enable_tracing : public primitive_component_base
     {
     public:
@@ -0,0 +1,197 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_EXECUTION_POLICY_AUG_02_2018_1042AM)
+#define PHYLANX_PRIMITIVES_EXECUTION_POLICY_AUG_02_2018_1042AM
+
+#include <phylanx/config.hpp>
+
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace phylanx { namespace execution_tree
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The ways the evaluation of a primitive can be scheduled. The values
+    /// are reported by the /phylanx/primitives/<name>/eval_direct counters.
+    enum class execution_mode : std::int64_t
+    {
+        undecided = -1,     ///< use the launch policy requested by the caller
+        async = 0,          ///< spawn a new HPX thread
+        direct = 1,         ///< run on the calling HPX thread
+        parallel = 2        ///< spawn a new HPX thread and split the work
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Learns the evaluation time of one primitive instance as a linear
+    /// function of the amount of data it operates on (duration = a + b * work,
+    /// where work is the number of elements of the evaluation's arguments and
+    /// literal operands). Older measurements are exponentially decayed so
+    /// that the model follows changes of the workload. If all measurements
+    /// were taken for the same amount of work the model degenerates to the
+    /// (decayed) mean evaluation time.
+    class PHYLANX_EXPORT execution_cost_model
+    {
+    public:
+        execution_cost_model() = default;
+
+        execution_cost_model(execution_cost_model const& rhs);
+        execution_cost_model& operator=(execution_cost_model const& rhs);
+
+        /// Add the measured duration [ns] of an evaluation
+        void update(std::size_t work, std::int64_t duration);
+
+        /// Predict the duration [ns] of an evaluation for the given amount
+        /// of work, or for the same amount of work as the last evaluation
+        double predict(std::size_t work) const;
+        double predict() const;
+
+        /// Return the (decayed) mean of the measured durations [ns]
+        double mean() const;
+
+        /// Return the amount of work of the last evaluation
+        std::size_t last_work() const;
+
+        /// Return the number of measurements taken so far
+        std::int64_t samples() const;
+
+    private:
+        using mutex_type = hpx::lcos::local::spinlock;
+
+        double predict_locked(double work) const;
+
+        mutable mutex_type mtx_;
+
+        // weighted sums needed for the least squares fit
+        double sum_weights_ = 0.0;
+        double sum_work_ = 0.0;
+        double sum_duration_ = 0.0;
+        double sum_work2_ = 0.0;
+        double sum_work_duration_ = 0.0;
+
+        std::size_t last_work_ = 0;
+        std::int64_t samples_ = 0;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// An execution policy decides how the next evaluation of a primitive is
+    /// scheduled, based on the cost model of that primitive instance and on
+    /// the mode used for the previous evaluation.
+    class PHYLANX_EXPORT execution_policy
+    {
+    public:
+        virtual ~execution_policy() = default;
+
+        virtual execution_mode select(execution_cost_model const& model,
+            execution_mode current) const = 0;
+
+        virtual std::string name() const = 0;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The default policy, all costs are expressed as multiples of the time
+    /// needed to spawn an HPX thread (task_overhead [ns]). Primitives
+    /// predicted to be cheaper than direct_ratio spawns are run directly,
+    /// primitives more expensive than async_ratio spawns are run
+    /// asynchronously (in between the previous mode is kept to avoid
+    /// oscillation). Primitives more expensive than parallel_ratio spawns are
+    /// additionally marked for splitting their work if more than one core is
+    /// available.
+    ///
+    /// The parameters are initialized from the configuration entries
+    /// 'phylanx.execution_policy.task_overhead' (default: 5000),
+    /// 'phylanx.execution_policy.direct_ratio' (default: 30),
+    /// 'phylanx.execution_policy.async_ratio' (default: 60),
+    /// 'phylanx.execution_policy.parallel_ratio' (default: 400), and
+    /// 'phylanx.execution_policy.cores' (default: number of OS threads).
+    class PHYLANX_EXPORT adaptive_execution_policy : public execution_policy
+    {
+    public:
+        struct parameters
+        {
+            double task_overhead;       // [ns]
+            double direct_ratio;
+            double async_ratio;
+            double parallel_ratio;
+            std::size_t cores;
+        };
+
+        adaptive_execution_policy();
+        explicit adaptive_execution_policy(parameters const& params);
+
+        execution_mode select(execution_cost_model const& model,
+            execution_mode current) const override;
+
+        std::string name() const override
+        {
+            return "adaptive";
+        }
+
+        parameters const& get_parameters() const
+        {
+            return params_;
+        }
+
+    private:
+        parameters params_;
+    };
+
+    /// The policy used by earlier versions: run directly if the mean
+    /// evaluation time is below 150us, asynchronously if it is above 300us.
+    class PHYLANX_EXPORT threshold_execution_policy : public execution_policy
+    {
+    public:
+        execution_mode select(execution_cost_model const& model,
+            execution_mode current) const override;
+
+        std::string name() const override
+        {
+            return "threshold";
+        }
+    };
+
+    /// Always use the given execution mode
+    class PHYLANX_EXPORT fixed_execution_policy : public execution_policy
+    {
+    public:
+        explicit fixed_execution_policy(execution_mode mode)
+          : mode_(mode)
+        {
+        }
+
+        execution_mode select(execution_cost_model const&,
+            execution_mode) const override
+        {
+            return mode_;
+        }
+
+        std::string name() const override;
+
+    private:
+        execution_mode mode_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Create one of the predefined execution policies by name ("adaptive",
+    /// "threshold", "direct", "async", or "parallel")
+    PHYLANX_EXPORT std::shared_ptr<execution_policy> create_execution_policy(
+        std::string const& name);
+
+    /// Return the execution policy used for all primitives. Unless set
+    /// explicitly, this is the policy named by the configuration entry
+    /// 'phylanx.execution_policy' (default: "adaptive").
+    PHYLANX_EXPORT std::shared_ptr<execution_policy> get_execution_policy();
+
+    /// Replace the execution policy used for all primitives, returns the
+    /// previous policy
+    PHYLANX_EXPORT std::shared_ptr<execution_policy> set_execution_policy(
+        std::shared_ptr<execution_policy> policy);
+}}
+
+#endif
@@ -0,0 +1,101 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_FUSED_OPERATION_JUL_14_2018_0214PM)
+#define PHYLANX_PRIMITIVES_FUSED_OPERATION_JUL_14_2018_0214PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The fused_operation primitive evaluates a connected sub-tree of
+    // element-wise operations (arithmetics, comparisons, and unary math
+    // functions) in one pass over its operands. The compiler creates it in
+    // place of the individual primitives if element-wise fusion is enabled.
+    //
+    // The first operand passed to the constructor is the 'program' describing
+    // the fused expression in postfix order as a sequence of pairs of
+    // integers: (0, n) refers to the n-th remaining operand (a leaf of the
+    // fused sub-tree), (opcode, arity) applies the given operation to the
+    // 'arity' top-most values.
+    class fused_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<fused_operation>
+    {
+        using mutex_type = hpx::lcos::local::spinlock;
+
+        using arg_type = ir::node_data<double>;
+
+    public:
+        static match_pattern_type const match_data;
+
+        fused_operation() = default;
+
+        fused_operation(std::vector<primitive_argument_type>&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+
+        // Return the opcode for the primitive with the given name, return
+        // zero if the primitive can't be fused.
+        PHYLANX_EXPORT static std::int64_t opcode(std::string const& name);
+
+        // Return the number of operands the operation with the given opcode
+        // requires, return zero if it accepts two or more operands.
+        PHYLANX_EXPORT static std::size_t arity(std::int64_t opcode);
+
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            std::vector<primitive_argument_type> const& operands,
+            std::vector<primitive_argument_type> const& args) const;
+
+    private:
+        bool is_fusible(std::vector<primitive_argument_type> const& leaves,
+            std::size_t& dims, std::array<std::size_t, 2>& extents) const;
+
+        void run(std::vector<double const*> const& leaves,
+            double* scratch, double* result, std::size_t count) const;
+
+        primitive_argument_type evaluate(std::size_t dims,
+            std::array<std::size_t, 2> const& extents,
+            std::vector<primitive_argument_type>&& leaves) const;
+
+        hpx::future<primitive_argument_type> evaluate_unfused(
+            std::vector<primitive_argument_type>&& leaves) const;
+
+        primitive const& unfused_tree() const;
+
+    private:
+        std::vector<std::int64_t> program_;
+        std::size_t max_depth_;
+        bool has_comparison_;
+        bool returns_boolean_;
+
+        mutable mutex_type mtx_;
+        mutable primitive unfused_;
+    };
+
+    PHYLANX_EXPORT primitive create_fused_operation(
+        hpx::id_type const& locality,
+        std::vector<primitive_argument_type>&& operands,
+        std::string const& name = "", std::string const& codename = "");
+}}}
+
+#endif
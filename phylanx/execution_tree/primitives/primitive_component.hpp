@@ -81,6 +81,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
         PHYLANX_EXPORT std::int64_t get_eval_count(bool reset) const;
         PHYLANX_EXPORT std::int64_t get_eval_duration(bool reset) const;
         PHYLANX_EXPORT std::int64_t get_direct_execution(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_predicted_eval_duration(
+            bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_bytes_allocated(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_bytes_copied(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_copy_count(bool reset) const;
+        PHYLANX_EXPORT std::int64_t get_max_allocated_per_eval(
+            bool reset) const;
 
         // decide whether to execute eval directly
         PHYLANX_EXPORT static hpx::launch select_direct_execution(eval_action,
@@ -9,12 +9,15 @@
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/execution_policy.hpp>
+#include <phylanx/ir/memory_accounting.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/runtime/naming_fwd.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <set>
@@ -74,9 +77,32 @@ namespace phylanx { namespace execution_tree
             std::int64_t get_eval_duration(bool reset) const;
             std::int64_t get_direct_execution(bool reset) const;
 
-            // decide whether to execute eval directly
+            // the prediction is not a value accumulated since the last
+            // reset, reset is ignored as discarding the learned cost model
+            // would throw off the scheduling decisions for this primitive
+            std::int64_t get_predicted_eval_duration(bool reset) const;
+            std::int64_t get_bytes_allocated(bool reset) const;
+            std::int64_t get_bytes_copied(bool reset) const;
+            std::int64_t get_copy_count(bool reset) const;
+            std::int64_t get_max_allocated_per_eval(bool reset) const;
+
+            // decide whether to execute eval directly, this is delegated to
+            // the current execution_policy
             hpx::launch select_direct_eval_execution(hpx::launch policy) const;
 
+            // the execution mode selected for the current evaluation
+            execution_mode eval_mode() const
+            {
+                return static_cast<execution_mode>(execute_directly_);
+            }
+
+            // primitives split their work over several HPX threads only if
+            // the execution policy has selected execution_mode::parallel
+            bool parallel_eval() const
+            {
+                return eval_mode() == execution_mode::parallel;
+            }
+
         protected:
             std::string generate_error_message(std::string const& msg) const;
 
@@ -92,6 +118,21 @@ namespace phylanx { namespace execution_tree
             mutable std::int64_t eval_duration_;
             mutable std::int64_t execute_directly_;
 
+            // storage allocated and copied by node_data instances while
+            // this primitive's eval was running (excluding continuations)
+            mutable ir::memory_statistics memory_statistics_;
+
+            // learned cost of evaluating this primitive
+            mutable execution_cost_model cost_model_;
+
+        private:
+            struct eval_timer;
+
+            // the number of elements of the arguments and literal operands
+            std::size_t eval_work(
+                std::vector<primitive_argument_type> const& params) const;
+
+        protected:
 #if defined(HPX_HAVE_APEX)
             std::string eval_name_;
 #endif
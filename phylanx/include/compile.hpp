@@ -10,5 +10,6 @@
 #include <phylanx/execution_tree/compiler/actors.hpp>
 #include <phylanx/execution_tree/compiler/compiler.hpp>
 #include <phylanx/execution_tree/compile.hpp>
+#include <phylanx/execution_tree/optimize.hpp>
 
 #endif
@@ -7,7 +7,9 @@
 #define PHYLANX_IR_HPP
 
 #include <phylanx/config.hpp>
+#include <phylanx/ir/memory_accounting.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/ir/partitioned_array.hpp>
 #include <phylanx/ir/ranges.hpp>
 
 #endif
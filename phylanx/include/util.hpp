@@ -7,6 +7,8 @@
 #define PHYLANX_UTIL_HPP
 
 #include <phylanx/config.hpp>
+#include <phylanx/util/cached_config_flag.hpp>
+#include <phylanx/util/event_tracer.hpp>
 #include <phylanx/util/performance_data.hpp>
 #include <phylanx/util/repr_manip.hpp>
 #include <phylanx/util/serialization/ast.hpp>
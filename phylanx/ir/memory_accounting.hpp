@@ -0,0 +1,79 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_IR_MEMORY_ACCOUNTING_AUG_18_2018_1045AM)
+#define PHYLANX_IR_MEMORY_ACCOUNTING_AUG_18_2018_1045AM
+
+#include <phylanx/config.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace phylanx { namespace ir
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The memory statistics gathered for one evaluation context (usually a
+    /// primitive instance)
+    struct memory_statistics
+    {
+        // bytes of storage newly owned by node_data instances
+        std::atomic<std::int64_t> bytes_allocated_{0};
+
+        // bytes of storage copied from other node_data instances or
+        // containers (included in bytes_allocated_)
+        std::atomic<std::int64_t> bytes_copied_{0};
+
+        // number of deep copies
+        std::atomic<std::int64_t> copies_{0};
+
+        // the largest number of bytes allocated by a single evaluation
+        // (while its scope was active, see memory_accounting)
+        std::atomic<std::int64_t> max_allocated_per_eval_{0};
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Attributes the storage allocated and copied by node_data instances to
+    /// the innermost evaluation context which is active on the calling
+    /// thread. A primitive's context is active only while its eval()
+    /// function runs. No context is opened for continuations which run after
+    /// eval() returned a future which was not ready yet, the storage created
+    /// by those is attributed to the context active on the thread running
+    /// the continuation (usually none) and not to the primitive.
+    class PHYLANX_EXPORT memory_accounting
+    {
+    public:
+        /// Makes the given statistics the active evaluation context of the
+        /// calling (HPX-)thread for the lifetime of this object
+        class PHYLANX_EXPORT scope
+        {
+        public:
+            explicit scope(memory_statistics& stats);
+            ~scope();
+
+            scope(scope const&) = delete;
+            scope& operator=(scope const&) = delete;
+
+        private:
+            friend class memory_accounting;
+
+            memory_statistics* stats_;
+            scope* previous_;
+            std::int64_t bytes_allocated_;
+        };
+
+        /// Record the given number of freshly allocated bytes
+        static void allocated(std::size_t bytes);
+
+        /// Record a deep copy of the given number of bytes
+        static void copied(std::size_t bytes);
+
+        /// Enable or disable the accounting, returns the previous setting
+        static bool enable(bool enable);
+        static bool enabled();
+    };
+}}
+
+#endif
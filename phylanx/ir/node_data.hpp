@@ -8,12 +8,14 @@
 #define PHYLANX_IR_NODE_DATA_AUG_26_2017_0924AM
 
 #include <phylanx/config.hpp>
+#include <phylanx/ir/storage_pool.hpp>
 #include <phylanx/util/variant.hpp>
 
 #include <hpx/include/serialization.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/throw_exception.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -54,17 +56,20 @@ namespace phylanx { namespace ir
                     T const*>;
 
         public:
-            node_data_iterator(node_data<T> const& nd, std::size_t index = 0)
-              : nd_(nd), index_(index)
-            {
-            }
+            // The storage kind of the referenced node_data is resolved here,
+            // dense data is accessed through a cached pointer afterwards.
+            node_data_iterator(node_data<T> const& nd, std::size_t index = 0);
 
         private:
             friend class hpx::util::iterator_core_access;
 
             typename base_type::reference dereference() const
             {
-                return nd_[index_];
+                if (data_ != nullptr)
+                {
+                    return data_[row_ * spacing_ + column_];
+                }
+                return nd_[index_];     // sparse data
             }
 
             bool equal(node_data_iterator const& x) const
@@ -75,16 +80,29 @@ namespace phylanx { namespace ir
             void advance(typename base_type::difference_type n)
             {
                 index_ += n;
+                row_ = index_ / columns_;
+                column_ = index_ % columns_;
             }
 
             void increment()
             {
                 ++index_;
+                if (++column_ == columns_)
+                {
+                    column_ = 0;
+                    ++row_;
+                }
             }
 
             void decrement()
             {
                 --index_;
+                if (column_ == 0)
+                {
+                    column_ = columns_;
+                    --row_;
+                }
+                --column_;
             }
 
             typename base_type::difference_type distance_to(
@@ -95,7 +113,38 @@ namespace phylanx { namespace ir
 
             node_data<T> const& nd_;
             std::size_t index_;
+
+            T const* data_;
+            std::size_t columns_;
+            std::size_t spacing_;
+            std::size_t row_;
+            std::size_t column_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Blaze has no non-owning (custom) sparse matrix type, this refers to
+        // a sparse matrix held by another instance of node_data.
+        template <typename T>
+        class sparse_matrix_ref
+        {
+        public:
+            using matrix_type = blaze::CompressedMatrix<T, blaze::rowMajor>;
+
+            explicit sparse_matrix_ref(matrix_type const& m)
+              : m_(&m)
+            {
+            }
+
+            matrix_type const& get() const
+            {
+                return *m_;
+            }
+
+        private:
+            matrix_type const* m_;
         };
+
+        /// \endcond
     }
 
     template <typename T>
@@ -127,9 +176,15 @@ namespace phylanx { namespace ir
         using custom_storage1d_type = blaze::CustomVector<T, true, true>;
         using custom_storage2d_type = blaze::CustomMatrix<T, true, true>;
 
+        // sparse matrices are stored in compressed row storage (CSR) format
+        using sparse_storage2d_type =
+            blaze::CompressedMatrix<T, blaze::rowMajor>;
+        using sparse_ref_storage2d_type = detail::sparse_matrix_ref<T>;
+
         using storage_type =
             util::variant<storage0d_type, storage1d_type, storage2d_type,
-                custom_storage1d_type, custom_storage2d_type>;
+                custom_storage1d_type, custom_storage2d_type,
+                sparse_storage2d_type, sparse_ref_storage2d_type>;
 
         node_data() = default;
 
@@ -154,6 +209,12 @@ namespace phylanx { namespace ir
         explicit node_data(custom_storage2d_type const& values);
         explicit node_data(custom_storage2d_type && values);
 
+        /// Create node data for a sparse 2-dimensional value
+        explicit node_data(sparse_storage2d_type const& values);
+        explicit node_data(sparse_storage2d_type && values);
+
+        explicit node_data(sparse_ref_storage2d_type const& values);
+
         // conversion helpers for Python bindings
         explicit node_data(std::vector<T> const& values);
         explicit node_data(std::vector<std::vector<T>> const& values);
@@ -178,6 +239,12 @@ namespace phylanx { namespace ir
     private:
         static storage_type init_data_from(node_data const& d);
 
+        // attribute owned storage to the memory_accounting scope of the
+        // calling thread
+        static std::size_t owned_bytes(storage_type const& data);
+        static void account_allocation(storage_type const& data);
+        static void account_copy(storage_type const& data);
+
         template <typename U>
         static storage_type init_data_from_type(node_data<U> const& d)
         {
@@ -189,12 +256,22 @@ namespace phylanx { namespace ir
                 return storage_type(d.scalar());
 
             case 1:
-                increment_copy_construction_count();
-                return storage_type(d.vector());
+                {
+                    increment_copy_construction_count();
+                    storage_type result(storage1d_type(d.vector()));
+                    account_copy(result);
+                    return result;
+                }
 
             case 2:
-                increment_copy_construction_count();
-                return storage_type(d.matrix());
+                {
+                    increment_copy_construction_count();
+                    storage_type result = d.is_sparse() ?
+                        storage_type(sparse_storage2d_type(d.sparse_matrix())) :
+                        storage_type(storage2d_type(d.matrix()));
+                    account_copy(result);
+                    return result;
+                }
 
             default:
                 HPX_THROW_EXCEPTION(hpx::invalid_status,
@@ -208,6 +285,9 @@ namespace phylanx { namespace ir
         node_data(node_data const& d);
         node_data(node_data && d);
 
+        /// Owned dense storage is handed to the storage_pool for reuse
+        ~node_data();
+
         template <typename U, typename U1 =
             typename std::enable_if<!std::is_same<T, U>::value>::type>
         explicit node_data(node_data<U> const& d)
@@ -229,6 +309,43 @@ namespace phylanx { namespace ir
         node_data& operator=(custom_storage2d_type const& val);
         node_data& operator=(custom_storage2d_type && val);
 
+        node_data& operator=(sparse_storage2d_type const& val);
+        node_data& operator=(sparse_storage2d_type && val);
+
+        /// Assign the value of a dense vector or matrix expression, the
+        /// result is evaluated into storage taken from the storage_pool
+        template <typename VT>
+        node_data& operator=(
+            blaze::DenseVector<VT, blaze::columnVector> const& expr)
+        {
+            VT const& v = static_cast<VT const&>(expr);
+
+            storage1d_type result = storage_pool<T>::acquire_vector(v.size());
+            result = v;
+
+            increment_move_assignment_count();
+            release_storage();
+            data_ = std::move(result);
+            account_allocation(data_);
+            return *this;
+        }
+
+        template <typename MT, bool SO>
+        node_data& operator=(blaze::DenseMatrix<MT, SO> const& expr)
+        {
+            MT const& m = static_cast<MT const&>(expr);
+
+            storage2d_type result =
+                storage_pool<T>::acquire_matrix(m.rows(), m.columns());
+            result = m;
+
+            increment_move_assignment_count();
+            release_storage();
+            data_ = std::move(result);
+            account_allocation(data_);
+            return *this;
+        }
+
         // conversion helpers for Python bindings
         node_data& operator=(std::vector<T> const& val);
         node_data& operator=(std::vector<std::vector<T>> const& values);
@@ -236,6 +353,9 @@ namespace phylanx { namespace ir
     private:
         static storage_type copy_data_from(node_data const& d);
 
+        // hand owned dense storage to the storage_pool
+        void release_storage();
+
     public:
         node_data& operator=(node_data const& d);
         node_data& operator=(node_data && d);
@@ -260,6 +380,9 @@ namespace phylanx { namespace ir
 
         std::size_t size() const;
 
+        /// Access the dense matrix. All overloads throw for sparse data,
+        /// which has to be converted explicitly (see dense() or
+        /// matrix_copy()).
         storage2d_type& matrix_non_ref();
         storage2d_type const& matrix_non_ref() const;
         storage2d_type matrix_copy() const;
@@ -278,6 +401,13 @@ namespace phylanx { namespace ir
         custom_storage1d_type vector() &&;
         custom_storage1d_type vector() const&&;
 
+        /// Access the sparse matrix
+        sparse_storage2d_type& sparse_matrix_non_ref();
+        sparse_storage2d_type const& sparse_matrix_non_ref() const;
+        sparse_storage2d_type sparse_matrix_copy() const;
+
+        sparse_storage2d_type const& sparse_matrix() const;
+
         storage0d_type& scalar();
         storage0d_type const& scalar() const;
 
@@ -301,6 +431,9 @@ namespace phylanx { namespace ir
         /// instance of node_data
         bool is_ref() const;
 
+        /// Return whether this instance holds (or refers to) a sparse matrix
+        bool is_sparse() const;
+
         explicit operator bool() const;
 
         bool operator!() const
@@ -316,6 +449,19 @@ namespace phylanx { namespace ir
         const_iterator cbegin() const;
         const_iterator cend() const;
 
+        /// Invoke f(T const* data, std::size_t size) for each row of the
+        /// underlying array (scalars and vectors form a single row). The
+        /// storage kind is resolved once per call, which allows for the
+        /// elements of each row to be processed in a tight loop. Rows of
+        /// sparse matrices are expanded into a temporary buffer.
+        template <typename F>
+        void for_each_row(F && f) const;
+
+        /// Invoke f(T const& value) for each element of the underlying array
+        /// in row-major order
+        template <typename F>
+        void for_each(F && f) const;
+
         // conversion helpers for Python bindings
         std::vector<T> as_vector() const;
         std::vector<std::vector<T>> as_matrix() const;
@@ -332,6 +478,118 @@ namespace phylanx { namespace ir
         /// \endcond
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    template <typename F>
+    void node_data<T>::for_each_row(F && f) const
+    {
+        switch (data_.index())
+        {
+        case 0:
+            f(&scalar(), std::size_t(1));
+            return;
+
+        case 1: HPX_FALLTHROUGH;
+        case 3:
+            {
+                auto v = vector();
+                f(static_cast<T const*>(v.data()), v.size());
+            }
+            return;
+
+        case 2: HPX_FALLTHROUGH;
+        case 4:
+            {
+                auto m = matrix();
+                for (std::size_t i = 0; i != m.rows(); ++i)
+                {
+                    f(static_cast<T const*>(m.data(i)), m.columns());
+                }
+            }
+            return;
+
+        case 5: HPX_FALLTHROUGH;
+        case 6:
+            {
+                auto const& m = sparse_matrix();
+                std::vector<T> row;
+                for (std::size_t i = 0; i != m.rows(); ++i)
+                {
+                    row.assign(m.columns(), T(0));
+                    for (auto it = m.begin(i); it != m.end(i); ++it)
+                    {
+                        row[it->index()] = it->value();
+                    }
+                    f(static_cast<T const*>(row.data()), row.size());
+                }
+            }
+            return;
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::invalid_status,
+            "phylanx::ir::node_data<T>::for_each_row()",
+            "node_data object holds unsupported data type");
+    }
+
+    template <typename T>
+    template <typename F>
+    void node_data<T>::for_each(F && f) const
+    {
+        for_each_row(
+            [&](T const* data, std::size_t size)
+            {
+                for (std::size_t i = 0; i != size; ++i)
+                {
+                    f(data[i]);
+                }
+            });
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        template <typename T>
+        node_data_iterator<T>::node_data_iterator(
+                node_data<T> const& nd, std::size_t index)
+          : nd_(nd), index_(index), data_(nullptr), columns_(1), spacing_(1)
+        {
+            switch (nd.index())
+            {
+            case 0:
+                data_ = &nd.scalar();
+                break;
+
+            case 1: HPX_FALLTHROUGH;
+            case 3:
+                {
+                    auto v = nd.vector();
+                    data_ = v.data();
+                    columns_ = spacing_ = (std::max)(v.size(), std::size_t(1));
+                }
+                break;
+
+            case 2: HPX_FALLTHROUGH;
+            case 4:
+                {
+                    auto m = nd.matrix();
+                    data_ = m.data();
+                    columns_ = (std::max)(m.columns(), std::size_t(1));
+                    spacing_ = m.spacing();
+                }
+                break;
+
+            default:
+                break;
+            }
+
+            row_ = index_ / columns_;
+            column_ = index_ % columns_;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     struct reset_enable_counts_on_exit
     {
@@ -0,0 +1,272 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_IR_PARTITIONED_ARRAY_JUL_30_2018_0955AM)
+#define PHYLANX_IR_PARTITIONED_ARRAY_JUL_30_2018_0955AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/include/actions.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/serialization.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace ir
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The element-wise operations supported for partitioned arrays
+    enum class elementwise_operation : std::int32_t
+    {
+        add = 0,
+        sub = 1,
+        mul = 2,
+        div = 3
+    };
+
+    namespace server
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // A tile is a (dense) block of a partitioned array which lives on
+        // one of the localities. All operations on a tile are executed on
+        // the locality the tile lives on, only the data of other tiles
+        // needed for the operation are moved.
+        class tile : public hpx::components::component_base<tile>
+        {
+        public:
+            tile() = default;
+
+            explicit tile(node_data<double>&& data)
+              : data_(std::move(data))
+            {
+            }
+
+            // return a copy of the data held by this tile
+            PHYLANX_EXPORT node_data<double> get_data() const;
+
+            // apply the given element-wise operation to this tile and the
+            // given tile, create the result on this locality
+            PHYLANX_EXPORT hpx::future<hpx::id_type> elementwise(
+                elementwise_operation op, hpx::id_type const& rhs) const;
+
+            // transpose this tile and create the result on the given
+            // locality
+            PHYLANX_EXPORT hpx::future<hpx::id_type> transpose(
+                hpx::id_type const& locality) const;
+
+            // calculate the sum of all elements of this tile
+            PHYLANX_EXPORT double sum() const;
+
+            HPX_DEFINE_COMPONENT_DIRECT_ACTION(tile, get_data, get_data_action);
+            HPX_DEFINE_COMPONENT_ACTION(tile, elementwise, elementwise_action);
+            HPX_DEFINE_COMPONENT_ACTION(tile, transpose, transpose_action);
+            HPX_DEFINE_COMPONENT_ACTION(tile, sum, sum_action);
+
+            node_data<double> const& data() const
+            {
+                return data_;
+            }
+
+        private:
+            node_data<double> data_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A two-dimensional array which is partitioned into a grid of tiles. The
+    // tiles are distributed in a round-robin fashion over the localities the
+    // array was created for, tile (i, j) is placed on the locality
+    // localities[(i * grid_columns + j) % localities.size()]. All tiles have
+    // the same extent, except for the last row and column of tiles.
+    //
+    // Instances refer to their tiles only, copying (or sending) a
+    // partitioned array to another locality does not move any of the data.
+    // The execution tree represents partitioned arrays as values of their
+    // own (see primitive_argument_type), the tiled_* primitives operate on
+    // them.
+    class partitioned_array
+    {
+    public:
+        partitioned_array() = default;
+
+        /// Partition the given matrix into tiles of the given extent and
+        /// distribute those over the given localities
+        ///
+        /// \param data         The matrix to partition
+        /// \param tile_rows    The number of rows of each tile
+        /// \param tile_columns The number of columns of each tile
+        /// \param localities   The localities to distribute the tiles to
+        ///
+        PHYLANX_EXPORT static hpx::future<partitioned_array> create(
+            node_data<double> const& data, std::size_t tile_rows,
+            std::size_t tile_columns,
+            std::vector<hpx::id_type> const& localities);
+
+        /// Partition the given matrix into blocks of rows, one for each of
+        /// the given localities
+        PHYLANX_EXPORT static hpx::future<partitioned_array> create(
+            node_data<double> const& data,
+            std::vector<hpx::id_type> const& localities);
+
+        /// Collect all tiles into a single matrix on the calling locality
+        PHYLANX_EXPORT hpx::future<node_data<double>> gather() const;
+
+        std::size_t rows() const { return rows_; }
+        std::size_t columns() const { return columns_; }
+
+        std::size_t tile_rows() const { return tile_rows_; }
+        std::size_t tile_columns() const { return tile_columns_; }
+
+        // number of tiles in each dimension
+        std::size_t grid_rows() const { return grid_rows_; }
+        std::size_t grid_columns() const { return grid_columns_; }
+
+        hpx::id_type const& tile(std::size_t row, std::size_t column) const
+        {
+            return tiles_[row * grid_columns_ + column];
+        }
+
+        // the locality the given tile lives on
+        hpx::id_type const& locality(
+            std::size_t row, std::size_t column) const
+        {
+            return localities_[(row * grid_columns_ + column) %
+                localities_.size()];
+        }
+
+        std::vector<hpx::id_type> const& localities() const
+        {
+            return localities_;
+        }
+
+        // the extent of the given tile
+        PHYLANX_EXPORT std::size_t tile_rows(std::size_t row) const;
+        PHYLANX_EXPORT std::size_t tile_columns(std::size_t column) const;
+
+        // the tiles of the array in row-major order
+        std::vector<hpx::id_type>& tiles()
+        {
+            return tiles_;
+        }
+        std::vector<hpx::id_type> const& tiles() const
+        {
+            return tiles_;
+        }
+
+        // create the layout of an array without any tiles
+        PHYLANX_EXPORT partitioned_array(std::size_t rows,
+            std::size_t columns, std::size_t tile_rows,
+            std::size_t tile_columns,
+            std::vector<hpx::id_type> const& localities);
+
+        // two arrays are equal if they refer to the same tiles
+        friend bool operator==(
+            partitioned_array const& lhs, partitioned_array const& rhs)
+        {
+            return lhs.rows_ == rhs.rows_ && lhs.columns_ == rhs.columns_ &&
+                lhs.tile_rows_ == rhs.tile_rows_ &&
+                lhs.tile_columns_ == rhs.tile_columns_ &&
+                lhs.tiles_ == rhs.tiles_;
+        }
+        friend bool operator!=(
+            partitioned_array const& lhs, partitioned_array const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive& ar, unsigned)
+        {
+            ar & rows_ & columns_ & tile_rows_ & tile_columns_ & grid_rows_ &
+                grid_columns_ & localities_ & tiles_;
+        }
+
+        std::size_t rows_ = 0;
+        std::size_t columns_ = 0;
+        std::size_t tile_rows_ = 0;
+        std::size_t tile_columns_ = 0;
+        std::size_t grid_rows_ = 0;
+        std::size_t grid_columns_ = 0;
+
+        std::vector<hpx::id_type> localities_;
+        std::vector<hpx::id_type> tiles_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Apply the given element-wise operation to all corresponding tiles of
+    /// both arrays. Both arrays must have the same shape and tiling, the
+    /// result has the same tiling as well.
+    PHYLANX_EXPORT hpx::future<partitioned_array> elementwise(
+        elementwise_operation op, partitioned_array const& lhs,
+        partitioned_array const& rhs);
+
+    inline hpx::future<partitioned_array> add(
+        partitioned_array const& lhs, partitioned_array const& rhs)
+    {
+        return elementwise(elementwise_operation::add, lhs, rhs);
+    }
+
+    inline hpx::future<partitioned_array> sub(
+        partitioned_array const& lhs, partitioned_array const& rhs)
+    {
+        return elementwise(elementwise_operation::sub, lhs, rhs);
+    }
+
+    inline hpx::future<partitioned_array> mul(
+        partitioned_array const& lhs, partitioned_array const& rhs)
+    {
+        return elementwise(elementwise_operation::mul, lhs, rhs);
+    }
+
+    inline hpx::future<partitioned_array> div(
+        partitioned_array const& lhs, partitioned_array const& rhs)
+    {
+        return elementwise(elementwise_operation::div, lhs, rhs);
+    }
+
+    /// Calculate the matrix product of both arrays. The tile columns of lhs
+    /// must match the tile rows of rhs. Each tile of the result is computed
+    /// on the locality it is placed on, fetching the required row of tiles
+    /// of lhs and column of tiles of rhs.
+    PHYLANX_EXPORT hpx::future<partitioned_array> dot(
+        partitioned_array const& lhs, partitioned_array const& rhs);
+
+    /// Transpose the given array. Each tile is transposed on the locality it
+    /// lives on and is moved to the locality owning its new position.
+    PHYLANX_EXPORT hpx::future<partitioned_array> transpose(
+        partitioned_array const& arr);
+
+    /// Calculate the sum of all elements, the partial sums are computed on
+    /// the localities owning the tiles.
+    PHYLANX_EXPORT hpx::future<double> sum(partitioned_array const& arr);
+
+    /// Calculate the mean of all elements
+    PHYLANX_EXPORT hpx::future<double> mean(partitioned_array const& arr);
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+HPX_REGISTER_ACTION_DECLARATION(
+    phylanx::ir::server::tile::get_data_action,
+    phylanx_tile_get_data_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    phylanx::ir::server::tile::elementwise_action,
+    phylanx_tile_elementwise_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    phylanx::ir::server::tile::transpose_action,
+    phylanx_tile_transpose_action);
+HPX_REGISTER_ACTION_DECLARATION(
+    phylanx::ir::server::tile::sum_action,
+    phylanx_tile_sum_action);
+
+#endif
@@ -113,6 +113,7 @@ namespace phylanx { namespace ir
 
     private:
         friend class hpx::util::iterator_core_access;
+        friend class range;
 
         execution_tree::primitive_argument_type dereference() const;
         bool equal(range_iterator const& other) const;
@@ -155,6 +156,11 @@ namespace phylanx { namespace ir
         args_type copy();
         args_type copy() const;
 
+        // Access the stored element at the given position without copying
+        // it, integer ranges don't store their elements
+        execution_tree::primitive_argument_type const& at(
+            std::size_t pos) const;
+
         range ref();
         range const ref() const;
 
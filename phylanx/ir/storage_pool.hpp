@@ -0,0 +1,85 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_IR_STORAGE_POOL_AUG_12_2018_0319PM)
+#define PHYLANX_IR_STORAGE_POOL_AUG_12_2018_0319PM
+
+#include <phylanx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <blaze/Math.h>
+
+namespace phylanx { namespace ir
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Recycles the dense storage of node_data instances.
+    ///
+    /// Storage released by a node_data instance is kept on free lists which
+    /// are local to the releasing (OS-)thread. The free lists are keyed by
+    /// size class, each power of two is split into four classes. Storage is
+    /// acquired from the size class which guarantees enough capacity for the
+    /// requested shape, freshly allocated storage reserves the capacity of
+    /// its size class (at most 25% more than requested). Iterative
+    /// algorithms which repeatedly create temporaries of the same shapes
+    /// therefore do not allocate any memory once the free lists have been
+    /// populated.
+    ///
+    /// The storage cached by all threads together is limited by the
+    /// configuration setting phylanx.storage_pool.max_bytes (default: 256
+    /// MiB). Threads which have not used their free lists for the time
+    /// given by phylanx.storage_pool.trim_interval (in milliseconds,
+    /// default: 1000, 0 disables trimming) free all storage cached by them.
+    template <typename T>
+    class PHYLANX_EXPORT storage_pool
+    {
+    public:
+        using vector_type = blaze::DynamicVector<T>;
+        using matrix_type = blaze::DynamicMatrix<T>;
+
+        /// Return storage for a vector of the given size, the values of the
+        /// elements are unspecified
+        static vector_type acquire_vector(std::size_t size);
+
+        /// Return storage for a matrix of the given shape, the values of the
+        /// elements are unspecified
+        static matrix_type acquire_matrix(
+            std::size_t rows, std::size_t columns);
+
+        /// Keep the memory held by the given storage for later reuse. The
+        /// storage is left empty if it was pooled, otherwise it is left
+        /// untouched (and will be freed by its destructor).
+        static void release(vector_type&& v);
+        static void release(matrix_type&& m);
+
+        /// Free all storage cached by the calling thread
+        static void clear();
+
+        /// Free the storage cached by threads which have not used their free
+        /// lists since the previous invocation
+        static void trim();
+
+        /// Enable or disable pooling, returns the previous setting
+        static bool enable(bool enable);
+        static bool enabled();
+
+        /// Statistics (summed over all threads), exposed as performance
+        /// counters
+        static std::int64_t hit_count(bool reset);
+        static std::int64_t miss_count(bool reset);
+        static std::int64_t release_count(bool reset);
+        static std::int64_t discard_count(bool reset);
+        static std::int64_t cached_bytes(bool reset);
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Start (stop) trimming the storage pools periodically, invoked during
+    /// startup (shutdown) of the runtime
+    PHYLANX_EXPORT void start_storage_pool_trimming();
+    PHYLANX_EXPORT void stop_storage_pool_trimming();
+}}
+
+#endif
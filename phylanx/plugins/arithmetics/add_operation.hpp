@@ -90,6 +90,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_argument_type add2d(arg_type&& lhs, arg_type&& rhs) const;
         primitive_argument_type add2d(args_type && args) const;
 
+        primitive_argument_type add_sparse(
+            arg_type&& lhs, arg_type&& rhs) const;
+
         primitive_argument_type handle_list_operands(
             primitive_argument_type&& lhs, primitive_argument_type&& rhs) const;
         primitive_argument_type handle_numeric_operands(
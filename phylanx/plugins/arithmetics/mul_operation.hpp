@@ -100,6 +100,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_argument_type mul2d2d(
             operand_type&& lhs, operand_type&& rhs) const;
         primitive_argument_type mul2d2d(operands_type&& ops) const;
+
+        primitive_argument_type mul_sparse(
+            operand_type&& lhs, operand_type&& rhs) const;
+        primitive_argument_type mul_sparse(operands_type&& ops) const;
     };
 
     inline primitive create_mul_operation(hpx::id_type const& locality,
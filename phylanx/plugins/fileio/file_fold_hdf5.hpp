@@ -0,0 +1,62 @@
+//  Copyright (c) 2018 Alireza Kheirkhahan
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_FILE_FOLD_HDF5_AUG_10_2018_1130AM)
+#define PHYLANX_PRIMITIVES_FILE_FOLD_HDF5_AUG_10_2018_1130AM
+
+#include <phylanx/config.hpp>
+
+#if defined(PHYLANX_HAVE_HIGHFIVE)
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// file_fold_hdf5(f, initial, filename, dataset[, block_rows])
+    ///
+    /// Stream the given dataset block by block, where each block holds up to
+    /// block_rows rows, and fold the blocks from the left:
+    /// f(...f(f(initial, block0), block1)..., blockN). The next block is read
+    /// while f is being applied to the current one, only two blocks are held
+    /// in memory at any time.
+    class file_fold_hdf5
+      : public primitive_component_base
+      , public std::enable_shared_from_this<file_fold_hdf5>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            std::vector<primitive_argument_type> const& operands,
+            std::vector<primitive_argument_type> const& args) const;
+
+    public:
+        static match_pattern_type const match_data;
+
+        file_fold_hdf5() = default;
+
+        file_fold_hdf5(std::vector<primitive_argument_type>&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+    };
+
+    inline primitive create_file_fold_hdf5(hpx::id_type const& locality,
+        std::vector<primitive_argument_type>&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "file_fold_hdf5", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
+#endif
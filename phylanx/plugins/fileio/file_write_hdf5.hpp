@@ -40,10 +40,6 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         hpx::future<primitive_argument_type> eval(
             std::vector<primitive_argument_type> const& args) const override;
-
-    private:
-        void write_to_file_hdf5(ir::node_data<double> const& val,
-            std::string const& filename, std::string const& dataset_name) const;
     };
 
     inline primitive create_file_write_hdf5(hpx::id_type const& locality,
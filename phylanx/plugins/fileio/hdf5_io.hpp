@@ -0,0 +1,77 @@
+//  Copyright (c) 2018 Alireza Kheirkhahan
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_HDF5_IO_AUG_10_2018_1045AM)
+#define PHYLANX_PRIMITIVES_HDF5_IO_AUG_10_2018_1045AM
+
+#include <phylanx/config.hpp>
+
+#if defined(PHYLANX_HAVE_HIGHFIVE)
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Asynchronous access to HDF5 datasets. The HDF5 library blocks the calling
+// thread and is not guaranteed to be thread-safe, all accesses are therefore
+// executed one at a time on the threads of the HPX I/O pool, which keeps the
+// HPX worker threads free to run the remaining parts of the execution tree.
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The part of a dataset to access. The vectors may be shorter than
+        // the number of dimensions of the dataset: missing offsets are 0,
+        // missing strides are 1, and missing counts extend the selection up
+        // to the end of the respective dimension.
+        struct hdf5_hyperslab
+        {
+            std::vector<std::size_t> offset;
+            std::vector<std::size_t> count;
+            std::vector<std::size_t> stride;
+
+            bool empty() const
+            {
+                return offset.empty() && count.empty() && stride.empty();
+            }
+        };
+
+        // Convert the value of a hyperslab argument (an integer, a list of
+        // integers, an integer vector, or nil) into the extents per dimension
+        std::vector<std::size_t> extract_hyperslab_extents(
+            primitive_argument_type const& val, std::string const& name,
+            std::string const& codename);
+
+        ///////////////////////////////////////////////////////////////////////
+        // Asynchronously retrieve the dimensions of the given dataset
+        hpx::future<std::vector<std::size_t>> hdf5_dataset_dimensions(
+            std::string const& filename, std::string const& dataset_name);
+
+        // Asynchronously read the selected part of the given dataset
+        hpx::future<ir::node_data<double>> read_hdf5(
+            std::string const& filename, std::string const& dataset_name,
+            hdf5_hyperslab const& slab, std::string const& name,
+            std::string const& codename);
+
+        // Asynchronously write the given data. If no offset is given the file
+        // is (re-)created and the dataset covers all of the data, otherwise
+        // the data is written into the existing dataset starting at the
+        // given offset.
+        hpx::future<void> write_hdf5(
+            ir::node_data<double> val, std::string const& filename,
+            std::string const& dataset_name,
+            std::vector<std::size_t> const& offset, std::string const& name,
+            std::string const& codename);
+    }
+}}}
+
+#endif
+#endif
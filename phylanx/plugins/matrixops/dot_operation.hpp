@@ -69,6 +69,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
             operand_type&& lhs, operand_type&& rhs) const;
         primitive_argument_type dot2d2d(
             operand_type&& lhs, operand_type&& rhs) const;
+        primitive_argument_type dot_sparse(
+            operand_type&& lhs, operand_type&& rhs) const;
     };
 
     inline primitive create_dot_operation(hpx::id_type const& locality,
@@ -24,12 +24,14 @@
 #include <phylanx/plugins/matrixops/linearmatrix.hpp>
 #include <phylanx/plugins/matrixops/linspace.hpp>
 #include <phylanx/plugins/matrixops/mean_operation.hpp>
+#include <phylanx/plugins/matrixops/partitioned_operation.hpp>
 #include <phylanx/plugins/matrixops/power_operation.hpp>
 #include <phylanx/plugins/matrixops/random.hpp>
 #include <phylanx/plugins/matrixops/row_set.hpp>
 #include <phylanx/plugins/matrixops/set_operation.hpp>
 #include <phylanx/plugins/matrixops/shuffle_operation.hpp>
 #include <phylanx/plugins/matrixops/slicing_operation.hpp>
+#include <phylanx/plugins/matrixops/sparse_operation.hpp>
 #include <phylanx/plugins/matrixops/square_root_operation.hpp>
 #include <phylanx/plugins/matrixops/sum_operation.hpp>
 #include <phylanx/plugins/matrixops/transpose_operation.hpp>
@@ -0,0 +1,99 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_PARTITIONED_OPERATION_SEP_02_2018_0215PM)
+#define PHYLANX_PRIMITIVES_PARTITIONED_OPERATION_SEP_02_2018_0215PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/partitioned_array.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Create, combine, and collect matrices which are partitioned into
+    /// tiles distributed over all localities. All operations on tiles are
+    /// executed on the localities owning them:
+    ///
+    ///     partition(m)                    -- one block of rows of m for
+    ///                                        each locality
+    ///     partition(m, rows, columns)     -- tiles of the given extent
+    ///     gather(p)                       -- collect p into a matrix
+    ///     tiled_add(p1, p2)               -- element-wise operations,
+    ///     tiled_sub(p1, p2)                  both arrays must have the
+    ///     tiled_mul(p1, p2)                  same shape and tiling
+    ///     tiled_div(p1, p2)
+    ///     tiled_dot(p1, p2)               -- matrix product
+    ///     tiled_transpose(p)              -- transpose of p
+    ///     tiled_sum(p)                    -- sum of all elements
+    ///     tiled_mean(p)                   -- mean of all elements
+    class partitioned_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<partitioned_operation>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            std::vector<primitive_argument_type> const& operands,
+            std::vector<primitive_argument_type> const& args) const;
+
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        partitioned_operation() = default;
+
+        partitioned_operation(std::vector<primitive_argument_type>&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+
+    private:
+        enum class operation
+        {
+            partition,
+            gather,
+            add,
+            sub,
+            mul,
+            div,
+            dot,
+            transpose,
+            sum,
+            mean
+        };
+
+        hpx::future<primitive_argument_type> partition(
+            std::vector<primitive_argument_type>&& args) const;
+        hpx::future<primitive_argument_type> gather(
+            ir::partitioned_array&& arr) const;
+        hpx::future<primitive_argument_type> binary(
+            ir::partitioned_array&& lhs, ir::partitioned_array&& rhs) const;
+        hpx::future<primitive_argument_type> unary(
+            ir::partitioned_array&& arr) const;
+
+        std::size_t num_operands() const;
+
+        operation operation_ = operation::partition;
+    };
+
+    inline primitive create_partitioned_operation(
+        hpx::id_type const& locality,
+        std::vector<primitive_argument_type>&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "__partitioned", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
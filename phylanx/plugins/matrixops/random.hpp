@@ -13,10 +13,10 @@
 #include <hpx/lcos/future.hpp>
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
-#include <random>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -33,15 +33,26 @@ namespace phylanx { namespace execution_tree { namespace primitives
       : public primitive_component_base
       , public std::enable_shared_from_this<random>
     {
-        static std::uint32_t seed_;     // The current seed for the generator.
+        static std::atomic<std::uint32_t> seed_;    // The current seed.
+        static std::atomic<std::uint64_t> sequence_;    // The next sequence.
         static std::uint32_t default_seed();
 
     public:
-        static std::mt19937 rng_;       // The Mersenne twister generator.
+        // Random numbers are generated in blocks of this many elements. Each
+        // block uses its own stream of the counter based generator, which
+        // allows to fill the blocks concurrently while producing the same
+        // result, independently of the number of threads.
+        static constexpr std::size_t block_size = 4096;
 
         static void set_seed(std::uint32_t);
         static std::uint32_t get_seed();
 
+        // Return the key to use for the next sequence of random numbers. All
+        // generated sequences are independent of each other and depend only
+        // on the seed and on the number of sequences generated since the
+        // seed was set.
+        static std::uint64_t next_key();
+
     public:
         static match_pattern_type const match_data;
 
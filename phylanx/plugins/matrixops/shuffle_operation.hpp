@@ -14,7 +14,6 @@
 #include <hpx/lcos/future.hpp>
 
 #include <memory>
-#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -22,12 +21,13 @@
 namespace phylanx { namespace execution_tree { namespace primitives
 {
     /// \brief Randomly shuffles the elements of a PhySL list or the rows of a
-    /// PhySL matrix in place. Unlike [NumPy shuffle](
+    /// PhySL matrix. Unlike [NumPy shuffle](
     /// https://docs.scipy.org/doc/numpy-1.14.0/reference/generated/numpy.random
     /// .shuffle.html)
-    /// it returns the shuffled matrix or list
+    /// it returns the shuffled matrix or list and leaves its argument (e.g.
+    /// the value of a variable) untouched
     ///
-    /// \returns The PhySL matrix or PhySL list that was shuffled in place
+    /// \returns A shuffled copy of the PhySL matrix or PhySL list
     ///
     /// \param args Is either a matrix or list of any values to be
     /// randomly shuffled
@@ -55,8 +55,6 @@ namespace phylanx { namespace execution_tree { namespace primitives
             std::vector<primitive_argument_type> const& params) const override;
 
     private:
-        static std::mt19937 rand_machine;
-
         primitive_argument_type shuffle_1d(arg_type&& arg) const;
         primitive_argument_type shuffle_2d(arg_type&& arg) const;
     };
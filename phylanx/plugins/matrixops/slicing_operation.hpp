@@ -32,6 +32,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
         using storage0d_type = typename arg_type::storage0d_type;
         using storage1d_type = typename arg_type::storage1d_type;
         using storage2d_type = typename arg_type::storage2d_type;
+        using custom_storage1d_type = typename arg_type::custom_storage1d_type;
+        using custom_storage2d_type = typename arg_type::custom_storage2d_type;
+        using sparse_storage2d_type = typename arg_type::sparse_storage2d_type;
 
         hpx::future<primitive_argument_type> eval(
             std::vector<primitive_argument_type> const& operands,
@@ -83,6 +86,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::vector<std::int64_t> create_list_slice(std::int64_t& start,
             std::int64_t& stop, std::int64_t step,
             std::size_t array_length) const;
+        std::size_t slice_extent(std::int64_t& start, std::int64_t& stop,
+            std::int64_t step, std::size_t array_length) const;
+        std::int64_t single_index(
+            std::int64_t index, std::size_t array_length) const;
 
         primitive_argument_type slicing0d(arg_type&& arg) const;
         primitive_argument_type slicing1d(arg_type&& arg,
@@ -90,6 +97,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_argument_type slicing2d(arg_type&& arg,
             std::vector<std::int64_t> const& extracted_row,
             std::vector<std::int64_t> const& extracted_column) const;
+        primitive_argument_type slicing2d_sparse(arg_type&& arg,
+            std::vector<std::int64_t> const& extracted_row,
+            std::vector<std::int64_t> const& extracted_column) const;
 
         primitive_argument_type handle_numeric_operand(
             std::vector<primitive_argument_type>&& args) const;
@@ -0,0 +1,69 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_SPARSE_OPERATION_AUG_19_2018_0930AM)
+#define PHYLANX_PRIMITIVES_SPARSE_OPERATION_AUG_19_2018_0930AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// Convert between dense and sparse (compressed row) matrices:
+    ///
+    ///     sparse(m)                       -- keep the non-zeros of m
+    ///     sparse(rows, columns, values, shape)
+    ///                                     -- build from coordinate lists,
+    ///                                        duplicates are summed up
+    ///     dense(m)                        -- convert m to a dense matrix
+    class sparse_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<sparse_operation>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            std::vector<primitive_argument_type> const& operands,
+            std::vector<primitive_argument_type> const& args) const;
+
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        sparse_operation() = default;
+
+        sparse_operation(std::vector<primitive_argument_type>&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            std::vector<primitive_argument_type> const& args) const override;
+
+    private:
+        primitive_argument_type to_sparse(
+            std::vector<primitive_argument_type>&& args) const;
+        primitive_argument_type from_coordinates(
+            std::vector<primitive_argument_type>&& args) const;
+        primitive_argument_type to_dense(
+            std::vector<primitive_argument_type>&& args) const;
+
+        bool dense_ = false;
+    };
+
+    inline primitive create_sparse_operation(hpx::id_type const& locality,
+        std::vector<primitive_argument_type>&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "sparse", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
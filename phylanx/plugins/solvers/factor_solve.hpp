@@ -0,0 +1,66 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//  Copyright (c) 2018 Shahrzad Shirzad
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PLUGINS_FACTOR_SOLVE_AUG_14_2018_1100AM)
+#define PHYLANX_PLUGINS_FACTOR_SOLVE_AUG_14_2018_1100AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/ir/ranges.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// solve(factor, B)
+    ///
+    /// Solve A * X = B using a factorization of A as returned by one of
+    /// lu_factor, cholesky_factor, or ldlt_factor. B can be a vector or a
+    /// matrix whose columns are the right hand sides to solve for, all of
+    /// which are handled by a single call to LAPACK.
+    class factor_solve
+      : public primitive_component_base
+      , public std::enable_shared_from_this<factor_solve>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            std::vector<primitive_argument_type> const& operands,
+            std::vector<primitive_argument_type> const& args) const;
+
+        using arg_type = ir::node_data<double>;
+
+    public:
+        static match_pattern_type const match_data;
+
+        factor_solve() = default;
+
+        factor_solve(std::vector<primitive_argument_type>&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            std::vector<primitive_argument_type> const& params) const override;
+
+    private:
+        primitive_argument_type solve(ir::range&& factor, arg_type&& b) const;
+    };
+
+    inline primitive create_factor_solve(hpx::id_type const& locality,
+        std::vector<primitive_argument_type>&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "solve", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
@@ -0,0 +1,81 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//  Copyright (c) 2018 Shahrzad Shirzad
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PLUGINS_FACTORIZATION_PRIMITIVES_AUG_14_2018_1030AM)
+#define PHYLANX_PLUGINS_FACTORIZATION_PRIMITIVES_AUG_14_2018_1030AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// lu_factor(A), cholesky_factor(A[, ul]), ldlt_factor(A[, ul])
+    ///
+    /// Factorize the given square matrix once, the returned factor object
+    /// can be passed to solve(factor, B) any number of times. The factor
+    /// object is a list [kind, factors, pivots, uplo], its contents are an
+    /// implementation detail:
+    ///
+    ///  - kind:    "lu", "cholesky", or "ldlt"
+    ///  - factors: the factorization as computed by LAPACK. The matrix is
+    ///             stored in row-major order, which LAPACK sees as A^T.
+    ///  - pivots:  the pivot indices (nil for "cholesky")
+    ///  - uplo:    the triangle of A^T used by LAPACK ("L" or "U")
+    ///
+    /// The optional argument ul ("L" or "U", default: "L") selects the
+    /// triangle of the symmetric matrix A which is referenced.
+    class factorization
+      : public primitive_component_base
+      , public std::enable_shared_from_this<factorization>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            std::vector<primitive_argument_type> const& operands,
+            std::vector<primitive_argument_type> const& args) const;
+
+        using arg_type = ir::node_data<double>;
+        using storage2d_type = typename arg_type::storage2d_type;
+
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        factorization() = default;
+
+        factorization(std::vector<primitive_argument_type>&& operands,
+            std::string const& name, std::string const& codename);
+
+        hpx::future<primitive_argument_type> eval(
+            std::vector<primitive_argument_type> const& params) const override;
+
+    private:
+        primitive_argument_type lu_factor(storage2d_type&& A) const;
+        primitive_argument_type cholesky_factor(
+            storage2d_type&& A, char uplo) const;
+        primitive_argument_type ldlt_factor(
+            storage2d_type&& A, char uplo) const;
+
+        std::string kind_;
+    };
+
+    inline primitive create_factorization(hpx::id_type const& locality,
+        std::vector<primitive_argument_type>&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "_factorization", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
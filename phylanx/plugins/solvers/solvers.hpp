@@ -7,6 +7,8 @@
 #define PHYLANX_PLUGINS_SOLVERS_PRIMITIVES_MAY_11_2018_1030AM
 
 #include <phylanx/plugins/solvers/decomposition.hpp>
+#include <phylanx/plugins/solvers/factor_solve.hpp>
+#include <phylanx/plugins/solvers/factorization.hpp>
 #include <phylanx/plugins/solvers/linear_solver.hpp>
 
 #endif
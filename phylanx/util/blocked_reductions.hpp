@@ -0,0 +1,347 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_BLOCKED_REDUCTIONS_AUG_06_2018_0312PM)
+#define PHYLANX_UTIL_BLOCKED_REDUCTIONS_AUG_06_2018_0312PM
+
+#include <phylanx/config.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/runtime.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <blaze/Math.h>
+
+// Reductions of dense row-major matrices. If requested (usually because the
+// execution policy selected execution_mode::parallel for the calling
+// primitive) the rows of the matrix are split into blocks which are reduced
+// concurrently on separate HPX threads, the partial results are combined in
+// block order afterwards. All loops run
+// over contiguous rows only: reductions along the columns accumulate whole
+// rows into a vector of partial results (processed in tiles of columns to
+// keep those in cache), which allows for the compiler to vectorize the
+// inner loops.
+
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        // minimal number of elements reduced by one HPX thread, this limits
+        // the overheads if a small matrix is reduced in parallel
+        constexpr std::size_t reduction_block_elements = 8192;
+
+        // number of columns accumulated at once when reducing along columns
+        constexpr std::size_t reduction_column_tile = 2048;
+
+        // the number of blocks of rows to process, this is one for
+        // sequential execution
+        inline std::size_t reduction_blocks(
+            std::size_t rows, std::size_t columns, bool parallel)
+        {
+            if (!parallel)
+            {
+                return 1;
+            }
+
+            std::size_t blocks = (std::min)(
+                rows * columns / reduction_block_elements,
+                std::size_t(4 * hpx::get_os_thread_count()));
+            return (std::max)(std::size_t(1), (std::min)(blocks, rows));
+        }
+
+        // invoke f(block, first_row, last_row) for each block of rows
+        template <typename F>
+        void for_each_block(std::size_t rows, std::size_t blocks, F && f)
+        {
+            auto reduce_block = [&](std::size_t block)
+            {
+                f(block, block * rows / blocks, (block + 1) * rows / blocks);
+            };
+
+            if (blocks == 1)
+            {
+                reduce_block(0);
+                return;
+            }
+
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), blocks, reduce_block);
+        }
+
+        // sum of a contiguous range, the independent accumulators break the
+        // dependency chain of the additions which allows for the loop to be
+        // vectorized
+        template <typename T>
+        T sum_range(T const* data, std::size_t size)
+        {
+            T s0 = T(0), s1 = T(0), s2 = T(0), s3 = T(0);
+
+            std::size_t i = 0;
+            for (/**/; i + 4 <= size; i += 4)
+            {
+                s0 += data[i];
+                s1 += data[i + 1];
+                s2 += data[i + 2];
+                s3 += data[i + 3];
+            }
+            for (/**/; i != size; ++i)
+            {
+                s0 += data[i];
+            }
+            return (s0 + s1) + (s2 + s3);
+        }
+
+        // index of the first element for which comp(element, others) holds
+        template <typename T, typename Compare>
+        std::size_t arg_reduce_range(
+            T const* data, std::size_t size, Compare && comp)
+        {
+            std::size_t result = 0;
+            for (std::size_t i = 1; i < size; ++i)
+            {
+                if (comp(data[i], data[result]))
+                {
+                    result = i;
+                }
+            }
+            return result;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Sum of all elements of the given matrix, the rows are processed
+    /// concurrently if parallel is true (this applies to all functions
+    /// below)
+    template <typename Matrix>
+    typename Matrix::ElementType blocked_sum(Matrix const& m, bool parallel)
+    {
+        using T = typename Matrix::ElementType;
+
+        std::size_t const blocks =
+            detail::reduction_blocks(m.rows(), m.columns(), parallel);
+        std::vector<T> partial(blocks, T(0));
+
+        detail::for_each_block(m.rows(), blocks,
+            [&](std::size_t block, std::size_t first, std::size_t last)
+            {
+                T result = T(0);
+                for (std::size_t i = first; i != last; ++i)
+                {
+                    result += detail::sum_range(m.data(i), m.columns());
+                }
+                partial[block] = result;
+            });
+
+        T result = T(0);
+        for (T const& s : partial)
+        {
+            result += s;
+        }
+        return result;
+    }
+
+    /// Sum of the elements of each row of the given matrix
+    template <typename Matrix>
+    blaze::DynamicVector<typename Matrix::ElementType> row_sums(
+        Matrix const& m, bool parallel)
+    {
+        blaze::DynamicVector<typename Matrix::ElementType> result(m.rows());
+
+        detail::for_each_block(m.rows(),
+            detail::reduction_blocks(m.rows(), m.columns(), parallel),
+            [&](std::size_t, std::size_t first, std::size_t last)
+            {
+                for (std::size_t i = first; i != last; ++i)
+                {
+                    result[i] = detail::sum_range(m.data(i), m.columns());
+                }
+            });
+
+        return result;
+    }
+
+    /// Sum of the elements of each column of the given matrix
+    template <typename Matrix>
+    blaze::DynamicVector<typename Matrix::ElementType> column_sums(
+        Matrix const& m, bool parallel)
+    {
+        using T = typename Matrix::ElementType;
+
+        std::size_t const columns = m.columns();
+        std::size_t const blocks =
+            detail::reduction_blocks(m.rows(), columns, parallel);
+        std::vector<std::vector<T>> partial(blocks);
+
+        detail::for_each_block(m.rows(), blocks,
+            [&](std::size_t block, std::size_t first, std::size_t last)
+            {
+                std::vector<T>& acc = partial[block];
+                acc.assign(columns, T(0));
+
+                for (std::size_t c = 0; c < columns;
+                     c += detail::reduction_column_tile)
+                {
+                    std::size_t const tile =
+                        (std::min)(detail::reduction_column_tile, columns - c);
+                    T* a = acc.data() + c;
+                    for (std::size_t i = first; i != last; ++i)
+                    {
+                        T const* row = m.data(i) + c;
+                        for (std::size_t j = 0; j != tile; ++j)
+                        {
+                            a[j] += row[j];
+                        }
+                    }
+                }
+            });
+
+        blaze::DynamicVector<T> result(columns, T(0));
+        for (auto const& acc : partial)
+        {
+            for (std::size_t j = 0; j != columns; ++j)
+            {
+                result[j] += acc[j];
+            }
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Row-major index of the first element e of the (non-empty) matrix for
+    /// which comp(e, x) holds for all other elements x (use std::greater for
+    /// argmax, std::less for argmin)
+    template <typename Matrix, typename Compare>
+    std::size_t arg_reduce(Matrix const& m, Compare comp, bool parallel)
+    {
+        using T = typename Matrix::ElementType;
+
+        std::size_t const columns = m.columns();
+        std::size_t const blocks =
+            detail::reduction_blocks(m.rows(), columns, parallel);
+        std::vector<std::size_t> partial(blocks);
+
+        detail::for_each_block(m.rows(), blocks,
+            [&](std::size_t block, std::size_t first, std::size_t last)
+            {
+                std::size_t best_row = first;
+                std::size_t best_column =
+                    detail::arg_reduce_range(m.data(first), columns, comp);
+                T best = m.data(first)[best_column];
+
+                for (std::size_t i = first + 1; i != last; ++i)
+                {
+                    T const* row = m.data(i);
+                    std::size_t j =
+                        detail::arg_reduce_range(row, columns, comp);
+                    if (comp(row[j], best))
+                    {
+                        best = row[j];
+                        best_row = i;
+                        best_column = j;
+                    }
+                }
+                partial[block] = best_row * columns + best_column;
+            });
+
+        // the blocks are combined in order to find the first occurrence
+        std::size_t result = partial[0];
+        for (std::size_t block = 1; block != blocks; ++block)
+        {
+            std::size_t const index = partial[block];
+            if (comp(m.data(index / columns)[index % columns],
+                    m.data(result / columns)[result % columns]))
+            {
+                result = index;
+            }
+        }
+        return result;
+    }
+
+    /// Column index of the first extremal element of each row
+    template <typename Matrix, typename Compare>
+    std::vector<std::size_t> row_arg_reduce(
+        Matrix const& m, Compare comp, bool parallel)
+    {
+        std::vector<std::size_t> result(m.rows());
+
+        detail::for_each_block(m.rows(),
+            detail::reduction_blocks(m.rows(), m.columns(), parallel),
+            [&](std::size_t, std::size_t first, std::size_t last)
+            {
+                for (std::size_t i = first; i != last; ++i)
+                {
+                    result[i] =
+                        detail::arg_reduce_range(m.data(i), m.columns(), comp);
+                }
+            });
+
+        return result;
+    }
+
+    /// Row index of the first extremal element of each column
+    template <typename Matrix, typename Compare>
+    std::vector<std::size_t> column_arg_reduce(
+        Matrix const& m, Compare comp, bool parallel)
+    {
+        using T = typename Matrix::ElementType;
+
+        std::size_t const columns = m.columns();
+        std::size_t const blocks =
+            detail::reduction_blocks(m.rows(), columns, parallel);
+
+        std::vector<std::vector<T>> best(blocks);
+        std::vector<std::vector<std::size_t>> index(blocks);
+
+        detail::for_each_block(m.rows(), blocks,
+            [&](std::size_t block, std::size_t first, std::size_t last)
+            {
+                std::vector<T>& b = best[block];
+                std::vector<std::size_t>& idx = index[block];
+
+                b.assign(m.data(first), m.data(first) + columns);
+                idx.assign(columns, first);
+
+                for (std::size_t c = 0; c < columns;
+                     c += detail::reduction_column_tile)
+                {
+                    std::size_t const tile =
+                        (std::min)(detail::reduction_column_tile, columns - c);
+                    T* bt = b.data() + c;
+                    std::size_t* it = idx.data() + c;
+                    for (std::size_t i = first + 1; i != last; ++i)
+                    {
+                        T const* row = m.data(i) + c;
+                        for (std::size_t j = 0; j != tile; ++j)
+                        {
+                            bool const better = comp(row[j], bt[j]);
+                            bt[j] = better ? row[j] : bt[j];
+                            it[j] = better ? i : it[j];
+                        }
+                    }
+                }
+            });
+
+        // the blocks are combined in order to find the first occurrence
+        std::vector<std::size_t> result = std::move(index[0]);
+        std::vector<T> result_best = std::move(best[0]);
+        for (std::size_t block = 1; block != blocks; ++block)
+        {
+            for (std::size_t j = 0; j != columns; ++j)
+            {
+                if (comp(best[block][j], result_best[j]))
+                {
+                    result_best[j] = best[block][j];
+                    result[j] = index[block][j];
+                }
+            }
+        }
+        return result;
+    }
+}}
+
+#endif
@@ -0,0 +1,46 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_CACHED_CONFIG_FLAG_AUG_20_2018_1015AM)
+#define PHYLANX_UTIL_CACHED_CONFIG_FLAG_AUG_20_2018_1015AM
+
+#include <phylanx/config.hpp>
+
+#include <atomic>
+
+namespace phylanx { namespace util { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A boolean setting which is initialized from the configuration entry
+    // of the given name ("1" enables it) when it is first queried and which
+    // can be changed at runtime afterwards.
+    class PHYLANX_EXPORT cached_config_flag
+    {
+    public:
+        constexpr cached_config_flag(char const* name, bool default_value)
+          : name_(name)
+          , default_value_(default_value)
+          , value_(-1)
+        {}
+
+        cached_config_flag(cached_config_flag const&) = delete;
+        cached_config_flag& operator=(cached_config_flag const&) = delete;
+
+        // Return the current setting
+        bool get();
+
+        // Change the setting, returns the previous one
+        bool set(bool enable);
+
+    private:
+        char const* name_;
+        bool default_value_;
+
+        // -1: not initialized yet, 0: disabled, 1: enabled
+        std::atomic<int> value_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,90 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_EVENT_TRACER_AUG_16_2018_0214PM)
+#define PHYLANX_UTIL_EVENT_TRACER_AUG_16_2018_0214PM
+
+#include <phylanx/config.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// A single evaluation of an execution tree node
+    struct trace_event
+    {
+        static constexpr std::size_t max_name_length = 63;
+        static constexpr std::size_t max_operands = 3;
+
+        std::uint64_t begin_;           // time stamps in nanoseconds
+        std::uint64_t end_;
+        std::uint64_t thread_id_;       // HPX thread which started the eval
+        std::uint32_t worker_;          // worker thread which started the eval
+        std::uint32_t end_worker_;      // worker thread which completed it
+        std::uint32_t num_operands_;
+        bool async_;                    // completed after eval returned
+
+        // The number of dimensions of the argument and literal operands
+        // (-1 if not numeric) and their extents
+        std::int8_t dimensions_[max_operands];
+        std::int64_t extents_[max_operands][2];
+
+        char name_[max_name_length + 1];    // truncated primitive name
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Records trace events into fixed size ring buffers which are local to
+    /// the recording (OS-)thread. Recording an event neither allocates memory
+    /// (except for the first event recorded by a thread) nor takes a lock,
+    /// once a buffer is full the oldest events are overwritten. The recorded
+    /// events can be written in the Chrome trace event format, which can be
+    /// viewed with chrome://tracing or https://ui.perfetto.dev. Evaluations
+    /// which completed asynchronously are written as pairs of async events,
+    /// as they may begin and end on different worker threads.
+    ///
+    /// \note snapshot(), clear(), and write_chrome_trace() should be called
+    ///       while no events are being recorded, otherwise the events
+    ///       recorded concurrently may be reported inconsistently.
+    class PHYLANX_EXPORT event_tracer
+    {
+    public:
+        /// The number of events kept per thread
+        static constexpr std::size_t buffer_size = 16384;
+
+        /// Enable or disable recording events, returns the previous setting
+        static bool enable(bool enable);
+        static bool enabled()
+        {
+            return enabled_.load(std::memory_order_relaxed);
+        }
+
+        /// Record the given event into the buffer of the calling thread
+        static void record(trace_event const& event);
+
+        /// Return the events recorded by all threads ordered by their start
+        static std::vector<trace_event> snapshot();
+
+        /// The number of events which have been overwritten
+        static std::int64_t overwritten_count(bool reset);
+
+        /// Discard all recorded events
+        static void clear();
+
+        /// Write all recorded events in the Chrome trace event format
+        static void write_chrome_trace(std::ostream& os);
+        static void write_chrome_trace(std::string const& filename);
+
+    private:
+        static std::atomic<bool> enabled_;
+    };
+}}
+
+#endif
@@ -24,7 +24,10 @@ namespace phylanx { namespace util
     ///                 data is required
     /// \param counter_name_last_parts A vector containing the last part of the
     ///                 performance counter names. e.g. std::vector{
-    ///                     "count/eval", "time/eval", "eval_direct" }
+    ///                     "count/eval", "time/eval", "eval_direct" }, the
+    ///                 memory counters are "memory/allocated",
+    ///                 "memory/copied", "memory/max_allocated_per_eval", and
+    ///                 "count/copies"
     /// \param locality_id The locality the performance counter data is going
     ///                 to be queried from
     ///
@@ -0,0 +1,141 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_PHILOX_JUL_20_2018_1120AM)
+#define PHYLANX_UTIL_PHILOX_JUL_20_2018_1120AM
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Counter based random number generator Philox-4x32-10 as described in:
+    //
+    //      J. K. Salmon, M. A. Moraes, R. O. Dror, and D. E. Shaw, "Parallel
+    //      random numbers: as easy as 1, 2, 3", SC'11
+    //
+    // The generated sequence is fully determined by a 64 bit key (usually the
+    // seed) and a 64 bit stream number. Each stream is an independent
+    // sequence of 2^66 numbers, its elements are computed by encrypting a
+    // counter, which makes it possible to create any number of independent
+    // generators that can be used concurrently without sharing any state.
+    //
+    // This type satisfies the requirements of UniformRandomBitGenerator and
+    // can be used with the distributions defined by <random>.
+    class philox4x32
+    {
+    public:
+        using result_type = std::uint32_t;
+
+        static constexpr result_type (min)()
+        {
+            return (std::numeric_limits<result_type>::min)();
+        }
+        static constexpr result_type (max)()
+        {
+            return (std::numeric_limits<result_type>::max)();
+        }
+
+        explicit philox4x32(std::uint64_t key = 0, std::uint64_t stream = 0)
+          : key_{{std::uint32_t(key), std::uint32_t(key >> 32)}}
+          , counter_{{0, 0, std::uint32_t(stream),
+                std::uint32_t(stream >> 32)}}
+          , result_{}
+          , index_(4)
+        {}
+
+        result_type operator()()
+        {
+            if (index_ == 4)
+            {
+                generate();
+                increment();
+                index_ = 0;
+            }
+            return result_[index_++];
+        }
+
+        // Skip the given number of values of the current stream.
+        void discard(std::uint64_t n)
+        {
+            while (n != 0 && index_ != 4)
+            {
+                ++index_;
+                --n;
+            }
+            if (n != 0)
+            {
+                // skip whole blocks of four values
+                std::uint64_t blocks = n / 4;
+                std::uint64_t lo = counter_[0] + (blocks & 0xffffffff);
+                counter_[0] = std::uint32_t(lo);
+                counter_[1] += std::uint32_t(blocks >> 32) +
+                    std::uint32_t(lo >> 32);
+
+                generate();
+                increment();
+                index_ = std::size_t(n % 4);
+            }
+        }
+
+        friend bool operator==(philox4x32 const& lhs, philox4x32 const& rhs)
+        {
+            return lhs.key_ == rhs.key_ && lhs.counter_ == rhs.counter_ &&
+                lhs.index_ == rhs.index_;
+        }
+        friend bool operator!=(philox4x32 const& lhs, philox4x32 const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        static void mulhilo(std::uint32_t a, std::uint32_t b,
+            std::uint32_t& hi, std::uint32_t& lo)
+        {
+            std::uint64_t product = std::uint64_t(a) * std::uint64_t(b);
+            hi = std::uint32_t(product >> 32);
+            lo = std::uint32_t(product);
+        }
+
+        void generate()
+        {
+            std::array<std::uint32_t, 4> ctr = counter_;
+            std::array<std::uint32_t, 2> key = key_;
+
+            for (int round = 0; round != 10; ++round)
+            {
+                std::uint32_t hi0, lo0, hi1, lo1;
+                mulhilo(0xD2511F53, ctr[0], hi0, lo0);
+                mulhilo(0xCD9E8D57, ctr[2], hi1, lo1);
+
+                ctr = {{hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1],
+                    lo0}};
+
+                key[0] += 0x9E3779B9;
+                key[1] += 0xBB67AE85;
+            }
+            result_ = ctr;
+        }
+
+        void increment()
+        {
+            if (++counter_[0] == 0)
+            {
+                ++counter_[1];
+            }
+        }
+
+    private:
+        std::array<std::uint32_t, 2> key_;
+        std::array<std::uint32_t, 4> counter_;
+        std::array<std::uint32_t, 4> result_;
+        std::size_t index_;
+    };
+}}
+
+#endif
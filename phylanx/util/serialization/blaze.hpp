@@ -64,6 +64,44 @@ namespace hpx { namespace serialization
             hpx::serialization::make_array(target.data(), rows * spacing);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, bool SO>
+    void load(input_archive& archive, blaze::CompressedMatrix<T, SO>& target,
+        unsigned)
+    {
+        // De-serialize sparse matrix, the non-zero elements are stored for
+        // each row (row-major) or column (column-major)
+        std::size_t rows = 0UL;
+        std::size_t columns = 0UL;
+        std::size_t nonzeros = 0UL;
+        archive >> rows >> columns >> nonzeros;
+
+        target.resize(rows, columns, false);
+        target.reserve(nonzeros);
+
+        std::size_t const outer = (SO == blaze::rowMajor) ? rows : columns;
+        for (std::size_t i = 0; i != outer; ++i)
+        {
+            std::size_t count = 0UL;
+            archive >> count;
+            for (std::size_t k = 0; k != count; ++k)
+            {
+                std::size_t index = 0UL;
+                T value = T();
+                archive >> index >> value;
+                if (SO == blaze::rowMajor)
+                {
+                    target.append(i, index, value);
+                }
+                else
+                {
+                    target.append(index, i, value);
+                }
+            }
+            target.finalize(i);
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename T, bool AF, bool PF, bool TF>
     void load(input_archive& archive,
@@ -155,6 +193,30 @@ namespace hpx { namespace serialization
             target.data(), rows * spacing);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, bool SO>
+    void save(output_archive& archive,
+        blaze::CompressedMatrix<T, SO> const& target, unsigned)
+    {
+        // Serialize sparse matrix
+        std::size_t rows = target.rows();
+        std::size_t columns = target.columns();
+        std::size_t nonzeros = target.nonZeros();
+        archive << rows << columns << nonzeros;
+
+        std::size_t const outer = (SO == blaze::rowMajor) ? rows : columns;
+        for (std::size_t i = 0; i != outer; ++i)
+        {
+            std::size_t count = target.nonZeros(i);
+            archive << count;
+            for (auto it = target.begin(i); it != target.end(i); ++it)
+            {
+                std::size_t index = it->index();
+                archive << index << it->value();
+            }
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     HPX_SERIALIZATION_SPLIT_FREE_TEMPLATE(
         (template <typename T, bool TF>), (blaze::DynamicVector<T, TF>));
@@ -162,6 +224,9 @@ namespace hpx { namespace serialization
     HPX_SERIALIZATION_SPLIT_FREE_TEMPLATE(
         (template <typename T, bool SO>), (blaze::DynamicMatrix<T, SO>));
 
+    HPX_SERIALIZATION_SPLIT_FREE_TEMPLATE(
+        (template <typename T, bool SO>), (blaze::CompressedMatrix<T, SO>));
+
     HPX_SERIALIZATION_SPLIT_FREE_TEMPLATE(
         (template <typename T, bool AF, bool PF, bool TF>),
         (blaze::CustomVector<T, AF, PF, TF>));
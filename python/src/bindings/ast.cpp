@@ -12,6 +12,7 @@
 
 #include <pybind11/pybind11.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -288,5 +289,49 @@ void phylanx::bindings::bind_ast(pybind11::module m)
     ///////////////////////////////////////////////////////////////////////////
     // Compiler State
     pybind11::class_<phylanx::bindings::compiler_state>(m, "compiler_state")
-        .def(pybind11::init<>());
+        .def(pybind11::init<std::size_t>(), pybind11::arg("cache_size") = 128,
+            "create a new compiler state, cache_size is the maximum number "
+            "of compiled expressions kept for repeated evaluation")
+        .def_property_readonly("cache_hits",
+            [](phylanx::bindings::compiler_state const& c)
+            {
+                return c.eval_cache.hits();
+            },
+            "number of evaluations which reused a compiled expression")
+        .def_property_readonly("cache_misses",
+            [](phylanx::bindings::compiler_state const& c)
+            {
+                return c.eval_cache.misses();
+            },
+            "number of evaluations which required compiling the expression")
+        .def_property_readonly("cache_evictions",
+            [](phylanx::bindings::compiler_state const& c)
+            {
+                return c.eval_cache.evictions();
+            },
+            "number of compiled expressions evicted from the cache")
+        .def_property_readonly("cache_size",
+            [](phylanx::bindings::compiler_state const& c)
+            {
+                return c.eval_cache.size();
+            },
+            "number of compiled expressions currently held in the cache")
+        .def_property_readonly("cache_capacity",
+            [](phylanx::bindings::compiler_state const& c)
+            {
+                return c.eval_cache.capacity();
+            },
+            "maximum number of compiled expressions held in the cache")
+        .def("clear_cache",
+            [](phylanx::bindings::compiler_state& c)
+            {
+                pybind11::gil_scoped_release release;       // release GIL
+                hpx::threads::run_as_hpx_thread(
+                    [&]()
+                    {
+                        pybind11::gil_scoped_acquire acquire;
+                        c.eval_cache.clear(c.eval_snippets.snippets_);
+                    });
+            },
+            "remove all compiled expressions from the cache");
 }
@@ -9,15 +9,20 @@
 #define PHYLANX_BINDING_HELPERS_HPP
 
 #include <phylanx/phylanx.hpp>
+#include <phylanx/ast/detail/is_identifier.hpp>
 
 #include <pybind11/pybind11.h>
 
 #include <hpx/runtime/threads/run_as_hpx_thread.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <iterator>
+#include <list>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
@@ -29,6 +34,119 @@ namespace phylanx { namespace bindings
     void bind_execution_tree(pybind11::module m);
     void bind_util(pybind11::module m);
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Cache of compiled expressions evaluated by expression_evaluator, each
+    // entry refers to the snippet the expression was compiled into. The
+    // entries are kept in least recently used order, the least recently used
+    // entry is evicted if the cache is full. All accesses are protected by
+    // the GIL.
+    class compiled_expression_cache
+    {
+        using function = phylanx::execution_tree::compiler::function;
+        using snippet_iterator = std::list<function>::iterator;
+
+        struct entry
+        {
+            std::string expr_;
+            std::size_t generation_;
+            function f_;
+            snippet_iterator snippet_;
+        };
+
+        using entries_type = std::list<entry>;
+
+    public:
+        explicit compiled_expression_cache(std::size_t capacity)
+          : capacity_(capacity)
+          , hits_(0)
+          , misses_(0)
+          , evictions_(0)
+        {
+        }
+
+        // Return the compiled function for the given expression if it was
+        // compiled for the same state of the compilation environment.
+        function const* find(std::string const& expr, std::size_t generation,
+            std::list<function>& snippets)
+        {
+            auto it = index_.find(expr);
+            if (it == index_.end())
+            {
+                ++misses_;
+                return nullptr;
+            }
+
+            if (it->second->generation_ != generation)
+            {
+                // the environment has changed since this was compiled
+                erase(it->second, snippets);
+                ++misses_;
+                return nullptr;
+            }
+
+            ++hits_;
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return &entries_.front().f_;
+        }
+
+        void insert(std::string const& expr, std::size_t generation,
+            function const& f, snippet_iterator snippet,
+            std::list<function>& snippets)
+        {
+            if (capacity_ == 0)
+            {
+                return;
+            }
+
+            auto it = index_.find(expr);
+            if (it != index_.end())
+            {
+                erase(it->second, snippets);
+            }
+
+            while (entries_.size() >= capacity_)
+            {
+                erase(std::prev(entries_.end()), snippets);
+                ++evictions_;
+            }
+
+            entries_.push_front(entry{expr, generation, f, snippet});
+            index_[expr] = entries_.begin();
+        }
+
+        void clear(std::list<function>& snippets)
+        {
+            while (!entries_.empty())
+            {
+                erase(entries_.begin(), snippets);
+            }
+        }
+
+        std::size_t size() const { return entries_.size(); }
+        std::size_t capacity() const { return capacity_; }
+
+        std::int64_t hits() const { return hits_; }
+        std::int64_t misses() const { return misses_; }
+        std::int64_t evictions() const { return evictions_; }
+
+    private:
+        // release the snippet the expression was compiled into as well
+        void erase(entries_type::iterator it, std::list<function>& snippets)
+        {
+            snippets.erase(it->snippet_);
+            index_.erase(it->expr_);
+            entries_.erase(it);
+        }
+
+        std::size_t capacity_;
+        entries_type entries_;
+        std::unordered_map<std::string, entries_type::iterator> index_;
+
+        std::int64_t hits_;
+        std::int64_t misses_;
+        std::int64_t evictions_;
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     // support for compilers
     struct compiler_state
@@ -39,6 +157,11 @@ namespace phylanx { namespace bindings
         phylanx::execution_tree::compiler::environment eval_env;
         phylanx::execution_tree::compiler::function_list eval_snippets;
 
+        // the generation is incremented whenever the compilation environment
+        // might have been modified, this invalidates all cached expressions
+        std::size_t generation;
+        compiled_expression_cache eval_cache;
+
         static pybind11::object import_phylanx()
         {
 #if defined(_DEBUG)
@@ -48,10 +171,12 @@ namespace phylanx { namespace bindings
 #endif
         }
 
-        compiler_state()
+        explicit compiler_state(std::size_t cache_size = 128)
           : m(import_phylanx())
           , eval_env(phylanx::execution_tree::compiler::default_environment())
           , eval_snippets()
+          , generation(0)
+          , eval_cache(cache_size)
         {
         }
     };
@@ -160,12 +285,28 @@ namespace phylanx { namespace bindings
         return hpx::threads::run_as_hpx_thread(
             [&]() -> void
             {
+                pybind11::gil_scoped_acquire acquire;
+                ++c.generation;
                 phylanx::execution_tree::compile(
                     phylanx::ast::generate_ast(xexpr_str), c.eval_snippets,
                     c.eval_env);
             });
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Only expressions referring to a compiled function (as used by the
+    // @Phylanx decorator) can be cached. Compiling any other expression
+    // evaluates it, which may have side effects or may depend on the current
+    // value of variables.
+    inline bool is_cacheable_expression(
+        std::vector<phylanx::ast::expression> const& xexpr,
+        phylanx::execution_tree::compiler::function const& f)
+    {
+        return xexpr.size() == 1 &&
+            phylanx::ast::detail::is_identifier(xexpr[0]) &&
+            phylanx::execution_tree::is_primitive_operand(f.arg_);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     inline phylanx::execution_tree::primitive_argument_type
     expression_evaluator(
@@ -177,9 +318,30 @@ namespace phylanx { namespace bindings
             [&]() -> phylanx::execution_tree::primitive_argument_type
             {
                 pybind11::gil_scoped_acquire acquire;
-                auto xexpr = phylanx::ast::generate_ast(xexpr_str);
-                auto x = phylanx::execution_tree::compile(
-                    xexpr, c.eval_snippets, c.eval_env);
+
+                phylanx::execution_tree::compiler::function x;
+                if (auto const* cached = c.eval_cache.find(
+                        xexpr_str, c.generation, c.eval_snippets.snippets_))
+                {
+                    x = *cached;
+                }
+                else
+                {
+                    auto xexpr = phylanx::ast::generate_ast(xexpr_str);
+                    x = phylanx::execution_tree::compile(
+                        xexpr, c.eval_snippets, c.eval_env);
+
+                    if (is_cacheable_expression(xexpr, x))
+                    {
+                        c.eval_cache.insert(xexpr_str, c.generation, x,
+                            std::prev(c.eval_snippets.snippets_.end()),
+                            c.eval_snippets.snippets_);
+                    }
+                    else
+                    {
+                        ++c.generation;
+                    }
+                }
 
                 std::vector<phylanx::execution_tree::primitive_argument_type>
                     fargs;
@@ -193,8 +355,11 @@ namespace phylanx { namespace bindings
                     fargs.emplace_back(std::move(value));
                 }
 
+                // the arguments may refer to the data of the numpy arrays
+                // held by args, the result must not outlive those
                 pybind11::gil_scoped_release release;       // release GIL
-                return x(std::move(fargs));
+                return phylanx::execution_tree::extract_copy_value(
+                    x(std::move(fargs)));
             });
     };
 }}
@@ -101,4 +101,20 @@ void phylanx::bindings::bind_execution_tree(pybind11::module m)
         .def("__repr__",
             &phylanx::bindings::repr<phylanx::execution_tree::primitive>)
     ;
+
+    pybind11::class_<phylanx::ir::partitioned_array>(execution_tree,
+        "partitioned_array",
+        "type representing a matrix partitioned into tiles over localities")
+        .def_property_readonly("rows", &phylanx::ir::partitioned_array::rows)
+        .def_property_readonly(
+            "columns", &phylanx::ir::partitioned_array::columns)
+        .def("gather", [](phylanx::ir::partitioned_array const& arr)
+            {
+                return hpx::threads::run_as_hpx_thread(
+                    [&]() {
+                        return arr.gather().get();
+                    });
+            },
+            "collect all tiles into a single matrix")
+    ;
 }
@@ -327,11 +327,89 @@ namespace pybind11 { namespace detail
         }
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Determine whether the data of the given numpy array can be referenced
+    // directly by a blaze::CustomVector/CustomMatrix (aligned and padded),
+    // i.e. whether the array already is a writeable C-contiguous array of T
+    // whose buffer satisfies the alignment requirements of Blaze and whose
+    // rows don't require any padding. Read-only arrays are always copied as
+    // the node_data referring to them would allow modifying their data.
+    template <typename T>
+    bool is_referenceable(handle src, std::size_t expected_dims)
+    {
+        if (!isinstance<array>(src))
+        {
+            return false;
+        }
+
+        auto a = reinterpret_borrow<array>(src);
+        if (a.ndim() != expected_dims || !a.dtype().is(dtype::of<T>()) ||
+            !(a.flags() & array::c_style) || !a.writeable())
+        {
+            return false;
+        }
+
+        constexpr std::size_t simd_size = blaze::SIMDTrait<T>::size;
+        constexpr std::size_t alignment = blaze::AlignmentOf<T>::value;
+
+        std::size_t row_size = a.shape(expected_dims - 1);
+        return row_size != 0 && row_size % simd_size == 0 &&
+            reinterpret_cast<std::uintptr_t>(a.data()) % alignment == 0;
+    }
+
     template <typename T>
     class type_caster<phylanx::ir::node_data<T>>
     {
         using result_type = typename casted_type<T>::type;
 
+        // The numpy array wrapped by the loaded value, this keeps the array
+        // alive as long as the caster exists. The node_data view does not
+        // own the array, expression_evaluator keeps the arguments of the
+        // Python call alive until the result of the evaluation has been
+        // detached from them.
+        array base_;
+
+        // Wrap the buffer of a writeable numpy array without copying its
+        // data. The view is used for reading only: primitives copy
+        // referenced node_data before modifying it (e.g. shuffle) and
+        // variables copy referenced node_data when being defined or
+        // assigned to.
+        bool load1d_ref(handle src)
+        {
+            if (!std::is_same<T, result_type>::value ||
+                !is_referenceable<T>(src, 1))
+            {
+                return false;
+            }
+
+            auto a = reinterpret_borrow<array>(src);
+            std::size_t size = a.shape(0);
+
+            value = typename phylanx::ir::node_data<T>::custom_storage1d_type(
+                const_cast<T*>(static_cast<T const*>(a.data())), size, size);
+            base_ = a;
+            return true;
+        }
+
+        bool load2d_ref(handle src)
+        {
+            if (!std::is_same<T, result_type>::value ||
+                !is_referenceable<T>(src, 2))
+            {
+                return false;
+            }
+
+            auto a = reinterpret_borrow<array>(src);
+            std::size_t rows = a.shape(0);
+            std::size_t columns = a.shape(1);
+
+            value = typename phylanx::ir::node_data<T>::custom_storage2d_type(
+                const_cast<T*>(static_cast<T const*>(a.data())), rows,
+                columns, columns);
+            base_ = a;
+            return true;
+        }
+
         bool load0d(handle src, bool convert)
         {
             // np.array([0]) is convertible to a scalar value
@@ -381,6 +459,11 @@ namespace pybind11 { namespace detail
                 return false;
             }
 
+            if (load1d_ref(src))
+            {
+                return true;
+            }
+
             // Coerce into an array, but don't do type conversion yet; the copy
             // below handles it.
             auto buf = array::ensure(src);
@@ -420,6 +503,11 @@ namespace pybind11 { namespace detail
                 return false;
             }
 
+            if (load2d_ref(src))
+            {
+                return true;
+            }
+
             // Coerce into an array, but don't do type conversion yet; the copy
             // below handles it.
             auto buf = array::ensure(src);
@@ -4,6 +4,7 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/ast/detail/is_placeholder.hpp>
 #include <phylanx/ast/generate_ast.hpp>
 #include <phylanx/ast/match_ast.hpp>
 #include <phylanx/ast/node.hpp>
@@ -11,6 +12,12 @@
 #include <phylanx/ast/traverse.hpp>
 #include <phylanx/util/variant.hpp>
 
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/format.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <map>
 #include <string>
 #include <utility>
@@ -580,4 +587,433 @@ namespace phylanx { namespace ast
 
         return result;
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Generate the key describing the shape of the top-level node of the
+        // given expression. An expression can match a rule only if both keys
+        // are equal. Returns false if the expression is (or starts with) a
+        // placeholder, which can possibly match anything.
+        bool generate_rule_key(expression const& e, std::string& key)
+        {
+            if (is_placeholder(e))
+            {
+                return false;
+            }
+
+            expression const& expr = extract_expression(e);
+            if (!expr.rest.empty())
+            {
+                // the first operator has to match
+                key = "o" +
+                    std::to_string(static_cast<int>(expr.rest[0].operator_));
+                return true;
+            }
+
+            switch (expr.first.index())
+            {
+            case 1:     // primary_expr
+                {
+                    primary_expr const& pe =
+                        util::get<1>(expr.first.get()).get();
+                    if (is_placeholder(pe))
+                    {
+                        return false;
+                    }
+
+                    if (pe.index() == 7)
+                    {
+                        function_call const& fc = util::get<7>(pe.get()).get();
+                        if (is_placeholder(fc.function_name))
+                        {
+                            return false;
+                        }
+
+                        key = "c" + fc.function_name.name;
+                        return true;
+                    }
+
+                    key = "p" + std::to_string(pe.index());
+                    return true;
+                }
+
+            case 2:     // unary_expr
+                {
+                    unary_expr const& ue = util::get<2>(expr.first.get()).get();
+                    key = "u" + std::to_string(static_cast<int>(ue.operator_));
+                    return true;
+                }
+
+            default:
+                break;
+            }
+
+            key = "n";
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // All rules indexed by the shape of their left hand side, the rules
+        // which may match a given node are tried in their original order.
+        class rule_index
+        {
+        public:
+            explicit rule_index(std::vector<transform_rule> const& rules)
+            {
+                std::map<std::string, std::vector<std::size_t>> keyed;
+                for (std::size_t i = 0; i != rules.size(); ++i)
+                {
+                    std::string key;
+                    if (generate_rule_key(rules[i].first, key))
+                    {
+                        keyed[key].push_back(i);
+                    }
+                    else
+                    {
+                        wildcards_.push_back(i);
+                    }
+                }
+
+                // every key refers to its rules merged with the rules
+                // starting with a placeholder
+                for (auto& p : keyed)
+                {
+                    std::vector<std::size_t>& candidates = indexed_[p.first];
+                    candidates.reserve(p.second.size() + wildcards_.size());
+                    std::merge(p.second.begin(), p.second.end(),
+                        wildcards_.begin(), wildcards_.end(),
+                        std::back_inserter(candidates));
+                }
+            }
+
+            std::vector<std::size_t> const& candidates(
+                expression const& expr) const
+            {
+                std::string key;
+                if (generate_rule_key(expr, key))
+                {
+                    auto it = indexed_.find(key);
+                    if (it != indexed_.end())
+                    {
+                        return it->second;
+                    }
+                }
+                return wildcards_;
+            }
+
+        private:
+            std::map<std::string, std::vector<std::size_t>> indexed_;
+            std::vector<std::size_t> wildcards_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Bottom-up rewriting of an expression tree. All functions return
+        // whether the given node was changed, only in this case the rewritten
+        // node is stored in 'result'. Unchanged subtrees are never copied.
+        class rewriter
+        {
+        public:
+            rewriter(std::vector<transform_rule> const& rules,
+                    std::size_t max_rewrites)
+              : rules_(rules)
+              , index_(rules)
+              , max_rewrites_(max_rewrites)
+              , rewrites_(0)
+            {
+            }
+
+            bool rewrite(expression const& expr, expression& result)
+            {
+                expression children;
+                bool changed = rewrite_children(expr, children);
+
+                expression replaced;
+                if (apply_rules(changed ? children : expr, replaced))
+                {
+                    result = std::move(replaced);
+                    return true;
+                }
+
+                if (changed)
+                {
+                    result = std::move(children);
+                }
+                return changed;
+            }
+
+        private:
+            bool rewrite(std::vector<expression> const& exprs,
+                std::vector<expression>& result)
+            {
+                bool changed = false;
+                for (std::size_t i = 0; i != exprs.size(); ++i)
+                {
+                    expression expr;
+                    if (rewrite(exprs[i], expr))
+                    {
+                        if (!changed)
+                        {
+                            result.reserve(exprs.size());
+                            result.assign(exprs.begin(), exprs.begin() + i);
+                            changed = true;
+                        }
+                        result.push_back(std::move(expr));
+                    }
+                    else if (changed)
+                    {
+                        result.push_back(exprs[i]);
+                    }
+                }
+                return changed;
+            }
+
+            bool rewrite(function_call const& fc, function_call& result)
+            {
+                std::vector<expression> args;
+                if (!rewrite(fc.args, args))
+                {
+                    return false;
+                }
+                result = function_call{fc.function_name, std::move(args)};
+                return true;
+            }
+
+            bool rewrite(primary_expr const& pe, primary_expr& result)
+            {
+                switch (pe.index())
+                {
+                case 6:     // phylanx::util::recursive_wrapper<expression>
+                    {
+                        expression expr;
+                        if (!rewrite(util::get<6>(pe.var).get(), expr))
+                        {
+                            return false;
+                        }
+                        result = primary_expr{std::move(expr)};
+                    }
+                    break;
+
+                case 7:     // phylanx::util::recursive_wrapper<function_call>
+                    {
+                        function_call fc;
+                        if (!rewrite(util::get<7>(pe.var).get(), fc))
+                        {
+                            return false;
+                        }
+                        result = primary_expr{std::move(fc)};
+                    }
+                    break;
+
+                case 8:
+                    // phylanx::util::recursive_wrapper<std::vector<ast::expression>>
+                    {
+                        std::vector<expression> exprs;
+                        if (!rewrite(util::get<8>(pe.var).get(), exprs))
+                        {
+                            return false;
+                        }
+                        result = primary_expr{std::move(exprs)};
+                    }
+                    break;
+
+                case 0: HPX_FALLTHROUGH;    // nil
+                case 1: HPX_FALLTHROUGH;    // bool
+                case 2: HPX_FALLTHROUGH;    // phylanx::ir::node_data<double>
+                case 3: HPX_FALLTHROUGH;    // identifier
+                case 4: HPX_FALLTHROUGH;    // std::string
+                case 5: HPX_FALLTHROUGH;    // std::int64_t
+                default:
+                    return false;
+                }
+
+                result.id = pe.id;
+                result.col = pe.col;
+                return true;
+            }
+
+            bool rewrite(operand const& op, operand& result)
+            {
+                switch (op.index())
+                {
+                case 1:     // phylanx::util::recursive_wrapper<primary_expr>
+                    {
+                        primary_expr pe;
+                        if (!rewrite(util::get<1>(op.var).get(), pe))
+                        {
+                            return false;
+                        }
+
+                        // eliminate rewritten expressions consisting of
+                        // only one operand
+                        if (pe.index() == 6)
+                        {
+                            expression const& expr =
+                                util::get<6>(pe.var).get();
+                            if (expr.rest.empty() && expr.first.index() != 0)
+                            {
+                                result = expr.first;
+                                return true;
+                            }
+                        }
+
+                        result = operand{std::move(pe)};
+                        return true;
+                    }
+
+                case 2:     // phylanx::util::recursive_wrapper<unary_expr>
+                    {
+                        unary_expr const& ue = util::get<2>(op.var).get();
+
+                        operand inner;
+                        if (!rewrite(ue.operand_, inner))
+                        {
+                            return false;
+                        }
+                        result = operand{
+                            unary_expr{ue.operator_, std::move(inner)}};
+                        return true;
+                    }
+
+                case 0: HPX_FALLTHROUGH;    // nil
+                default:
+                    break;
+                }
+                return false;
+            }
+
+            bool rewrite_children(expression const& expr, expression& result)
+            {
+                operand first;
+                bool first_changed = rewrite(expr.first, first);
+
+                std::vector<operation> rest;
+                bool rest_changed = false;
+                for (std::size_t i = 0; i != expr.rest.size(); ++i)
+                {
+                    operand op;
+                    if (rewrite(expr.rest[i].operand_, op))
+                    {
+                        if (!rest_changed)
+                        {
+                            rest.reserve(expr.rest.size());
+                            rest.assign(
+                                expr.rest.begin(), expr.rest.begin() + i);
+                            rest_changed = true;
+                        }
+                        rest.push_back(operation{
+                            expr.rest[i].operator_, std::move(op)});
+                    }
+                    else if (rest_changed)
+                    {
+                        rest.push_back(expr.rest[i]);
+                    }
+                }
+
+                if (!first_changed && !rest_changed)
+                {
+                    return false;
+                }
+
+                result = expression{
+                    first_changed ? std::move(first) : expr.first,
+                    rest_changed ? std::move(rest) : expr.rest};
+                return true;
+            }
+
+            // Apply the first matching rule to the given node, the result
+            // is rewritten until no rule applies anymore.
+            bool apply_rules(expression const& expr, expression& result)
+            {
+                for (std::size_t i : index_.candidates(expr))
+                {
+                    transform_rule const& rule = rules_[i];
+
+                    std::multimap<std::string, expression> placeholders;
+                    if (!match_ast(expr, rule.first,
+                            on_placeholder_match{placeholders}))
+                    {
+                        continue;
+                    }
+
+                    if (++rewrites_ > max_rewrites_)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "phylanx::ast::rewrite_ast",
+                            hpx::util::format(
+                                "exceeded the maximal number of rewrites "
+                                    "(" PHYLANX_FORMAT_SPEC(1) "), the "
+                                    "transformation rules possibly do not "
+                                    "terminate",
+                                max_rewrites_));
+                    }
+
+                    expression replacement{rule.second};
+                    for (auto const& placeholder : placeholders)
+                    {
+                        replacement = transduce(replacement,
+                            identifier{placeholder.first}, placeholder.second);
+                    }
+                    replacement = simplify(replacement);
+
+                    if (!rewrite(replacement, result))
+                    {
+                        result = std::move(replacement);
+                    }
+                    return true;
+                }
+                return false;
+            }
+
+            std::vector<transform_rule> const& rules_;
+            rule_index index_;
+            std::size_t max_rewrites_;
+            std::size_t rewrites_;
+        };
+    }
+
+    expression rewrite_ast(expression const& in,
+        std::vector<transform_rule> const& rules, std::size_t max_rewrites)
+    {
+        if (rules.empty())
+        {
+            return in;
+        }
+
+        expression result;
+        detail::rewriter r(rules, max_rewrites);
+        if (!r.rewrite(in, result))
+        {
+            return in;
+        }
+        return result;
+    }
+
+    std::vector<expression> rewrite_ast(std::vector<expression> const& in,
+        std::vector<transform_rule> const& rules, std::size_t max_rewrites)
+    {
+        if (rules.empty())
+        {
+            return in;
+        }
+
+        // all expressions share the same index and rewrite budget
+        detail::rewriter r(rules, max_rewrites);
+
+        std::vector<expression> result;
+        result.reserve(in.size());
+        for (auto const& expr : in)
+        {
+            expression rewritten;
+            if (r.rewrite(expr, rewritten))
+            {
+                result.push_back(std::move(rewritten));
+            }
+            else
+            {
+                result.push_back(expr);
+            }
+        }
+        return result;
+    }
 }}
@@ -27,23 +27,23 @@ namespace phylanx { namespace execution_tree
             ast::expression const& expr, compiler::function_list& snippets,
             compiler::environment& env, hpx::id_type const& default_locality)
         {
-            pattern_list const& patterns = get_all_known_patterns();
+            auto patterns = get_all_known_expression_patterns();
             ++snippets.compile_id_;
-            return compiler::compile(name, expr, snippets, env,
-                compiler::generate_patterns(patterns), default_locality);
+            return compiler::compile(
+                name, expr, snippets, env, *patterns, default_locality);
         }
 
         compiler::function compile(std::string const& name,
             ast::expression const& expr, compiler::function_list& snippets,
             hpx::id_type const& default_locality)
         {
-            pattern_list const& patterns = get_all_known_patterns();
+            auto patterns = get_all_known_expression_patterns();
             compiler::environment env =
                 compiler::default_environment(default_locality);
 
             ++snippets.compile_id_;
-            return compiler::compile(name, expr, snippets, env,
-                compiler::generate_patterns(patterns), default_locality);
+            return compiler::compile(
+                name, expr, snippets, env, *patterns, default_locality);
         }
     }
 
@@ -20,13 +20,17 @@
 #include <phylanx/execution_tree/compiler/compiler.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/fused_operation.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/cached_config_flag.hpp>
 
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <list>
 #include <map>
 #include <string>
@@ -46,7 +50,7 @@ namespace phylanx { namespace execution_tree { namespace compiler
             auto const& p = hpx::util::get<1>(patterns);
             if (!hpx::util::get<1>(p).empty())
             {
-                result.define(hpx::util::get<0>(p),
+                result.define_builtin(hpx::util::get<0>(p),
                     builtin_function(hpx::util::get<2>(p), default_locality));
             }
         }
@@ -56,7 +60,180 @@ namespace phylanx { namespace execution_tree { namespace compiler
 
     environment default_environment(hpx::id_type const& default_locality)
     {
-        return default_environment(get_all_known_patterns(), default_locality);
+        auto patterns =
+            execution_tree::get_all_known_patterns_snapshot();
+        return default_environment(*patterns, default_locality);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        static util::detail::cached_config_flag elementwise_fusion(
+            "phylanx.fuse_elementwise", false);
+    }
+
+    bool elementwise_fusion_enabled()
+    {
+        return detail::elementwise_fusion.get();
+    }
+
+    bool enable_elementwise_fusion(bool enable)
+    {
+        return detail::elementwise_fusion.set(enable);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Generate the key describing the shape of the top-level node of the
+        // given expression. Two expressions can match only if their keys are
+        // equal. Returns false if the expression is (or starts with) a
+        // placeholder, which can possibly match anything.
+        bool generate_pattern_key(ast::expression const& e, std::string& key,
+            std::size_t& num_args, bool& variadic)
+        {
+            num_args = 0;
+            variadic = false;
+
+            if (ast::detail::is_placeholder(e))
+            {
+                return false;
+            }
+
+            ast::expression const& expr = ast::detail::extract_expression(e);
+            if (!expr.rest.empty())
+            {
+                // the first operator has to match
+                key = "o" +
+                    std::to_string(static_cast<int>(expr.rest[0].operator_));
+                return true;
+            }
+
+            switch (expr.first.index())
+            {
+            case 1:     // primary_expr
+                {
+                    ast::primary_expr const& pe =
+                        util::get<1>(expr.first.get()).get();
+                    if (ast::detail::is_placeholder(pe))
+                    {
+                        return false;
+                    }
+
+                    if (pe.index() == 7)
+                    {
+                        ast::function_call const& fc =
+                            util::get<7>(pe.get()).get();
+                        if (ast::detail::is_placeholder(fc.function_name))
+                        {
+                            return false;
+                        }
+
+                        key = "c" + fc.function_name.name;
+                        num_args = fc.args.size();
+                        for (auto const& arg : fc.args)
+                        {
+                            if (ast::detail::is_placeholder_ellipses(arg))
+                            {
+                                variadic = true;
+                                break;
+                            }
+                        }
+                        return true;
+                    }
+
+                    key = "p" + std::to_string(pe.index());
+                    return true;
+                }
+
+            case 2:     // unary_expr
+                {
+                    ast::unary_expr const& ue =
+                        util::get<2>(expr.first.get()).get();
+                    key = "u" + std::to_string(static_cast<int>(ue.operator_));
+                    return true;
+                }
+
+            default:
+                break;
+            }
+
+            key = "n";
+            return true;
+        }
+
+        // Merge two lists of patterns while maintaining their order
+        expression_pattern_list::indexed_patterns merge_patterns(
+            expression_pattern_list::indexed_patterns const& lhs,
+            expression_pattern_list::indexed_patterns const& rhs)
+        {
+            expression_pattern_list::indexed_patterns result;
+            result.reserve(lhs.size() + rhs.size());
+
+            std::merge(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                std::back_inserter(result),
+                [](expression_pattern_list::indexed_pattern const& l,
+                    expression_pattern_list::indexed_pattern const& r)
+                {
+                    return l.ordinal < r.ordinal;
+                });
+
+            return result;
+        }
+    }
+
+    void expression_pattern_list::build_index()
+    {
+        index_.clear();
+        wildcards_.clear();
+
+        std::size_t ordinal = 0;
+        for (auto it = patterns_.begin(); it != patterns_.end();
+             ++it, ++ordinal)
+        {
+            std::string key;
+            indexed_pattern p{it, ordinal, 0, false};
+            if (!detail::generate_pattern_key(
+                    hpx::util::get<1>(it->second), key, p.num_args,
+                    p.variadic))
+            {
+                p.variadic = true;      // may match any number of arguments
+                wildcards_.push_back(p);
+                continue;
+            }
+            index_[key].push_back(p);
+        }
+
+        // patterns which can match anything have to be considered for
+        // every expression
+        if (!wildcards_.empty())
+        {
+            for (auto& entry : index_)
+            {
+                entry.second = detail::merge_patterns(entry.second, wildcards_);
+            }
+        }
+
+        indexed_ = true;
+    }
+
+    expression_pattern_list::indexed_patterns const*
+    expression_pattern_list::candidates(ast::expression const& expr,
+        std::size_t& num_args, bool& variadic) const
+    {
+        std::string key;
+        if (!indexed_ ||
+            !detail::generate_pattern_key(expr, key, num_args, variadic))
+        {
+            return nullptr;
+        }
+
+        auto it = index_.find(key);
+        if (it == index_.end())
+        {
+            return &wildcards_;
+        }
+        return &it->second;
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -77,6 +254,7 @@ namespace phylanx { namespace execution_tree { namespace compiler
                         pattern, exprs[0], hpx::util::get<2>(p))));
             }
         }
+        result.build_index();
         return result;
     }
 
@@ -443,10 +621,208 @@ namespace phylanx { namespace execution_tree { namespace compiler
                     name_, id));
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // Return whether the given number of operands is supported by the
+        // fused version of the operation
+        static bool is_fusible_arity(std::int64_t opcode, std::size_t arity)
+        {
+            std::size_t required = primitives::fused_operation::arity(opcode);
+            return required == 0 ? arity >= 2 : arity == required;
+        }
+
+        // Match the given expression against all known patterns, succeed
+        // only if the matched primitive is fusible.
+        std::int64_t match_fusible(ast::expression const& expr,
+            std::multimap<std::string, ast::expression>& placeholders) const
+        {
+            auto try_match = [&](expression_pattern_list::value_type const& p)
+                -> std::int64_t
+            {
+                std::multimap<std::string, ast::expression> ph;
+                if (!ast::match_ast(expr, hpx::util::get<1>(p.second),
+                        ast::detail::on_placeholder_match{ph}))
+                {
+                    return -1;      // no match found for the current pattern
+                }
+
+                std::int64_t opcode =
+                    primitives::fused_operation::opcode(p.first);
+                if (opcode == 0 || !env_.is_builtin(p.first) ||
+                    !is_fusible_arity(opcode, ph.size()))
+                {
+                    return 0;
+                }
+
+                placeholders = std::move(ph);
+                return opcode;
+            };
+
+            std::size_t num_args = 0;
+            bool variadic = false;
+            auto const* candidates =
+                patterns_.candidates(expr, num_args, variadic);
+
+            if (ast::detail::is_function_call(expr))
+            {
+                std::string function_name = ast::detail::function_name(expr);
+                if (function_name == "define" || function_name == "lambda")
+                {
+                    return 0;
+                }
+
+                if (candidates == nullptr)
+                {
+                    auto cit = patterns_.lower_bound(function_name);
+                    for (/**/; cit != patterns_.end() &&
+                            (*cit).first == function_name; ++cit)
+                    {
+                        std::int64_t opcode = try_match(*cit);
+                        if (opcode >= 0)
+                        {
+                            return opcode;
+                        }
+                    }
+                    return 0;
+                }
+
+                for (auto const& candidate : *candidates)
+                {
+                    if (candidate.pattern->first != function_name ||
+                        (!variadic && !candidate.variadic &&
+                            candidate.num_args != num_args))
+                    {
+                        continue;
+                    }
+
+                    std::int64_t opcode = try_match(*candidate.pattern);
+                    if (opcode >= 0)
+                    {
+                        return opcode;
+                    }
+                }
+                return 0;
+            }
+
+            if (candidates == nullptr)
+            {
+                for (auto const& pattern : patterns_)
+                {
+                    std::int64_t opcode = try_match(pattern);
+                    if (opcode >= 0)
+                    {
+                        return opcode;
+                    }
+                }
+                return 0;
+            }
+
+            for (auto const& candidate : *candidates)
+            {
+                std::int64_t opcode = try_match(*candidate.pattern);
+                if (opcode >= 0)
+                {
+                    return opcode;
+                }
+            }
+            return 0;
+        }
+
+        // Recursively collect the connected element-wise operations rooted
+        // in the given operation, generate the postfix program for the
+        // fused primitive. Returns the number of fused operations.
+        std::size_t fuse_elementwise(std::int64_t opcode,
+            std::multimap<std::string, ast::expression> const& placeholders,
+            std::vector<std::int64_t>& program, std::list<function>& leaves)
+        {
+            std::size_t count = 1;
+            for (auto const& placeholder : placeholders)
+            {
+                std::multimap<std::string, ast::expression> operands;
+                std::int64_t op = match_fusible(placeholder.second, operands);
+                if (op != 0)
+                {
+                    count += fuse_elementwise(op, operands, program, leaves);
+                    continue;
+                }
+
+                program.push_back(0);
+                program.push_back(static_cast<std::int64_t>(leaves.size()));
+
+                environment env(&env_);
+                leaves.push_back(compile(name_, placeholder.second,
+                    snippets_, env, patterns_, default_locality_));
+            }
+
+            program.push_back(opcode);
+            program.push_back(static_cast<std::int64_t>(placeholders.size()));
+
+            return count;
+        }
+
+        // Attempt to replace the expression tree rooted in the given
+        // operation with a single fused primitive.
+        bool handle_fusion(
+            std::multimap<std::string, ast::expression> const& placeholders,
+            std::string const& name, ast::tagged id, function& result)
+        {
+            if (!elementwise_fusion_enabled() || !env_.is_builtin(name))
+            {
+                return false;
+            }
+
+            std::int64_t opcode = primitives::fused_operation::opcode(name);
+            if (opcode == 0 || !is_fusible_arity(opcode, placeholders.size()))
+            {
+                return false;
+            }
+
+            // fusing a single operation does not pay off, only create the
+            // fused primitive if at least one of the operands is fusible
+            bool has_fusible_operand = false;
+            for (auto const& placeholder : placeholders)
+            {
+                std::multimap<std::string, ast::expression> operands;
+                if (match_fusible(placeholder.second, operands) != 0)
+                {
+                    has_fusible_operand = true;
+                    break;
+                }
+            }
+            if (!has_fusible_operand)
+            {
+                return false;
+            }
+
+            std::vector<std::int64_t> program;
+            std::list<function> args;
+            fuse_elementwise(opcode, placeholders, program, args);
+
+            args.emplace_front(literal_value(primitive_argument_type{
+                ir::node_data<std::int64_t>{
+                    blaze::DynamicVector<std::int64_t>(
+                        program.size(), program.data())}}));
+
+            static std::string const fused("__fused");
+            primitive_name_parts name_parts(fused,
+                snippets_.sequence_numbers_[fused]++, id.id, id.col,
+                snippets_.compile_id_ - 1);
+
+            result = builtin_function(
+                &primitives::create_fused_operation, default_locality_)(
+                    std::move(args), std::move(name_parts), name_);
+            return true;
+        }
+
         function handle_placeholders(
             std::multimap<std::string, ast::expression>& placeholders,
             std::string const& name, ast::tagged id)
         {
+            function fused;
+            if (handle_fusion(placeholders, name, id, fused))
+            {
+                return fused;
+            }
+
             // add sequence number for this primitive component
             std::size_t sequence_number =
                 snippets_.sequence_numbers_[name]++;
@@ -514,33 +890,95 @@ namespace phylanx { namespace execution_tree { namespace compiler
                         }
                     }
 
-                    while (cit != patterns_.end() && (*cit).first == function_name)
+                    std::size_t num_args = 0;
+                    bool variadic = false;
+                    auto const* candidates =
+                        patterns_.candidates(expr, num_args, variadic);
+                    if (candidates == nullptr)
                     {
-                        std::multimap<std::string, ast::expression> placeholders;
-                        if (!ast::match_ast(expr, hpx::util::get<1>((*cit).second),
-                                ast::detail::on_placeholder_match{placeholders}))
+                        while (cit != patterns_.end() &&
+                            (*cit).first == function_name)
                         {
-                            ++cit;
-                            continue;   // no match found for the current pattern
+                            std::multimap<std::string, ast::expression>
+                                placeholders;
+                            if (!ast::match_ast(expr,
+                                    hpx::util::get<1>((*cit).second),
+                                    ast::detail::on_placeholder_match{
+                                        placeholders}))
+                            {
+                                ++cit;
+                                continue;   // no match found for the current pattern
+                            }
+
+                            return handle_placeholders(
+                                placeholders, (*cit).first, id);
+                        }
+                    }
+                    else
+                    {
+                        // consider only patterns creating the primitive of
+                        // the given name which have a compatible number of
+                        // arguments
+                        for (auto const& candidate : *candidates)
+                        {
+                            auto const& pattern = *candidate.pattern;
+                            if (pattern.first != function_name ||
+                                (!variadic && !candidate.variadic &&
+                                    candidate.num_args != num_args))
+                            {
+                                continue;
+                            }
+
+                            std::multimap<std::string, ast::expression>
+                                placeholders;
+                            if (!ast::match_ast(expr,
+                                    hpx::util::get<1>(pattern.second),
+                                    ast::detail::on_placeholder_match{
+                                        placeholders}))
+                            {
+                                continue;   // no match found for the current pattern
+                            }
+
+                            return handle_placeholders(
+                                placeholders, pattern.first, id);
                         }
-
-                        return handle_placeholders(placeholders, (*cit).first, id);
                     }
                 }
             }
             else
             {
-                // this should handle all remaining constructs (non-function calls)
-                for (auto const& pattern : patterns_)
+                // this should handle all remaining constructs (non-function
+                // calls), only patterns of the same shape can match
+                auto const* candidates = patterns_.candidates(expr);
+                if (candidates == nullptr)
                 {
-                    std::multimap<std::string, ast::expression> placeholders;
-                    if (!ast::match_ast(expr, hpx::util::get<1>(pattern.second),
-                            ast::detail::on_placeholder_match{placeholders}))
+                    for (auto const& pattern : patterns_)
                     {
-                        continue;   // no match found for the current pattern
+                        std::multimap<std::string, ast::expression> placeholders;
+                        if (!ast::match_ast(expr, hpx::util::get<1>(pattern.second),
+                                ast::detail::on_placeholder_match{placeholders}))
+                        {
+                            continue;   // no match found for the current pattern
+                        }
+
+                        return handle_placeholders(placeholders, pattern.first, id);
                     }
+                }
+                else
+                {
+                    for (auto const& candidate : *candidates)
+                    {
+                        auto const& pattern = *candidate.pattern;
 
-                    return handle_placeholders(placeholders, pattern.first, id);
+                        std::multimap<std::string, ast::expression> placeholders;
+                        if (!ast::match_ast(expr, hpx::util::get<1>(pattern.second),
+                                ast::detail::on_placeholder_match{placeholders}))
+                        {
+                            continue;   // no match found for the current pattern
+                        }
+
+                        return handle_placeholders(placeholders, pattern.first, id);
+                    }
                 }
             }
 
@@ -0,0 +1,1107 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/detail/tagged_id.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compile.hpp>
+#include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/optimize.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/variant.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::ostream& operator<<(
+        std::ostream& os, optimization_report const& report)
+    {
+        os << "folded constants: " << report.folded_constants << "\n"
+           << "eliminated subexpressions: " << report.eliminated_subexpressions
+           << "\n"
+           << "generated functions: " << report.generated_functions << "\n";
+
+        for (auto const& change : report.changes)
+        {
+            os << "  " << change << "\n";
+        }
+        return os;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Built-in functions which have no side effects and which evaluate
+        // all of their arguments unconditionally. Only those may be folded
+        // or evaluated less often than written.
+        std::set<std::string> const& pure_functions()
+        {
+            static std::set<std::string> const functions = {
+                "__add", "__and", "__div", "__eq", "__ge", "__gt", "__le",
+                "__lt", "__minus", "__mul", "__ne", "__not", "__or", "__sub",
+                "absolute", "add_dim", "all", "amax", "amin", "any", "arccos",
+                "arccosh", "arcsin", "arcsinh", "arctan", "arctanh",
+                "argmax", "argmin", "car", "cbrt", "cdr", "ceil", "conj",
+                "constant", "cos", "cross", "determinant", "diag", "dot",
+                "erf", "erfc", "exp", "exp10", "exp2", "floor", "hstack",
+                "identity", "imag", "inverse", "invcbrt", "invsqrt", "len",
+                "linearmatrix", "linspace", "log", "log10", "log2",
+                "make_list", "mean", "power", "real", "rint", "shape", "sin",
+                "slice", "slice_column", "slice_row", "sqrt", "square_root",
+                "sum", "tan", "transpose", "trunc", "vstack"
+            };
+            return functions;
+        }
+
+        bool is_pure_operator(ast::optoken op)
+        {
+            switch (op)
+            {
+            case ast::optoken::op_comma: HPX_FALLTHROUGH;
+            case ast::optoken::op_assign: HPX_FALLTHROUGH;
+            case ast::optoken::op_plus_assign: HPX_FALLTHROUGH;
+            case ast::optoken::op_minus_assign: HPX_FALLTHROUGH;
+            case ast::optoken::op_times_assign: HPX_FALLTHROUGH;
+            case ast::optoken::op_divide_assign: HPX_FALLTHROUGH;
+            case ast::optoken::op_mod_assign: HPX_FALLTHROUGH;
+            case ast::optoken::op_bit_and_assign: HPX_FALLTHROUGH;
+            case ast::optoken::op_bit_xor_assign: HPX_FALLTHROUGH;
+            case ast::optoken::op_bitor_assign: HPX_FALLTHROUGH;
+            case ast::optoken::op_shift_left_assign: HPX_FALLTHROUGH;
+            case ast::optoken::op_shift_right_assign: HPX_FALLTHROUGH;
+            case ast::optoken::op_pre_incr: HPX_FALLTHROUGH;
+            case ast::optoken::op_pre_decr: HPX_FALLTHROUGH;
+            case ast::optoken::op_post_incr: HPX_FALLTHROUGH;
+            case ast::optoken::op_post_decr: HPX_FALLTHROUGH;
+            case ast::optoken::op_unknown:
+                return false;
+
+            default:
+                break;
+            }
+            return true;
+        }
+
+        bool is_constant_identifier(std::string const& name)
+        {
+            return name == "nil" || name == "true" || name == "false";
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Invoke f for each primary expression and each operator of the given
+        // AST in pre-order, stop as soon as f returns false.
+        template <typename F>
+        bool visit_nodes(ast::expression const& expr, F& f);
+
+        template <typename F>
+        bool visit_nodes(std::vector<ast::expression> const& exprs, F& f)
+        {
+            for (auto const& expr : exprs)
+            {
+                if (!visit_nodes(expr, f))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <typename F>
+        bool visit_nodes(ast::primary_expr const& pe, F& f)
+        {
+            if (!f(pe))
+            {
+                return false;
+            }
+
+            switch (pe.index())
+            {
+            case 6:     // phylanx::util::recursive_wrapper<expression>
+                return visit_nodes(util::get<6>(pe.var).get(), f);
+
+            case 7:     // phylanx::util::recursive_wrapper<function_call>
+                return visit_nodes(util::get<7>(pe.var).get().args, f);
+
+            case 8:
+                // phylanx::util::recursive_wrapper<std::vector<ast::expression>>
+                return visit_nodes(util::get<8>(pe.var).get(), f);
+
+            default:
+                break;
+            }
+            return true;
+        }
+
+        template <typename F>
+        bool visit_nodes(ast::operand const& op, F& f)
+        {
+            switch (op.index())
+            {
+            case 1:     // phylanx::util::recursive_wrapper<primary_expr>
+                return visit_nodes(util::get<1>(op.var).get(), f);
+
+            case 2:     // phylanx::util::recursive_wrapper<unary_expr>
+                {
+                    ast::unary_expr const& ue = util::get<2>(op.var).get();
+                    return f(ue.operator_) && visit_nodes(ue.operand_, f);
+                }
+
+            case 0: HPX_FALLTHROUGH;    // nil
+            default:
+                break;
+            }
+            return true;
+        }
+
+        template <typename F>
+        bool visit_nodes(ast::expression const& expr, F& f)
+        {
+            if (!visit_nodes(expr.first, f))
+            {
+                return false;
+            }
+            for (auto const& op : expr.rest)
+            {
+                if (!f(op.operator_) || !visit_nodes(op.operand_, f))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Rebuild the given AST. The rewriter is given the chance to replace
+        // each expression and each primary expression (before their children
+        // are rewritten).
+        template <typename Rewriter>
+        ast::expression rewrite(ast::expression const& expr, Rewriter& r);
+
+        template <typename Rewriter>
+        std::vector<ast::expression> rewrite(
+            std::vector<ast::expression> const& exprs, Rewriter& r)
+        {
+            std::vector<ast::expression> result;
+            result.reserve(exprs.size());
+            for (auto const& expr : exprs)
+            {
+                result.push_back(rewrite(expr, r));
+            }
+            return result;
+        }
+
+        template <typename Rewriter>
+        ast::primary_expr rewrite(ast::primary_expr const& pe, Rewriter& r)
+        {
+            ast::primary_expr result;
+            if (r.rewrite_primary(pe, result))
+            {
+                return result;
+            }
+
+            switch (pe.index())
+            {
+            case 6:     // phylanx::util::recursive_wrapper<expression>
+                result = ast::primary_expr{
+                    rewrite(util::get<6>(pe.var).get(), r)};
+                break;
+
+            case 7:     // phylanx::util::recursive_wrapper<function_call>
+                {
+                    ast::function_call const& fc = util::get<7>(pe.var).get();
+                    result = ast::primary_expr{ast::function_call{
+                        fc.function_name, rewrite(fc.args, r)}};
+                }
+                break;
+
+            case 8:
+                // phylanx::util::recursive_wrapper<std::vector<ast::expression>>
+                result = ast::primary_expr{
+                    rewrite(util::get<8>(pe.var).get(), r)};
+                break;
+
+            default:
+                return pe;
+            }
+
+            result.id = pe.id;
+            result.col = pe.col;
+            return result;
+        }
+
+        template <typename Rewriter>
+        ast::operand rewrite(ast::operand const& op, Rewriter& r)
+        {
+            switch (op.index())
+            {
+            case 1:     // phylanx::util::recursive_wrapper<primary_expr>
+                return ast::operand{rewrite(util::get<1>(op.var).get(), r)};
+
+            case 2:     // phylanx::util::recursive_wrapper<unary_expr>
+                {
+                    ast::unary_expr const& ue = util::get<2>(op.var).get();
+                    ast::unary_expr result{
+                        ue.operator_, rewrite(ue.operand_, r)};
+                    result.id = ue.id;
+                    result.col = ue.col;
+                    return ast::operand{std::move(result)};
+                }
+
+            case 0: HPX_FALLTHROUGH;    // nil
+            default:
+                break;
+            }
+            return op;
+        }
+
+        template <typename Rewriter>
+        ast::expression rewrite(ast::expression const& expr, Rewriter& r)
+        {
+            ast::expression result;
+            if (r.rewrite_expression(expr, result))
+            {
+                return result;
+            }
+
+            ast::operand first = rewrite(expr.first, r);
+
+            std::vector<ast::operation> rest;
+            rest.reserve(expr.rest.size());
+            for (auto const& op : expr.rest)
+            {
+                rest.emplace_back(op.operator_, rewrite(op.operand_, r));
+            }
+
+            return ast::expression{std::move(first), std::move(rest)};
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        ast::expression make_expression(ast::primary_expr && pe)
+        {
+            return ast::expression{ast::operand{std::move(pe)}};
+        }
+
+        ast::expression make_expression(ast::function_call const& fc)
+        {
+            return make_expression(ast::primary_expr{fc});
+        }
+
+        ast::expression make_expression(
+            std::string const& name, ast::tagged const& id)
+        {
+            return ast::expression{ast::identifier{name, id.id, id.col}};
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Convert the value a subexpression evaluated to back into an AST
+        // literal, if possible
+        bool to_literal(primitive_argument_type const& val,
+            std::size_t max_size, ast::primary_expr& result)
+        {
+            switch (val.index())
+            {
+            case 1:     // phylanx::ir::node_data<std::uint8_t>
+                {
+                    auto const& nd = util::get<1>(val);
+                    if (nd.num_dimensions() != 0)
+                    {
+                        return false;
+                    }
+                    result = ast::primary_expr{nd.scalar() != 0};
+                }
+                return true;
+
+            case 2:     // phylanx::ir::node_data<std::int64_t>
+                {
+                    auto const& nd = util::get<2>(val);
+                    if (nd.num_dimensions() != 0)
+                    {
+                        return false;
+                    }
+                    result = ast::primary_expr{std::int64_t(nd.scalar())};
+                }
+                return true;
+
+            case 3:     // std::string
+                result = ast::primary_expr{util::get<3>(val)};
+                return true;
+
+            case 4:     // phylanx::ir::node_data<double>
+                {
+                    auto const& nd = util::get<4>(val);
+                    if (nd.size() > max_size)
+                    {
+                        return false;
+                    }
+                    result = ast::primary_expr{nd.copy()};
+                }
+                return true;
+
+            case 0: HPX_FALLTHROUGH;    // nil
+            case 5: HPX_FALLTHROUGH;    // primitive
+            case 6: HPX_FALLTHROUGH;    // std::vector<ast::expression>
+            case 7: HPX_FALLTHROUGH;    // phylanx::ir::range
+            default:
+                break;
+            }
+            return false;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Estimate the number of elements of values before they are created
+        bool multiply_sizes(
+            std::size_t lhs, std::size_t rhs, std::size_t& size)
+        {
+            if (lhs != 0 &&
+                rhs > (std::numeric_limits<std::size_t>::max)() / lhs)
+            {
+                return false;
+            }
+            size = lhs * rhs;
+            return true;
+        }
+
+        // Extract a non-negative integer literal
+        bool literal_integer(ast::expression const& expr, std::size_t& value)
+        {
+            if (!expr.rest.empty() || expr.first.index() != 1)
+            {
+                return false;
+            }
+
+            ast::primary_expr const& pe =
+                util::get<1>(expr.first.var).get();
+            switch (pe.index())
+            {
+            case 5:     // std::int64_t
+                if (util::get<5>(pe.var) < 0)
+                {
+                    return false;
+                }
+                value = static_cast<std::size_t>(util::get<5>(pe.var));
+                return true;
+
+            case 6:     // phylanx::util::recursive_wrapper<expression>
+                return literal_integer(util::get<6>(pe.var).get(), value);
+
+            default:
+                break;
+            }
+            return false;
+        }
+
+        // Calculate the number of elements of a literal shape, which is
+        // either an integer or a list of integers
+        bool literal_shape(ast::expression const& expr, std::size_t& size)
+        {
+            if (literal_integer(expr, size))
+            {
+                return true;
+            }
+            if (!expr.rest.empty() || expr.first.index() != 1)
+            {
+                return false;
+            }
+
+            ast::primary_expr const& pe =
+                util::get<1>(expr.first.var).get();
+
+            std::vector<ast::expression> const* dims = nullptr;
+            if (pe.index() == 7)        // function_call
+            {
+                ast::function_call const& fc = util::get<7>(pe.var).get();
+                if (fc.function_name.name != "make_list")
+                {
+                    return false;
+                }
+                dims = &fc.args;
+            }
+            else if (pe.index() == 8)   // list
+            {
+                dims = &util::get<8>(pe.var).get();
+            }
+            else
+            {
+                return false;
+            }
+
+            size = 1;
+            for (auto const& dim : *dims)
+            {
+                std::size_t extent = 0;
+                if (!literal_integer(dim, extent) ||
+                    !multiply_sizes(size, extent, size))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool estimate_size(ast::expression const& expr, std::size_t& size);
+
+        bool estimate_size(std::vector<ast::expression> const& exprs,
+            std::vector<std::size_t>& sizes)
+        {
+            sizes.reserve(exprs.size());
+            for (auto const& expr : exprs)
+            {
+                std::size_t size = 0;
+                if (!estimate_size(expr, size))
+                {
+                    return false;
+                }
+                sizes.push_back(size);
+            }
+            return true;
+        }
+
+        // The value of a function call is bounded by the size of its largest
+        // argument, except for the functions which create new (possibly
+        // larger) values.
+        bool estimate_size(ast::function_call const& fc, std::size_t& size)
+        {
+            std::vector<std::size_t> sizes;
+            if (!estimate_size(fc.args, sizes))
+            {
+                return false;
+            }
+
+            std::size_t largest = 1;
+            std::size_t total = 0;
+            for (std::size_t s : sizes)
+            {
+                largest = (std::max)(largest, s);
+                total += s;
+            }
+
+            std::string const& name = fc.function_name.name;
+            std::size_t result = largest;
+            if (name == "constant")
+            {
+                if (fc.args.size() == 2 &&
+                    !literal_shape(fc.args[1], result))
+                {
+                    return false;
+                }
+            }
+            else if (name == "identity")
+            {
+                std::size_t n = 0;
+                if (fc.args.size() != 1 || !literal_integer(fc.args[0], n) ||
+                    !multiply_sizes(n, n, result))
+                {
+                    return false;
+                }
+            }
+            else if (name == "linspace")
+            {
+                if (fc.args.size() != 3 ||
+                    !literal_integer(fc.args[2], result))
+                {
+                    return false;
+                }
+            }
+            else if (name == "linearmatrix")
+            {
+                std::size_t nx = 0, ny = 0;
+                if (fc.args.size() < 2 || !literal_integer(fc.args[0], nx) ||
+                    !literal_integer(fc.args[1], ny) ||
+                    !multiply_sizes(nx, ny, result))
+                {
+                    return false;
+                }
+            }
+            else if (name == "diag")
+            {
+                // a vector is turned into a (possibly offset) diagonal matrix
+                std::size_t offset = 0;
+                if (sizes.empty() ||
+                    (fc.args.size() == 2 &&
+                        !literal_integer(fc.args[1], offset)) ||
+                    !multiply_sizes(sizes[0] + offset, sizes[0] + offset,
+                        result))
+                {
+                    return false;
+                }
+            }
+            else if (name == "dot")
+            {
+                // the outer product is the largest possible result
+                if (sizes.size() != 2 ||
+                    !multiply_sizes(sizes[0], sizes[1], result))
+                {
+                    return false;
+                }
+            }
+            else if (name == "hstack" || name == "vstack" ||
+                name == "make_list")
+            {
+                result = total;
+            }
+
+            size = (std::max)(result, largest);
+            return true;
+        }
+
+        bool estimate_size(ast::primary_expr const& pe, std::size_t& size)
+        {
+            switch (pe.index())
+            {
+            case 2:     // phylanx::ir::node_data<double>
+                size = (std::max)(
+                    std::size_t(1), util::get<2>(pe.var).size());
+                return true;
+
+            case 6:     // phylanx::util::recursive_wrapper<expression>
+                return estimate_size(util::get<6>(pe.var).get(), size);
+
+            case 7:     // phylanx::util::recursive_wrapper<function_call>
+                return estimate_size(util::get<7>(pe.var).get(), size);
+
+            case 8:
+                // phylanx::util::recursive_wrapper<std::vector<ast::expression>>
+                {
+                    std::vector<std::size_t> sizes;
+                    if (!estimate_size(util::get<8>(pe.var).get(), sizes))
+                    {
+                        return false;
+                    }
+                    size = 1;
+                    for (std::size_t s : sizes)
+                    {
+                        size += s;
+                    }
+                }
+                return true;
+
+            default:
+                break;
+            }
+
+            size = 1;
+            return true;
+        }
+
+        bool estimate_size(ast::operand const& op, std::size_t& size)
+        {
+            switch (op.index())
+            {
+            case 1:     // phylanx::util::recursive_wrapper<primary_expr>
+                return estimate_size(util::get<1>(op.var).get(), size);
+
+            case 2:     // phylanx::util::recursive_wrapper<unary_expr>
+                return estimate_size(
+                    util::get<2>(op.var).get().operand_, size);
+
+            case 0: HPX_FALLTHROUGH;    // nil
+            default:
+                break;
+            }
+
+            size = 1;
+            return true;
+        }
+
+        // Return an upper bound for the number of elements of the value the
+        // given expression evaluates to and of any value created while
+        // evaluating it. Operators are applied element-wise, their results
+        // are not larger than their largest operand.
+        bool estimate_size(ast::expression const& expr, std::size_t& size)
+        {
+            if (!estimate_size(expr.first, size))
+            {
+                return false;
+            }
+            for (auto const& op : expr.rest)
+            {
+                std::size_t operand_size = 0;
+                if (!estimate_size(op.operand_, operand_size))
+                {
+                    return false;
+                }
+                size = (std::max)(size, operand_size);
+            }
+            return true;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        class ast_optimizer
+        {
+        public:
+            ast_optimizer(std::vector<ast::expression> const& exprs,
+                    optimization_options const& options,
+                    optimization_report& report)
+              : options_(options)
+              , report_(report)
+            {
+                // built-in functions may be redefined by the user, all
+                // identifiers are considered to be user defined names
+                for (auto const& expr : exprs)
+                {
+                    collect_identifiers(expr, user_names_);
+                }
+            }
+
+            std::vector<ast::expression> optimize(
+                std::vector<ast::expression> const& exprs)
+            {
+                std::vector<ast::expression> result = exprs;
+
+                if (options_.fold_constants)
+                {
+                    folder f{*this};
+                    result = rewrite(result, f);
+                }
+
+                if (options_.eliminate_common_subexpressions)
+                {
+                    eliminator e{*this};
+                    result = rewrite(result, e);
+
+                    // the generated functions have to be defined before
+                    // they are used
+                    result.insert(result.begin(), definitions_.begin(),
+                        definitions_.end());
+                }
+
+                return result;
+            }
+
+        private:
+            ///////////////////////////////////////////////////////////////////
+            static void collect_identifiers(
+                ast::expression const& expr, std::set<std::string>& names)
+            {
+                struct collector
+                {
+                    bool operator()(ast::primary_expr const& pe)
+                    {
+                        if (pe.index() == 3)    // identifier
+                        {
+                            std::string const& name =
+                                util::get<3>(pe.var).name;
+                            if (!is_constant_identifier(name))
+                            {
+                                names_.insert(name);
+                            }
+                        }
+                        return true;
+                    }
+                    bool operator()(ast::optoken)
+                    {
+                        return true;
+                    }
+
+                    std::set<std::string>& names_;
+                };
+
+                collector c{names};
+                visit_nodes(expr, c);
+            }
+
+            // Return whether the given expression has no side effects. If
+            // constant is true, the expression additionally may not refer to
+            // any variables.
+            bool is_pure(ast::expression const& expr, bool constant) const
+            {
+                struct checker
+                {
+                    bool operator()(ast::primary_expr const& pe)
+                    {
+                        switch (pe.index())
+                        {
+                        case 3:     // identifier
+                            return !constant_ ||
+                                is_constant_identifier(
+                                    util::get<3>(pe.var).name);
+
+                        case 7:     // function_call
+                            return optimizer_.is_pure_function(
+                                util::get<7>(pe.var).get().function_name.name);
+
+                        default:
+                            break;
+                        }
+                        return true;
+                    }
+                    bool operator()(ast::optoken op)
+                    {
+                        return is_pure_operator(op);
+                    }
+
+                    ast_optimizer const& optimizer_;
+                    bool constant_;
+                };
+
+                checker c{*this, constant};
+                return visit_nodes(expr, c);
+            }
+
+            bool is_pure_function(std::string const& name) const
+            {
+                return pure_functions().count(name) != 0 &&
+                    user_names_.count(name) == 0;
+            }
+
+            // generate a name not used anywhere in the program
+            std::string unique_name(std::string const& base)
+            {
+                std::string name = base;
+                while (user_names_.count(name) != 0)
+                {
+                    name += "_";
+                }
+                user_names_.insert(name);
+                return name;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // Constant folding
+            bool evaluate(ast::expression const& expr, ast::tagged const& id,
+                ast::primary_expr& result) const
+            {
+                // don't create large values at compile time
+                std::size_t size = 0;
+                if (!estimate_size(expr, size) ||
+                    size > options_.max_folded_size)
+                {
+                    return false;
+                }
+
+                primitive_argument_type value;
+                try
+                {
+                    compiler::function_list snippets;
+                    value = extract_copy_value(compile("<optimizer>",
+                        std::vector<ast::expression>{expr}, snippets)());
+                }
+                catch (std::exception const&)
+                {
+                    // leave the expression alone, any error will be reported
+                    // when the code is run
+                    return false;
+                }
+
+                if (!to_literal(value, options_.max_folded_size, result))
+                {
+                    return false;
+                }
+
+                result.id = id.id;
+                result.col = id.col;
+                return true;
+            }
+
+            bool fold(ast::expression const& expr, ast::tagged const& id,
+                ast::primary_expr& result)
+            {
+                if (!is_pure(expr, true) || !evaluate(expr, id, result))
+                {
+                    return false;
+                }
+
+                ++report_.folded_constants;
+                report_.changes.push_back("folded '" + ast::to_string(expr) +
+                    "' into '" + ast::to_string(make_expression(
+                        ast::primary_expr{result})) + "'");
+                return true;
+            }
+
+            struct folder
+            {
+                bool rewrite_expression(
+                    ast::expression const& expr, ast::expression& result)
+                {
+                    // expressions consisting of a single primary expression
+                    // are handled by rewrite_primary
+                    if (expr.rest.empty() && expr.first.index() == 1)
+                    {
+                        return false;
+                    }
+
+                    ast::primary_expr value;
+                    if (!optimizer_.fold(
+                            expr, ast::detail::tagged_id(expr), value))
+                    {
+                        return false;
+                    }
+                    result = make_expression(std::move(value));
+                    return true;
+                }
+
+                bool rewrite_primary(
+                    ast::primary_expr const& pe, ast::primary_expr& result)
+                {
+                    // function calls and parenthesized expressions used as
+                    // operands of operators
+                    if (pe.index() != 6 && pe.index() != 7)
+                    {
+                        return false;
+                    }
+                    return optimizer_.fold(
+                        make_expression(ast::primary_expr{pe}),
+                        ast::detail::tagged_id(pe), result);
+                }
+
+                ast_optimizer& optimizer_;
+            };
+
+            ///////////////////////////////////////////////////////////////////
+            // Common subexpression elimination
+            struct call_replacer
+            {
+                bool rewrite_expression(
+                    ast::expression const&, ast::expression&)
+                {
+                    return false;
+                }
+
+                bool rewrite_primary(
+                    ast::primary_expr const& pe, ast::primary_expr& result)
+                {
+                    if (pe.index() != 7 || util::get<7>(pe.var).get() != call_)
+                    {
+                        return false;
+                    }
+
+                    result = ast::primary_expr{
+                        ast::identifier{name_, pe.id, pe.col}};
+                    ++count_;
+                    return true;
+                }
+
+                ast::function_call const& call_;
+                std::string const& name_;
+                std::size_t count_;
+            };
+
+            // Select the longest function call occurring more than once in the
+            // given expression which does not refer to any of the given names
+            bool find_common_call(ast::expression const& expr,
+                std::set<std::string> const& excluded,
+                std::set<std::string> const& rejected,
+                ast::function_call& call, std::string& key) const
+            {
+                struct collector
+                {
+                    bool operator()(ast::primary_expr const& pe)
+                    {
+                        if (pe.index() == 7)
+                        {
+                            ast::function_call const& fc =
+                                util::get<7>(pe.var).get();
+                            std::string key =
+                                ast::to_string(make_expression(fc));
+                            auto it = calls_.find(key);
+                            if (it == calls_.end())
+                            {
+                                calls_.emplace(std::move(key),
+                                    std::make_pair(fc, std::size_t(1)));
+                            }
+                            else
+                            {
+                                ++it->second.second;
+                            }
+                        }
+                        return true;
+                    }
+                    bool operator()(ast::optoken)
+                    {
+                        return true;
+                    }
+
+                    std::map<std::string,
+                        std::pair<ast::function_call, std::size_t>> calls_;
+                };
+
+                collector c;
+                visit_nodes(expr, c);
+
+                bool found = false;
+                for (auto const& entry : c.calls_)
+                {
+                    if (entry.second.second < 2 ||
+                        rejected.count(entry.first) != 0 ||
+                        (found && entry.first.size() <= key.size()))
+                    {
+                        continue;
+                    }
+
+                    std::set<std::string> names;
+                    collect_identifiers(
+                        make_expression(entry.second.first), names);
+
+                    bool refers_to_excluded = false;
+                    for (auto const& name : names)
+                    {
+                        if (excluded.count(name) != 0)
+                        {
+                            refers_to_excluded = true;
+                            break;
+                        }
+                    }
+
+                    if (!refers_to_excluded)
+                    {
+                        call = entry.second.first;
+                        key = entry.first;
+                        found = true;
+                    }
+                }
+                return found;
+            }
+
+            // Replace all function calls occurring more than once in the given
+            // side-effect free expression by parameters of a new function,
+            // return a call to the new function (or the unchanged
+            // expression)
+            ast::expression eliminate(ast::expression const& expr)
+            {
+                ast::tagged const id = ast::detail::tagged_id(expr);
+
+                std::string function_name;
+                ast::expression body = expr;
+                std::vector<ast::expression> common_calls;
+                std::vector<std::string> param_names;
+                std::set<std::string> params;
+                std::set<std::string> rejected;
+                std::vector<std::string> changes;
+                std::size_t eliminated = 0;
+
+                ast::function_call call;
+                std::string key;
+                while (find_common_call(body, params, rejected, call, key))
+                {
+                    if (function_name.empty())
+                    {
+                        function_name = unique_name("__cse" +
+                            std::to_string(report_.generated_functions));
+                    }
+
+                    std::string const param = unique_name(function_name + "_" +
+                        std::to_string(common_calls.size()));
+
+                    call_replacer r{call, param, 0};
+                    ast::expression replaced = rewrite(body, r);
+                    if (r.count_ < 2)
+                    {
+                        // the textual representations were equal, but the
+                        // calls are not
+                        rejected.insert(key);
+                        continue;
+                    }
+
+                    body = std::move(replaced);
+                    common_calls.push_back(make_expression(call));
+                    param_names.push_back(param);
+                    params.insert(param);
+
+                    eliminated += r.count_ - 1;
+                    changes.push_back("'" + key + "' is evaluated once " +
+                        "instead of " + std::to_string(r.count_) +
+                        " times (in " + function_name + ")");
+                }
+
+                if (common_calls.empty())
+                {
+                    return expr;
+                }
+
+                // define(__cse<N>, <params>, <free variables>, body)
+                std::set<std::string> free_variables;
+                collect_identifiers(body, free_variables);
+
+                std::vector<ast::expression> define_args;
+                define_args.push_back(make_expression(function_name, id));
+
+                std::vector<ast::expression> call_args = common_calls;
+                for (auto const& name : param_names)
+                {
+                    define_args.push_back(make_expression(name, id));
+                }
+                for (auto const& name : free_variables)
+                {
+                    if (params.count(name) == 0)
+                    {
+                        define_args.push_back(make_expression(name, id));
+                        call_args.push_back(make_expression(name, id));
+                    }
+                }
+                define_args.push_back(std::move(body));
+
+                definitions_.push_back(make_expression(ast::function_call{
+                    ast::identifier{"define", id.id, id.col},
+                    std::move(define_args)}));
+
+                ++report_.generated_functions;
+                report_.eliminated_subexpressions += eliminated;
+                for (auto& change : changes)
+                {
+                    report_.changes.push_back(std::move(change));
+                }
+
+                return make_expression(ast::function_call{
+                    ast::identifier{function_name, id.id, id.col},
+                    std::move(call_args)});
+            }
+
+            struct eliminator
+            {
+                bool rewrite_expression(
+                    ast::expression const& expr, ast::expression& result)
+                {
+                    // handle maximal side-effect free expressions only,
+                    // everything else is searched for those
+                    if (!optimizer_.is_pure(expr, false))
+                    {
+                        return false;
+                    }
+                    result = optimizer_.eliminate(expr);
+                    return true;
+                }
+
+                bool rewrite_primary(
+                    ast::primary_expr const&, ast::primary_expr&)
+                {
+                    return false;
+                }
+
+                ast_optimizer& optimizer_;
+            };
+
+        private:
+            optimization_options const& options_;
+            optimization_report& report_;
+
+            std::set<std::string> user_names_;
+            std::vector<ast::expression> definitions_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<ast::expression> optimize_ast(
+        std::vector<ast::expression> const& exprs,
+        optimization_options const& options, optimization_report* report)
+    {
+        optimization_report local_report;
+        detail::ast_optimizer optimizer(
+            exprs, options, report != nullptr ? *report : local_report);
+        return optimizer.optimize(exprs);
+    }
+}}
@@ -7,6 +7,10 @@
 #include <phylanx/execution_tree/primitives.hpp>
 #include <phylanx/execution_tree/compile.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <utility>
 #include <string>
 #include <vector>
@@ -18,6 +22,22 @@ namespace phylanx { namespace execution_tree
     ///////////////////////////////////////////////////////////////////////////
     std::vector<std::pair<std::string, match_pattern_type>> registered_patterns;
 
+    namespace detail
+    {
+        using patterns_mutex_type = std::mutex;
+
+        // protects registered_patterns and the cached pattern lists below,
+        // the lists are generated without holding the lock
+        patterns_mutex_type& patterns_mtx()
+        {
+            static patterns_mutex_type mtx;
+            return mtx;
+        }
+
+        // incremented whenever a new pattern is registered
+        std::size_t patterns_version = 0;
+    }
+
     void show_patterns()
     {
         std::set<std::string> printed;
@@ -41,7 +61,15 @@ namespace phylanx { namespace execution_tree
     void register_pattern(
         std::string const& name, match_pattern_type const& pattern)
     {
+        std::lock_guard<detail::patterns_mutex_type> l(detail::patterns_mtx());
         registered_patterns.push_back(std::make_pair(name, pattern));
+        ++detail::patterns_version;
+    }
+
+    std::size_t get_patterns_version()
+    {
+        std::lock_guard<detail::patterns_mutex_type> l(detail::patterns_mtx());
+        return detail::patterns_version;
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -74,6 +102,7 @@ namespace phylanx { namespace execution_tree
                 // compiler-specific (internal) primitives
                 PHYLANX_MATCH_DATA(access_argument),
                 PHYLANX_MATCH_DATA(function_reference),
+                PHYLANX_MATCH_DATA(fused_operation),
                 PHYLANX_MATCH_DATA(wrapped_function),
                 PHYLANX_MATCH_DATA(define_function),
                 PHYLANX_MATCH_DATA_VERBATIM(define_function::match_data_lambda),
@@ -98,9 +127,92 @@ namespace phylanx { namespace execution_tree
 #undef PHYLANX_MATCH_DATA
     }
 
+    namespace detail
+    {
+        // A snapshot of a generated list together with the version of the
+        // registered patterns it was generated from. Snapshots are never
+        // modified once published, callers keep theirs alive as long as they
+        // need it.
+        template <typename List>
+        struct cached_list
+        {
+            std::shared_ptr<List const> list_;
+            std::size_t version_ = 0;
+        };
+
+        // Return the cached list if it is up to date, otherwise generate a
+        // new one outside of the lock and publish it (unless another thread
+        // has published a newer one in the meantime).
+        template <typename List, typename F>
+        std::shared_ptr<List const> get_cached_list(
+            cached_list<List>& cache, F&& generate)
+        {
+            std::size_t version = 0;
+            {
+                std::lock_guard<patterns_mutex_type> l(patterns_mtx());
+                if (cache.list_ && cache.version_ == patterns_version)
+                {
+                    return cache.list_;
+                }
+                version = patterns_version;
+            }
+
+            std::shared_ptr<List const> list = generate();
+
+            std::lock_guard<patterns_mutex_type> l(patterns_mtx());
+            if (!cache.list_ || cache.version_ < version)
+            {
+                cache.list_ = list;
+                cache.version_ = version;
+            }
+            return list;
+        }
+    }
+
+    std::shared_ptr<pattern_list const> get_all_known_patterns_snapshot()
+    {
+        static detail::cached_list<pattern_list> cache;
+        return detail::get_cached_list(cache, []()
+            {
+                pattern_list patterns;
+                {
+                    std::lock_guard<detail::patterns_mutex_type> l(
+                        detail::patterns_mtx());
+                    patterns = detail::get_all_known_patterns();
+                }
+                return std::make_shared<pattern_list const>(
+                    std::move(patterns));
+            });
+    }
+
+    // The lists handed out by reference are kept alive until the end of the
+    // program, a new one is generated only if patterns were registered.
     pattern_list const& get_all_known_patterns()
     {
-        static pattern_list patterns = detail::get_all_known_patterns();
-        return patterns;
+        static std::vector<std::shared_ptr<pattern_list const>> lists;
+
+        std::shared_ptr<pattern_list const> snapshot =
+            get_all_known_patterns_snapshot();
+
+        std::lock_guard<detail::patterns_mutex_type> l(detail::patterns_mtx());
+        if (std::find(lists.begin(), lists.end(), snapshot) == lists.end())
+        {
+            lists.push_back(snapshot);
+        }
+        return *snapshot;
+    }
+
+    std::shared_ptr<compiler::expression_pattern_list const>
+        get_all_known_expression_patterns()
+    {
+        // parsing all pattern strings is expensive, do it only once for
+        // each version of the list of registered patterns
+        static detail::cached_list<compiler::expression_pattern_list> cache;
+        return detail::get_cached_list(cache, []()
+            {
+                using list_type = compiler::expression_pattern_list const;
+                return std::make_shared<list_type>(compiler::generate_patterns(
+                    *get_all_known_patterns_snapshot()));
+            });
     }
 }}
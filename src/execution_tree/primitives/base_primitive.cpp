@@ -13,10 +13,12 @@
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/cached_config_flag.hpp>
 #include <phylanx/util/repr_manip.hpp>
 
 #include <hpx/include/actions.hpp>
 #include <hpx/include/components.hpp>
+#include <hpx/include/runtime.hpp>
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/util/logging.hpp>
 
@@ -49,7 +51,8 @@ namespace phylanx { namespace execution_tree
             "phylanx::ir::node_data<double>",
             "phylanx::execution_tree::primitive",
             "std::vector<phylanx::ast::expression>",
-            "phylanx::ir::range"
+            "phylanx::ir::range",
+            "phylanx::ir::partitioned_array"
         };
 
         static char const* const get_primitive_argument_type_name(std::size_t index)
@@ -348,7 +351,8 @@ namespace phylanx { namespace execution_tree
         case 4: HPX_FALLTHROUGH;    // phylanx::ir::node_data<double>
         case 5: HPX_FALLTHROUGH;    // primitive
         case 6: HPX_FALLTHROUGH;    // std::vector<ast::expression>
-        case 7:                     // phylanx::ir::range
+        case 7: HPX_FALLTHROUGH;    // phylanx::ir::range
+        case 8:                     // phylanx::ir::partitioned_array
             return val;
 
         default:
@@ -374,7 +378,8 @@ namespace phylanx { namespace execution_tree
         case 3: HPX_FALLTHROUGH;    // std::string
         case 5: HPX_FALLTHROUGH;    // primitive
         case 6: HPX_FALLTHROUGH;    // std::vector<ast::expression>
-        case 7:                     // phylanx::ir::range
+        case 7: HPX_FALLTHROUGH;    // phylanx::ir::range
+        case 8:                     // phylanx::ir::partitioned_array
             return val;
 
         case 1:    // phylanx::ir::node_data<std::uint8_t>
@@ -421,7 +426,8 @@ namespace phylanx { namespace execution_tree
         case 3: HPX_FALLTHROUGH;    // std::string
         case 5: HPX_FALLTHROUGH;    // primitive
         case 6: HPX_FALLTHROUGH;    // std::vector<ast::expression>
-        case 7:                     // phylanx::ir::range
+        case 7: HPX_FALLTHROUGH;    // phylanx::ir::range
+        case 8:                     // phylanx::ir::partitioned_array
             return val;
 
         case 1:    // phylanx::ir::node_data<std::uint8_t>
@@ -482,7 +488,8 @@ namespace phylanx { namespace execution_tree
         case 4: HPX_FALLTHROUGH;    // phylanx::ir::node_data<double>
         case 5: HPX_FALLTHROUGH;    // primitive
         case 6: HPX_FALLTHROUGH;    // std::vector<ast::expression>
-        case 7:                     // phylanx::ir::range
+        case 7: HPX_FALLTHROUGH;    // phylanx::ir::range
+        case 8:                     // phylanx::ir::partitioned_array
             return std::move(val);
 
         default:
@@ -507,7 +514,8 @@ namespace phylanx { namespace execution_tree
         case 3: HPX_FALLTHROUGH;    // std::string
         case 5: HPX_FALLTHROUGH;    // primitive
         case 6: HPX_FALLTHROUGH;    // std::vector<ast::expression>
-        case 7:                     // phylanx::ir::range
+        case 7: HPX_FALLTHROUGH;    // phylanx::ir::range
+        case 8:                     // phylanx::ir::partitioned_array
             return std::move(val);
 
         case 1:    // phylanx::ir::node_data<std::uint8_t>
@@ -568,7 +576,8 @@ namespace phylanx { namespace execution_tree
         case 4: HPX_FALLTHROUGH;    // phylanx::ir::node_data<double>
         case 5: HPX_FALLTHROUGH;    // primitive
         case 6: HPX_FALLTHROUGH;    // std::vector<ast::expression>
-        case 7:                     // phylanx::ir::range
+        case 7: HPX_FALLTHROUGH;    // phylanx::ir::range
+        case 8:                     // phylanx::ir::partitioned_array
             return std::move(val);
 
         default:
@@ -596,7 +605,8 @@ namespace phylanx { namespace execution_tree
         case 2: HPX_FALLTHROUGH;    // ir::node_data<std::int64_t>
         case 3: HPX_FALLTHROUGH;    // std::string
         case 4: HPX_FALLTHROUGH;    // phylanx::ir::node_data<double>
-        case 7:                     // phylanx::ir::range
+        case 7: HPX_FALLTHROUGH;    // phylanx::ir::range
+        case 8:                     // phylanx::ir::partitioned_array
             return val;
 
         case 6:                     // std::vector<ast::expression>
@@ -687,6 +697,9 @@ namespace phylanx { namespace execution_tree
             }
             break;
 
+        case 8:                     // phylanx::ir::partitioned_array
+            return val;
+
         case 5: HPX_FALLTHROUGH;    // primitive
         default:
             break;
@@ -711,7 +724,8 @@ namespace phylanx { namespace execution_tree
         case 2: HPX_FALLTHROUGH;    // ir::node_data<std::int64_t>
         case 3: HPX_FALLTHROUGH;    // std::string
         case 4: HPX_FALLTHROUGH;    // phylanx::ir::node_data<double>
-        case 7:                     // phylanx::ir::range
+        case 7: HPX_FALLTHROUGH;    // phylanx::ir::range
+        case 8:                     // phylanx::ir::partitioned_array
             return std::move(val);
 
         case 6:                     // std::vector<ast::expression>
@@ -2102,6 +2116,51 @@ namespace phylanx { namespace execution_tree
         return false;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    ir::partitioned_array extract_partitioned_array_value(
+        primitive_argument_type const& val,
+        std::string const& name, std::string const& codename)
+    {
+        ir::partitioned_array const* arr =
+            util::get_if<ir::partitioned_array>(&val);
+        if (arr != nullptr)
+        {
+            return *arr;
+        }
+
+        std::string type(detail::get_primitive_argument_type_name(val.index()));
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "phylanx::execution_tree::extract_partitioned_array_value",
+            generate_error_message(
+                "primitive_argument_type does not hold a partitioned array "
+                    "(type held: '" + type + "')",
+                name, codename));
+    }
+
+    ir::partitioned_array extract_partitioned_array_value(
+        primitive_argument_type&& val,
+        std::string const& name, std::string const& codename)
+    {
+        ir::partitioned_array* arr = util::get_if<ir::partitioned_array>(&val);
+        if (arr != nullptr)
+        {
+            return std::move(*arr);
+        }
+
+        std::string type(detail::get_primitive_argument_type_name(val.index()));
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "phylanx::execution_tree::extract_partitioned_array_value",
+            generate_error_message(
+                "primitive_argument_type does not hold a partitioned array "
+                    "(type held: '" + type + "')",
+                name, codename));
+    }
+
+    bool is_partitioned_array_operand(primitive_argument_type const& val)
+    {
+        return util::get_if<ir::partitioned_array>(&val) != nullptr;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     primitive primitive_operand(primitive_argument_type const& val,
         std::string const& name, std::string const& codename)
@@ -3429,6 +3488,14 @@ namespace phylanx { namespace execution_tree
             }
             return os;
 
+        case 8:     // phylanx::ir::partitioned_array
+            {
+                auto const& arr = util::get<8>(val);
+                os << "partitioned_array(" << arr.rows() << ", "
+                   << arr.columns() << ")";
+            }
+            return os;
+
         default:
             break;
         }
@@ -3439,5 +3506,21 @@ namespace phylanx { namespace execution_tree
 
         return os;
     }
-}}
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        static util::detail::cached_config_flag loop_trampolining(
+            "phylanx.trampoline_loops", true);
+    }
+
+    bool loop_trampolining_enabled()
+    {
+        return detail::loop_trampolining.get();
+    }
+
+    bool enable_loop_trampolining(bool enable)
+    {
+        return detail::loop_trampolining.set(enable);
+    }
+}}
@@ -5,6 +5,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/primitives/enable_tracing.hpp>
+#include <phylanx/util/event_tracer.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -32,7 +33,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
     match_pattern_type const enable_tracing::match_data =
     {
         hpx::util::make_tuple("enable_tracing",
-            std::vector<std::string>{"enable_tracing(_1)"},
+            std::vector<std::string>{
+                "enable_tracing(_1)", "enable_tracing(_1, _2)"},
             &create_enable_tracing, &create_primitive<enable_tracing>)
     };
 
@@ -50,28 +52,54 @@ namespace phylanx { namespace execution_tree { namespace primitives
             std::vector<primitive_argument_type> const& args,
             std::string const& name, std::string const& codename)
         {
-            if (operands.size() != 1)
+            if (operands.size() != 1 && operands.size() != 2)
             {
                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
                     "enable_tracing::eval",
                     generate_error_message(
-                        "expected one (boolean) argument",
+                        "expected one (boolean) argument and an optional "
+                            "(string) argument selecting the kind of tracing",
                         name, codename));
             }
 
-            if (!valid(operands[0]))
+            if (!valid(operands[0]) ||
+                (operands.size() == 2 && !valid(operands[1])))
             {
                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
                     "enable_tracing::eval",
                     generate_error_message(
                         "the enable_tracing primitive requires that the "
-                            "argument given by the operand is valid",
+                            "arguments given by the operands are valid",
                         name, codename));
             }
 
-            primitive::enable_tracing =
+            bool enable =
                 boolean_operand_sync(operands[0], args, name, codename) != 0;
 
+            std::string kind("text");
+            if (operands.size() == 2)
+            {
+                kind = string_operand_sync(operands[1], args, name, codename);
+            }
+
+            if (kind == "text")
+            {
+                primitive::enable_tracing = enable;
+            }
+            else if (kind == "events")
+            {
+                util::event_tracer::enable(enable);
+            }
+            else
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "enable_tracing::eval",
+                    generate_error_message(
+                        "the kind of tracing must be either 'text' or "
+                            "'events'",
+                        name, codename));
+            }
+
             return hpx::make_ready_future(primitive_argument_type{});
         }
     }
@@ -0,0 +1,311 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/execution_policy.hpp>
+
+#include <hpx/include/runtime.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace phylanx { namespace execution_tree
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // weight of the previous measurements relative to a new one
+        constexpr double cost_model_decay = 0.9;
+    }
+
+    execution_cost_model::execution_cost_model(execution_cost_model const& rhs)
+    {
+        *this = rhs;
+    }
+
+    execution_cost_model& execution_cost_model::operator=(
+        execution_cost_model const& rhs)
+    {
+        if (this != &rhs)
+        {
+            std::lock_guard<mutex_type> l(rhs.mtx_);
+            sum_weights_ = rhs.sum_weights_;
+            sum_work_ = rhs.sum_work_;
+            sum_duration_ = rhs.sum_duration_;
+            sum_work2_ = rhs.sum_work2_;
+            sum_work_duration_ = rhs.sum_work_duration_;
+            last_work_ = rhs.last_work_;
+            samples_ = rhs.samples_;
+        }
+        return *this;
+    }
+
+    void execution_cost_model::update(std::size_t work, std::int64_t duration)
+    {
+        double const x = double(work);
+        double const y = double(duration);
+
+        std::lock_guard<mutex_type> l(mtx_);
+
+        sum_weights_ = detail::cost_model_decay * sum_weights_ + 1.0;
+        sum_work_ = detail::cost_model_decay * sum_work_ + x;
+        sum_duration_ = detail::cost_model_decay * sum_duration_ + y;
+        sum_work2_ = detail::cost_model_decay * sum_work2_ + x * x;
+        sum_work_duration_ =
+            detail::cost_model_decay * sum_work_duration_ + x * y;
+
+        last_work_ = work;
+        ++samples_;
+    }
+
+    double execution_cost_model::predict_locked(double work) const
+    {
+        if (sum_weights_ == 0.0)
+        {
+            return 0.0;
+        }
+
+        double const mean_work = sum_work_ / sum_weights_;
+        double const mean_duration = sum_duration_ / sum_weights_;
+        double const variance =
+            sum_work2_ / sum_weights_ - mean_work * mean_work;
+
+        // all measurements were taken for (almost) the same amount of work
+        if (variance <= 1e-6 * (mean_work * mean_work + 1.0))
+        {
+            return mean_duration;
+        }
+
+        double const slope =
+            (sum_work_duration_ / sum_weights_ - mean_work * mean_duration) /
+            variance;
+
+        // noise may produce a negative slope, which is meaningless here
+        if (slope <= 0.0)
+        {
+            return mean_duration;
+        }
+
+        return (std::max)(
+            0.0, mean_duration + slope * (work - mean_work));
+    }
+
+    double execution_cost_model::predict(std::size_t work) const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return predict_locked(double(work));
+    }
+
+    double execution_cost_model::predict() const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return predict_locked(double(last_work_));
+    }
+
+    double execution_cost_model::mean() const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return sum_weights_ == 0.0 ? 0.0 : sum_duration_ / sum_weights_;
+    }
+
+    std::size_t execution_cost_model::last_work() const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return last_work_;
+    }
+
+    std::int64_t execution_cost_model::samples() const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return samples_;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        template <typename T>
+        T get_config_value(char const* name, T default_value)
+        {
+            return hpx::util::safe_lexical_cast<T>(
+                hpx::get_config_entry(name, std::to_string(default_value)),
+                default_value);
+        }
+
+        adaptive_execution_policy::parameters get_adaptive_parameters()
+        {
+            adaptive_execution_policy::parameters params;
+            params.task_overhead = get_config_value(
+                "phylanx.execution_policy.task_overhead", 5000.0);
+            params.direct_ratio = get_config_value(
+                "phylanx.execution_policy.direct_ratio", 30.0);
+            params.async_ratio = get_config_value(
+                "phylanx.execution_policy.async_ratio", 60.0);
+            params.parallel_ratio = get_config_value(
+                "phylanx.execution_policy.parallel_ratio", 400.0);
+            params.cores = get_config_value("phylanx.execution_policy.cores",
+                std::size_t(hpx::get_os_thread_count()));
+            return params;
+        }
+    }
+
+    adaptive_execution_policy::adaptive_execution_policy()
+      : params_(detail::get_adaptive_parameters())
+    {
+    }
+
+    adaptive_execution_policy::adaptive_execution_policy(
+            parameters const& params)
+      : params_(params)
+    {
+    }
+
+    execution_mode adaptive_execution_policy::select(
+        execution_cost_model const& model, execution_mode current) const
+    {
+        // nothing is known about this primitive yet
+        if (model.samples() == 0)
+        {
+            return current;
+        }
+
+        // there is nothing to gain from spawning threads
+        if (params_.cores <= 1)
+        {
+            return execution_mode::direct;
+        }
+
+        double const predicted = model.predict();
+        if (predicted > params_.parallel_ratio * params_.task_overhead)
+        {
+            return execution_mode::parallel;
+        }
+        if (predicted > params_.async_ratio * params_.task_overhead)
+        {
+            return execution_mode::async;
+        }
+        if (predicted < params_.direct_ratio * params_.task_overhead)
+        {
+            return execution_mode::direct;
+        }
+
+        // keep the previous decision (hysteresis)
+        return current == execution_mode::parallel ? execution_mode::async :
+                                                     current;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    execution_mode threshold_execution_policy::select(
+        execution_cost_model const& model, execution_mode current) const
+    {
+        if (model.samples() == 0)
+        {
+            return current;
+        }
+
+        // check whether execution status needs to be changed (with some
+        // hysteresis)
+        double const exec_time = model.mean();
+        if (exec_time > 300000)
+        {
+            return execution_mode::async;
+        }
+        if (exec_time < 150000)
+        {
+            return execution_mode::direct;
+        }
+        return current;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string fixed_execution_policy::name() const
+    {
+        switch (mode_)
+        {
+        case execution_mode::async:
+            return "async";
+
+        case execution_mode::direct:
+            return "direct";
+
+        case execution_mode::parallel:
+            return "parallel";
+
+        default:
+            break;
+        }
+        return "undecided";
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::shared_ptr<execution_policy> create_execution_policy(
+        std::string const& name)
+    {
+        if (name == "adaptive")
+        {
+            return std::make_shared<adaptive_execution_policy>();
+        }
+        if (name == "threshold")
+        {
+            return std::make_shared<threshold_execution_policy>();
+        }
+        if (name == "direct")
+        {
+            return std::make_shared<fixed_execution_policy>(
+                execution_mode::direct);
+        }
+        if (name == "async")
+        {
+            return std::make_shared<fixed_execution_policy>(
+                execution_mode::async);
+        }
+        if (name == "parallel")
+        {
+            return std::make_shared<fixed_execution_policy>(
+                execution_mode::parallel);
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "phylanx::execution_tree::create_execution_policy",
+            "unknown execution policy: " + name);
+    }
+
+    namespace detail
+    {
+        std::shared_ptr<execution_policy>& current_execution_policy()
+        {
+            static std::shared_ptr<execution_policy> policy =
+                create_execution_policy(hpx::get_config_entry(
+                    "phylanx.execution_policy", "adaptive"));
+            return policy;
+        }
+    }
+
+    std::shared_ptr<execution_policy> get_execution_policy()
+    {
+        return std::atomic_load(&detail::current_execution_policy());
+    }
+
+    std::shared_ptr<execution_policy> set_execution_policy(
+        std::shared_ptr<execution_policy> policy)
+    {
+        if (!policy)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::set_execution_policy",
+                "the execution policy must not be empty");
+        }
+        return std::atomic_exchange(
+            &detail::current_execution_policy(), std::move(policy));
+    }
+}}
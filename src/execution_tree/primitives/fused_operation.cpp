@@ -0,0 +1,743 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/fused_operation.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/blocked_reductions.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    primitive create_fused_operation(hpx::id_type const& locality,
+        std::vector<primitive_argument_type>&& operands,
+        std::string const& name, std::string const& codename)
+    {
+        static std::string type("__fused");
+        return create_primitive_component(
+            locality, type, std::move(operands), name, codename);
+    }
+
+    match_pattern_type const fused_operation::match_data =
+    {
+        hpx::util::make_tuple("__fused",
+            std::vector<std::string>{},
+            &create_fused_operation, &create_primitive<fused_operation>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        enum fused_opcode
+        {
+            fused_leaf = 0,
+            fused_add, fused_sub, fused_mul, fused_div, fused_minus,
+            fused_lt, fused_le, fused_gt, fused_ge, fused_eq, fused_ne,
+            fused_function
+        };
+
+        // Size of the blocks of elements the fused expression is evaluated
+        // on, all intermediate values of one block stay in the L1 cache.
+        constexpr std::size_t fused_block_size = 256;
+
+        using fused_function_type = double (*)(double);
+
+        struct fused_operation_info
+        {
+            char const* name;           // name of the fused primitive
+            char const* type;           // component type of the primitive
+            std::size_t arity;          // zero: two or more operands
+            fused_function_type func;   // unary function, if any
+        };
+
+        // The unary functions are restricted to those which are well
+        // defined for all arguments, the semantics are identical to the
+        // corresponding functions implemented by generic_operation.
+        static fused_operation_info const fused_operations[] =
+        {
+            {nullptr, nullptr, 0, nullptr},
+            {"__add", "__add", 0, nullptr},
+            {"__sub", "__sub", 0, nullptr},
+            {"__mul", "__mul", 0, nullptr},
+            {"__div", "__div", 0, nullptr},
+            {"__minus", "__minus", 1, nullptr},
+            {"__lt", "__lt", 2, nullptr},
+            {"__le", "__le", 2, nullptr},
+            {"__gt", "__gt", 2, nullptr},
+            {"__ge", "__ge", 2, nullptr},
+            {"__eq", "__eq", 2, nullptr},
+            {"__ne", "__ne", 2, nullptr},
+            {"absolute", "__gen", 1,
+                [](double m) -> double { return blaze::abs(m); }},
+            {"floor", "__gen", 1,
+                [](double m) -> double { return blaze::floor(m); }},
+            {"ceil", "__gen", 1,
+                [](double m) -> double { return blaze::ceil(m); }},
+            {"trunc", "__gen", 1,
+                [](double m) -> double { return blaze::trunc(m); }},
+            {"rint", "__gen", 1,
+                [](double m) -> double { return blaze::round(m); }},
+            {"sqrt", "__gen", 1,
+                [](double m) -> double { return blaze::sqrt(m); }},
+            {"invsqrt", "__gen", 1,
+                [](double m) -> double { return blaze::invsqrt(m); }},
+            {"cbrt", "__gen", 1,
+                [](double m) -> double { return blaze::cbrt(m); }},
+            {"invcbrt", "__gen", 1,
+                [](double m) -> double { return blaze::invcbrt(m); }},
+            {"exp", "__gen", 1,
+                [](double m) -> double { return blaze::exp(m); }},
+            {"exp2", "__gen", 1,
+                [](double m) -> double { return blaze::exp2(m); }},
+            {"exp10", "__gen", 1,
+                [](double m) -> double { return blaze::pow(10, m); }},
+            {"log", "__gen", 1,
+                [](double m) -> double { return blaze::log(m); }},
+            {"log2", "__gen", 1,
+                [](double m) -> double { return blaze::log2(m); }},
+            {"log10", "__gen", 1,
+                [](double m) -> double { return blaze::log10(m); }},
+            {"sin", "__gen", 1,
+                [](double m) -> double { return blaze::sin(m); }},
+            {"cos", "__gen", 1,
+                [](double m) -> double { return blaze::cos(m); }},
+            {"tan", "__gen", 1,
+                [](double m) -> double { return blaze::tan(m); }},
+            {"arcsin", "__gen", 1,
+                [](double m) -> double { return blaze::asin(m); }},
+            {"arccos", "__gen", 1,
+                [](double m) -> double { return blaze::acos(m); }},
+            {"arctan", "__gen", 1,
+                [](double m) -> double { return blaze::atan(m); }},
+            {"arcsinh", "__gen", 1,
+                [](double m) -> double { return blaze::asinh(m); }},
+            {"erf", "__gen", 1,
+                [](double m) -> double { return blaze::erf(m); }},
+            {"erfc", "__gen", 1,
+                [](double m) -> double { return blaze::erfc(m); }}
+        };
+
+        constexpr std::int64_t num_fused_operations =
+            sizeof(fused_operations) / sizeof(fused_operations[0]);
+
+        inline bool is_comparison(std::int64_t opcode)
+        {
+            return opcode >= fused_lt && opcode <= fused_ne;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        bool leaf_extents(ir::node_data<T> const& leaf, std::size_t& dims,
+            std::array<std::size_t, 2>& extents)
+        {
+            // sparse operands are handled by the original primitives
+            if (leaf.is_sparse())
+            {
+                return false;
+            }
+
+            std::size_t leaf_dims = leaf.num_dimensions();
+            if (leaf_dims == 0)
+            {
+                return true;        // scalars are broadcast
+            }
+
+            auto ext = leaf.dimensions();
+            if (dims == 0)
+            {
+                dims = leaf_dims;
+                extents[0] = ext[0];
+                extents[1] = ext[1];
+                return true;
+            }
+
+            return dims == leaf_dims && extents[0] == ext[0] &&
+                extents[1] == ext[1];
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t fused_operation::opcode(std::string const& name)
+    {
+        static std::map<std::string, std::int64_t> const opcodes = []()
+        {
+            std::map<std::string, std::int64_t> result;
+            for (std::int64_t i = 1; i != detail::num_fused_operations; ++i)
+            {
+                result[detail::fused_operations[i].name] = i;
+            }
+            return result;
+        }();
+
+        auto it = opcodes.find(name);
+        return it != opcodes.end() ? it->second : 0;
+    }
+
+    std::size_t fused_operation::arity(std::int64_t opcode)
+    {
+        HPX_ASSERT(opcode > 0 && opcode < detail::num_fused_operations);
+        return detail::fused_operations[opcode].arity;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    fused_operation::fused_operation(
+            std::vector<primitive_argument_type>&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , max_depth_(0)
+      , has_comparison_(false)
+      , returns_boolean_(false)
+    {
+        if (operands_.empty())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "fused_operation::fused_operation",
+                generate_error_message(
+                    "the fused_operation primitive requires at least one "
+                    "operand describing the fused expression"));
+        }
+
+        auto program = extract_integer_value(operands_[0], name_, codename_);
+        program_.assign(program.vector().begin(), program.vector().end());
+        operands_.erase(operands_.begin());
+
+        // verify the program and calculate the required stack depth
+        std::size_t depth = 0;
+        bool valid_program = !program_.empty() && (program_.size() % 2) == 0;
+        for (std::size_t i = 0; valid_program && i != program_.size(); i += 2)
+        {
+            std::int64_t op = program_[i];
+            std::int64_t arg = program_[i + 1];
+
+            if (op == detail::fused_leaf)
+            {
+                valid_program = arg >= 0 &&
+                    static_cast<std::size_t>(arg) < operands_.size();
+                max_depth_ = (std::max)(max_depth_, ++depth);
+                continue;
+            }
+
+            valid_program = op > 0 && op < detail::num_fused_operations &&
+                arg > 0 && static_cast<std::size_t>(arg) <= depth;
+            if (valid_program)
+            {
+                depth -= static_cast<std::size_t>(arg - 1);
+                has_comparison_ = has_comparison_ || detail::is_comparison(op);
+            }
+        }
+
+        if (!valid_program || depth != 1 ||
+            program_[program_.size() - 2] == detail::fused_leaf)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "fused_operation::fused_operation",
+                generate_error_message(
+                    "the fused_operation primitive was initialized with an "
+                    "invalid description of the fused expression"));
+        }
+
+        returns_boolean_ =
+            detail::is_comparison(program_[program_.size() - 2]);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool fused_operation::is_fusible(
+        std::vector<primitive_argument_type> const& leaves, std::size_t& dims,
+        std::array<std::size_t, 2>& extents) const
+    {
+        dims = 0;
+        extents = {1, 1};
+
+        for (auto const& leaf : leaves)
+        {
+            switch (leaf.index())
+            {
+            case 1:     // phylanx::ir::node_data<std::uint8_t>
+                if (has_comparison_ ||
+                    !detail::leaf_extents(util::get<1>(leaf), dims, extents))
+                {
+                    return false;
+                }
+                break;
+
+            case 2:     // ir::node_data<std::int64_t>
+                if (has_comparison_ ||
+                    !detail::leaf_extents(util::get<2>(leaf), dims, extents))
+                {
+                    return false;
+                }
+                break;
+
+            case 4:     // phylanx::ir::node_data<double>
+                if (!detail::leaf_extents(util::get<4>(leaf), dims, extents))
+                {
+                    return false;
+                }
+                break;
+
+            default:
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Evaluate the fused expression for 'count' consecutive elements. All
+    // intermediate results are kept in the scratch area, which is large
+    // enough to hold max_depth_ blocks.
+    void fused_operation::run(std::vector<double const*> const& leaves,
+        double* scratch, double* result, std::size_t count) const
+    {
+        std::array<double const*, 64> small_stack;
+        std::vector<double const*> large_stack;
+
+        double const** stack = small_stack.data();
+        if (max_depth_ > small_stack.size())
+        {
+            large_stack.resize(max_depth_);
+            stack = large_stack.data();
+        }
+
+        std::size_t depth = 0;
+        std::size_t const size = program_.size();
+        for (std::size_t i = 0; i != size; i += 2)
+        {
+            std::int64_t op = program_[i];
+            std::size_t arg = static_cast<std::size_t>(program_[i + 1]);
+
+            if (op == detail::fused_leaf)
+            {
+                stack[depth++] = leaves[arg];
+                continue;
+            }
+
+            depth -= arg;
+
+            double const** args = &stack[depth];
+            double* out = (i + 2 == size) ?
+                result : scratch + depth * detail::fused_block_size;
+
+            double const* lhs = args[0];
+            switch (op)
+            {
+            case detail::fused_add:
+                for (std::size_t k = 1; k != arg; ++k, lhs = out)
+                {
+                    double const* rhs = args[k];
+                    for (std::size_t j = 0; j != count; ++j)
+                        out[j] = lhs[j] + rhs[j];
+                }
+                break;
+
+            case detail::fused_sub:
+                for (std::size_t k = 1; k != arg; ++k, lhs = out)
+                {
+                    double const* rhs = args[k];
+                    for (std::size_t j = 0; j != count; ++j)
+                        out[j] = lhs[j] - rhs[j];
+                }
+                break;
+
+            case detail::fused_mul:
+                for (std::size_t k = 1; k != arg; ++k, lhs = out)
+                {
+                    double const* rhs = args[k];
+                    for (std::size_t j = 0; j != count; ++j)
+                        out[j] = lhs[j] * rhs[j];
+                }
+                break;
+
+            case detail::fused_div:
+                for (std::size_t k = 1; k != arg; ++k, lhs = out)
+                {
+                    double const* rhs = args[k];
+                    for (std::size_t j = 0; j != count; ++j)
+                        out[j] = lhs[j] / rhs[j];
+                }
+                break;
+
+            case detail::fused_minus:
+                for (std::size_t j = 0; j != count; ++j)
+                    out[j] = -lhs[j];
+                break;
+
+            case detail::fused_lt:
+                for (std::size_t j = 0; j != count; ++j)
+                    out[j] = lhs[j] < args[1][j] ? 1.0 : 0.0;
+                break;
+
+            case detail::fused_le:
+                for (std::size_t j = 0; j != count; ++j)
+                    out[j] = lhs[j] <= args[1][j] ? 1.0 : 0.0;
+                break;
+
+            case detail::fused_gt:
+                for (std::size_t j = 0; j != count; ++j)
+                    out[j] = lhs[j] > args[1][j] ? 1.0 : 0.0;
+                break;
+
+            case detail::fused_ge:
+                for (std::size_t j = 0; j != count; ++j)
+                    out[j] = lhs[j] >= args[1][j] ? 1.0 : 0.0;
+                break;
+
+            case detail::fused_eq:
+                for (std::size_t j = 0; j != count; ++j)
+                    out[j] = lhs[j] == args[1][j] ? 1.0 : 0.0;
+                break;
+
+            case detail::fused_ne:
+                for (std::size_t j = 0; j != count; ++j)
+                    out[j] = lhs[j] != args[1][j] ? 1.0 : 0.0;
+                break;
+
+            default:
+                {
+                    detail::fused_function_type f =
+                        detail::fused_operations[op].func;
+                    for (std::size_t j = 0; j != count; ++j)
+                        out[j] = f(lhs[j]);
+                }
+                break;
+            }
+
+            stack[depth++] = out;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type fused_operation::evaluate(std::size_t dims,
+        std::array<std::size_t, 2> const& extents,
+        std::vector<primitive_argument_type>&& leaves) const
+    {
+        std::size_t const block = detail::fused_block_size;
+
+        std::vector<arg_type> values;
+        values.reserve(leaves.size());
+        for (auto && leaf : leaves)
+        {
+            values.emplace_back(
+                extract_numeric_value(std::move(leaf), name_, codename_));
+        }
+
+        // scalar operands are broadcast by pointing to a block holding
+        // copies of the scalar value
+        std::vector<double> scalars;
+        scalars.reserve(values.size() * block);
+
+        std::vector<std::uint8_t> is_scalar(values.size(), 0);
+        for (std::size_t i = 0; i != values.size(); ++i)
+        {
+            if (values[i].num_dimensions() == 0)
+            {
+                is_scalar[i] = 1;
+                scalars.insert(scalars.end(), block, values[i].scalar());
+            }
+        }
+
+        // the buffers needed to evaluate a block of elements, each range of
+        // elements evaluated concurrently uses its own set
+        struct buffers
+        {
+            std::vector<double> scratch;
+            std::vector<double> boolean_result;
+            std::vector<double const*> current;
+        };
+
+        auto make_buffers = [&]()
+        {
+            return buffers{std::vector<double>(max_depth_ * block),
+                std::vector<double>(returns_boolean_ ? block : 0),
+                std::vector<double const*>(values.size())};
+        };
+
+        // evaluate one contiguous row of elements, block by block
+        auto evaluate_row = [&](buffers& b,
+            std::vector<double const*> const& row, std::size_t count,
+            double* out, std::uint8_t* bool_out)
+        {
+            for (std::size_t j = 0; j < count; j += block)
+            {
+                std::size_t n = (std::min)(block, count - j);
+                for (std::size_t i = 0; i != row.size(); ++i)
+                {
+                    b.current[i] = is_scalar[i] ? row[i] : row[i] + j;
+                }
+
+                if (bool_out != nullptr)
+                {
+                    run(b.current, b.scratch.data(), b.boolean_result.data(),
+                        n);
+                    for (std::size_t k = 0; k != n; ++k)
+                    {
+                        bool_out[j + k] = b.boolean_result[k] != 0.0;
+                    }
+                }
+                else
+                {
+                    run(b.current, b.scratch.data(), out + j, n);
+                }
+            }
+        };
+
+        std::vector<double const*> row(values.size());
+        std::size_t scalar_offset = 0;
+        for (std::size_t i = 0; i != values.size(); ++i)
+        {
+            if (is_scalar[i])
+            {
+                row[i] = &scalars[scalar_offset];
+                scalar_offset += block;
+            }
+        }
+
+        // the elements are split into ranges evaluated concurrently only if
+        // the execution policy asked for it
+        bool const parallel = parallel_eval();
+
+        switch (dims)
+        {
+        case 0:
+            {
+                buffers b = make_buffers();
+                double result = 0.0;
+                run(row, b.scratch.data(), &result, 1);
+                if (returns_boolean_)
+                {
+                    return primitive_argument_type{
+                        ir::node_data<std::uint8_t>{result != 0.0}};
+                }
+                return primitive_argument_type{ir::node_data<double>{result}};
+            }
+
+        case 1:
+            {
+                for (std::size_t i = 0; i != values.size(); ++i)
+                {
+                    if (!is_scalar[i])
+                        row[i] = values[i].vector().data();
+                }
+
+                auto evaluate_range = [&](double* out, std::uint8_t* bool_out)
+                {
+                    util::detail::for_each_block(extents[0],
+                        util::detail::reduction_blocks(
+                            extents[0], 1, parallel),
+                        [&](std::size_t, std::size_t first, std::size_t last)
+                        {
+                            buffers b = make_buffers();
+                            std::vector<double const*> range(row);
+                            for (std::size_t i = 0; i != range.size(); ++i)
+                            {
+                                if (!is_scalar[i])
+                                    range[i] += first;
+                            }
+                            evaluate_row(b, range, last - first,
+                                out != nullptr ? out + first : nullptr,
+                                bool_out != nullptr ? bool_out + first :
+                                                      nullptr);
+                        });
+                };
+
+                if (returns_boolean_)
+                {
+                    blaze::DynamicVector<std::uint8_t> result(extents[0]);
+                    evaluate_range(nullptr, result.data());
+                    return primitive_argument_type{
+                        ir::node_data<std::uint8_t>{std::move(result)}};
+                }
+
+                blaze::DynamicVector<double> result(extents[0]);
+                evaluate_range(result.data(), nullptr);
+                return primitive_argument_type{
+                    ir::node_data<double>{std::move(result)}};
+            }
+
+        case 2:
+            {
+                std::vector<blaze::CustomMatrix<double, true, true>> matrices;
+                matrices.reserve(values.size());
+                for (std::size_t i = 0; i != values.size(); ++i)
+                {
+                    matrices.emplace_back(is_scalar[i] ?
+                        blaze::CustomMatrix<double, true, true>{} :
+                        values[i].matrix());
+                }
+
+                // evaluate the rows of either result matrix
+                auto evaluate_rows = [&](blaze::DynamicMatrix<double>* out,
+                    blaze::DynamicMatrix<std::uint8_t>* bool_out)
+                {
+                    util::detail::for_each_block(extents[0],
+                        util::detail::reduction_blocks(
+                            extents[0], extents[1], parallel),
+                        [&](std::size_t, std::size_t first, std::size_t last)
+                        {
+                            buffers b = make_buffers();
+                            std::vector<double const*> range(row);
+                            for (std::size_t r = first; r != last; ++r)
+                            {
+                                for (std::size_t i = 0; i != range.size(); ++i)
+                                {
+                                    if (!is_scalar[i])
+                                        range[i] = matrices[i].data(r);
+                                }
+                                evaluate_row(b, range, extents[1],
+                                    out != nullptr ? out->data(r) : nullptr,
+                                    bool_out != nullptr ? bool_out->data(r) :
+                                                          nullptr);
+                            }
+                        });
+                };
+
+                if (returns_boolean_)
+                {
+                    blaze::DynamicMatrix<std::uint8_t> result(
+                        extents[0], extents[1]);
+                    evaluate_rows(nullptr, &result);
+                    return primitive_argument_type{
+                        ir::node_data<std::uint8_t>{std::move(result)}};
+                }
+
+                blaze::DynamicMatrix<double> result(extents[0], extents[1]);
+                evaluate_rows(&result, nullptr);
+                return primitive_argument_type{
+                    ir::node_data<double>{std::move(result)}};
+            }
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "fused_operation::evaluate",
+            generate_error_message(
+                "operand has unsupported number of dimensions"));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Lazily create the tree of primitives the fused expression was generated
+    // from. The leaves of this tree refer to the (already evaluated) operands
+    // of the fused primitive passed as arguments.
+    primitive const& fused_operation::unfused_tree() const
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        if (unfused_.valid())
+        {
+            return unfused_;
+        }
+
+        compiler::primitive_name_parts parts;
+        if (!compiler::parse_primitive_name(name_, parts))
+        {
+            parts = compiler::primitive_name_parts("__fused");
+        }
+
+        std::vector<primitive_argument_type> stack;
+        stack.reserve(max_depth_);
+
+        for (std::size_t i = 0; i != program_.size(); i += 2)
+        {
+            std::int64_t op = program_[i];
+            std::int64_t arg = program_[i + 1];
+
+            parts.sequence_number = static_cast<std::int64_t>(i / 2);
+            if (op == detail::fused_leaf)
+            {
+                parts.primitive = "access-argument";
+                stack.emplace_back(create_primitive_component(hpx::find_here(),
+                    parts.primitive, primitive_argument_type{arg},
+                    compiler::compose_primitive_name(parts), codename_));
+                continue;
+            }
+
+            auto const& info = detail::fused_operations[op];
+
+            std::vector<primitive_argument_type> args(
+                std::make_move_iterator(stack.end() - arg),
+                std::make_move_iterator(stack.end()));
+            stack.erase(stack.end() - arg, stack.end());
+
+            parts.primitive = info.name;
+            stack.emplace_back(create_primitive_component(hpx::find_here(),
+                info.type, std::move(args),
+                compiler::compose_primitive_name(parts), codename_));
+        }
+
+        HPX_ASSERT(stack.size() == 1);
+        unfused_ = primitive_operand(stack.back(), name_, codename_);
+        return unfused_;
+    }
+
+    hpx::future<primitive_argument_type> fused_operation::evaluate_unfused(
+        std::vector<primitive_argument_type>&& leaves) const
+    {
+        return unfused_tree().eval(std::move(leaves));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> fused_operation::eval(
+        std::vector<primitive_argument_type> const& operands,
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (!detail::verify_argument_values(operands))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "fused_operation::eval",
+                generate_error_message(
+                    "the fused_operation primitive requires that the "
+                    "arguments given by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_](std::vector<primitive_argument_type>&& leaves)
+            ->  hpx::future<primitive_argument_type>
+            {
+                std::size_t dims = 0;
+                std::array<std::size_t, 2> extents;
+                if (this_->is_fusible(leaves, dims, extents))
+                {
+                    return hpx::make_ready_future(
+                        this_->evaluate(dims, extents, std::move(leaves)));
+                }
+
+                // operands which require broadcasting or which are not
+                // numeric are handled by the original primitives
+                return this_->evaluate_unfused(std::move(leaves));
+            }),
+            detail::map_operands(
+                operands, functional::value_operand{}, args,
+                name_, codename_));
+    }
+
+    hpx::future<primitive_argument_type> fused_operation::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        return eval(operands_, args);
+    }
+}}}
@@ -152,6 +152,33 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return primitive_->get_direct_execution(reset);
     }
 
+    std::int64_t primitive_component::get_predicted_eval_duration(
+        bool reset) const
+    {
+        return primitive_->get_predicted_eval_duration(reset);
+    }
+
+    std::int64_t primitive_component::get_bytes_allocated(bool reset) const
+    {
+        return primitive_->get_bytes_allocated(reset);
+    }
+
+    std::int64_t primitive_component::get_bytes_copied(bool reset) const
+    {
+        return primitive_->get_bytes_copied(reset);
+    }
+
+    std::int64_t primitive_component::get_copy_count(bool reset) const
+    {
+        return primitive_->get_copy_count(reset);
+    }
+
+    std::int64_t primitive_component::get_max_allocated_per_eval(
+        bool reset) const
+    {
+        return primitive_->get_max_allocated_per_eval(reset);
+    }
+
     hpx::launch primitive_component::select_direct_execution(
         primitive_component::eval_action, hpx::launch policy,
         hpx::naming::address_type lva)
@@ -6,16 +6,23 @@
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/execution_policy.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
-#include <phylanx/util/scoped_timer.hpp>
+#include <phylanx/ir/memory_accounting.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/event_tracer.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
 #include <hpx/runtime/naming_fwd.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/throw_exception.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <set>
 #include <string>
@@ -67,6 +74,210 @@ namespace phylanx { namespace execution_tree { namespace primitives
             std::forward<T>(t));
     }
 
+    namespace detail
+    {
+        // Record the shape of an argument or literal operand into the given
+        // trace event
+        template <typename T>
+        void trace_shape(util::trace_event& event, std::size_t i,
+            ir::node_data<T> const& data)
+        {
+            std::size_t dims = data.num_dimensions();
+            event.dimensions_[i] = static_cast<std::int8_t>(dims);
+            for (std::size_t d = 0; d != dims && d != 2; ++d)
+            {
+                event.extents_[i][d] =
+                    static_cast<std::int64_t>(data.dimension(int(d)));
+            }
+        }
+
+        void trace_operand(
+            util::trace_event& event, primitive_argument_type const& val)
+        {
+            std::size_t i = event.num_operands_++;
+            switch (val.index())
+            {
+            case 1:     // phylanx::ir::node_data<std::uint8_t>
+                trace_shape(event, i, util::get<1>(val));
+                break;
+
+            case 2:     // phylanx::ir::node_data<std::int64_t>
+                trace_shape(event, i, util::get<2>(val));
+                break;
+
+            case 4:     // phylanx::ir::node_data<double>
+                trace_shape(event, i, util::get<4>(val));
+                break;
+
+            case 7:     // ir::range
+                event.dimensions_[i] = 1;
+                event.extents_[i][0] = util::get<7>(val).size();
+                break;
+
+            default:
+                event.dimensions_[i] = -1;
+                break;
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Measures the duration of an evaluation and feeds it into the cost model
+    // of the primitive once the evaluation has finished. The evaluation is
+    // recorded by the event tracer if that was enabled when it started.
+    struct primitive_component_base::eval_timer
+    {
+        eval_timer(primitive_component_base const* p, std::size_t work,
+                std::vector<primitive_argument_type> const& params)
+          : started_at_(hpx::util::high_resolution_clock::now())
+          , this_(p)
+          , work_(work)
+          , traced_(util::event_tracer::enabled())
+        {
+            if (traced_)
+            {
+                trace_begin(params);
+            }
+        }
+
+        eval_timer(eval_timer const&) = delete;
+        eval_timer(eval_timer && rhs)
+          : started_at_(rhs.started_at_)
+          , this_(rhs.this_)
+          , work_(rhs.work_)
+          , traced_(rhs.traced_)
+        {
+            if (traced_)
+            {
+                event_ = rhs.event_;
+            }
+            rhs.this_ = nullptr;
+        }
+
+        eval_timer& operator=(eval_timer const&) = delete;
+        eval_timer& operator=(eval_timer &&) = delete;
+
+        // the evaluation completes after do_eval has returned
+        void set_async()
+        {
+            if (traced_)
+            {
+                event_.async_ = true;
+            }
+        }
+
+        ~eval_timer()
+        {
+            if (this_ != nullptr)
+            {
+                std::uint64_t now = hpx::util::high_resolution_clock::now();
+                std::int64_t duration =
+                    static_cast<std::int64_t>(now - started_at_);
+                this_->eval_duration_ += duration;
+                this_->cost_model_.update(work_, duration);
+
+                if (traced_)
+                {
+                    trace_end(now);
+                }
+            }
+        }
+
+    private:
+        void trace_begin(std::vector<primitive_argument_type> const& params)
+        {
+            hpx::threads::thread_id_type id = hpx::threads::get_self_id();
+            event_.thread_id_ = reinterpret_cast<std::uint64_t>(id.get());
+            event_.worker_ =
+                static_cast<std::uint32_t>(hpx::get_worker_thread_num());
+            event_.num_operands_ = 0;
+            event_.async_ = false;
+
+            for (auto const& param : params)
+            {
+                if (event_.num_operands_ == util::trace_event::max_operands)
+                {
+                    return;
+                }
+                detail::trace_operand(event_, param);
+            }
+            for (auto const& operand : this_->operands_)
+            {
+                if (event_.num_operands_ == util::trace_event::max_operands)
+                {
+                    return;
+                }
+                if (!is_primitive_operand(operand))
+                {
+                    detail::trace_operand(event_, operand);
+                }
+            }
+        }
+
+        void trace_end(std::uint64_t now)
+        {
+            event_.begin_ = started_at_;
+            event_.end_ = now;
+            event_.end_worker_ =
+                static_cast<std::uint32_t>(hpx::get_worker_thread_num());
+
+            std::size_t length = this_->name_.copy(
+                event_.name_, util::trace_event::max_name_length);
+            event_.name_[length] = '\0';
+
+            util::event_tracer::record(event_);
+        }
+
+        std::uint64_t started_at_;
+        primitive_component_base const* this_;
+        std::size_t work_;
+        bool traced_;
+        util::trace_event event_;
+    };
+
+    namespace detail
+    {
+        std::size_t data_size(primitive_argument_type const& val)
+        {
+            switch (val.index())
+            {
+            case 1:     // phylanx::ir::node_data<std::uint8_t>
+                return util::get<1>(val).size();
+
+            case 2:     // phylanx::ir::node_data<std::int64_t>
+                return util::get<2>(val).size();
+
+            case 4:     // phylanx::ir::node_data<double>
+                return util::get<4>(val).size();
+
+            case 7:     // ir::range
+                return static_cast<std::size_t>(util::get<7>(val).size());
+
+            default:
+                break;
+            }
+            return 1;
+        }
+    }
+
+    std::size_t primitive_component_base::eval_work(
+        std::vector<primitive_argument_type> const& params) const
+    {
+        std::size_t work = 0;
+        for (auto const& param : params)
+        {
+            work += detail::data_size(param);
+        }
+        for (auto const& operand : operands_)
+        {
+            if (!is_primitive_operand(operand))
+            {
+                work += detail::data_size(operand);
+            }
+        }
+        return work;
+    }
+
     hpx::future<primitive_argument_type> primitive_component_base::do_eval(
         std::vector<primitive_argument_type> const& params) const
     {
@@ -74,10 +285,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         hpx::util::annotate_function annotate(eval_name_.c_str());
 #endif
 
-        util::scoped_timer<std::int64_t> timer(eval_duration_);
+        eval_timer timer(this, eval_work(params), params);
         ++eval_count_;
 
-        auto f = this->eval(params);
+        hpx::future<primitive_argument_type> f;
+        {
+            // attribute the storage created by this evaluation, no scope is
+            // opened for continuations running after eval has returned (see
+            // ir::memory_accounting)
+            ir::memory_accounting::scope memory_scope(memory_statistics_);
+            f = this->eval(params);
+        }
         if (!f.is_ready())
         {
             using shared_state_ptr =
@@ -86,6 +304,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
             shared_state_ptr const& state =
                 hpx::traits::future_access<decltype(f)>::get_shared_state(f);
 
+            timer.set_async();
             state->set_on_completed(keep_alive(std::move(timer)));
         }
         return f;
@@ -182,6 +401,40 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return hpx::util::get_and_reset_value(execute_directly_, reset);
     }
 
+    std::int64_t primitive_component_base::get_predicted_eval_duration(
+        bool reset) const
+    {
+        // the cost model is not affected by resetting the counter (see
+        // the declaration)
+        return static_cast<std::int64_t>(cost_model_.predict());
+    }
+
+    std::int64_t primitive_component_base::get_bytes_allocated(
+        bool reset) const
+    {
+        return hpx::util::get_and_reset_value(
+            memory_statistics_.bytes_allocated_, reset);
+    }
+
+    std::int64_t primitive_component_base::get_bytes_copied(bool reset) const
+    {
+        return hpx::util::get_and_reset_value(
+            memory_statistics_.bytes_copied_, reset);
+    }
+
+    std::int64_t primitive_component_base::get_copy_count(bool reset) const
+    {
+        return hpx::util::get_and_reset_value(
+            memory_statistics_.copies_, reset);
+    }
+
+    std::int64_t primitive_component_base::get_max_allocated_per_eval(
+        bool reset) const
+    {
+        return hpx::util::get_and_reset_value(
+            memory_statistics_.max_allocated_per_eval_, reset);
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     bool primitive_component_base::get_sync_execution()
     {
@@ -206,28 +459,23 @@ namespace phylanx { namespace execution_tree { namespace primitives
             return hpx::launch::sync;
         }
 
-        if (eval_count_ != 0)
-        {
-            // check whether execution status needs to be changed (with some
-            // hysteresis)
-            std::int64_t exec_time = (eval_duration_ / eval_count_);
-            if (exec_time > 300000)
-            {
-                execute_directly_ = 0;
-            }
-            else if (exec_time < 150000)
-            {
-                execute_directly_ = 1;
-            }
-        }
+        execution_mode mode = get_execution_policy()->select(
+            cost_model_, static_cast<execution_mode>(execute_directly_));
+        execute_directly_ = static_cast<std::int64_t>(mode);
 
-        if (execute_directly_ == 1)
+        switch (mode)
         {
+        case execution_mode::direct:
             return hpx::launch::sync;
-        }
-        else if (execute_directly_ == 0)
-        {
+
+        // for execution_mode::parallel the primitive additionally splits
+        // its work, see parallel_eval()
+        case execution_mode::async: HPX_FALLTHROUGH;
+        case execution_mode::parallel:
             return hpx::launch::async;
+
+        default:
+            break;
         }
 
         return policy;
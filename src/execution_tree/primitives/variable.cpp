@@ -72,7 +72,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 result =
                     value_operand_sync(operands_[0], args, name_, codename_);
             }
-            operands_[0] = std::move(result);
+            // the value may refer to data held elsewhere (e.g. an argument
+            // of the enclosing function), which may not outlive the variable
+            operands_[0] = extract_copy_value(std::move(result));
             evaluated_ = true;
         }
 
@@ -0,0 +1,116 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/memory_accounting.hpp>
+
+#include <hpx/runtime/threads/thread_helpers.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace phylanx { namespace ir
+{
+    namespace detail
+    {
+        std::atomic<bool> memory_accounting_enabled(true);
+
+        // The innermost active scope is stored with the calling HPX thread,
+        // this keeps it valid if the thread is suspended and resumed on a
+        // different core. Plain OS-threads use a thread_local instead.
+        memory_accounting::scope*& os_thread_scope()
+        {
+            static thread_local memory_accounting::scope* current = nullptr;
+            return current;
+        }
+
+        memory_accounting::scope* current_scope()
+        {
+            if (hpx::threads::get_self_ptr() != nullptr)
+            {
+                return reinterpret_cast<memory_accounting::scope*>(
+                    hpx::threads::get_thread_data(
+                        hpx::threads::get_self_id()));
+            }
+            return os_thread_scope();
+        }
+
+        void set_current_scope(memory_accounting::scope* current)
+        {
+            if (hpx::threads::get_self_ptr() != nullptr)
+            {
+                hpx::threads::set_thread_data(hpx::threads::get_self_id(),
+                    reinterpret_cast<std::size_t>(current));
+                return;
+            }
+            os_thread_scope() = current;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    memory_accounting::scope::scope(memory_statistics& stats)
+      : stats_(enabled() ? &stats : nullptr)
+      , previous_(detail::current_scope())
+      , bytes_allocated_(0)
+    {
+        detail::set_current_scope(this);
+    }
+
+    memory_accounting::scope::~scope()
+    {
+        detail::set_current_scope(previous_);
+
+        if (stats_ != nullptr)
+        {
+            std::int64_t peak =
+                stats_->max_allocated_per_eval_.load(std::memory_order_relaxed);
+            while (bytes_allocated_ > peak &&
+                !stats_->max_allocated_per_eval_.compare_exchange_weak(
+                    peak, bytes_allocated_, std::memory_order_relaxed))
+            {
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void memory_accounting::allocated(std::size_t bytes)
+    {
+        scope* current = detail::current_scope();
+        if (current != nullptr && current->stats_ != nullptr)
+        {
+            current->bytes_allocated_ += static_cast<std::int64_t>(bytes);
+            current->stats_->bytes_allocated_.fetch_add(
+                static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+        }
+    }
+
+    void memory_accounting::copied(std::size_t bytes)
+    {
+        scope* current = detail::current_scope();
+        if (current != nullptr && current->stats_ != nullptr)
+        {
+            current->bytes_allocated_ += static_cast<std::int64_t>(bytes);
+            current->stats_->bytes_allocated_.fetch_add(
+                static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+            current->stats_->bytes_copied_.fetch_add(
+                static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+            current->stats_->copies_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool memory_accounting::enable(bool enable)
+    {
+        return detail::memory_accounting_enabled.exchange(
+            enable, std::memory_order_relaxed);
+    }
+
+    bool memory_accounting::enabled()
+    {
+        return detail::memory_accounting_enabled.load(
+            std::memory_order_relaxed);
+    }
+}}
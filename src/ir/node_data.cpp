@@ -6,6 +6,7 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/ir/memory_accounting.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/util/serialization/blaze.hpp>
 #include <phylanx/util/serialization/variant.hpp>
@@ -90,6 +91,44 @@ namespace phylanx { namespace ir
         return hpx::util::get_and_reset_value(count_move_assignments_, reset);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // memory accounting, references to external data don't own any storage
+    template <typename T>
+    std::size_t node_data<T>::owned_bytes(storage_type const& data)
+    {
+        switch (data.index())
+        {
+        case 1:
+            return util::get<1>(data).size() * sizeof(T);
+
+        case 2:
+            {
+                auto const& m = util::get<2>(data);
+                return m.rows() * m.spacing() * sizeof(T);
+            }
+
+        case 5:
+            return util::get<5>(data).nonZeros() *
+                (sizeof(T) + sizeof(std::size_t));
+
+        default:
+            break;
+        }
+        return 0;
+    }
+
+    template <typename T>
+    void node_data<T>::account_allocation(storage_type const& data)
+    {
+        memory_accounting::allocated(owned_bytes(data));
+    }
+
+    template <typename T>
+    void node_data<T>::account_copy(storage_type const& data)
+    {
+        memory_accounting::copied(owned_bytes(data));
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     /// Create node data for a 0-dimensional value
     template <typename T>
@@ -110,6 +149,7 @@ namespace phylanx { namespace ir
       : data_(values)
     {
         increment_copy_construction_count();
+        account_copy(data_);
     }
 
     template <typename T>
@@ -117,6 +157,7 @@ namespace phylanx { namespace ir
         : data_(std::move(values))
     {
         increment_move_construction_count();
+        account_allocation(data_);
     }
 
     template <typename T>
@@ -124,16 +165,17 @@ namespace phylanx { namespace ir
     {
         if (dims[1] != 1)
         {
-            data_ = storage2d_type(dims[0], dims[1]);
+            data_ = storage_pool<T>::acquire_matrix(dims[0], dims[1]);
         }
         else if (dims[0] != 1)
         {
-            data_ = storage1d_type(dims[0]);
+            data_ = storage_pool<T>::acquire_vector(dims[0]);
         }
         else
         {
             data_ = storage0d_type();
         }
+        account_allocation(data_);
     }
 
     template <typename T>
@@ -141,16 +183,22 @@ namespace phylanx { namespace ir
     {
         if (dims[1] != 1)
         {
-            data_ = storage2d_type(dims[0], dims[1], default_value);
+            storage2d_type m =
+                storage_pool<T>::acquire_matrix(dims[0], dims[1]);
+            m = default_value;
+            data_ = std::move(m);
         }
         else if (dims[0] != 1)
         {
-            data_ = storage1d_type(dims[0], default_value);
+            storage1d_type v = storage_pool<T>::acquire_vector(dims[0]);
+            v = default_value;
+            data_ = std::move(v);
         }
         else
         {
             data_ = default_value;
         }
+        account_allocation(data_);
     }
 
     template <typename T>
@@ -174,6 +222,7 @@ namespace phylanx { namespace ir
       : data_(values)
     {
         increment_copy_construction_count();
+        account_copy(data_);
     }
 
     template <typename T>
@@ -181,6 +230,7 @@ namespace phylanx { namespace ir
       : data_(std::move(values))
     {
         increment_move_construction_count();
+        account_allocation(data_);
     }
 
     template <typename T>
@@ -198,6 +248,30 @@ namespace phylanx { namespace ir
         increment_move_construction_count();
     }
 
+    /// Create node data for a sparse 2-dimensional value
+    template <typename T>
+    node_data<T>::node_data(sparse_storage2d_type const& values)
+      : data_(values)
+    {
+        increment_copy_construction_count();
+        account_copy(data_);
+    }
+
+    template <typename T>
+    node_data<T>::node_data(sparse_storage2d_type&& values)
+      : data_(std::move(values))
+    {
+        increment_move_construction_count();
+        account_allocation(data_);
+    }
+
+    template <typename T>
+    node_data<T>::node_data(sparse_ref_storage2d_type const& values)
+      : data_(values)
+    {
+        increment_move_construction_count();
+    }
+
     // conversion helpers for Python bindings
     template <typename T>
     node_data<T>::node_data(std::vector<T> const& values)
@@ -208,6 +282,7 @@ namespace phylanx { namespace ir
         {
             util::get<1>(data_)[i] = values[i];
         }
+        account_copy(data_);
     }
 
     template <typename T>
@@ -224,6 +299,7 @@ namespace phylanx { namespace ir
                 util::get<2>(data_)(i, j) = row[j];
             }
         }
+        account_copy(data_);
     }
 
     template <typename T>
@@ -239,6 +315,7 @@ namespace phylanx { namespace ir
         case 2:
             {
                 increment_copy_construction_count();
+                account_copy(d.data_);
                 return d.data_;
             }
             break;
@@ -260,6 +337,21 @@ namespace phylanx { namespace ir
             }
             break;
 
+        case 5:
+            {
+                increment_copy_construction_count();
+                account_copy(d.data_);
+                return d.data_;
+            }
+            break;
+
+        case 6:
+            {
+                increment_move_construction_count();
+                return d.data_;
+            }
+            break;
+
         default:
             HPX_THROW_EXCEPTION(hpx::invalid_status,
                 "phylanx::ir::node_data<T>::node_data<T>",
@@ -281,6 +373,30 @@ namespace phylanx { namespace ir
         increment_move_construction_count();
     }
 
+    template <typename T>
+    node_data<T>::~node_data()
+    {
+        release_storage();
+    }
+
+    template <typename T>
+    void node_data<T>::release_storage()
+    {
+        switch (data_.index())
+        {
+        case 1:
+            storage_pool<T>::release(std::move(util::get<1>(data_)));
+            break;
+
+        case 2:
+            storage_pool<T>::release(std::move(util::get<2>(data_)));
+            break;
+
+        default:
+            break;
+        }
+    }
+
     template <typename T>
     node_data<T>& node_data<T>::operator=(storage0d_type val)
     {
@@ -293,6 +409,7 @@ namespace phylanx { namespace ir
     {
         increment_copy_assignment_count();
         data_ = val;
+        account_copy(data_);
         return *this;
     }
 
@@ -301,6 +418,7 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        account_allocation(data_);
         return *this;
     }
 
@@ -326,6 +444,7 @@ namespace phylanx { namespace ir
     {
         increment_copy_assignment_count();
         data_ = val;
+        account_copy(data_);
         return *this;
     }
 
@@ -334,6 +453,7 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        account_allocation(data_);
         return *this;
     }
 
@@ -354,6 +474,24 @@ namespace phylanx { namespace ir
         return *this;
     }
 
+    template <typename T>
+    node_data<T>& node_data<T>::operator=(sparse_storage2d_type const& val)
+    {
+        increment_copy_assignment_count();
+        data_ = val;
+        account_copy(data_);
+        return *this;
+    }
+
+    template <typename T>
+    node_data<T>& node_data<T>::operator=(sparse_storage2d_type && val)
+    {
+        increment_move_assignment_count();
+        data_ = std::move(val);
+        account_allocation(data_);
+        return *this;
+    }
+
     template <typename T>
     node_data<T>& node_data<T>::operator=(std::vector<T> const& values)
     {
@@ -363,6 +501,7 @@ namespace phylanx { namespace ir
         {
             util::get<1>(data_)[i] = values[i];
         }
+        account_copy(data_);
         return *this;
     }
 
@@ -381,6 +520,7 @@ namespace phylanx { namespace ir
                 util::get<2>(data_)(i, j) = row[j];
             }
         }
+        account_copy(data_);
         return *this;
     }
 
@@ -397,6 +537,7 @@ namespace phylanx { namespace ir
         case 2:
             {
                 increment_copy_assignment_count();
+                account_copy(d.data_);
                 return d.data_;
             }
             break;
@@ -419,6 +560,21 @@ namespace phylanx { namespace ir
             }
             break;
 
+        case 5:
+            {
+                increment_copy_assignment_count();
+                account_copy(d.data_);
+                return d.data_;
+            }
+            break;
+
+        case 6:
+            {
+                increment_move_assignment_count();
+                return d.data_;
+            }
+            break;
+
         default:
             HPX_THROW_EXCEPTION(hpx::invalid_status,
                 "phylanx::ir::node_data<T>::node_data<T>",
@@ -442,11 +598,31 @@ namespace phylanx { namespace ir
         if (this != &d)
         {
             increment_move_assignment_count();
+            release_storage();
             data_ = std::move(d.data_);
         }
         return *this;
     }
 
+    namespace detail
+    {
+        // Sparse matrices don't store zero elements, return a reference to
+        // a zero value in this case.
+        template <typename T>
+        T const& sparse_element(blaze::CompressedMatrix<T> const& m,
+            std::size_t row, std::size_t column)
+        {
+            static T const zero = T(0);
+
+            auto it = m.find(row, column);
+            if (it == m.end(row))
+            {
+                return zero;
+            }
+            return it->value();
+        }
+    }
+
     /// Access a specific element of the underlying N-dimensional array
     template <typename T>
     T& node_data<T>::operator[](std::size_t index)
@@ -469,6 +645,13 @@ namespace phylanx { namespace ir
                 return m(idx_m, idx_n);
             }
 
+        case 5: HPX_FALLTHROUGH;
+        case 6:
+            HPX_THROW_EXCEPTION(hpx::invalid_status,
+                "phylanx::ir::node_data<T>::operator[]()",
+                "the elements of a sparse matrix can't be modified through "
+                "node_data");
+
         default:
             break;
         }
@@ -494,6 +677,13 @@ namespace phylanx { namespace ir
         case 4:
             return matrix()(indicies[0], indicies[1]);
 
+        case 5: HPX_FALLTHROUGH;
+        case 6:
+            HPX_THROW_EXCEPTION(hpx::invalid_status,
+                "phylanx::ir::node_data<T>::operator[]()",
+                "the elements of a sparse matrix can't be modified through "
+                "node_data");
+
         default:
             break;
         }
@@ -519,6 +709,13 @@ namespace phylanx { namespace ir
         case 4:
             return matrix()(index1, index2);
 
+        case 5: HPX_FALLTHROUGH;
+        case 6:
+            HPX_THROW_EXCEPTION(hpx::invalid_status,
+                "phylanx::ir::node_data<T>::at()",
+                "the elements of a sparse matrix can't be modified through "
+                "node_data");
+
         default:
             break;
         }
@@ -549,6 +746,14 @@ namespace phylanx { namespace ir
                 return m(idx_m, idx_n);
             }
 
+        case 5: HPX_FALLTHROUGH;
+        case 6:
+            {
+                auto const& m = sparse_matrix();
+                return detail::sparse_element(
+                    m, index / m.columns(), index % m.columns());
+            }
+
         default:
             break;
         }
@@ -574,6 +779,11 @@ namespace phylanx { namespace ir
         case 4:
             return matrix()(indicies[0], indicies[1]);
 
+        case 5: HPX_FALLTHROUGH;
+        case 6:
+            return detail::sparse_element(
+                sparse_matrix(), indicies[0], indicies[1]);
+
         default:
             break;
         }
@@ -599,6 +809,10 @@ namespace phylanx { namespace ir
         case 4:
             return matrix()(index1, index2);
 
+        case 5: HPX_FALLTHROUGH;
+        case 6:
+            return detail::sparse_element(sparse_matrix(), index1, index2);
+
         default:
             break;
         }
@@ -627,6 +841,13 @@ namespace phylanx { namespace ir
                 return m.rows() * m.columns();
             }
 
+        case 5: HPX_FALLTHROUGH;
+        case 6:
+            {
+                auto const& m = sparse_matrix();
+                return m.rows() * m.columns();
+            }
+
         default:
             break;
         }
@@ -660,12 +881,27 @@ namespace phylanx { namespace ir
         return const_iterator(*this, size());
     }
 
+    namespace detail
+    {
+        [[noreturn]] void throw_sparse_not_supported(char const* func)
+        {
+            HPX_THROW_EXCEPTION(hpx::invalid_status, func,
+                "node_data object holds a sparse matrix which is not "
+                "supported by this operation, use dense() to convert it");
+        }
+    }
+
     template <typename T>
     typename node_data<T>::storage2d_type& node_data<T>::matrix_non_ref()
     {
         storage2d_type* m = util::get_if<storage2d_type>(&data_);
         if (m == nullptr)
         {
+            if (is_sparse())
+            {
+                detail::throw_sparse_not_supported(
+                    "phylanx::ir::node_data<T>::matrix_non_ref()");
+            }
             HPX_THROW_EXCEPTION(hpx::invalid_status,
                 "phylanx::ir::node_data<T>::matrix_non_ref()",
                 "node_data object holds unsupported data type");
@@ -680,6 +916,11 @@ namespace phylanx { namespace ir
         storage2d_type const* m = util::get_if<storage2d_type>(&data_);
         if (m == nullptr)
         {
+            if (is_sparse())
+            {
+                detail::throw_sparse_not_supported(
+                    "phylanx::ir::node_data<T>::matrix_non_ref()");
+            }
             HPX_THROW_EXCEPTION(hpx::invalid_status,
                 "phylanx::ir::node_data<T>::matrix_non_ref()",
                 "node_data object holds unsupported data type");
@@ -703,6 +944,12 @@ namespace phylanx { namespace ir
             return *m;
         }
 
+        // sparse matrices are converted to dense ones
+        if (is_sparse())
+        {
+            return storage2d_type{sparse_matrix()};
+        }
+
         HPX_THROW_EXCEPTION(hpx::invalid_status,
             "phylanx::ir::node_data<T>::matrix()",
             "node_data object holds unsupported data type");
@@ -725,6 +972,12 @@ namespace phylanx { namespace ir
                 m->data(), m->rows(), m->columns(), m->spacing());
         }
 
+        if (is_sparse())
+        {
+            detail::throw_sparse_not_supported(
+                "phylanx::ir::node_data<T>::matrix()");
+        }
+
         HPX_THROW_EXCEPTION(hpx::invalid_status,
             "phylanx::ir::node_data<T>::matrix()",
             "node_data object holds unsupported data type");
@@ -748,6 +1001,12 @@ namespace phylanx { namespace ir
                 m->rows(), m->columns(), m->spacing());
         }
 
+        if (is_sparse())
+        {
+            detail::throw_sparse_not_supported(
+                "phylanx::ir::node_data<T>::matrix()");
+        }
+
         HPX_THROW_EXCEPTION(hpx::invalid_status,
             "phylanx::ir::node_data<T>::matrix()",
             "node_data object holds unsupported data type");
@@ -783,6 +1042,65 @@ namespace phylanx { namespace ir
             "node_data::matrix() shouldn't be called on an rvalue");
     }
 
+    template <typename T>
+    typename node_data<T>::sparse_storage2d_type&
+    node_data<T>::sparse_matrix_non_ref()
+    {
+        sparse_storage2d_type* m = util::get_if<sparse_storage2d_type>(&data_);
+        if (m == nullptr)
+        {
+            HPX_THROW_EXCEPTION(hpx::invalid_status,
+                "phylanx::ir::node_data<T>::sparse_matrix_non_ref()",
+                "node_data object holds unsupported data type");
+        }
+        return *m;
+    }
+
+    template <typename T>
+    typename node_data<T>::sparse_storage2d_type const&
+    node_data<T>::sparse_matrix_non_ref() const
+    {
+        sparse_storage2d_type const* m =
+            util::get_if<sparse_storage2d_type>(&data_);
+        if (m == nullptr)
+        {
+            HPX_THROW_EXCEPTION(hpx::invalid_status,
+                "phylanx::ir::node_data<T>::sparse_matrix_non_ref()",
+                "node_data object holds unsupported data type");
+        }
+        return *m;
+    }
+
+    template <typename T>
+    typename node_data<T>::sparse_storage2d_type
+    node_data<T>::sparse_matrix_copy() const
+    {
+        return sparse_matrix();
+    }
+
+    template <typename T>
+    typename node_data<T>::sparse_storage2d_type const&
+    node_data<T>::sparse_matrix() const
+    {
+        sparse_ref_storage2d_type const* rm =
+            util::get_if<sparse_ref_storage2d_type>(&data_);
+        if (rm != nullptr)
+        {
+            return rm->get();
+        }
+
+        sparse_storage2d_type const* m =
+            util::get_if<sparse_storage2d_type>(&data_);
+        if (m != nullptr)
+        {
+            return *m;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::invalid_status,
+            "phylanx::ir::node_data<T>::sparse_matrix()",
+            "node_data object holds unsupported data type");
+    }
+
     template <typename T>
     typename node_data<T>::storage1d_type& node_data<T>::vector_non_ref()
     {
@@ -945,7 +1263,9 @@ namespace phylanx { namespace ir
             return 1;
 
         case 2: HPX_FALLTHROUGH;
-        case 4:
+        case 4: HPX_FALLTHROUGH;
+        case 5: HPX_FALLTHROUGH;
+        case 6:
             return 2;
 
         default:
@@ -977,6 +1297,13 @@ namespace phylanx { namespace ir
                 return dimensions_type{m.rows(), m.columns()};
             }
 
+        case 5: HPX_FALLTHROUGH;
+        case 6:
+            {
+                auto const& m = sparse_matrix();
+                return dimensions_type{m.rows(), m.columns()};
+            }
+
         default:
             break;
         }
@@ -1005,6 +1332,13 @@ namespace phylanx { namespace ir
                 return (dim == 0) ? m.rows() : m.columns();
             }
 
+        case 5: HPX_FALLTHROUGH;
+        case 6:
+            {
+                auto const& m = sparse_matrix();
+                return (dim == 0) ? m.rows() : m.columns();
+            }
+
         default:
             break;
         }
@@ -1026,9 +1360,14 @@ namespace phylanx { namespace ir
         case 2:
             return node_data<T>{matrix()};
 
+        case 5:
+            return node_data<T>{
+                sparse_ref_storage2d_type{util::get<5>(data_)}};
+
         case 0: HPX_FALLTHROUGH;
         case 3: HPX_FALLTHROUGH;
-        case 4:
+        case 4: HPX_FALLTHROUGH;
+        case 6:
             return *this;
 
         default:
@@ -1051,9 +1390,14 @@ namespace phylanx { namespace ir
         case 2:
             return node_data<T>{matrix()};
 
+        case 5:
+            return node_data<T>{
+                sparse_ref_storage2d_type{util::get<5>(data_)}};
+
         case 0: HPX_FALLTHROUGH;
         case 3: HPX_FALLTHROUGH;
-        case 4:
+        case 4: HPX_FALLTHROUGH;
+        case 6:
             return *this;
 
         default:
@@ -1089,7 +1433,8 @@ namespace phylanx { namespace ir
         {
         case 0: HPX_FALLTHROUGH;
         case 1: HPX_FALLTHROUGH;
-        case 2:
+        case 2: HPX_FALLTHROUGH;
+        case 5:
             return *this;
 
         case 3:
@@ -1098,6 +1443,9 @@ namespace phylanx { namespace ir
         case 4:
             return node_data<T>{matrix_copy()};
 
+        case 6:
+            return node_data<T>{sparse_matrix_copy()};
+
         default:
             break;
         }
@@ -1116,11 +1464,13 @@ namespace phylanx { namespace ir
         {
         case 0: HPX_FALLTHROUGH;
         case 1: HPX_FALLTHROUGH;
-        case 2:
+        case 2: HPX_FALLTHROUGH;
+        case 5:
             return false;
 
         case 3: HPX_FALLTHROUGH;
-        case 4:
+        case 4: HPX_FALLTHROUGH;
+        case 6:
             return true;
 
         default:
@@ -1132,6 +1482,13 @@ namespace phylanx { namespace ir
             "node_data object holds unsupported data type");
     }
 
+    template <typename T>
+    bool node_data<T>::is_sparse() const
+    {
+        std::size_t index = data_.index();
+        return index == 5 || index == 6;
+    }
+
     // conversion helpers for Python bindings
     template <typename T>
     std::vector<T> node_data<T>::as_vector() const
@@ -1163,14 +1520,17 @@ namespace phylanx { namespace ir
         switch(data_.index())
         {
         case 2: HPX_FALLTHROUGH;
-        case 4:
+        case 4: HPX_FALLTHROUGH;
+        case 5: HPX_FALLTHROUGH;
+        case 6:
             {
-                auto m = matrix();
-                std::vector<std::vector<T>> result(m.rows());
-                for (std::size_t i = 0; i != m.rows(); ++i)
-                {
-                    result[i].assign(m.begin(i), m.end(i));
-                }
+                std::vector<std::vector<T>> result;
+                result.reserve(dimension(0));
+                for_each_row(
+                    [&](T const* data, std::size_t size)
+                    {
+                        result.emplace_back(data, data + size);
+                    });
                 return result;
             }
 
@@ -1187,6 +1547,23 @@ namespace phylanx { namespace ir
     }
 
     ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        template <typename T>
+        bool sparse_equal(node_data<T> const& lhs, node_data<T> const& rhs)
+        {
+            if (lhs.is_sparse() && rhs.is_sparse())
+            {
+                return lhs.sparse_matrix() == rhs.sparse_matrix();
+            }
+            if (lhs.is_sparse())
+            {
+                return lhs.sparse_matrix() == rhs.matrix();
+            }
+            return lhs.matrix() == rhs.sparse_matrix();
+        }
+    }
+
     bool operator==(node_data<double> const& lhs, node_data<double> const& rhs)
     {
         if (lhs.num_dimensions() != rhs.num_dimensions() ||
@@ -1195,6 +1572,11 @@ namespace phylanx { namespace ir
             return false;
         }
 
+        if (lhs.is_sparse() || rhs.is_sparse())
+        {
+            return detail::sparse_equal(lhs, rhs);
+        }
+
         switch (lhs.num_dimensions())
         {
         case 0:
@@ -1226,6 +1608,11 @@ namespace phylanx { namespace ir
             return false;
         }
 
+        if (lhs.is_sparse() || rhs.is_sparse())
+        {
+            return detail::sparse_equal(lhs, rhs);
+        }
+
         switch (lhs.num_dimensions())
         {
         case 0:
@@ -1257,6 +1644,11 @@ namespace phylanx { namespace ir
             return false;
         }
 
+        if (lhs.is_sparse() || rhs.is_sparse())
+        {
+            return detail::sparse_equal(lhs, rhs);
+        }
+
         switch (lhs.num_dimensions())
         {
         case 0:
@@ -1283,8 +1675,9 @@ namespace phylanx { namespace ir
     ///////////////////////////////////////////////////////////////////////////
     namespace detail
     {
-        template <typename T, typename Range>
-        void print_array(std::ostream& out, Range const& r, std::size_t size)
+        // print the elements of a row converting them to U first
+        template <typename U, typename T>
+        void print_array(std::ostream& out, T const* data, std::size_t size)
         {
             out << "[";
             for (std::size_t i = 0; i != size; ++i)
@@ -1293,86 +1686,73 @@ namespace phylanx { namespace ir
                 {
                     out << ", ";
                 }
-                out << T(r[i]);
+                out << U(data[i]);
             }
             out << "]";
         }
-    }
 
-    ///////////////////////////////////////////////////////////////////////////
-    std::ostream& operator<<(std::ostream& out, node_data<double> const& nd)
-    {
-        std::size_t dims = nd.num_dimensions();
-        switch (dims)
+        template <typename U, typename T>
+        void print_node_data(std::ostream& out, node_data<T> const& nd,
+            char const* name)
         {
-        case 0:
-            out << nd[0];
-            break;
-
-        case 1: HPX_FALLTHROUGH;
-        case 3:
-            detail::print_array<double>(out, nd.vector(), nd.size());
-            break;
-
-        case 2: HPX_FALLTHROUGH;
-        case 4:
+            std::size_t dims = nd.num_dimensions();
+            switch (dims)
             {
-                out << "[";
-                auto data = nd.matrix();
-                for (std::size_t row = 0; row != data.rows(); ++row)
+            case 1:
+                nd.for_each_row(
+                    [&](T const* data, std::size_t size)
+                    {
+                        print_array<U>(out, data, size);
+                    });
+                break;
+
+            case 2:
                 {
-                    if (row != 0)
-                        out << ", ";
-                    detail::print_array<double>(
-                        out, blaze::row(data, row), data.columns());
+                    out << "[";
+                    bool first = true;
+                    nd.for_each_row(
+                        [&](T const* data, std::size_t size)
+                        {
+                            if (!first)
+                                out << ", ";
+                            first = false;
+                            print_array<U>(out, data, size);
+                        });
+                    out << "]";
                 }
-                out << "]";
+                break;
+
+            default:
+                HPX_THROW_EXCEPTION(hpx::invalid_status, name,
+                    "invalid dimensionality: " + std::to_string(dims));
             }
-            break;
+        }
+    }
 
-        default:
-            HPX_THROW_EXCEPTION(hpx::invalid_status,
-                "node_data<double>::operator<<()",
-                "invalid dimensionality: " + std::to_string(dims));
+    ///////////////////////////////////////////////////////////////////////////
+    std::ostream& operator<<(std::ostream& out, node_data<double> const& nd)
+    {
+        if (nd.num_dimensions() == 0)
+        {
+            out << nd.scalar();
+            return out;
         }
+
+        detail::print_node_data<double>(
+            out, nd, "node_data<double>::operator<<()");
         return out;
     }
 
     std::ostream& operator<<(std::ostream& out, node_data<std::int64_t> const& nd)
     {
-        std::size_t dims = nd.num_dimensions();
-        switch (dims)
+        if (nd.num_dimensions() == 0)
         {
-            case 0:
-                out << nd[0];
-                break;
-
-            case 1: HPX_FALLTHROUGH;
-            case 3:
-                detail::print_array<std::int64_t>(out, nd.vector(), nd.size());
-                break;
-
-            case 2: HPX_FALLTHROUGH;
-            case 4:
-            {
-                out << "[";
-                auto data = nd.matrix();
-                for (std::size_t row = 0; row != data.rows(); ++row)
-                {
-                    if (row != 0)
-                        out << ", ";
-                    detail::print_array<std::int64_t>(
-                            out, blaze::row(data, row), data.columns());
-                }
-                out << "]";
-            }
-                break;
-
-            default:
-                HPX_THROW_EXCEPTION(hpx::invalid_status,
-                                    "node_data<std::int64_t>::operator<<()",
-                                    "invalid dimensionality: " + std::to_string(dims));
+            out << nd.scalar();
+            return out;
         }
+
+        detail::print_node_data<std::int64_t>(
+            out, nd, "node_data<std::int64_t>::operator<<()");
         return out;
     }
 
@@ -1380,6 +1760,11 @@ namespace phylanx { namespace ir
     template <typename T>
     node_data<T>::operator bool() const
     {
+        if (is_sparse())
+        {
+            return sparse_matrix().nonZeros() != 0;
+        }
+
         std::size_t dims = num_dimensions();
         switch (dims)
         {
@@ -1432,6 +1817,14 @@ namespace phylanx { namespace ir
             ar << util::get<4>(data_);
             break;
 
+        case 5:
+            ar << util::get<5>(data_);
+            break;
+
+        case 6:
+            ar << util::get<6>(data_).get();
+            break;
+
         default:
             HPX_THROW_EXCEPTION(hpx::invalid_status,
                 "node_data<T>::serialize",
@@ -1474,6 +1867,15 @@ namespace phylanx { namespace ir
             }
             break;
 
+        case 5: HPX_FALLTHROUGH;
+        case 6:     // deserialize sparse matrix references as sparse matrix
+            {
+                sparse_storage2d_type m;
+                ar >> m;
+                data_ = std::move(m);
+            }
+            break;
+
         default:
             HPX_THROW_EXCEPTION(hpx::invalid_status,
                 "node_data<T>::serialize",
@@ -1484,40 +1886,15 @@ namespace phylanx { namespace ir
     ///////////////////////////////////////////////////////////////////////////
     std::ostream& operator<<(std::ostream& out, node_data<std::uint8_t> const& nd)
     {
-        std::size_t dims = nd.num_dimensions();
-        switch (dims)
+        out << std::boolalpha;
+        if (nd.num_dimensions() == 0)
         {
-        case 0:
-            out << std::boolalpha << std::to_string(bool{nd[0] != 0});
-            break;
-
-        case 1: HPX_FALLTHROUGH;
-        case 3:
-            out << std::boolalpha;
-            detail::print_array<bool>(out, nd.vector(), nd.size());
-            break;
-
-        case 2: HPX_FALLTHROUGH;
-        case 4:
-            {
-                out << std::boolalpha << "[";
-                auto data = nd.matrix();
-                for (std::size_t row = 0; row != data.rows(); ++row)
-                {
-                    if (row != 0)
-                        out << ", ";
-                    detail::print_array<bool>(
-                        out, blaze::row(data, row), data.columns());
-                }
-                out << "]";
-            }
-            break;
-
-        default:
-            HPX_THROW_EXCEPTION(hpx::invalid_status,
-                "node_data<std::uint8_t>::operator<<()",
-                "invalid dimensionality: " + std::to_string(dims));
+            out << std::to_string(bool{nd.scalar() != 0});
+            return out;
         }
+
+        detail::print_node_data<bool>(
+            out, nd, "node_data<std::uint8_t>::operator<<()");
         return out;
     }
 }}
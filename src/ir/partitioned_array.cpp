@@ -0,0 +1,454 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/ir/partitioned_array.hpp>
+
+#include <hpx/include/actions.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace ir { namespace detail
+{
+    // Calculate one tile of a matrix product from the given row of tiles of
+    // the left hand side and the given column of tiles of the right hand
+    // side. This is executed on the locality the resulting tile is placed on.
+    hpx::future<hpx::id_type> dot_tiles(std::vector<hpx::id_type> const& lhs,
+        std::vector<hpx::id_type> const& rhs);
+}}}
+
+HPX_PLAIN_ACTION(phylanx::ir::detail::dot_tiles, phylanx_ir_dot_tiles_action);
+
+///////////////////////////////////////////////////////////////////////////////
+HPX_REGISTER_ACTION(phylanx::ir::server::tile::get_data_action,
+    phylanx_tile_get_data_action)
+HPX_REGISTER_ACTION(phylanx::ir::server::tile::elementwise_action,
+    phylanx_tile_elementwise_action)
+HPX_REGISTER_ACTION(phylanx::ir::server::tile::transpose_action,
+    phylanx_tile_transpose_action)
+HPX_REGISTER_ACTION(phylanx::ir::server::tile::sum_action,
+    phylanx_tile_sum_action)
+
+typedef hpx::components::component<phylanx::ir::server::tile>
+    phylanx_tile_component_type;
+HPX_REGISTER_COMPONENT(phylanx_tile_component_type)
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace ir
+{
+    namespace detail
+    {
+        hpx::future<hpx::id_type> dot_tiles(
+            std::vector<hpx::id_type> const& lhs,
+            std::vector<hpx::id_type> const& rhs)
+        {
+            using get_data_action = server::tile::get_data_action;
+
+            std::vector<hpx::future<node_data<double>>> lhs_data;
+            lhs_data.reserve(lhs.size());
+            for (auto const& id : lhs)
+            {
+                lhs_data.push_back(hpx::async(get_data_action(), id));
+            }
+
+            std::vector<hpx::future<node_data<double>>> rhs_data;
+            rhs_data.reserve(rhs.size());
+            for (auto const& id : rhs)
+            {
+                rhs_data.push_back(hpx::async(get_data_action(), id));
+            }
+
+            return hpx::dataflow(hpx::launch::sync,
+                hpx::util::unwrapping(
+                    [](std::vector<node_data<double>>&& lhs,
+                        std::vector<node_data<double>>&& rhs)
+                    -> hpx::future<hpx::id_type>
+                    {
+                        blaze::DynamicMatrix<double> result =
+                            lhs[0].matrix() * rhs[0].matrix();
+                        for (std::size_t k = 1; k != lhs.size(); ++k)
+                        {
+                            result += lhs[k].matrix() * rhs[k].matrix();
+                        }
+                        return hpx::new_<server::tile>(hpx::find_here(),
+                            node_data<double>{std::move(result)});
+                    }),
+                std::move(lhs_data), std::move(rhs_data));
+        }
+
+        std::size_t num_tiles(std::size_t size, std::size_t tile_size)
+        {
+            return (size + tile_size - 1) / tile_size;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace server
+    {
+        node_data<double> tile::get_data() const
+        {
+            return data_;
+        }
+
+        hpx::future<hpx::id_type> tile::elementwise(
+            elementwise_operation op, hpx::id_type const& rhs) const
+        {
+            // the corresponding tile usually lives on the same locality,
+            // the operation is attached as a continuation to avoid blocking
+            // the calling HPX thread while its data is fetched. The (managed)
+            // id of this tile keeps it alive until the continuation has run.
+            return hpx::dataflow(hpx::launch::sync,
+                hpx::util::unwrapping(
+                    [this, op, self = this->get_id()](
+                        node_data<double>&& rhs_data)
+                    -> hpx::future<hpx::id_type>
+                    {
+                        auto const& lhs_m = data_.matrix();
+                        auto const& rhs_m = rhs_data.matrix();
+
+                        blaze::DynamicMatrix<double> result;
+                        switch (op)
+                        {
+                        case elementwise_operation::add:
+                            result = lhs_m + rhs_m;
+                            break;
+
+                        case elementwise_operation::sub:
+                            result = lhs_m - rhs_m;
+                            break;
+
+                        case elementwise_operation::mul:
+                            result = lhs_m % rhs_m;
+                            break;
+
+                        case elementwise_operation::div:
+                            result = blaze::map(lhs_m, rhs_m,
+                                [](double x, double y) { return x / y; });
+                            break;
+
+                        default:
+                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "phylanx::ir::server::tile::elementwise",
+                                "unknown element-wise operation");
+                        }
+
+                        return hpx::new_<tile>(hpx::find_here(),
+                            node_data<double>{std::move(result)});
+                    }),
+                hpx::async(get_data_action(), rhs));
+        }
+
+        hpx::future<hpx::id_type> tile::transpose(
+            hpx::id_type const& locality) const
+        {
+            blaze::DynamicMatrix<double> result =
+                blaze::trans(data_.matrix());
+            return hpx::new_<tile>(
+                locality, node_data<double>{std::move(result)});
+        }
+
+        double tile::sum() const
+        {
+            return blaze::sum(data_.matrix());
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    partitioned_array::partitioned_array(std::size_t rows,
+            std::size_t columns, std::size_t tile_rows,
+            std::size_t tile_columns,
+            std::vector<hpx::id_type> const& localities)
+      : rows_(rows)
+      , columns_(columns)
+      , tile_rows_(tile_rows)
+      , tile_columns_(tile_columns)
+      , grid_rows_(detail::num_tiles(rows, tile_rows))
+      , grid_columns_(detail::num_tiles(columns, tile_columns))
+      , localities_(localities)
+    {
+        if (tile_rows == 0 || tile_columns == 0 || localities.empty())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::ir::partitioned_array::partitioned_array",
+                "the tiles must not be empty and at least one locality "
+                "has to be given");
+        }
+    }
+
+    std::size_t partitioned_array::tile_rows(std::size_t row) const
+    {
+        return (std::min)(tile_rows_, rows_ - row * tile_rows_);
+    }
+
+    std::size_t partitioned_array::tile_columns(std::size_t column) const
+    {
+        return (std::min)(tile_columns_, columns_ - column * tile_columns_);
+    }
+
+    hpx::future<partitioned_array> partitioned_array::create(
+        node_data<double> const& data, std::size_t tile_rows,
+        std::size_t tile_columns, std::vector<hpx::id_type> const& localities)
+    {
+        if (data.num_dimensions() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::ir::partitioned_array::create",
+                "partitioned arrays can be created from matrices only");
+        }
+
+        auto m = data.matrix();
+
+        partitioned_array result(
+            m.rows(), m.columns(), tile_rows, tile_columns, localities);
+
+        std::vector<hpx::future<hpx::id_type>> tiles;
+        tiles.reserve(result.grid_rows_ * result.grid_columns_);
+
+        for (std::size_t i = 0; i != result.grid_rows_; ++i)
+        {
+            for (std::size_t j = 0; j != result.grid_columns_; ++j)
+            {
+                blaze::DynamicMatrix<double> block = blaze::submatrix(m,
+                    i * tile_rows, j * tile_columns, result.tile_rows(i),
+                    result.tile_columns(j));
+
+                tiles.push_back(hpx::new_<server::tile>(
+                    result.locality(i, j), node_data<double>{std::move(block)}));
+            }
+        }
+
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping(
+                [result](std::vector<hpx::id_type>&& tiles) mutable
+                -> partitioned_array
+                {
+                    result.tiles_ = std::move(tiles);
+                    return result;
+                }),
+            std::move(tiles));
+    }
+
+    hpx::future<partitioned_array> partitioned_array::create(
+        node_data<double> const& data,
+        std::vector<hpx::id_type> const& localities)
+    {
+        auto dims = data.dimensions();
+        std::size_t tile_rows = detail::num_tiles(
+            dims[0], (std::max)(std::size_t(1), localities.size()));
+
+        return create(data, (std::max)(std::size_t(1), tile_rows),
+            (std::max)(std::size_t(1), dims[1]), localities);
+    }
+
+    hpx::future<node_data<double>> partitioned_array::gather() const
+    {
+        using get_data_action = server::tile::get_data_action;
+
+        std::vector<hpx::future<node_data<double>>> tiles;
+        tiles.reserve(tiles_.size());
+        for (auto const& id : tiles_)
+        {
+            tiles.push_back(hpx::async(get_data_action(), id));
+        }
+
+        partitioned_array const arr = *this;
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping(
+                [arr](std::vector<node_data<double>>&& tiles)
+                -> node_data<double>
+                {
+                    blaze::DynamicMatrix<double> result(
+                        arr.rows(), arr.columns());
+
+                    for (std::size_t i = 0; i != arr.grid_rows(); ++i)
+                    {
+                        for (std::size_t j = 0; j != arr.grid_columns(); ++j)
+                        {
+                            blaze::submatrix(result, i * arr.tile_rows(),
+                                j * arr.tile_columns(), arr.tile_rows(i),
+                                arr.tile_columns(j)) =
+                                tiles[i * arr.grid_columns() + j].matrix();
+                        }
+                    }
+
+                    return node_data<double>{std::move(result)};
+                }),
+            std::move(tiles));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        hpx::future<partitioned_array> make_partitioned_array(
+            partitioned_array&& layout,
+            std::vector<hpx::future<hpx::id_type>>&& tiles)
+        {
+            return hpx::dataflow(hpx::launch::sync,
+                hpx::util::unwrapping(
+                    [layout](std::vector<hpx::id_type>&& tiles) mutable
+                    -> partitioned_array
+                    {
+                        layout.tiles() = std::move(tiles);
+                        return layout;
+                    }),
+                std::move(tiles));
+        }
+    }
+
+    hpx::future<partitioned_array> elementwise(elementwise_operation op,
+        partitioned_array const& lhs, partitioned_array const& rhs)
+    {
+        if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns() ||
+            lhs.tile_rows() != rhs.tile_rows() ||
+            lhs.tile_columns() != rhs.tile_columns())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::ir::elementwise",
+                "the dimensions and the tiling of the operands do not match");
+        }
+
+        partitioned_array result(lhs.rows(), lhs.columns(), lhs.tile_rows(),
+            lhs.tile_columns(), lhs.localities());
+
+        std::vector<hpx::future<hpx::id_type>> tiles;
+        tiles.reserve(result.grid_rows() * result.grid_columns());
+
+        for (std::size_t i = 0; i != result.grid_rows(); ++i)
+        {
+            for (std::size_t j = 0; j != result.grid_columns(); ++j)
+            {
+                tiles.push_back(hpx::async(server::tile::elementwise_action(),
+                    lhs.tile(i, j), op, rhs.tile(i, j)));
+            }
+        }
+
+        return detail::make_partitioned_array(
+            std::move(result), std::move(tiles));
+    }
+
+    hpx::future<partitioned_array> dot(
+        partitioned_array const& lhs, partitioned_array const& rhs)
+    {
+        if (lhs.columns() != rhs.rows() ||
+            lhs.tile_columns() != rhs.tile_rows())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::ir::dot",
+                "the dimensions and the tiling of the operands do not match");
+        }
+
+        partitioned_array result(lhs.rows(), rhs.columns(), lhs.tile_rows(),
+            rhs.tile_columns(), lhs.localities());
+
+        std::vector<hpx::future<hpx::id_type>> tiles;
+        tiles.reserve(result.grid_rows() * result.grid_columns());
+
+        for (std::size_t i = 0; i != result.grid_rows(); ++i)
+        {
+            std::vector<hpx::id_type> lhs_tiles;
+            lhs_tiles.reserve(lhs.grid_columns());
+            for (std::size_t k = 0; k != lhs.grid_columns(); ++k)
+            {
+                lhs_tiles.push_back(lhs.tile(i, k));
+            }
+
+            for (std::size_t j = 0; j != result.grid_columns(); ++j)
+            {
+                std::vector<hpx::id_type> rhs_tiles;
+                rhs_tiles.reserve(rhs.grid_rows());
+                for (std::size_t k = 0; k != rhs.grid_rows(); ++k)
+                {
+                    rhs_tiles.push_back(rhs.tile(k, j));
+                }
+
+                tiles.push_back(hpx::async(phylanx_ir_dot_tiles_action(),
+                    result.locality(i, j), lhs_tiles, std::move(rhs_tiles)));
+            }
+        }
+
+        return detail::make_partitioned_array(
+            std::move(result), std::move(tiles));
+    }
+
+    hpx::future<partitioned_array> transpose(partitioned_array const& arr)
+    {
+        partitioned_array result(arr.columns(), arr.rows(),
+            arr.tile_columns(), arr.tile_rows(), arr.localities());
+
+        // tile (i, j) of the argument becomes tile (j, i) of the result
+        std::vector<hpx::future<hpx::id_type>> tiles(
+            result.grid_rows() * result.grid_columns());
+
+        for (std::size_t i = 0; i != arr.grid_rows(); ++i)
+        {
+            for (std::size_t j = 0; j != arr.grid_columns(); ++j)
+            {
+                tiles[j * result.grid_columns() + i] =
+                    hpx::async(server::tile::transpose_action(),
+                        arr.tile(i, j), result.locality(j, i));
+            }
+        }
+
+        return detail::make_partitioned_array(
+            std::move(result), std::move(tiles));
+    }
+
+    hpx::future<double> sum(partitioned_array const& arr)
+    {
+        std::vector<hpx::future<double>> sums;
+        sums.reserve(arr.grid_rows() * arr.grid_columns());
+
+        for (std::size_t i = 0; i != arr.grid_rows(); ++i)
+        {
+            for (std::size_t j = 0; j != arr.grid_columns(); ++j)
+            {
+                sums.push_back(
+                    hpx::async(server::tile::sum_action(), arr.tile(i, j)));
+            }
+        }
+
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping(
+                [](std::vector<double>&& sums) -> double
+                {
+                    double result = 0.0;
+                    for (double s : sums)
+                    {
+                        result += s;
+                    }
+                    return result;
+                }),
+            std::move(sums));
+    }
+
+    hpx::future<double> mean(partitioned_array const& arr)
+    {
+        std::size_t size = arr.rows() * arr.columns();
+        if (size == 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::ir::mean",
+                "the mean of an empty array is undefined");
+        }
+
+        return sum(arr).then(hpx::launch::sync,
+            [size](hpx::future<double>&& f) -> double
+            {
+                return f.get() / size;
+            });
+    }
+}}
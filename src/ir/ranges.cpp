@@ -473,6 +473,38 @@ namespace phylanx { namespace ir
             "range object holds unsupported data type");
     }
 
+    execution_tree::primitive_argument_type const& range::at(
+        std::size_t pos) const
+    {
+        switch (data_.index())
+        {
+        case 1:    // wrapped_args_type
+            return util::get<1>(data_).get()[pos];
+
+        case 2:    // arg_pair_type
+            {
+                auto const& it = util::get<2>(data_).first.it_;
+                switch (it.index())
+                {
+                case 1:    // args_iterator_type
+                    return *(util::get<1>(it) + pos);
+                case 2:    // args_const_iterator_type
+                    return *(util::get<2>(it) + pos);
+                default:
+                    break;
+                }
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::invalid_status,
+            "phylanx::ir::range::at()",
+            "range object does not store its elements");
+    }
+
     range range::ref()
     {
         switch (data_.index())
@@ -0,0 +1,633 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/storage_pool.hpp>
+
+#include <hpx/include/runtime.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/util/interval_timer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+namespace phylanx { namespace ir
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // storage with a smaller capacity is not pooled
+        constexpr std::size_t min_pooled_elements = 64;
+
+        // each power of two is split into 2^size_class_bits size classes,
+        // which limits the memory reserved in excess of the requested
+        // capacity to 1 / 2^size_class_bits (25%)
+        constexpr std::size_t size_class_bits = 2;
+
+        // storage with a larger capacity (2^26 elements) is not pooled
+        constexpr std::size_t max_size_exponent = 26;
+        constexpr std::size_t num_size_classes =
+            (max_size_exponent + 1) << size_class_bits;
+
+        // maximal number of entries kept per size class and thread
+        constexpr std::size_t max_free_list_entries = 8;
+
+        // default for the number of bytes kept by all pools together
+        constexpr std::int64_t default_max_cached_bytes =
+            std::int64_t(256) << 20;
+
+        // default for the time [ms] after which threads which have not used
+        // their pools free the storage cached by them
+        constexpr std::int64_t default_trim_interval = 1000;
+
+        // largest k for which 2^k <= n (n > 0)
+        inline std::size_t floor_log2(std::size_t n)
+        {
+            std::size_t k = 0;
+            while ((n >> (k + 1)) != 0)
+            {
+                ++k;
+            }
+            return k;
+        }
+
+        // the smallest capacity held by storage of the given size class
+        inline std::size_t class_capacity(std::size_t size_class)
+        {
+            std::size_t const exponent = size_class >> size_class_bits;
+            std::size_t const mantissa = (std::size_t(1) << size_class_bits) |
+                (size_class & ((std::size_t(1) << size_class_bits) - 1));
+            return (mantissa << exponent) >> size_class_bits;
+        }
+
+        // the size class of storage with the given capacity (the largest
+        // class whose capacity is not larger)
+        inline std::size_t floor_size_class(std::size_t capacity)
+        {
+            std::size_t const exponent = floor_log2(capacity);
+            std::size_t const mantissa =
+                (capacity << size_class_bits) >> exponent;
+            return (exponent << size_class_bits) |
+                (mantissa & ((std::size_t(1) << size_class_bits) - 1));
+        }
+
+        // the size class to take storage of the given capacity from (the
+        // smallest class whose capacity is not smaller)
+        inline std::size_t ceil_size_class(std::size_t capacity)
+        {
+            std::size_t size_class = floor_size_class(capacity);
+            if (class_capacity(size_class) < capacity)
+            {
+                ++size_class;
+            }
+            return size_class;
+        }
+
+        // the capacity needed for the given number of rows and columns
+        // including the padding added by Blaze
+        template <typename T>
+        std::size_t required_capacity(std::size_t rows, std::size_t columns)
+        {
+            return rows * (columns + blaze::SIMDTrait<T>::size);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::int64_t get_config_value(
+            char const* name, std::int64_t default_value)
+        {
+            try
+            {
+                return std::stoll(hpx::get_config_entry(
+                    name, std::to_string(default_value)));
+            }
+            catch (std::exception const&)
+            {
+                return default_value;
+            }
+        }
+
+        // The budget is read from the configuration once the runtime has
+        // been started
+        std::int64_t max_cached_bytes()
+        {
+            static std::atomic<std::int64_t> max_bytes(-1);
+
+            std::int64_t value = max_bytes.load(std::memory_order_relaxed);
+            if (value < 0)
+            {
+                if (hpx::get_runtime_ptr() == nullptr)
+                {
+                    return default_max_cached_bytes;
+                }
+                value = (std::max)(std::int64_t(0),
+                    get_config_value("phylanx.storage_pool.max_bytes",
+                        default_max_cached_bytes));
+                max_bytes.store(value, std::memory_order_relaxed);
+            }
+            return value;
+        }
+
+        // the number of bytes cached by all pools
+        std::atomic<std::int64_t> total_cached_bytes(0);
+
+        ///////////////////////////////////////////////////////////////////////
+        // The statistics of one thread are written by that thread only and
+        // are summed up when they are queried.
+        enum statistics_kind
+        {
+            hits = 0,
+            misses = 1,
+            releases = 2,
+            discards = 3,
+            num_statistics = 4
+        };
+
+        struct thread_statistics
+        {
+            void increment(statistics_kind kind)
+            {
+                counts_[kind].store(
+                    counts_[kind].load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+            }
+
+            std::array<std::atomic<std::int64_t>, num_statistics> counts_ =
+                {{{0}, {0}, {0}, {0}}};
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Storage>
+        struct free_list
+        {
+            std::vector<Storage> entries_;
+        };
+
+        template <typename T>
+        struct thread_free_lists;
+
+        // All free lists of one element type, the registry allows to sum up
+        // the statistics and to free the storage cached by idle threads.
+        template <typename T>
+        struct pool_registry
+        {
+            using mutex_type = std::mutex;
+
+            static pool_registry& get()
+            {
+                static pool_registry registry;
+                return registry;
+            }
+
+            void add(thread_free_lists<T>* lists)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                lists_.push_back(lists);
+            }
+
+            void remove(thread_free_lists<T>* lists)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                for (std::size_t i = 0; i != num_statistics; ++i)
+                {
+                    retired_[i] += lists->statistics_.counts_[i].load(
+                        std::memory_order_relaxed);
+                }
+                lists_.erase(
+                    std::remove(lists_.begin(), lists_.end(), lists),
+                    lists_.end());
+            }
+
+            std::int64_t count(statistics_kind kind, bool reset)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                std::int64_t total = retired_[kind];
+                for (auto const* lists : lists_)
+                {
+                    total += lists->statistics_.counts_[kind].load(
+                        std::memory_order_relaxed);
+                }
+
+                std::int64_t const result = total - reset_base_[kind];
+                if (reset)
+                {
+                    reset_base_[kind] = total;
+                }
+                return result;
+            }
+
+            std::int64_t cached_bytes()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+
+                std::int64_t total = 0;
+                for (auto const* lists : lists_)
+                {
+                    total += lists->cached_bytes_.load(
+                        std::memory_order_relaxed);
+                }
+                return total;
+            }
+
+            void trim()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                for (auto* lists : lists_)
+                {
+                    lists->trim();
+                }
+            }
+
+            mutex_type mtx_;
+            std::vector<thread_free_lists<T>*> lists_;
+
+            // statistics of threads which have exited
+            std::array<std::int64_t, num_statistics> retired_ = {{0, 0, 0, 0}};
+
+            // the totals at the time of the last reset of each counter
+            std::array<std::int64_t, num_statistics> reset_base_ =
+                {{0, 0, 0, 0}};
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        struct thread_free_lists
+        {
+            using mutex_type = hpx::lcos::local::spinlock;
+
+            thread_free_lists()
+            {
+                pool_registry<T>::get().add(this);
+            }
+
+            ~thread_free_lists()
+            {
+                clear();
+                pool_registry<T>::get().remove(this);
+                destroyed() = true;
+            }
+
+            // the free lists may be accessed while other thread local
+            // objects are being destroyed
+            static bool& destroyed()
+            {
+                static thread_local bool destroyed_ = false;
+                return destroyed_;
+            }
+
+            template <typename Storage>
+            bool push(std::array<free_list<Storage>, num_size_classes>& lists,
+                Storage&& storage)
+            {
+                std::size_t const capacity = storage.capacity();
+                if (capacity < min_pooled_elements)
+                {
+                    return false;
+                }
+
+                std::size_t const size_class = floor_size_class(capacity);
+                std::int64_t const bytes =
+                    static_cast<std::int64_t>(capacity * sizeof(T));
+
+                std::lock_guard<mutex_type> l(mtx_);
+                used_ = true;
+
+                if (size_class >= num_size_classes ||
+                    lists[size_class].entries_.size() ==
+                        max_free_list_entries ||
+                    !reserve_bytes(bytes))
+                {
+                    statistics_.increment(discards);
+                    return false;
+                }
+
+                lists[size_class].entries_.push_back(std::move(storage));
+                add_cached_bytes(bytes);
+                statistics_.increment(releases);
+                return true;
+            }
+
+            template <typename Storage>
+            bool pop(std::array<free_list<Storage>, num_size_classes>& lists,
+                std::size_t size_class, Storage& storage)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                used_ = true;
+
+                auto& entries = lists[size_class].entries_;
+                if (entries.empty())
+                {
+                    statistics_.increment(misses);
+                    return false;
+                }
+
+                storage = std::move(entries.back());
+                entries.pop_back();
+
+                std::int64_t const bytes =
+                    static_cast<std::int64_t>(storage.capacity() * sizeof(T));
+                add_cached_bytes(-bytes);
+                total_cached_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+                statistics_.increment(hits);
+                return true;
+            }
+
+            void clear()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                clear_locked();
+            }
+
+            // free everything if this thread has not used its pool since
+            // the previous invocation
+            void trim()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (!used_)
+                {
+                    clear_locked();
+                }
+                used_ = false;
+            }
+
+            std::array<free_list<blaze::DynamicVector<T>>, num_size_classes>
+                vectors_;
+            std::array<free_list<blaze::DynamicMatrix<T>>, num_size_classes>
+                matrices_;
+
+            std::atomic<std::int64_t> cached_bytes_{0};
+            thread_statistics statistics_;
+
+        private:
+            // take the given number of bytes from the global budget
+            static bool reserve_bytes(std::int64_t bytes)
+            {
+                std::int64_t const previous = total_cached_bytes.fetch_add(
+                    bytes, std::memory_order_relaxed);
+                if (previous + bytes > max_cached_bytes())
+                {
+                    total_cached_bytes.fetch_sub(
+                        bytes, std::memory_order_relaxed);
+                    return false;
+                }
+                return true;
+            }
+
+            void add_cached_bytes(std::int64_t bytes)
+            {
+                cached_bytes_.store(
+                    cached_bytes_.load(std::memory_order_relaxed) + bytes,
+                    std::memory_order_relaxed);
+            }
+
+            void clear_locked()
+            {
+                for (auto& list : vectors_)
+                {
+                    list.entries_.clear();
+                    list.entries_.shrink_to_fit();
+                }
+                for (auto& list : matrices_)
+                {
+                    list.entries_.clear();
+                    list.entries_.shrink_to_fit();
+                }
+
+                total_cached_bytes.fetch_sub(
+                    cached_bytes_.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+                cached_bytes_.store(0, std::memory_order_relaxed);
+            }
+
+            mutex_type mtx_;
+            bool used_ = false;
+        };
+
+        template <typename T>
+        thread_free_lists<T>* get_free_lists()
+        {
+            if (thread_free_lists<T>::destroyed())
+            {
+                return nullptr;
+            }
+
+            static thread_local thread_free_lists<T> lists;
+            return &lists;
+        }
+
+        template <typename T>
+        std::atomic<bool>& pool_enabled()
+        {
+            static std::atomic<bool> enabled(true);
+            return enabled;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    typename storage_pool<T>::vector_type storage_pool<T>::acquire_vector(
+        std::size_t size)
+    {
+        std::size_t const required = detail::required_capacity<T>(1, size);
+        if (!enabled() || required < detail::min_pooled_elements)
+        {
+            return vector_type(size);
+        }
+
+        std::size_t const size_class = detail::ceil_size_class(required);
+        if (size_class >= detail::num_size_classes)
+        {
+            return vector_type(size);
+        }
+
+        vector_type v;
+        auto* lists = detail::get_free_lists<T>();
+        if (lists == nullptr || !lists->pop(lists->vectors_, size_class, v))
+        {
+            v.reserve(detail::class_capacity(size_class));
+        }
+
+        v.resize(size, false);
+        return v;
+    }
+
+    template <typename T>
+    typename storage_pool<T>::matrix_type storage_pool<T>::acquire_matrix(
+        std::size_t rows, std::size_t columns)
+    {
+        std::size_t const required =
+            detail::required_capacity<T>(rows, columns);
+        if (!enabled() || required < detail::min_pooled_elements)
+        {
+            return matrix_type(rows, columns);
+        }
+
+        std::size_t const size_class = detail::ceil_size_class(required);
+        if (size_class >= detail::num_size_classes)
+        {
+            return matrix_type(rows, columns);
+        }
+
+        matrix_type m;
+        auto* lists = detail::get_free_lists<T>();
+        if (lists == nullptr || !lists->pop(lists->matrices_, size_class, m))
+        {
+            m.reserve(detail::class_capacity(size_class));
+        }
+
+        m.resize(rows, columns, false);
+        return m;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    void storage_pool<T>::release(vector_type&& v)
+    {
+        if (enabled())
+        {
+            auto* lists = detail::get_free_lists<T>();
+            if (lists != nullptr)
+            {
+                lists->push(lists->vectors_, std::move(v));
+            }
+        }
+    }
+
+    template <typename T>
+    void storage_pool<T>::release(matrix_type&& m)
+    {
+        if (enabled())
+        {
+            auto* lists = detail::get_free_lists<T>();
+            if (lists != nullptr)
+            {
+                lists->push(lists->matrices_, std::move(m));
+            }
+        }
+    }
+
+    template <typename T>
+    void storage_pool<T>::clear()
+    {
+        auto* lists = detail::get_free_lists<T>();
+        if (lists != nullptr)
+        {
+            lists->clear();
+        }
+    }
+
+    template <typename T>
+    void storage_pool<T>::trim()
+    {
+        detail::pool_registry<T>::get().trim();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    bool storage_pool<T>::enable(bool enable)
+    {
+        return detail::pool_enabled<T>().exchange(
+            enable, std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    bool storage_pool<T>::enabled()
+    {
+        return detail::pool_enabled<T>().load(std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    std::int64_t storage_pool<T>::hit_count(bool reset)
+    {
+        return detail::pool_registry<T>::get().count(detail::hits, reset);
+    }
+
+    template <typename T>
+    std::int64_t storage_pool<T>::miss_count(bool reset)
+    {
+        return detail::pool_registry<T>::get().count(detail::misses, reset);
+    }
+
+    template <typename T>
+    std::int64_t storage_pool<T>::release_count(bool reset)
+    {
+        return detail::pool_registry<T>::get().count(detail::releases, reset);
+    }
+
+    template <typename T>
+    std::int64_t storage_pool<T>::discard_count(bool reset)
+    {
+        return detail::pool_registry<T>::get().count(detail::discards, reset);
+    }
+
+    // the number of cached bytes is a gauge, it can't be reset
+    template <typename T>
+    std::int64_t storage_pool<T>::cached_bytes(bool)
+    {
+        return detail::pool_registry<T>::get().cached_bytes();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        bool trim_storage_pools()
+        {
+            storage_pool<double>::trim();
+            storage_pool<std::uint8_t>::trim();
+            storage_pool<std::int64_t>::trim();
+            return true;
+        }
+
+        std::unique_ptr<hpx::util::interval_timer>& storage_pool_timer()
+        {
+            static std::unique_ptr<hpx::util::interval_timer> timer;
+            return timer;
+        }
+    }
+
+    void start_storage_pool_trimming()
+    {
+        std::int64_t const interval =
+            detail::get_config_value("phylanx.storage_pool.trim_interval",
+                detail::default_trim_interval);
+        if (interval <= 0)
+        {
+            return;
+        }
+
+        auto& timer = detail::storage_pool_timer();
+        timer.reset(new hpx::util::interval_timer(
+            &detail::trim_storage_pools, interval * 1000,
+            "phylanx::ir::storage_pool::trim", true));
+        timer->start();
+    }
+
+    void stop_storage_pool_trimming()
+    {
+        auto& timer = detail::storage_pool_timer();
+        if (timer)
+        {
+            timer->stop();
+            timer.reset();
+        }
+    }
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+template class PHYLANX_EXPORT phylanx::ir::storage_pool<double>;
+template class PHYLANX_EXPORT phylanx::ir::storage_pool<std::uint8_t>;
+template class PHYLANX_EXPORT phylanx::ir::storage_pool<std::int64_t>;
@@ -9,6 +9,7 @@
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/ir/storage_pool.hpp>
 
 #include <hpx/include/agas.hpp>
 #include <hpx/include/components.hpp>
@@ -67,20 +68,47 @@ namespace phylanx { namespace performance_counters
     public:
         primitive_counter()
           : first_init_(false)
-          , duration_counter_(false)
+          , kind_(counter_kind::count)
         {}
 
         primitive_counter(hpx::performance_counters::counter_info const& info)
           : hpx::performance_counters::base_performance_counter<
                 primitive_counter>(info)
           , first_init_(false)
-          , duration_counter_(false)
+          , kind_(counter_kind::count)
         {
             hpx::performance_counters::counter_path_elements paths;
             hpx::performance_counters::get_counter_path_elements(
                 info.fullname_, paths);
-            duration_counter_ =
-                paths.countername_.find("time") != std::string::npos;
+            if (paths.countername_.find("memory/allocated") !=
+                std::string::npos)
+            {
+                kind_ = counter_kind::bytes_allocated;
+            }
+            else if (paths.countername_.find("memory/copied") !=
+                std::string::npos)
+            {
+                kind_ = counter_kind::bytes_copied;
+            }
+            else if (paths.countername_.find(
+                         "memory/max_allocated_per_eval") != std::string::npos)
+            {
+                kind_ = counter_kind::max_allocated_per_eval;
+            }
+            else if (paths.countername_.find("count/copies") !=
+                std::string::npos)
+            {
+                kind_ = counter_kind::copies;
+            }
+            else if (paths.countername_.find("time/predicted") !=
+                std::string::npos)
+            {
+                kind_ = counter_kind::predicted_duration;
+            }
+            else if (paths.countername_.find("time") != std::string::npos)
+            {
+                kind_ = counter_kind::duration;
+            }
         }
 
         // Produce the counter value
@@ -106,14 +134,7 @@ namespace phylanx { namespace performance_counters
             // Extract the values from instances_
             for (auto const& instance : instances_)
             {
-                if (duration_counter_)
-                {
-                    result.push_back(instance->get_eval_duration(reset));
-                }
-                else
-                {
-                    result.push_back(instance->get_eval_count(reset));
-                }
+                result.push_back(get_value(instance, reset));
             }
 
             value.values_ = std::move(result);
@@ -147,14 +168,7 @@ namespace phylanx { namespace performance_counters
                 // Consider the reset flag
                 if (reset)
                 {
-                    if (duration_counter_)
-                    {
-                        instance->get_eval_duration(true);
-                    }
-                    else
-                    {
-                        instance->get_eval_count(true);
-                    }
+                    get_value(instance, true);
                 }
                 instances_sorted[instance_info.sequence_number] = instance;
             }
@@ -173,9 +187,49 @@ namespace phylanx { namespace performance_counters
         using base_primitive_ptr = std::shared_ptr<
             phylanx::execution_tree::primitives::primitive_component>;
 
+        enum class counter_kind
+        {
+            count,
+            duration,
+            predicted_duration,
+            bytes_allocated,
+            bytes_copied,
+            copies,
+            max_allocated_per_eval
+        };
+
+        std::int64_t get_value(
+            base_primitive_ptr const& instance, bool reset) const
+        {
+            switch (kind_)
+            {
+            case counter_kind::duration:
+                return instance->get_eval_duration(reset);
+
+            case counter_kind::predicted_duration:
+                return instance->get_predicted_eval_duration(reset);
+
+            case counter_kind::bytes_allocated:
+                return instance->get_bytes_allocated(reset);
+
+            case counter_kind::bytes_copied:
+                return instance->get_bytes_copied(reset);
+
+            case counter_kind::copies:
+                return instance->get_copy_count(reset);
+
+            case counter_kind::max_allocated_per_eval:
+                return instance->get_max_allocated_per_eval(reset);
+
+            default:
+                break;
+            }
+            return instance->get_eval_count(reset);
+        }
+
         std::vector<base_primitive_ptr> instances_;
         std::atomic<bool> first_init_;
-        bool duration_counter_;
+        counter_kind kind_;
     };
 
     hpx::naming::gid_type primitive_counter_creator(
@@ -423,6 +477,37 @@ namespace phylanx { namespace performance_counters
             "returns the current value of the move-assignment count of "
                 "any node_data<double>");
 
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_double/storage_pool/hits",
+            &ir::storage_pool<double>::hit_count,
+            "returns the number of times the storage of a node_data<double> "
+                "was taken from the storage pool");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_double/storage_pool/misses",
+            &ir::storage_pool<double>::miss_count,
+            "returns the number of times the storage of a node_data<double> "
+                "had to be allocated as the storage pool had none available");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_double/storage_pool/releases",
+            &ir::storage_pool<double>::release_count,
+            "returns the number of times the storage of a node_data<double> "
+                "was returned to the storage pool");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_double/storage_pool/discards",
+            &ir::storage_pool<double>::discard_count,
+            "returns the number of times the storage of a node_data<double> "
+                "was freed as the storage pool was full");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_double/storage_pool/cached",
+            &ir::storage_pool<double>::cached_bytes,
+            "returns the number of bytes currently held by the storage pool "
+                "for node_data<double>",
+            "bytes");
+
         // Iterate and register a time and count performance counter per each
         // primitive
         namespace et = phylanx::execution_tree;
@@ -453,13 +538,68 @@ namespace phylanx { namespace performance_counters
                 &primitive_counter_creator,
                 &hpx::performance_counters::locality_counter_discoverer);
 
+            // Register a primitive predicted time performance counter
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/time/predicted",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the execution time "
+                    "of the next invocation of the eval function as "
+                    "predicted by the cost model of each " +
+                    name + " primitive",
+                &primitive_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer,
+                HPX_PERFORMANCE_COUNTER_V1, "ns");
+
+            // Register the primitive memory performance counters
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/memory/allocated",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the number of bytes "
+                    "of node_data storage created while evaluating each " +
+                    name + " primitive (including copies)",
+                &primitive_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer,
+                HPX_PERFORMANCE_COUNTER_V1, "bytes");
+
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/memory/copied",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the number of bytes "
+                    "deep-copied between node_data instances while "
+                    "evaluating each " + name + " primitive",
+                &primitive_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer,
+                HPX_PERFORMANCE_COUNTER_V1, "bytes");
+
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name +
+                    "/memory/max_allocated_per_eval",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the largest number "
+                    "of bytes of node_data storage created by a single "
+                    "evaluation of each " + name + " primitive",
+                &primitive_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer,
+                HPX_PERFORMANCE_COUNTER_V1, "bytes");
+
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/count/copies",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the number of deep "
+                    "copies of node_data storage made while evaluating "
+                    "each " + name + " primitive",
+                &primitive_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer);
+
             // Register a direct_execution performance counter
             hpx::performance_counters::install_counter_type(
                 "/phylanx/primitives/" + name + "/eval_direct",
                 hpx::performance_counters::counter_raw_values,
                 "returns a list whose elements contain whether "
                     "the eval function for the " + name + " primitive "
-                    "was executed directly",
+                    "was executed directly (1), asynchronously (0), "
+                    "asynchronously while splitting its work (2), or "
+                    "whether no decision was made yet (-1)",
                 &direct_execution_counter_creator,
                 &hpx::performance_counters::locality_counter_discoverer);
         }
@@ -8,6 +8,7 @@
 
 #include <hpx/include/iostreams.hpp>
 #include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/throw_exception.hpp>
 
@@ -16,6 +17,7 @@
 #include <iostream>
 #include <memory>
 #include <numeric>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -38,6 +40,88 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // The factors of row u of X are the solution of A x = b with
+        //
+        //      A = YtY + sum_j c_uj * y_j * y_j^T
+        //      b = sum_j (c_uj + 1) * y_j
+        //
+        // where j runs over the non-zero confidences c_uj of row u only. This
+        // avoids forming the dense diagonal matrices c_u and c_u + I. A is
+        // symmetric positive definite, the system is solved using a Cholesky
+        // decomposition instead of explicitly inverting A.
+        inline void als_accumulate(blaze::DynamicMatrix<double>& A,
+            blaze::DynamicVector<double>& b,
+            blaze::DynamicMatrix<double> const& Y, std::size_t j, double c)
+        {
+            auto y = blaze::trans(blaze::row(Y, j));
+            A += c * (y * blaze::trans(y));
+            b += (c + 1.0) * y;
+        }
+
+        inline void als_solve(blaze::DynamicMatrix<double>& X, std::size_t u,
+            blaze::DynamicMatrix<double>& A, blaze::DynamicVector<double>& b)
+        {
+            blaze::posv(A, b, 'L');
+            blaze::row(X, u) = blaze::trans(b);
+        }
+
+        // Update the factors X for sparse confidence values, each row of X
+        // is updated independently.
+        void als_update_sparse(blaze::DynamicMatrix<double>& X,
+            blaze::DynamicMatrix<double> const& Y,
+            blaze::DynamicMatrix<double> const& YtY,
+            blaze::CompressedMatrix<double, blaze::rowMajor> const& conf)
+        {
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), conf.rows(),
+                [&](std::size_t u)
+                {
+                    blaze::DynamicMatrix<double> A = YtY;
+                    blaze::DynamicVector<double> b(Y.columns(), 0.0);
+
+                    for (auto it = conf.begin(u); it != conf.end(u); ++it)
+                    {
+                        if (it->value() != 0.0)
+                        {
+                            als_accumulate(A, b, Y, it->index(), it->value());
+                        }
+                    }
+
+                    als_solve(X, u, A, b);
+                });
+        }
+
+        // Update the factors X for dense confidence values, row u of conf
+        // holds the confidences of row u of X.
+        void als_update_dense(blaze::DynamicMatrix<double>& X,
+            blaze::DynamicMatrix<double> const& Y,
+            blaze::DynamicMatrix<double> const& YtY,
+            blaze::DynamicMatrix<double> const& conf)
+        {
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), X.rows(),
+                [&](std::size_t u)
+                {
+                    blaze::DynamicMatrix<double> A = YtY;
+                    blaze::DynamicVector<double> b(Y.columns(), 0.0);
+
+                    auto conf_u = blaze::row(conf, u);
+                    for (std::size_t j = 0; j != conf_u.size(); ++j)
+                    {
+                        if (conf_u[j] != 0.0)
+                        {
+                            als_accumulate(A, b, Y, j, conf_u[j]);
+                        }
+                    }
+
+                    als_solve(X, u, A, b);
+                });
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type als::calculate_als(
         std::vector<primitive_argument_type> && args) const
@@ -51,7 +135,6 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     "the als algorithm primitive requires for the first "
                     "argument ('ratings') to represent a matrix"));
         }
-        auto ratings = arg1.matrix();
 
         auto arg2 = extract_numeric_value(args[1], name_, codename_);
         if (arg2.num_dimensions() != 0)
@@ -84,13 +167,30 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 extract_scalar_integer_value(args[5], name_, codename_) != 0;
         }
 
-        using vector_type = ir::node_data<double>::storage1d_type;
         using matrix_type = ir::node_data<double>::storage2d_type;
+        using sparse_matrix_type = ir::node_data<double>::sparse_storage2d_type;
 
         // perform calculations
-        std::int64_t num_users = ratings.rows();
-        std::int64_t num_items = ratings.columns();
-        auto conf = alpha * ratings;
+        std::int64_t num_users = arg1.dimension(0);
+        std::int64_t num_items = arg1.dimension(1);
+
+        // the ratings are processed row by row for the users and row by row
+        // of the transposed ratings for the items
+        bool const sparse = arg1.is_sparse();
+        sparse_matrix_type conf_sparse;
+        sparse_matrix_type conf_sparse_t;
+        matrix_type conf;
+        matrix_type conf_t;
+        if (sparse)
+        {
+            conf_sparse = alpha * arg1.sparse_matrix();
+            conf_sparse_t = blaze::trans(conf_sparse);
+        }
+        else
+        {
+            conf = alpha * arg1.matrix();
+            conf_t = blaze::trans(conf);
+        }
 
         matrix_type X(num_users, num_factors);
         matrix_type Y(num_items, num_factors);
@@ -116,8 +216,6 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
 
         auto I_f = blaze::IdentityMatrix<double>(num_factors);
-        auto I_i = blaze::IdentityMatrix<double>(num_items);
-        auto I_u = blaze::IdentityMatrix<double>(num_users);
 
         for (std::int64_t step = 0; step < iterations; ++step)
         {
@@ -130,37 +228,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
                           << "\nY: " << Y << std::endl;
             }
 
-            for (std::int64_t u = 0; u < num_users; u++)
+            if (sparse)
             {
-                vector_type conf_u = blaze::trans(blaze::row(conf, u));
-                blaze::DynamicMatrix<double> c_u(
-                    conf_u.size(), conf_u.size(), 0);
-                blaze::Band<blaze::DynamicMatrix<double>> diag =
-                    blaze::band(c_u, 0);
-                diag = conf_u;
-                vector_type p_u;
-                p_u = blaze::map(conf_u, [&](double x) { return (x != 0.0); });
-                matrix_type A = (blaze::trans(Y) * c_u) * Y + YtY;
-                vector_type b = (blaze::trans(Y) * (c_u + I_i)) * (p_u);
-                auto row_x = blaze::row(X, u);
-                row_x = (trans(b) * blaze::inv(A));
+                detail::als_update_sparse(X, Y, YtY, conf_sparse);
+                detail::als_update_sparse(Y, X, XtX, conf_sparse_t);
+                continue;
             }
 
-            for (std::int64_t i = 0; i < num_items; i++)
-            {
-                vector_type conf_i = blaze::column(conf, i);
-                blaze::DynamicMatrix<double> c_i(
-                    conf_i.size(), conf_i.size(), 0);
-                blaze::Band<blaze::DynamicMatrix<double>> diag =
-                    blaze::band(c_i, 0);
-                diag = conf_i;
-                vector_type p_i;
-                p_i = blaze::map(conf_i, [&](double x) { return (x != 0.0); });
-                matrix_type A = (blaze::trans(X) * c_i) * X + XtX;
-                vector_type b = (blaze::trans(X) * (c_i + I_u)) * (p_i);
-                auto row_y = blaze::row(Y, i);
-                row_y = (trans(b) * blaze::inv(A));
-            }
+            detail::als_update_dense(X, Y, YtY, conf);
+            detail::als_update_dense(Y, X, XtX, conf_t);
         }
 
         return primitive_argument_type
@@ -12,6 +12,7 @@
 #include <hpx/include/util.hpp>
 #include <hpx/throw_exception.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -886,6 +887,58 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // At least one of the operands is a sparse matrix
+    primitive_argument_type add_operation::add_sparse(
+        arg_type&& lhs, arg_type&& rhs) const
+    {
+        if (lhs.num_dimensions() == 2 && rhs.num_dimensions() == 2 &&
+            lhs.dimensions() == rhs.dimensions())
+        {
+            // the sum of two sparse matrices is sparse
+            if (lhs.is_sparse() && rhs.is_sparse())
+            {
+                if (lhs.is_ref())
+                {
+                    return primitive_argument_type{
+                        arg_type{arg_type::sparse_storage2d_type{
+                            lhs.sparse_matrix() + rhs.sparse_matrix()}}};
+                }
+
+                lhs.sparse_matrix_non_ref() += rhs.sparse_matrix();
+                return primitive_argument_type{std::move(lhs)};
+            }
+
+            // adding a sparse matrix to a dense one modifies only the
+            // elements corresponding to non-zero values
+            arg_type& dense = lhs.is_sparse() ? rhs : lhs;
+            arg_type& sparse = lhs.is_sparse() ? lhs : rhs;
+
+            if (dense.is_ref())
+            {
+                return primitive_argument_type{blaze::DynamicMatrix<double>{
+                    dense.matrix() + sparse.sparse_matrix()}};
+            }
+
+            dense.matrix() += sparse.sparse_matrix();
+            return primitive_argument_type{std::move(dense)};
+        }
+
+        // all other combinations (scalars, broadcasting) result in dense
+        // matrices anyways
+        if (lhs.is_sparse())
+        {
+            lhs = arg_type{lhs.matrix_copy()};
+        }
+        if (rhs.is_sparse())
+        {
+            rhs = arg_type{rhs.matrix_copy()};
+        }
+
+        return handle_numeric_operands(primitive_argument_type{std::move(lhs)},
+            primitive_argument_type{std::move(rhs)});
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     void add_operation::append_element(
         std::vector<primitive_argument_type>& result,
@@ -957,6 +1010,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
         arg_type lhs = extract_numeric_value(std::move(op1), name_, codename_);
         arg_type rhs = extract_numeric_value(std::move(op2), name_, codename_);
 
+        if (lhs.is_sparse() || rhs.is_sparse())
+        {
+            return add_sparse(std::move(lhs), std::move(rhs));
+        }
+
         std::size_t lhs_dims = lhs.num_dimensions();
         switch (lhs_dims)
         {
@@ -991,6 +1049,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 extract_numeric_value(std::move(op), name_, codename_));
         }
 
+        // sparse operands are added pairwise
+        if (std::any_of(args.begin(), args.end(),
+                [](arg_type const& arg) { return arg.is_sparse(); }))
+        {
+            primitive_argument_type result{std::move(args[0])};
+            for (std::size_t i = 1; i != args.size(); ++i)
+            {
+                result = handle_numeric_operands(std::move(result),
+                    primitive_argument_type{std::move(args[i])});
+            }
+            return result;
+        }
+
         std::size_t lhs_dims = args[0].num_dimensions();
         switch (lhs_dims)
         {
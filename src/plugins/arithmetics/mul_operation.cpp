@@ -14,6 +14,7 @@
 #include <hpx/include/util.hpp>
 #include <hpx/throw_exception.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <numeric>
@@ -372,6 +373,87 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 name_, codename_));
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // At least one of the operands is a sparse matrix
+    primitive_argument_type mul_operation::mul_sparse(
+        operand_type&& lhs, operand_type&& rhs) const
+    {
+        // scaling a sparse matrix keeps it sparse
+        if (lhs.num_dimensions() == 0 || rhs.num_dimensions() == 0)
+        {
+            operand_type& sparse = lhs.is_sparse() ? lhs : rhs;
+            double scale = lhs.is_sparse() ? rhs.scalar() : lhs.scalar();
+
+            if (sparse.is_ref())
+            {
+                return primitive_argument_type{
+                    operand_type{operand_type::sparse_storage2d_type{
+                        sparse.sparse_matrix() * scale}}};
+            }
+
+            sparse.sparse_matrix_non_ref() *= scale;
+            return primitive_argument_type{std::move(sparse)};
+        }
+
+        // the element-wise product has non-zero elements only where the
+        // sparse operand has non-zero elements
+        if (lhs.num_dimensions() == 2 && rhs.num_dimensions() == 2 &&
+            lhs.dimensions() == rhs.dimensions())
+        {
+            if (lhs.is_sparse() && rhs.is_sparse())
+            {
+                return primitive_argument_type{
+                    operand_type{operand_type::sparse_storage2d_type{
+                        lhs.sparse_matrix() % rhs.sparse_matrix()}}};
+            }
+
+            operand_type& dense = lhs.is_sparse() ? rhs : lhs;
+            operand_type& sparse = lhs.is_sparse() ? lhs : rhs;
+
+            return primitive_argument_type{
+                operand_type{operand_type::sparse_storage2d_type{
+                    sparse.sparse_matrix() % dense.matrix()}}};
+        }
+
+        // all other combinations (broadcasting) are handled for dense
+        // matrices
+        if (lhs.is_sparse())
+        {
+            lhs = operand_type{lhs.matrix_copy()};
+        }
+        if (rhs.is_sparse())
+        {
+            rhs = operand_type{rhs.matrix_copy()};
+        }
+
+        switch (lhs.num_dimensions())
+        {
+        case 0:
+            return mul0d(std::move(lhs), std::move(rhs));
+
+        case 1:
+            return mul1d(std::move(lhs), std::move(rhs));
+
+        default:
+            break;
+        }
+        return mul2d(std::move(lhs), std::move(rhs));
+    }
+
+    primitive_argument_type mul_operation::mul_sparse(
+        operands_type&& ops) const
+    {
+        // sparse operands are multiplied pairwise
+        operand_type result = std::move(ops[0]);
+        for (std::size_t i = 1; i != ops.size(); ++i)
+        {
+            result = extract_numeric_value(
+                mul_sparse(std::move(result), std::move(ops[i])),
+                name_, codename_);
+        }
+        return primitive_argument_type{std::move(result)};
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type mul_operation::mul2d(
         operand_type&& lhs, operand_type&& rhs) const
@@ -913,6 +995,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 [this_](operand_type&& lhs, operand_type&& rhs)
                 ->  primitive_argument_type
                 {
+                    if (lhs.is_sparse() || rhs.is_sparse())
+                    {
+                        return this_->mul_sparse(
+                            std::move(lhs), std::move(rhs));
+                    }
+
                     std::size_t lhs_dims = lhs.num_dimensions();
                     switch (lhs_dims)
                     {
@@ -941,6 +1029,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
             [this_](operands_type&& ops) -> primitive_argument_type
             {
+                if (std::any_of(ops.begin(), ops.end(),
+                        [](operand_type const& op) { return op.is_sparse(); }))
+                {
+                    return this_->mul_sparse(std::move(ops));
+                }
+
                 std::size_t lhs_dims = ops[0].num_dimensions();
                 switch (lhs_dims)
                 {
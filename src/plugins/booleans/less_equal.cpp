@@ -519,6 +519,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     less_equal_.name_, less_equal_.codename_));
         }
 
+        primitive_argument_type operator()(
+            ir::partitioned_array&&, ir::partitioned_array&&) const
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "less_equal::eval",
+                execution_tree::generate_error_message(
+                    "left hand side and right hand side are incompatible "
+                        "and can't be compared",
+                    less_equal_.name_, less_equal_.codename_));
+        }
+
         primitive_argument_type operator()(
             ir::node_data<double>&& lhs, ir::node_data<std::int64_t>&& rhs) const
         {
@@ -444,6 +444,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     or_.name_, or_.codename_));
         }
 
+        primitive_argument_type operator()(
+            ir::partitioned_array&&, ir::partitioned_array&&) const
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "or_operation::eval",
+                execution_tree::generate_error_message(
+                    "left hand side and right hand side can't be "
+                        "compared",
+                    or_.name_, or_.codename_));
+        }
+
         primitive_argument_type operator()(
             std::string lhs, std::string rhs) const
         {
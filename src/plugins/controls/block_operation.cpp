@@ -40,45 +40,70 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::vector<primitive_argument_type> && args,
         hpx::lcos::local::promise<primitive_argument_type> && result) const
     {
-        // skip statements that don't return anything
-        while (i != operands_.size() && !valid(operands_[i]))
-        {
-            if (i == operands_.size() - 1)
-            {
-                result.set_value(primitive_argument_type{});
-            }
-            ++i;
-        }
+        bool const trampoline = loop_trampolining_enabled();
 
-        if (i == operands_.size())
-            return;
-
-        auto this_ = this->shared_from_this();
-        auto f = value_operand(operands_[i], args, name_, codename_);
-        f.then(
-            hpx::launch::sync,
-            [this_, i, args = std::move(args), result = std::move(result)](
-                hpx::future<primitive_argument_type>&& step) mutable -> void
+        try
+        {
+            // evaluate statements in place as long as they are ready
+            for (/**/; i != operands_.size(); ++i)
             {
-                try
+                // skip statements that don't return anything
+                if (!valid(operands_[i]))
                 {
-                    // the value of the last step is returned
-                    if (i == this_->operands_.size() - 1)
+                    if (i == operands_.size() - 1)
                     {
-                        result.set_value(step.get());
-                        return;
+                        result.set_value(primitive_argument_type{});
                     }
+                    continue;
+                }
 
-                    step.get();    // rethrow exception
+                auto f = value_operand(operands_[i], args, name_, codename_);
+                if (!trampoline || !f.is_ready())
+                {
+                    auto this_ = this->shared_from_this();
+                    f.then(hpx::launch::sync,
+                        [this_, i, args = std::move(args),
+                            result = std::move(result)](
+                            hpx::future<primitive_argument_type>&& step) mutable
+                        -> void
+                        {
+                            try
+                            {
+                                // the value of the last step is returned
+                                if (i == this_->operands_.size() - 1)
+                                {
+                                    result.set_value(step.get());
+                                    return;
+                                }
 
-                    // trigger next step
-                    this_->next(i + 1, std::move(args), std::move(result));
+                                step.get();    // rethrow exception
+
+                                // trigger next step
+                                this_->next(
+                                    i + 1, std::move(args), std::move(result));
+                            }
+                            catch (...)
+                            {
+                                result.set_exception(std::current_exception());
+                            }
+                        });
+                    return;
                 }
-                catch (...)
+
+                // the value of the last step is returned
+                if (i == operands_.size() - 1)
                 {
-                    result.set_exception(std::current_exception());
+                    result.set_value(f.get());
+                    return;
                 }
-            });
+
+                f.get();    // rethrow exception
+            }
+        }
+        catch (...)
+        {
+            result.set_exception(std::current_exception());
+        }
     }
 
     hpx::future<primitive_argument_type> block_operation::eval(
@@ -71,30 +71,59 @@ namespace phylanx { namespace execution_tree { namespace primitives
             std::vector<primitive_argument_type> const& args)
         {
             this->args_ = args;
+
+            auto val = value_operand(
+                that_->operands_[0], args_, that_->name_, that_->codename_);
+            if (trampoline_ && val.is_ready())
+            {
+                val.get();
+                return loop();
+            }
+
             auto this_ = this->shared_from_this();
-            return value_operand(
-                that_->operands_[0], args_, that_->name_, that_->codename_)
-                    .then(hpx::launch::sync,
-                        [this_](hpx::future<primitive_argument_type>&& val)
-                          -> hpx::future<primitive_argument_type>
+            return val.then(hpx::launch::sync,
+                [this_](hpx::future<primitive_argument_type>&& val)
+                  -> hpx::future<primitive_argument_type>
                 {
                     val.get();
                     return this_->loop();
                 });
         }
 
+        // Iterate in place as long as the condition, the body, and the
+        // reinit statement are evaluated synchronously. The loop is suspended
+        // into a continuation only if one of them returns a future which is
+        // not ready yet.
         hpx::future<primitive_argument_type> loop()
         {
-            // Evaluate condition of for statement
-            auto this_ = this->shared_from_this();
-            return value_operand(
-                that_->operands_[1], args_, that_->name_, that_->codename_)
-                    .then(hpx::launch::sync,
+            while (true)
+            {
+                // Evaluate condition of for statement
+                auto cond = value_operand(
+                    that_->operands_[1], args_, that_->name_, that_->codename_);
+                if (!trampoline_ || !cond.is_ready())
+                {
+                    auto this_ = this->shared_from_this();
+                    return cond.then(hpx::launch::sync,
                         [this_](hpx::future<primitive_argument_type>&& cond)
                           -> hpx::future<primitive_argument_type>
+                        {
+                            return this_->body(std::move(cond));
+                        });
+                }
+
+                if (!extract_scalar_boolean_value(
+                        cond.get(), that_->name_, that_->codename_))
                 {
-                    return this_->body(std::move(cond));
-                });
+                    return hpx::make_ready_future(result_);
+                }
+
+                hpx::future<primitive_argument_type> next;
+                if (!step(next))
+                {
+                    return next;
+                }
+            }
         }
 
         hpx::future<primitive_argument_type> body(
@@ -103,18 +132,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
             if (extract_scalar_boolean_value(
                     cond.get(), that_->name_, that_->codename_))
             {
-                // Evaluate body of for statement
-                auto this_ = this->shared_from_this();
-                return value_operand(
-                    that_->operands_[3], args_, that_->name_, that_->codename_)
-                        .then(hpx::launch::sync,
-                            [this_](
-                                hpx::future<primitive_argument_type>&& result) mutable
-                            -> hpx::future<primitive_argument_type>
-                        {
-                            this_->result_ = result.get();
-                            return this_->reinit();    // Do the reinit statement
-                        });
+                hpx::future<primitive_argument_type> next;
+                if (!step(next))
+                {
+                    return next;
+                }
+                return loop();
             }
 
             return hpx::make_ready_future(result_);
@@ -122,22 +145,65 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         hpx::future<primitive_argument_type> reinit()
         {
-            auto this_ = this->shared_from_this();
-            return value_operand(
-                that_->operands_[2], args_, that_->name_, that_->codename_)
-                    .then(hpx::launch::sync,
-                        [this_](hpx::future<primitive_argument_type>&& val)
-                          -> hpx::future<primitive_argument_type>
-                {
-                    val.get();
-                    return this_->loop();   // Call the loop again
-                });
+            hpx::future<primitive_argument_type> next;
+            if (!reinit(next))
+            {
+                return next;
+            }
+            return loop();
         }
 
     private:
+        // Evaluate the body and the reinit statement, return false (and the
+        // future representing the continued loop) if one of those could not
+        // be evaluated synchronously.
+        bool step(hpx::future<primitive_argument_type>& next)
+        {
+            // Evaluate body of for statement
+            auto result = value_operand(
+                that_->operands_[3], args_, that_->name_, that_->codename_);
+            if (!trampoline_ || !result.is_ready())
+            {
+                auto this_ = this->shared_from_this();
+                next = result.then(hpx::launch::sync,
+                    [this_](hpx::future<primitive_argument_type>&& result)
+                      -> hpx::future<primitive_argument_type>
+                    {
+                        this_->result_ = result.get();
+                        return this_->reinit();    // Do the reinit statement
+                    });
+                return false;
+            }
+
+            result_ = result.get();
+            return reinit(next);
+        }
+
+        bool reinit(hpx::future<primitive_argument_type>& next)
+        {
+            auto val = value_operand(
+                that_->operands_[2], args_, that_->name_, that_->codename_);
+            if (!trampoline_ || !val.is_ready())
+            {
+                auto this_ = this->shared_from_this();
+                next = val.then(hpx::launch::sync,
+                    [this_](hpx::future<primitive_argument_type>&& val)
+                      -> hpx::future<primitive_argument_type>
+                    {
+                        val.get();
+                        return this_->loop();   // Call the loop again
+                    });
+                return false;
+            }
+
+            val.get();
+            return true;
+        }
+
         std::vector<primitive_argument_type> args_;
         primitive_argument_type result_;
         std::shared_ptr<for_operation const> that_;
+        bool const trampoline_ = loop_trampolining_enabled();
     };
 
     // Start iteration over given for statement
@@ -66,17 +66,38 @@ namespace phylanx { namespace execution_tree { namespace primitives
             }
         }
 
+        // Iterate in place as long as the condition and the body are
+        // evaluated synchronously. The loop is suspended into a continuation
+        // only if one of them returns a future which is not ready yet.
         hpx::future<primitive_argument_type> loop()
         {
-            // Evaluate condition of while statement
-            auto this_ = this->shared_from_this();
-            return literal_operand(
-                that_->operands_[0], args_, that_->name_, that_->codename_)
-                .then(hpx::launch::sync,
-                    [this_](hpx::future<primitive_argument_type>&& cond)
-                            -> hpx::future<primitive_argument_type> {
-                    return this_->body(std::move(cond));
-                });
+            while (true)
+            {
+                // Evaluate condition of while statement
+                auto cond = literal_operand(
+                    that_->operands_[0], args_, that_->name_, that_->codename_);
+                if (!trampoline_ || !cond.is_ready())
+                {
+                    auto this_ = this->shared_from_this();
+                    return cond.then(hpx::launch::sync,
+                        [this_](hpx::future<primitive_argument_type>&& cond)
+                                -> hpx::future<primitive_argument_type> {
+                            return this_->body(std::move(cond));
+                        });
+                }
+
+                if (!extract_scalar_boolean_value(
+                        cond.get(), that_->name_, that_->codename_))
+                {
+                    return hpx::make_ready_future(std::move(result_));
+                }
+
+                hpx::future<primitive_argument_type> next;
+                if (!step(next))
+                {
+                    return next;
+                }
+            }
         }
 
         hpx::future<primitive_argument_type> body(
@@ -85,26 +106,45 @@ namespace phylanx { namespace execution_tree { namespace primitives
             if (extract_scalar_boolean_value(
                     cond.get(), that_->name_, that_->codename_))
             {
-                // Evaluate body of while statement
+                hpx::future<primitive_argument_type> next;
+                if (!step(next))
+                {
+                    return next;
+                }
+                return loop();
+            }
+
+            return hpx::make_ready_future(std::move(result_));
+        }
+
+    private:
+        // Evaluate body of while statement, return false (and the future
+        // representing the continued loop) if it could not be evaluated
+        // synchronously.
+        bool step(hpx::future<primitive_argument_type>& next)
+        {
+            auto result = literal_operand(
+                that_->operands_[1], args_, that_->name_, that_->codename_);
+            if (!trampoline_ || !result.is_ready())
+            {
                 auto this_ = this->shared_from_this();
-                return literal_operand(
-                    that_->operands_[1], args_, that_->name_, that_->codename_)
-                    .then(hpx::launch::sync,
-                        [this_](hpx::future<primitive_argument_type>&&
-                                    result) mutable
+                next = result.then(hpx::launch::sync,
+                    [this_](hpx::future<primitive_argument_type>&& result)
                         -> hpx::future<primitive_argument_type> {
                         this_->result_ = result.get();
                         return this_->loop();
                     });
+                return false;
             }
 
-            return hpx::make_ready_future(std::move(result_));
+            result_ = result.get();
+            return true;
         }
 
-    private:
         std::vector<primitive_argument_type> args_;
         primitive_argument_type result_;
         std::shared_ptr<while_operation const> that_;
+        bool const trampoline_ = loop_trampolining_enabled();
     };
 
     // Start iteration over given while statement
@@ -0,0 +1,207 @@
+//  Copyright (c) 2018 Alireza Kheirkhahan
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+
+#if defined(PHYLANX_HAVE_HIGHFIVE)
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/fileio/file_fold_hdf5.hpp>
+#include <phylanx/plugins/fileio/hdf5_io.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const file_fold_hdf5::match_data =
+    {
+        hpx::util::make_tuple("file_fold_hdf5",
+            std::vector<std::string>{
+                "file_fold_hdf5(_1, _2, _3, _4)",
+                "file_fold_hdf5(_1, _2, _3, _4, _5)"
+            },
+            &create_file_fold_hdf5, &create_primitive<file_fold_hdf5>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    file_fold_hdf5::file_fold_hdf5(
+            std::vector<primitive_argument_type>&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // number of elements per block if no block size is given (8MB)
+        constexpr std::size_t default_fold_block_elements = 1048576;
+    }
+
+    hpx::future<primitive_argument_type> file_fold_hdf5::eval(
+        std::vector<primitive_argument_type> const& operands,
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands.size() != 4 && operands.size() != 5)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "file_fold_hdf5::eval",
+                execution_tree::generate_error_message(
+                    "the file_fold_hdf5 primitive requires four or five "
+                        "operands",
+                    name_, codename_));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]) ||
+            !valid(operands[2]) || !valid(operands[3]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "file_fold_hdf5::eval",
+                execution_tree::generate_error_message(
+                    "the file_fold_hdf5 primitive requires that the "
+                        "arguments given by the operands array are valid",
+                    name_, codename_));
+        }
+
+        // the first argument must be an invokable
+        primitive const* p = util::get_if<primitive>(&operands[0]);
+        if (p == nullptr)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "file_fold_hdf5::eval",
+                execution_tree::generate_error_message(
+                    "the first argument to file_fold_hdf5 must be an "
+                        "invocable object",
+                    name_, codename_));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::async, hpx::util::unwrapping(
+            [this_](primitive_argument_type&& bound_func,
+                    primitive_argument_type&& initial,
+                    std::string&& filename, std::string&& dataset_name,
+                    primitive_argument_type&& block_size)
+            -> primitive_argument_type
+            {
+                std::vector<std::size_t> dims =
+                    detail::hdf5_dataset_dimensions(filename, dataset_name)
+                        .get();
+
+                if (dims.size() > 2)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "file_fold_hdf5::eval",
+                        execution_tree::generate_error_message(
+                            "the input file has incompatible number of "
+                                "dimensions",
+                            this_->name_, this_->codename_));
+                }
+
+                auto apply = [&](ir::node_data<double>&& block)
+                {
+                    std::vector<primitive_argument_type> args(2);
+                    args[0] = std::move(initial);
+                    args[1] = primitive_argument_type{std::move(block)};
+
+                    initial = value_operand_sync(bound_func, std::move(args),
+                        this_->name_, this_->codename_);
+                };
+
+                // a scalar dataset consists of exactly one block
+                if (dims.empty())
+                {
+                    apply(detail::read_hdf5(filename, dataset_name,
+                        detail::hdf5_hyperslab{}, this_->name_,
+                        this_->codename_).get());
+                    return primitive_argument_type{std::move(initial)};
+                }
+
+                std::size_t const rows = dims[0];
+                std::size_t const columns = dims.size() == 2 ? dims[1] : 1;
+
+                std::size_t block_rows = 0;
+                if (valid(block_size))
+                {
+                    std::int64_t size = extract_scalar_integer_value(
+                        block_size, this_->name_, this_->codename_);
+                    if (size <= 0)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "file_fold_hdf5::eval",
+                            execution_tree::generate_error_message(
+                                "the number of rows per block must be "
+                                    "positive",
+                                this_->name_, this_->codename_));
+                    }
+                    block_rows = std::size_t(size);
+                }
+                else
+                {
+                    block_rows = (std::max)(std::size_t(1),
+                        detail::default_fold_block_elements /
+                            (std::max)(columns, std::size_t(1)));
+                }
+
+                auto read_block = [&](std::size_t first)
+                {
+                    detail::hdf5_hyperslab slab;
+                    slab.offset.push_back(first);
+                    slab.count.push_back((std::min)(block_rows, rows - first));
+                    return detail::read_hdf5(filename, dataset_name, slab,
+                        this_->name_, this_->codename_);
+                };
+
+                if (rows == 0 || columns == 0)
+                {
+                    return primitive_argument_type{std::move(initial)};
+                }
+
+                // read the next block while the current one is being folded
+                hpx::future<ir::node_data<double>> next = read_block(0);
+                for (std::size_t first = 0; first < rows; first += block_rows)
+                {
+                    ir::node_data<double> block = next.get();
+                    if (rows - first > block_rows)
+                    {
+                        next = read_block(first + block_rows);
+                    }
+                    apply(std::move(block));
+                }
+
+                return primitive_argument_type{std::move(initial)};
+            }),
+            p->bind(args),
+            value_operand(operands[1], args, name_, codename_),
+            string_operand(operands[2], args, name_, codename_),
+            string_operand(operands[3], args, name_, codename_),
+            operands.size() == 5 ?
+                value_operand(operands[4], args, name_, codename_) :
+                hpx::make_ready_future(primitive_argument_type{}));
+    }
+
+    hpx::future<primitive_argument_type> file_fold_hdf5::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return eval(args, noargs);
+        }
+        return eval(operands_, args);
+    }
+}}}
+
+#endif
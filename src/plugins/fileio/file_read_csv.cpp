@@ -9,6 +9,7 @@
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
+#include <hpx/include/runtime.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/throw_exception.hpp>
 
@@ -18,15 +19,226 @@
 #include <boost/spirit/include/qi_parse.hpp>
 #include <boost/spirit/include/qi_real.hpp>
 
+#include <algorithm>
 #include <cstddef>
-#include <fstream>
+#include <cstring>
 #include <string>
 #include <utility>
 #include <vector>
 
+#if defined(HPX_WINDOWS)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 namespace phylanx { namespace execution_tree { namespace primitives
 {
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Read-only memory mapping of a whole file
+        class mapped_file
+        {
+        public:
+            explicit mapped_file(std::string const& filename)
+            {
+#if defined(HPX_WINDOWS)
+                file_ = ::CreateFileA(filename.c_str(), GENERIC_READ,
+                    FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                    nullptr);
+                if (file_ == INVALID_HANDLE_VALUE)
+                {
+                    return;
+                }
+
+                LARGE_INTEGER size;
+                if (!::GetFileSizeEx(file_, &size))
+                {
+                    return;
+                }
+                size_ = std::size_t(size.QuadPart);
+                is_open_ = true;
+
+                if (size_ != 0)
+                {
+                    mapping_ = ::CreateFileMappingA(
+                        file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if (mapping_ != nullptr)
+                    {
+                        data_ = static_cast<char const*>(::MapViewOfFile(
+                            mapping_, FILE_MAP_READ, 0, 0, 0));
+                    }
+                    is_open_ = data_ != nullptr;
+                }
+#else
+                fd_ = ::open(filename.c_str(), O_RDONLY);
+                if (fd_ == -1)
+                {
+                    return;
+                }
+
+                struct stat st;
+                if (::fstat(fd_, &st) == -1)
+                {
+                    return;
+                }
+                size_ = std::size_t(st.st_size);
+                is_open_ = true;
+
+                if (size_ != 0)
+                {
+                    void* p = ::mmap(
+                        nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+                    if (p == MAP_FAILED)
+                    {
+                        is_open_ = false;
+                        return;
+                    }
+                    ::madvise(p, size_, MADV_SEQUENTIAL);
+                    data_ = static_cast<char const*>(p);
+                }
+#endif
+            }
+
+            mapped_file(mapped_file const&) = delete;
+            mapped_file& operator=(mapped_file const&) = delete;
+
+            ~mapped_file()
+            {
+#if defined(HPX_WINDOWS)
+                if (data_ != nullptr)
+                {
+                    ::UnmapViewOfFile(data_);
+                }
+                if (mapping_ != nullptr)
+                {
+                    ::CloseHandle(mapping_);
+                }
+                if (file_ != INVALID_HANDLE_VALUE)
+                {
+                    ::CloseHandle(file_);
+                }
+#else
+                if (data_ != nullptr)
+                {
+                    ::munmap(const_cast<char*>(data_), size_);
+                }
+                if (fd_ != -1)
+                {
+                    ::close(fd_);
+                }
+#endif
+            }
+
+            bool is_open() const { return is_open_; }
+            char const* data() const { return data_; }
+            std::size_t size() const { return data_ != nullptr ? size_ : 0; }
+
+        private:
+#if defined(HPX_WINDOWS)
+            HANDLE file_ = INVALID_HANDLE_VALUE;
+            HANDLE mapping_ = nullptr;
+#else
+            int fd_ = -1;
+#endif
+            char const* data_ = nullptr;
+            std::size_t size_ = 0;
+            bool is_open_ = false;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // A range of complete lines of the file
+        struct chunk
+        {
+            char const* begin;
+            char const* end;
+            std::size_t first_row;
+        };
+
+        // chunks are not made smaller than this to keep the overheads low
+        constexpr std::size_t min_chunk_size = 1024 * 1024;
+
+        std::size_t max_chunk_count(std::size_t size)
+        {
+            std::size_t count = (std::min)(size / min_chunk_size,
+                std::size_t(4 * hpx::get_os_thread_count()));
+            return (std::max)(count, std::size_t(1));
+        }
+
+        char const* end_of_line(char const* p, char const* end)
+        {
+            char const* eol = static_cast<char const*>(
+                std::memchr(p, '\n', std::size_t(end - p)));
+            return eol != nullptr ? eol : end;
+        }
+
+        char const* next_line(char const* eol, char const* end)
+        {
+            return eol != end ? eol + 1 : end;
+        }
+
+        std::vector<chunk> split_into_chunks(
+            char const* begin, char const* end, std::size_t count)
+        {
+            std::vector<chunk> chunks;
+            chunks.reserve(count);
+
+            std::size_t chunk_size = std::size_t(end - begin) / count;
+            char const* p = begin;
+            for (std::size_t i = 1; i < count && p != end; ++i)
+            {
+                char const* split = begin + i * chunk_size;
+                if (split <= p)
+                {
+                    continue;
+                }
+                char const* chunk_end = next_line(end_of_line(split, end), end);
+                chunks.push_back(chunk{p, chunk_end, 0});
+                p = chunk_end;
+            }
+            if (p != end)
+            {
+                chunks.push_back(chunk{p, end, 0});
+            }
+            return chunks;
+        }
+
+        // the last line doesn't need to be terminated by a newline
+        std::size_t count_lines(char const* begin, char const* end)
+        {
+            if (begin == end)
+            {
+                return 0;
+            }
+            std::size_t count = std::count(begin, end, '\n');
+            return end[-1] == '\n' ? count : count + 1;
+        }
+
+        // parse one line of comma separated values, a trailing '\r' (for
+        // files with Windows line endings) is ignored
+        bool parse_line(char const*& p, char const* eol,
+            std::vector<double>& values)
+        {
+            if (p != eol && eol[-1] == '\r')
+            {
+                --eol;
+            }
+            return boost::spirit::qi::parse(
+                p, eol, boost::spirit::qi::double_ % ',', values);
+        }
+
+        bool parsed_completely(char const* p, char const* eol)
+        {
+            return p == eol || (p + 1 == eol && *p == '\r');
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     match_pattern_type const file_read_csv::match_data =
     {
@@ -70,9 +282,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         std::string filename =
             string_operand_sync(operands_[0], args, name_, codename_);
-        std::ifstream infile(filename.c_str(), std::ios::in);
 
-        if (!infile.is_open())
+        detail::mapped_file file(filename);
+        if (!file.is_open())
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "phylanx::execution_tree::primitives::file_read_csv::eval",
@@ -81,56 +293,112 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     name_, codename_));
         }
 
-        std::string line;
-        bool header_parsed = false;
-        std::vector<double> matrix_array, current_line;
-        std::size_t n_rows = 0, n_cols = 0;
-        std::size_t before_readln = 0, after_readln = 0;
+        char const* const begin = file.data();
+        char const* const end = begin + file.size();
 
-        while (std::getline(infile, line))
+        // skip leading lines which can't be parsed completely (header)
+        std::vector<double> current_line;
+        char const* data = begin;
+        while (data != end)
         {
-            before_readln = matrix_array.size();
-
-            auto begin_local = line.begin();
-            if (boost::spirit::qi::parse(begin_local, line.end(),
-                    boost::spirit::qi::double_ % ',', current_line))
-            {
-                if (begin_local == line.end() || header_parsed)
-                {
-                    header_parsed = true;
+            char const* eol = detail::end_of_line(data, end);
 
-                    matrix_array.insert(matrix_array.end(),
-                        current_line.begin(), current_line.end());
-
-                    after_readln = matrix_array.size();
-                    if (n_rows == 0)
-                    {
-                        n_cols = matrix_array.size();
-                    }
-                    else if (n_cols != (after_readln - before_readln))
-                    {
-                        HPX_THROW_EXCEPTION(hpx::invalid_data,
-                            "phylanx::execution_tree::primitives::"
-                                "file_read_csv::eval",
-                            execution_tree::generate_error_message(
-                                "wrong data format, different number of "
-                                    "element in this row " +
-                                    filename + ':' + std::to_string(n_rows),
-                                name_, codename_));
-                    }
-                    n_rows++;
-                }
-                current_line.clear();
-            }
-            else
+            char const* p = data;
+            current_line.clear();
+            if (!detail::parse_line(p, eol, current_line))
             {
                 HPX_THROW_EXCEPTION(hpx::invalid_data,
                     "phylanx::execution_tree::primitives::file_read_csv::eval",
                     execution_tree::generate_error_message(
-                        "wrong data format " + filename + ':' +
-                            std::to_string(n_rows),
+                        "wrong data format " + filename + ":0",
                         name_, codename_));
             }
+
+            if (detail::parsed_completely(p, eol))
+            {
+                break;
+            }
+            data = detail::next_line(eol, end);
+        }
+
+        // the first data line determines the number of columns
+        std::size_t const n_cols = data != end ? current_line.size() : 0;
+
+        // split the data into newline-aligned chunks and count the lines of
+        // each of them to determine the rows the chunks start with
+        std::vector<detail::chunk> chunks = detail::split_into_chunks(
+            data, end, detail::max_chunk_count(std::size_t(end - data)));
+
+        std::vector<hpx::future<std::size_t>> line_counts;
+        line_counts.reserve(chunks.size());
+        for (auto const& c : chunks)
+        {
+            line_counts.push_back(hpx::async(
+                [c]() { return detail::count_lines(c.begin, c.end); }));
+        }
+
+        std::size_t n_rows = 0;
+        for (std::size_t i = 0; i != chunks.size(); ++i)
+        {
+            chunks[i].first_row = n_rows;
+            n_rows += line_counts[i].get();
+        }
+
+        // parse all chunks concurrently, directly into the result
+        blaze::DynamicMatrix<double> matrix(n_rows, n_cols);
+
+        std::vector<hpx::future<void>> parsed;
+        parsed.reserve(chunks.size());
+        for (auto const& c : chunks)
+        {
+            parsed.push_back(hpx::async(
+                [&, c]()
+                {
+                    std::vector<double> line_data;
+                    line_data.reserve(n_cols);
+
+                    std::size_t row = c.first_row;
+                    for (char const* p = c.begin; p != c.end; ++row)
+                    {
+                        char const* eol = detail::end_of_line(p, c.end);
+
+                        line_data.clear();
+                        if (!detail::parse_line(p, eol, line_data))
+                        {
+                            HPX_THROW_EXCEPTION(hpx::invalid_data,
+                                "phylanx::execution_tree::primitives::"
+                                    "file_read_csv::eval",
+                                execution_tree::generate_error_message(
+                                    "wrong data format " + filename + ':' +
+                                        std::to_string(row),
+                                    name_, codename_));
+                        }
+
+                        if (line_data.size() != n_cols)
+                        {
+                            HPX_THROW_EXCEPTION(hpx::invalid_data,
+                                "phylanx::execution_tree::primitives::"
+                                    "file_read_csv::eval",
+                                execution_tree::generate_error_message(
+                                    "wrong data format, different number of "
+                                        "element in this row " +
+                                        filename + ':' + std::to_string(row),
+                                    name_, codename_));
+                        }
+
+                        std::copy(line_data.begin(), line_data.end(),
+                            matrix.begin(row));
+
+                        p = detail::next_line(eol, c.end);
+                    }
+                }));
+        }
+
+        // rethrow the first exception, if any
+        hpx::wait_all(parsed);
+        for (auto& f : parsed)
+        {
+            f.get();
         }
 
         if (n_rows == 1)
@@ -139,20 +407,18 @@ namespace phylanx { namespace execution_tree { namespace primitives
             {
                 // scalar value
                 return hpx::make_ready_future(primitive_argument_type{
-                    ir::node_data<double>{matrix_array[0]}});
+                    ir::node_data<double>{matrix(0, 0)}});
             }
 
             // vector
-            blaze::DynamicVector<double> vector(n_cols, matrix_array.data());
+            blaze::DynamicVector<double> vector =
+                blaze::trans(blaze::row(matrix, 0));
 
             return hpx::make_ready_future(primitive_argument_type{
                 ir::node_data<double>{std::move(vector)}});
         }
 
         // matrix
-        blaze::DynamicMatrix<double> matrix(
-            n_rows, n_cols, matrix_array.data());
-
         return hpx::make_ready_future(
             primitive_argument_type{ir::node_data<double>{std::move(matrix)}});
     }
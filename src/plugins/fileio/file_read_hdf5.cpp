@@ -8,19 +8,15 @@
 #if defined(PHYLANX_HAVE_HIGHFIVE)
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/fileio/file_read_hdf5.hpp>
+#include <phylanx/plugins/fileio/hdf5_io.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/throw_exception.hpp>
 
-#include <phylanx/util/detail/blaze-highfive.hpp>
-#include <highfive/H5DataSet.hpp>
-#include <highfive/H5DataSpace.hpp>
-#include <highfive/H5File.hpp>
-
 #include <cstddef>
-#include <fstream>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -32,7 +28,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
     match_pattern_type const file_read_hdf5::match_data =
     {
         hpx::util::make_tuple("file_read_hdf5",
-            std::vector<std::string>{"file_read_hdf5(_1, _2)"},
+            std::vector<std::string>{
+                "file_read_hdf5(_1, _2)",
+                "file_read_hdf5(_1, _2, _3)",
+                "file_read_hdf5(_1, _2, _3, _4)",
+                "file_read_hdf5(_1, _2, _3, _4, _5)"
+            },
             &create_file_read_hdf5, &create_primitive<file_read_hdf5>)
     };
 
@@ -44,21 +45,23 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {
     }
 
-    // read data from given file and return content
+    // read data from given file and return content, the optional operands
+    // select a hyperslab (offset, count, stride) of the dataset
     hpx::future<primitive_argument_type> file_read_hdf5::eval(
+        std::vector<primitive_argument_type> const& operands,
         std::vector<primitive_argument_type> const& args) const
     {
-        if (operands_.size() != 2)
+        if (operands.size() < 2 || operands.size() > 5)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "phylanx::execution_tree::primitives::file_read_hdf5::eval",
                 execution_tree::generate_error_message(
-                    "the file_read_hdf5 primitive requires exactly two "
-                        "literal arguments",
+                    "the file_read_hdf5 primitive requires two to five "
+                        "operands",
                     name_, codename_));
         }
 
-        if (!valid(operands_[0]) || !valid(operands_[1]))
+        if (!valid(operands[0]) || !valid(operands[1]))
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "phylanx::execution_tree::primitives::file_read_hdf5::eval",
@@ -68,53 +71,53 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     name_, codename_));
         }
 
-        std::string filename =
-            string_operand_sync(operands_[0], args, name_, codename_);
-        std::string datasetName =
-            string_operand_sync(operands_[1], args, name_, codename_);
-
-        HighFive::File infile(filename, HighFive::File::ReadOnly);
-        HighFive::DataSet dataSet = infile.getDataSet(datasetName);
-        HighFive::DataSpace dataSpace = dataSet.getSpace();
-
-        switch (dataSpace.getNumberDimensions())
-        {
-        case 0:
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_](std::vector<primitive_argument_type>&& ops)
+            ->  hpx::future<primitive_argument_type>
             {
-                // scalar value
-                double scalar;
-                dataSet.read(scalar);
-                return hpx::make_ready_future(
-                    primitive_argument_type{ir::node_data<double>{scalar}});
-            }
-
-        case 1:
-            {
-                // vector
-                std::vector<std::size_t> dims = dataSpace.getDimensions();
-                blaze::DynamicVector<double> vector(dims[0]);
-                dataSet.read(vector);
-                return hpx::make_ready_future(primitive_argument_type{
-                    ir::node_data<double>{std::move(vector)}});
-            }
-
-        case 2:
-            {
-                // matrix
-                std::vector<std::size_t> dims = dataSpace.getDimensions();
-                blaze::DynamicMatrix<double> matrix(dims[0], dims[1]);
-                dataSet.read(matrix);
-                return hpx::make_ready_future(primitive_argument_type{
-                    ir::node_data<double>{std::move(matrix)}});
-            }
+                std::string filename = extract_string_value(
+                    std::move(ops[0]), this_->name_, this_->codename_);
+                std::string dataset_name = extract_string_value(
+                    std::move(ops[1]), this_->name_, this_->codename_);
+
+                detail::hdf5_hyperslab slab;
+                if (ops.size() > 2)
+                {
+                    slab.offset = detail::extract_hyperslab_extents(
+                        ops[2], this_->name_, this_->codename_);
+                }
+                if (ops.size() > 3)
+                {
+                    slab.count = detail::extract_hyperslab_extents(
+                        ops[3], this_->name_, this_->codename_);
+                }
+                if (ops.size() > 4)
+                {
+                    slab.stride = detail::extract_hyperslab_extents(
+                        ops[4], this_->name_, this_->codename_);
+                }
+
+                return detail::read_hdf5(filename, dataset_name, slab,
+                        this_->name_, this_->codename_)
+                    .then(hpx::launch::sync,
+                        [](hpx::future<ir::node_data<double>>&& f)
+                        {
+                            return primitive_argument_type{f.get()};
+                        });
+            }),
+            detail::map_operands(
+                operands, functional::value_operand{}, args, name_, codename_));
+    }
 
-        default:
-            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                "phylanx::execution_tree::primitives::file_read_hdf5::eval",
-                execution_tree::generate_error_message(
-                    "the input file has incompatible number of dimensions",
-                    name_, codename_));
+    hpx::future<primitive_argument_type> file_read_hdf5::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return eval(args, noargs);
         }
+        return eval(operands_, args);
     }
 }}}
 
@@ -57,42 +57,20 @@ namespace phylanx { namespace execution_tree { namespace primitives
             std::numeric_limits<long double>::digits10 + 1);
         outfile << std::scientific;
 
-        switch (val.num_dimensions())
-        {
-        case 0:
-            outfile << val.scalar() << '\n';
-            break;
-
-        case 1:
+        // scalars and vectors are written as a single line
+        val.for_each_row(
+            [&](double const* data, std::size_t size)
             {
-                auto v = val.vector();
-                for (std::size_t i = 0UL; i != v.size(); ++i)
+                for (std::size_t i = 0UL; i != size; ++i)
                 {
                     if (i != 0)
                     {
                         outfile << ',';
                     }
-                    outfile << v[i];
+                    outfile << data[i];
                 }
                 outfile << '\n';
-            }
-            break;
-
-        case 2:
-            {
-                auto matrix = val.matrix();
-                for (std::size_t i = 0UL; i != matrix.rows(); ++i)
-                {
-                    outfile << matrix(i, 0);
-                    for (std::size_t j = 1UL; j != matrix.columns(); ++j)
-                    {
-                        outfile << ',' << matrix(i, j);
-                    }
-                    outfile << '\n';
-                }
-            }
-            break;
-        }
+            });
     }
 
     hpx::future<primitive_argument_type> file_write_csv::eval(
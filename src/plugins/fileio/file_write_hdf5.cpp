@@ -8,19 +8,14 @@
 #if defined(PHYLANX_HAVE_HIGHFIVE)
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/fileio/file_write_hdf5.hpp>
+#include <phylanx/plugins/fileio/hdf5_io.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/throw_exception.hpp>
 
-#include <highfive/H5File.hpp>
-#include <highfive/H5DataSet.hpp>
-#include <highfive/H5DataSpace.hpp>
-#include <phylanx/util/detail/blaze-highfive.hpp>
-
 #include <cstddef>
-#include <fstream>
 #include <memory>
 #include <string>
 #include <vector>
@@ -34,7 +29,10 @@ namespace phylanx { namespace execution_tree { namespace primitives
     match_pattern_type const file_write_hdf5::match_data =
     {
         hpx::util::make_tuple("file_write_hdf5",
-            std::vector<std::string>{"file_write_hdf5(_1, _2, _3)"},
+            std::vector<std::string>{
+                "file_write_hdf5(_1, _2, _3)",
+                "file_write_hdf5(_1, _2, _3, _4)"
+            },
             &create_file_write_hdf5, &create_primitive<file_write_hdf5>)
     };
 
@@ -46,62 +44,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {
     }
 
-    void file_write_hdf5::write_to_file_hdf5(ir::node_data<double> const& val,
-        std::string const& filename, std::string const& dataset_name) const
-    {
-        HighFive::File outfile(filename,
-            HighFive::File::ReadWrite | HighFive::File::Create |
-                HighFive::File::Truncate);
-
-        switch (val.num_dimensions())
-        {
-        case 0:
-            {
-                auto scalar = val.scalar();
-                HighFive::DataSet dataSet =
-                    outfile.createDataSet<double>(
-                        dataset_name, HighFive::DataSpace::From(scalar));
-                dataSet.write(scalar);
-            }
-            break;
-
-        case 1:
-            {
-                auto vector = val.vector();
-                std::vector<std::size_t> dims(1);
-                dims[0] = vector.size();
-                HighFive::DataSet dataSet =
-                    outfile.createDataSet<double>(
-                        dataset_name, HighFive::DataSpace(dims));
-                dataSet.write(vector);
-            }
-            break;
-
-        case 2:
-            {
-                auto matrix = val.matrix();
-                std::vector<std::size_t> dims(2);
-                dims[0] = matrix.rows();
-                dims[1] = matrix.columns();
-                HighFive::DataSet dataSet =
-                    outfile.createDataSet<double>(
-                        dataset_name, HighFive::DataSpace(dims));
-                dataSet.write(matrix);
-            }
-            break;
-        }
-    }
-
     hpx::future<primitive_argument_type> file_write_hdf5::eval(
         std::vector<primitive_argument_type> const& operands,
         std::vector<primitive_argument_type> const& args) const
     {
-        if (operands.size() != 3)
+        if (operands.size() != 3 && operands.size() != 4)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "phylanx::execution_tree::primitives::file_write::file_write_hdf5",
                 execution_tree::generate_error_message(
-                    "the file_write primitive requires exactly three operands",
+                    "the file_write primitive requires three or four "
+                        "operands",
                     name_, codename_));
         }
 
@@ -116,33 +69,45 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     name_, codename_));
         }
 
-        std::string filename =
-            string_operand_sync(operands[0], args, name_, codename_);
-        std::string dataset_name =
-            string_operand_sync(operands[1], args, name_, codename_);
-
+        // the optional fourth operand is the offset at which the data is
+        // written into an existing dataset
         auto this_ = this->shared_from_this();
-        return numeric_operand(operands[2], args, name_, codename_)
-            .then(hpx::launch::sync, hpx::util::unwrapping(
-                [this_, filename = std::move(filename),
-                    dataset_name = std::move(dataset_name)](
-                    ir::node_data<double>&& val) -> primitive_argument_type
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_](std::string&& filename, std::string&& dataset_name,
+                ir::node_data<double>&& val, primitive_argument_type&& offset)
+            ->  hpx::future<primitive_argument_type>
+            {
+                if (!valid(val))
                 {
-                    if (!valid(val))
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "file_write_hdf5::eval",
+                        execution_tree::generate_error_message(
+                            "the file_write_hdf5 primitive requires that "
+                            "the argument value given by the operand is "
+                            "non-empty",
+                            this_->name_, this_->codename_));
+                }
+
+                std::vector<std::size_t> offsets =
+                    detail::extract_hyperslab_extents(
+                        offset, this_->name_, this_->codename_);
+
+                hpx::future<void> f = detail::write_hdf5(val, filename,
+                    dataset_name, offsets, this_->name_, this_->codename_);
+
+                return f.then(hpx::launch::sync,
+                    [val = std::move(val)](hpx::future<void>&& f) mutable
                     {
-                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                            "file_write_hdf5::eval",
-                            execution_tree::generate_error_message(
-                                "the file_write_hdf5 primitive requires that "
-                                "the argument value given by the operand is "
-                                "non-empty",
-                                this_->name_, this_->codename_));
-                    }
-
-                    this_->write_to_file_hdf5(val, std::move(filename),
-                        std::move(dataset_name));
-                    return primitive_argument_type(std::move(val));
-                }));
+                        f.get();        // propagate exceptions
+                        return primitive_argument_type(std::move(val));
+                    });
+            }),
+            string_operand(operands[0], args, name_, codename_),
+            string_operand(operands[1], args, name_, codename_),
+            numeric_operand(operands[2], args, name_, codename_),
+            operands.size() == 4 ?
+                value_operand(operands[3], args, name_, codename_) :
+                hpx::make_ready_future(primitive_argument_type{}));
     }
 
     ///////////////////////////////////////////////////////////////////////////
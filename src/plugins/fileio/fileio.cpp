@@ -23,4 +23,6 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(file_read_hdf5_plugin,
     phylanx::execution_tree::primitives::file_read_hdf5::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(file_write_hdf5_plugin,
     phylanx::execution_tree::primitives::file_write_hdf5::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(file_fold_hdf5_plugin,
+    phylanx::execution_tree::primitives::file_fold_hdf5::match_data);
 #endif
@@ -0,0 +1,393 @@
+//  Copyright (c) 2018 Alireza Kheirkhahan
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+
+#if defined(PHYLANX_HAVE_HIGHFIVE)
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/ir/ranges.hpp>
+#include <phylanx/plugins/fileio/hdf5_io.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/runtime/threads/run_as_os_thread.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <phylanx/util/detail/blaze-highfive.hpp>
+#include <highfive/H5DataSet.hpp>
+#include <highfive/H5DataSpace.hpp>
+#include <highfive/H5File.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        std::vector<std::size_t> extract_hyperslab_extents(
+            primitive_argument_type const& val, std::string const& name,
+            std::string const& codename)
+        {
+            std::vector<std::size_t> result;
+            if (!valid(val))
+            {
+                return result;      // nil selects the default
+            }
+
+            auto append = [&](std::int64_t extent)
+            {
+                if (extent < 0)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "phylanx::execution_tree::primitives::detail::"
+                            "extract_hyperslab_extents",
+                        execution_tree::generate_error_message(
+                            "the offset, count, and stride of a hyperslab "
+                                "must not be negative",
+                            name, codename));
+                }
+                result.push_back(std::size_t(extent));
+            };
+
+            if (is_list_operand(val))
+            {
+                for (auto const& elem : extract_list_value(val, name, codename))
+                {
+                    append(extract_scalar_integer_value(elem, name, codename));
+                }
+                return result;
+            }
+
+            ir::node_data<std::int64_t> extents =
+                extract_integer_value(val, name, codename);
+            if (extents.num_dimensions() > 1)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::detail::"
+                        "extract_hyperslab_extents",
+                    execution_tree::generate_error_message(
+                        "the offset, count, and stride of a hyperslab must "
+                            "be given as a scalar or a vector",
+                        name, codename));
+            }
+
+            for (std::int64_t extent : extents)
+            {
+                append(extent);
+            }
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // HDF5 is not guaranteed to be thread-safe, all accesses to it are
+        // serialized
+        std::mutex& hdf5_mutex()
+        {
+            static std::mutex mtx;
+            return mtx;
+        }
+
+        // Run the given (blocking) function on a thread of the HPX I/O pool,
+        // continuations attached to the returned future run on the HPX worker
+        // threads again.
+        template <typename F>
+        auto run_hdf5_io(F && f)
+        ->  hpx::future<decltype(f())>
+        {
+            using result_type = decltype(f());
+
+            return hpx::threads::run_as_os_thread(
+                    [f = std::forward<F>(f)]() mutable -> result_type
+                    {
+                        std::lock_guard<std::mutex> l(hdf5_mutex());
+                        return f();
+                    })
+                .then(hpx::launch::async,
+                    [](hpx::future<result_type>&& f) -> result_type
+                    {
+                        return f.get();
+                    });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Fill in the default values of the given hyperslab and verify that
+        // it lies inside of the dataset
+        void resolve_hyperslab(hdf5_hyperslab& slab,
+            std::vector<std::size_t> const& dims, std::string const& name,
+            std::string const& codename)
+        {
+            std::size_t const num_dims = dims.size();
+            if (slab.offset.size() > num_dims ||
+                slab.count.size() > num_dims || slab.stride.size() > num_dims)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::detail::"
+                        "resolve_hyperslab",
+                    execution_tree::generate_error_message(
+                        "the given hyperslab has more dimensions than the "
+                            "dataset",
+                        name, codename));
+            }
+
+            slab.offset.resize(num_dims, 0);
+            slab.stride.resize(num_dims, 1);
+
+            std::size_t const given_counts = slab.count.size();
+            slab.count.resize(num_dims);
+
+            for (std::size_t i = 0; i != num_dims; ++i)
+            {
+                std::size_t const offset = slab.offset[i];
+                std::size_t const stride = slab.stride[i];
+
+                if (stride == 0 || offset >= dims[i])
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "phylanx::execution_tree::primitives::detail::"
+                            "resolve_hyperslab",
+                        execution_tree::generate_error_message(
+                            "the given hyperslab has a zero stride or an "
+                                "offset outside of the dataset",
+                            name, codename));
+                }
+
+                if (i >= given_counts)
+                {
+                    slab.count[i] = (dims[i] - offset + stride - 1) / stride;
+                }
+
+                std::size_t const count = slab.count[i];
+                if (count == 0 || (count - 1) * stride >= dims[i] - offset)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "phylanx::execution_tree::primitives::detail::"
+                            "resolve_hyperslab",
+                        execution_tree::generate_error_message(
+                            "the given hyperslab is empty or extends beyond "
+                                "the bounds of the dataset",
+                            name, codename));
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        hpx::future<std::vector<std::size_t>> hdf5_dataset_dimensions(
+            std::string const& filename, std::string const& dataset_name)
+        {
+            return run_hdf5_io(
+                [=]() -> std::vector<std::size_t>
+                {
+                    HighFive::File infile(filename, HighFive::File::ReadOnly);
+                    return infile.getDataSet(dataset_name)
+                        .getSpace()
+                        .getDimensions();
+                });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        ir::node_data<double> read_hdf5_sync(std::string const& filename,
+            std::string const& dataset_name, hdf5_hyperslab slab,
+            std::string const& name, std::string const& codename)
+        {
+            HighFive::File infile(filename, HighFive::File::ReadOnly);
+            HighFive::DataSet dataSet = infile.getDataSet(dataset_name);
+            std::vector<std::size_t> dims = dataSet.getSpace().getDimensions();
+
+            if (dims.size() > 2)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::detail::read_hdf5",
+                    execution_tree::generate_error_message(
+                        "the input file has incompatible number of "
+                            "dimensions",
+                        name, codename));
+            }
+
+            if (slab.empty())
+            {
+                switch (dims.size())
+                {
+                case 0:
+                    {
+                        // scalar value
+                        double scalar;
+                        dataSet.read(scalar);
+                        return ir::node_data<double>{scalar};
+                    }
+
+                case 1:
+                    {
+                        // vector
+                        blaze::DynamicVector<double> vector(dims[0]);
+                        dataSet.read(vector);
+                        return ir::node_data<double>{std::move(vector)};
+                    }
+
+                default:
+                    {
+                        // matrix
+                        blaze::DynamicMatrix<double> matrix(dims[0], dims[1]);
+                        dataSet.read(matrix);
+                        return ir::node_data<double>{std::move(matrix)};
+                    }
+                }
+            }
+
+            resolve_hyperslab(slab, dims, name, codename);
+
+            HighFive::Selection selection =
+                dataSet.select(slab.offset, slab.count, slab.stride);
+
+            if (dims.size() == 1)
+            {
+                blaze::DynamicVector<double> vector(slab.count[0]);
+                selection.read(vector);
+                return ir::node_data<double>{std::move(vector)};
+            }
+
+            blaze::DynamicMatrix<double> matrix(slab.count[0], slab.count[1]);
+            selection.read(matrix);
+            return ir::node_data<double>{std::move(matrix)};
+        }
+
+        hpx::future<ir::node_data<double>> read_hdf5(
+            std::string const& filename, std::string const& dataset_name,
+            hdf5_hyperslab const& slab, std::string const& name,
+            std::string const& codename)
+        {
+            return run_hdf5_io(
+                [=]() -> ir::node_data<double>
+                {
+                    return read_hdf5_sync(
+                        filename, dataset_name, slab, name, codename);
+                });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // create the dataset covering the whole of the given data
+        void create_hdf5_sync(ir::node_data<double> const& val,
+            std::string const& filename, std::string const& dataset_name)
+        {
+            HighFive::File outfile(filename,
+                HighFive::File::ReadWrite | HighFive::File::Create |
+                    HighFive::File::Truncate);
+
+            switch (val.num_dimensions())
+            {
+            case 0:
+                {
+                    auto scalar = val.scalar();
+                    HighFive::DataSet dataSet =
+                        outfile.createDataSet<double>(
+                            dataset_name, HighFive::DataSpace::From(scalar));
+                    dataSet.write(scalar);
+                }
+                break;
+
+            case 1:
+                {
+                    auto vector = val.vector();
+                    std::vector<std::size_t> dims(1);
+                    dims[0] = vector.size();
+                    HighFive::DataSet dataSet =
+                        outfile.createDataSet<double>(
+                            dataset_name, HighFive::DataSpace(dims));
+                    dataSet.write(vector);
+                }
+                break;
+
+            case 2:
+                {
+                    auto matrix = val.matrix();
+                    std::vector<std::size_t> dims(2);
+                    dims[0] = matrix.rows();
+                    dims[1] = matrix.columns();
+                    HighFive::DataSet dataSet =
+                        outfile.createDataSet<double>(
+                            dataset_name, HighFive::DataSpace(dims));
+                    dataSet.write(matrix);
+                }
+                break;
+            }
+        }
+
+        // write the given data into part of an existing dataset
+        void update_hdf5_sync(ir::node_data<double> const& val,
+            std::string const& filename, std::string const& dataset_name,
+            std::vector<std::size_t> const& offset, std::string const& name,
+            std::string const& codename)
+        {
+            HighFive::File outfile(filename, HighFive::File::ReadWrite);
+            HighFive::DataSet dataSet = outfile.getDataSet(dataset_name);
+            std::vector<std::size_t> dims = dataSet.getSpace().getDimensions();
+
+            if (val.num_dimensions() != dims.size() || dims.empty())
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::detail::write_hdf5",
+                    execution_tree::generate_error_message(
+                        "the data written into part of an existing dataset "
+                            "must be a vector or a matrix with the same "
+                            "number of dimensions as the dataset",
+                        name, codename));
+            }
+
+            hdf5_hyperslab slab;
+            slab.offset = offset;
+            if (dims.size() == 1)
+            {
+                slab.count.push_back(val.size());
+            }
+            else
+            {
+                slab.count.push_back(val.dimension(0));
+                slab.count.push_back(val.dimension(1));
+            }
+            resolve_hyperslab(slab, dims, name, codename);
+
+            HighFive::Selection selection =
+                dataSet.select(slab.offset, slab.count);
+
+            if (dims.size() == 1)
+            {
+                selection.write(val.vector());
+            }
+            else
+            {
+                selection.write(val.matrix());
+            }
+        }
+
+        hpx::future<void> write_hdf5(ir::node_data<double> val,
+            std::string const& filename, std::string const& dataset_name,
+            std::vector<std::size_t> const& offset, std::string const& name,
+            std::string const& codename)
+        {
+            return run_hdf5_io(
+                [val = std::move(val), filename, dataset_name, offset, name,
+                    codename]() -> void
+                {
+                    if (offset.empty())
+                    {
+                        create_hdf5_sync(val, filename, dataset_name);
+                    }
+                    else
+                    {
+                        update_hdf5_sync(val, filename, dataset_name, offset,
+                            name, codename);
+                    }
+                });
+        }
+    }
+}}}
+
+#endif
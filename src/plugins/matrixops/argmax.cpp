@@ -7,7 +7,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/argmax.hpp>
-#include <phylanx/util/matrix_iterators.hpp>
+#include <phylanx/util/blocked_reductions.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -123,66 +124,30 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type argmax::argmax2d_flatten(arg_type && arg_a) const
     {
-        using phylanx::util::matrix_row_iterator;
-
-        auto a = arg_a.matrix();
-
-        const matrix_row_iterator<decltype(a)> a_begin(a);
-        const matrix_row_iterator<decltype(a)> a_end(a, a.rows());
-
-        val_type global_max = 0.;
-        std::size_t global_index = 0ul;
-        std::size_t passed_rows = 0ul;
-        for (auto it = a_begin; it != a_end; ++it, ++passed_rows)
-        {
-            const auto local_max = std::max_element(it->begin(), it->end());
-            const auto local_max_val = *local_max;
-
-            if (local_max_val > global_max)
-            {
-                global_max = local_max_val;
-                global_index = std::distance(it->begin(), local_max) +
-                    passed_rows * it->size();
-            }
-        }
-        return primitive_argument_type(std::int64_t(global_index));
+        return primitive_argument_type(std::int64_t(
+            util::arg_reduce(
+                arg_a.matrix(), std::greater<val_type>{}, parallel_eval())));
     }
 
     primitive_argument_type argmax::argmax2d_x_axis(arg_type && arg_a) const
     {
-        using phylanx::util::matrix_row_iterator;
-
         auto a = arg_a.matrix();
-
-        const matrix_row_iterator<decltype(a)> a_begin(a);
-        const matrix_row_iterator<decltype(a)> a_end(a, a.rows());
+        auto indices =
+            util::row_arg_reduce(a, std::greater<val_type>{}, parallel_eval());
 
         blaze::DynamicVector<double> result(a.rows());
-        auto result_it = result.begin();
-        for (auto it = a_begin; it != a_end; ++it, ++result_it)
-        {
-            const auto local_max = std::max_element(it->begin(), it->end());
-            *result_it = std::distance(it->begin(), local_max);
-        }
+        std::copy(indices.begin(), indices.end(), result.begin());
         return primitive_argument_type{std::move(result)};
     }
 
     primitive_argument_type argmax::argmax2d_y_axis(arg_type && arg_a) const
     {
-        using phylanx::util::matrix_column_iterator;
-
         auto a = arg_a.matrix();
-
-        const matrix_column_iterator<decltype(a)> a_begin(a);
-        const matrix_column_iterator<decltype(a)> a_end(a, a.columns());
+        auto indices = util::column_arg_reduce(
+            a, std::greater<val_type>{}, parallel_eval());
 
         blaze::DynamicVector<double> result(a.columns());
-        auto result_it = result.begin();
-        for (auto it = a_begin; it != a_end; ++it, ++result_it)
-        {
-            const auto local_max = std::max_element(it->begin(), it->end());
-            *result_it = std::distance(it->begin(), local_max);
-        }
+        std::copy(indices.begin(), indices.end(), result.begin());
         return primitive_argument_type{std::move(result)};
     }
 
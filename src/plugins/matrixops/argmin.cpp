@@ -7,7 +7,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/argmin.hpp>
-#include <phylanx/util/matrix_iterators.hpp>
+#include <phylanx/util/blocked_reductions.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <string>
@@ -124,68 +125,32 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type argmin::argmin2d_flatten(arg_type && arg_a) const
     {
-        using phylanx::util::matrix_row_iterator;
-
-        auto a = arg_a.matrix();
-
-        const matrix_row_iterator<decltype(a)> a_begin(a);
-        const matrix_row_iterator<decltype(a)> a_end(a, a.rows());
-
-        val_type global_min = (std::numeric_limits<val_type>::max)();
-        std::size_t global_index = 0ul;
-        std::size_t passed_rows = 0ul;
-        for (auto it = a_begin; it != a_end; ++it, ++passed_rows)
-        {
-            const auto local_min = std::min_element(it->begin(), it->end());
-            const auto local_min_val = *local_min;
-
-            if (local_min_val < global_min)
-            {
-                global_min = local_min_val;
-                global_index = std::distance(it->begin(), local_min) +
-                    passed_rows * it->size();
-            }
-        }
-        return primitive_argument_type(std::int64_t(global_index));
+        return primitive_argument_type(std::int64_t(
+            util::arg_reduce(
+                arg_a.matrix(), std::less<val_type>{}, parallel_eval())));
     }
 
     primitive_argument_type argmin::argmin2d_x_axis(arg_type && arg_a) const
     {
-        using phylanx::util::matrix_row_iterator;
-
         auto a = arg_a.matrix();
-
-        const matrix_row_iterator<decltype(a)> a_begin(a);
-        const matrix_row_iterator<decltype(a)> a_end(a, a.rows());
+        auto indices =
+            util::row_arg_reduce(a, std::less<val_type>{}, parallel_eval());
 
         // TODO: Result vector must be of int64_t instead of double
         blaze::DynamicVector<double> result(a.rows());
-        auto result_it = result.begin();
-        for (auto it = a_begin; it != a_end; ++it, ++result_it)
-        {
-            const auto local_min = std::min_element(it->begin(), it->end());
-            *result_it = std::distance(it->begin(), local_min);
-        }
+        std::copy(indices.begin(), indices.end(), result.begin());
         return primitive_argument_type{std::move(result)};
     }
 
     primitive_argument_type argmin::argmin2d_y_axis(arg_type && arg_a) const
     {
-        using phylanx::util::matrix_column_iterator;
-
         auto a = arg_a.matrix();
-
-        const matrix_column_iterator<decltype(a)> a_begin(a);
-        const matrix_column_iterator<decltype(a)> a_end(a, a.columns());
+        auto indices = util::column_arg_reduce(
+            a, std::less<val_type>{}, parallel_eval());
 
         // TODO: Result vector must be of int64_t instead of double
         blaze::DynamicVector<double> result(a.columns());
-        auto result_it = result.begin();
-        for (auto it = a_begin; it != a_end; ++it, ++result_it)
-        {
-            const auto local_min = std::min_element(it->begin(), it->end());
-            *result_it = std::distance(it->begin(), local_min);
-        }
+        std::copy(indices.begin(), indices.end(), result.begin());
         return primitive_argument_type{std::move(result)};
     }
 
@@ -234,6 +234,72 @@ namespace phylanx { namespace execution_tree { namespace primitives
             ir::node_data<double>{std::move(lhs)}};
     }
 
+    // At least one of the operands is a sparse matrix
+    primitive_argument_type dot_operation::dot_sparse(
+        operand_type&& lhs, operand_type&& rhs) const
+    {
+        using sparse_type = operand_type::sparse_storage2d_type;
+
+        std::size_t lhs_dims = lhs.num_dimensions();
+        std::size_t rhs_dims = rhs.num_dimensions();
+
+        // scaling a sparse matrix keeps it sparse
+        if (lhs_dims == 0)
+        {
+            return primitive_argument_type{operand_type{
+                sparse_type{rhs.sparse_matrix() * lhs.scalar()}}};
+        }
+        if (rhs_dims == 0)
+        {
+            return primitive_argument_type{operand_type{
+                sparse_type{lhs.sparse_matrix() * rhs.scalar()}}};
+        }
+
+        if ((lhs_dims == 1 && lhs.size() != rhs.dimension(0)) ||
+            (lhs_dims == 2 && lhs.dimension(1) != rhs.dimension(0)))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dot_operation::dot_sparse",
+                execution_tree::generate_error_message(
+                    "the operands have incompatible number of "
+                        "dimensions",
+                    name_, codename_));
+        }
+
+        if (lhs_dims == 1)
+        {
+            // vector times sparse matrix
+            return primitive_argument_type{operand_type{
+                blaze::DynamicVector<double>{blaze::trans(
+                    blaze::trans(lhs.vector()) * rhs.sparse_matrix())}}};
+        }
+
+        if (rhs_dims == 1)
+        {
+            // sparse matrix times vector
+            return primitive_argument_type{operand_type{
+                blaze::DynamicVector<double>{
+                    lhs.sparse_matrix() * rhs.vector()}}};
+        }
+
+        if (lhs.is_sparse() && rhs.is_sparse())
+        {
+            return primitive_argument_type{operand_type{
+                sparse_type{lhs.sparse_matrix() * rhs.sparse_matrix()}}};
+        }
+
+        if (lhs.is_sparse())
+        {
+            return primitive_argument_type{operand_type{
+                blaze::DynamicMatrix<double>{
+                    lhs.sparse_matrix() * rhs.matrix()}}};
+        }
+
+        return primitive_argument_type{operand_type{
+            blaze::DynamicMatrix<double>{
+                lhs.matrix() * rhs.sparse_matrix()}}};
+    }
+
     hpx::future<primitive_argument_type> dot_operation::eval(
         std::vector<primitive_argument_type> const& operands,
         std::vector<primitive_argument_type> const& args) const
@@ -264,6 +330,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
             [this_](operand_type&& op1, operand_type&& op2)
             ->  primitive_argument_type
             {
+                if (op1.is_sparse() || op2.is_sparse())
+                {
+                    return this_->dot_sparse(std::move(op1), std::move(op2));
+                }
+
                 std::size_t dims = op1.num_dimensions();
                 switch (dims)
                 {
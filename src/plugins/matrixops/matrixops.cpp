@@ -61,6 +61,10 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(shuffle_operation_plugin,
     phylanx::execution_tree::primitives::shuffle_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(slicing_operation_plugin,
     phylanx::execution_tree::primitives::slicing_operation::match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(sparse_operation_plugin,
+    phylanx::execution_tree::primitives::sparse_operation::match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(dense_operation_plugin,
+    phylanx::execution_tree::primitives::sparse_operation::match_data[1]);
 PHYLANX_REGISTER_PLUGIN_FACTORY(square_root_operation_plugin,
     phylanx::execution_tree::primitives::square_root_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(sum_operation_plugin,
@@ -99,3 +103,27 @@ namespace plugin {
 PHYLANX_REGISTER_PLUGIN_FACTORY(phylanx::plugin::generic_operation_plugin,
     generic_operation_plugin,
     phylanx::execution_tree::primitives::make_list::match_data, "__gen");
+
+namespace phylanx {
+namespace plugin {
+    struct partitioned_operation_plugin : plugin_base
+    {
+        void register_known_primitives() override
+        {
+            namespace pet = phylanx::execution_tree;
+
+            std::string partitioned_operation_name("__partitioned");
+            for (auto const& pattern :
+                pet::primitives::partitioned_operation::match_data)
+            {
+                pet::register_pattern(partitioned_operation_name, pattern);
+            }
+        }
+    };
+}
+}
+
+PHYLANX_REGISTER_PLUGIN_FACTORY(phylanx::plugin::partitioned_operation_plugin,
+    partitioned_operation_plugin,
+    phylanx::execution_tree::primitives::partitioned_operation::match_data[0],
+    "__partitioned");
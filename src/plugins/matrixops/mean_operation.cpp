@@ -6,7 +6,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/mean_operation.hpp>
-#include <phylanx/util/matrix_iterators.hpp>
+#include <phylanx/util/blocked_reductions.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
@@ -125,68 +126,31 @@ namespace phylanx { namespace execution_tree { namespace primitives
     primitive_argument_type mean_operation::mean2d_flatten(
         arg_type&& arg_a) const
     {
-        using phylanx::util::matrix_row_iterator;
-
         auto matrix = arg_a.matrix();
-
-        const matrix_row_iterator<decltype(matrix)> matrix_begin(matrix);
-        const matrix_row_iterator<decltype(matrix)> matrix_end(
-            matrix, matrix.rows());
-
-        val_type global_sum = 0.0;
-        std::size_t global_size = 0ul;
-        for (auto it = matrix_begin; it != matrix_end; ++it)
-        {
-            global_sum += std::accumulate(it->begin(), it->end(), 0.0);
-            global_size += (*it).size();
-        }
-
-        return primitive_argument_type(global_sum / global_size);
+        return primitive_argument_type(
+            util::blocked_sum(matrix, parallel_eval()) /
+                (matrix.rows() * matrix.columns()));
     }
 
     primitive_argument_type mean_operation::mean2d_x_axis(
         arg_type&& arg_a) const
     {
-        using phylanx::util::matrix_row_iterator;
-
         auto matrix = arg_a.matrix();
 
-        const matrix_row_iterator<decltype(matrix)> matrix_begin(matrix);
-        const matrix_row_iterator<decltype(matrix)> matrix_end(
-            matrix, matrix.rows());
-
-        blaze::DynamicVector<double> result(matrix.rows());
-        auto result_it = result.begin();
-        for (auto it = matrix_begin; it != matrix_end; ++it, ++result_it)
-        {
-            const auto local_sum =
-                std::accumulate(it->begin(), it->end(), 0.0);
-            const auto local_size = (*it).size();
-            *result_it = local_sum / local_size;
-        }
+        blaze::DynamicVector<double> result =
+            util::row_sums(matrix, parallel_eval());
+        result /= double(matrix.columns());
         return primitive_argument_type{std::move(result)};
     }
 
     primitive_argument_type mean_operation::mean2d_y_axis(
         arg_type&& arg_a) const
     {
-        using phylanx::util::matrix_column_iterator;
-
         auto matrix = arg_a.matrix();
 
-        const matrix_column_iterator<decltype(matrix)> matrix_begin(matrix);
-        const matrix_column_iterator<decltype(matrix)> matrix_end(
-            matrix, matrix.columns());
-
-        blaze::DynamicVector<double> result(matrix.columns());
-        auto result_it = result.begin();
-        for (auto it = matrix_begin; it != matrix_end; ++it, ++result_it)
-        {
-            const auto local_sum =
-                std::accumulate(it->begin(), it->end(), 0.0);
-            const auto local_size = (*it).size();
-            *result_it = local_sum / local_size;
-        }
+        blaze::DynamicVector<double> result =
+            util::column_sums(matrix, parallel_eval());
+        result /= double(matrix.rows());
         return primitive_argument_type{std::move(result)};
     }
 
@@ -0,0 +1,374 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/ir/partitioned_array.hpp>
+#include <phylanx/plugins/matrixops/partitioned_operation.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const partitioned_operation::match_data =
+    {
+        hpx::util::make_tuple("partition",
+            std::vector<std::string>{
+                "partition(_1)", "partition(_1, _2, _3)"},
+            &create_partitioned_operation,
+            &create_primitive<partitioned_operation>),
+
+        hpx::util::make_tuple("gather",
+            std::vector<std::string>{"gather(_1)"},
+            &create_partitioned_operation,
+            &create_primitive<partitioned_operation>),
+
+        hpx::util::make_tuple("tiled_add",
+            std::vector<std::string>{"tiled_add(_1, _2)"},
+            &create_partitioned_operation,
+            &create_primitive<partitioned_operation>),
+
+        hpx::util::make_tuple("tiled_sub",
+            std::vector<std::string>{"tiled_sub(_1, _2)"},
+            &create_partitioned_operation,
+            &create_primitive<partitioned_operation>),
+
+        hpx::util::make_tuple("tiled_mul",
+            std::vector<std::string>{"tiled_mul(_1, _2)"},
+            &create_partitioned_operation,
+            &create_primitive<partitioned_operation>),
+
+        hpx::util::make_tuple("tiled_div",
+            std::vector<std::string>{"tiled_div(_1, _2)"},
+            &create_partitioned_operation,
+            &create_primitive<partitioned_operation>),
+
+        hpx::util::make_tuple("tiled_dot",
+            std::vector<std::string>{"tiled_dot(_1, _2)"},
+            &create_partitioned_operation,
+            &create_primitive<partitioned_operation>),
+
+        hpx::util::make_tuple("tiled_transpose",
+            std::vector<std::string>{"tiled_transpose(_1)"},
+            &create_partitioned_operation,
+            &create_primitive<partitioned_operation>),
+
+        hpx::util::make_tuple("tiled_sum",
+            std::vector<std::string>{"tiled_sum(_1)"},
+            &create_partitioned_operation,
+            &create_primitive<partitioned_operation>),
+
+        hpx::util::make_tuple("tiled_mean",
+            std::vector<std::string>{"tiled_mean(_1)"},
+            &create_partitioned_operation,
+            &create_primitive<partitioned_operation>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        std::string extract_partitioned_operation_name(std::string const& name)
+        {
+            compiler::primitive_name_parts name_parts;
+            if (!compiler::parse_primitive_name(name, name_parts))
+            {
+                return name.substr(0, name.find('$'));
+            }
+            return name_parts.primitive;
+        }
+    }
+
+    partitioned_operation::partitioned_operation(
+            std::vector<primitive_argument_type>&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {
+        std::string func_name =
+            detail::extract_partitioned_operation_name(name);
+
+        if (func_name == "gather")
+            operation_ = operation::gather;
+        else if (func_name == "tiled_add")
+            operation_ = operation::add;
+        else if (func_name == "tiled_sub")
+            operation_ = operation::sub;
+        else if (func_name == "tiled_mul")
+            operation_ = operation::mul;
+        else if (func_name == "tiled_div")
+            operation_ = operation::div;
+        else if (func_name == "tiled_dot")
+            operation_ = operation::dot;
+        else if (func_name == "tiled_transpose")
+            operation_ = operation::transpose;
+        else if (func_name == "tiled_sum")
+            operation_ = operation::sum;
+        else if (func_name == "tiled_mean")
+            operation_ = operation::mean;
+        else
+        {
+            HPX_ASSERT(func_name == "partition");
+            operation_ = operation::partition;
+        }
+    }
+
+    std::size_t partitioned_operation::num_operands() const
+    {
+        switch (operation_)
+        {
+        case operation::add: HPX_FALLTHROUGH;
+        case operation::sub: HPX_FALLTHROUGH;
+        case operation::mul: HPX_FALLTHROUGH;
+        case operation::div: HPX_FALLTHROUGH;
+        case operation::dot:
+            return 2;
+
+        default:
+            break;
+        }
+        return 1;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> partitioned_operation::partition(
+        std::vector<primitive_argument_type>&& args) const
+    {
+        auto m = extract_numeric_value(std::move(args[0]), name_, codename_);
+        if (m.num_dimensions() != 2 || m.is_sparse())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "partitioned_operation::partition",
+                generate_error_message(
+                    "the partition primitive requires its first argument to "
+                    "be a dense matrix"));
+        }
+
+        hpx::future<ir::partitioned_array> result;
+        if (args.size() == 1)
+        {
+            // one block of rows for each locality
+            result = ir::partitioned_array::create(
+                m, hpx::find_all_localities());
+        }
+        else
+        {
+            std::int64_t tile_rows =
+                extract_scalar_integer_value(args[1], name_, codename_);
+            std::int64_t tile_columns =
+                extract_scalar_integer_value(args[2], name_, codename_);
+            if (tile_rows <= 0 || tile_columns <= 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "partitioned_operation::partition",
+                    generate_error_message(
+                        "the partition primitive requires the extent of the "
+                        "tiles to be positive"));
+            }
+
+            result = ir::partitioned_array::create(m,
+                static_cast<std::size_t>(tile_rows),
+                static_cast<std::size_t>(tile_columns),
+                hpx::find_all_localities());
+        }
+
+        return result.then(hpx::launch::sync,
+            [](hpx::future<ir::partitioned_array>&& f)
+            {
+                return primitive_argument_type{f.get()};
+            });
+    }
+
+    hpx::future<primitive_argument_type> partitioned_operation::gather(
+        ir::partitioned_array&& arr) const
+    {
+        return arr.gather().then(hpx::launch::sync,
+            [](hpx::future<ir::node_data<double>>&& f)
+            {
+                return primitive_argument_type{f.get()};
+            });
+    }
+
+    hpx::future<primitive_argument_type> partitioned_operation::binary(
+        ir::partitioned_array&& lhs, ir::partitioned_array&& rhs) const
+    {
+        hpx::future<ir::partitioned_array> result;
+        if (operation_ == operation::dot)
+        {
+            if (lhs.columns() != rhs.rows() ||
+                lhs.tile_columns() != rhs.tile_rows())
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "partitioned_operation::binary",
+                    generate_error_message(
+                        "the tiled_dot primitive requires the number of "
+                        "columns (and the tile columns) of the left hand "
+                        "side to match the number of rows (and the tile "
+                        "rows) of the right hand side"));
+            }
+            result = ir::dot(lhs, rhs);
+        }
+        else
+        {
+            if (lhs.rows() != rhs.rows() || lhs.columns() != rhs.columns() ||
+                lhs.tile_rows() != rhs.tile_rows() ||
+                lhs.tile_columns() != rhs.tile_columns())
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "partitioned_operation::binary",
+                    generate_error_message(
+                        "the element-wise tiled primitives require both "
+                        "operands to have the same shape and tiling"));
+            }
+
+            ir::elementwise_operation op = ir::elementwise_operation::add;
+            switch (operation_)
+            {
+            case operation::sub:
+                op = ir::elementwise_operation::sub;
+                break;
+
+            case operation::mul:
+                op = ir::elementwise_operation::mul;
+                break;
+
+            case operation::div:
+                op = ir::elementwise_operation::div;
+                break;
+
+            default:
+                break;
+            }
+            result = ir::elementwise(op, lhs, rhs);
+        }
+
+        return result.then(hpx::launch::sync,
+            [](hpx::future<ir::partitioned_array>&& f)
+            {
+                return primitive_argument_type{f.get()};
+            });
+    }
+
+    hpx::future<primitive_argument_type> partitioned_operation::unary(
+        ir::partitioned_array&& arr) const
+    {
+        if (operation_ == operation::transpose)
+        {
+            return ir::transpose(arr).then(hpx::launch::sync,
+                [](hpx::future<ir::partitioned_array>&& f)
+                {
+                    return primitive_argument_type{f.get()};
+                });
+        }
+
+        if (operation_ == operation::mean && arr.rows() * arr.columns() == 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "partitioned_operation::unary",
+                generate_error_message(
+                    "the tiled_mean primitive requires a non-empty array"));
+        }
+
+        hpx::future<double> result = (operation_ == operation::sum) ?
+            ir::sum(arr) : ir::mean(arr);
+
+        return result.then(hpx::launch::sync,
+            [](hpx::future<double>&& f)
+            {
+                return primitive_argument_type{f.get()};
+            });
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> partitioned_operation::eval(
+        std::vector<primitive_argument_type> const& operands,
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operation_ == operation::partition ?
+                (operands.size() != 1 && operands.size() != 3) :
+                operands.size() != num_operands())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "partitioned_operation::eval",
+                generate_error_message(
+                    operation_ == operation::partition ?
+                        "the partition primitive requires exactly one or "
+                            "three operands" :
+                    num_operands() == 1 ?
+                        "the tiled primitives require exactly one operand" :
+                        "the tiled primitives require exactly two operands"));
+        }
+
+        for (auto const& operand : operands)
+        {
+            if (!valid(operand))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "partitioned_operation::eval",
+                    generate_error_message(
+                        "the partitioned primitives require that the "
+                        "arguments given by the operands array are valid"));
+            }
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_](std::vector<primitive_argument_type>&& args)
+            ->  hpx::future<primitive_argument_type>
+            {
+                if (this_->operation_ == operation::partition)
+                {
+                    return this_->partition(std::move(args));
+                }
+
+                auto lhs = extract_partitioned_array_value(
+                    std::move(args[0]), this_->name_, this_->codename_);
+
+                switch (this_->operation_)
+                {
+                case operation::gather:
+                    return this_->gather(std::move(lhs));
+
+                case operation::transpose: HPX_FALLTHROUGH;
+                case operation::sum: HPX_FALLTHROUGH;
+                case operation::mean:
+                    return this_->unary(std::move(lhs));
+
+                default:
+                    break;
+                }
+
+                auto rhs = extract_partitioned_array_value(
+                    std::move(args[1]), this_->name_, this_->codename_);
+                return this_->binary(std::move(lhs), std::move(rhs));
+            }),
+            detail::map_operands(
+                operands, functional::value_operand{}, args,
+                name_, codename_));
+    }
+
+    hpx::future<primitive_argument_type> partitioned_operation::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return eval(args, noargs);
+        }
+        return eval(operands_, args);
+    }
+}}}
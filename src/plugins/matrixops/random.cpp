@@ -7,14 +7,18 @@
 #include <phylanx/execution_tree/primitives/generic_function.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/random.hpp>
+#include <phylanx/util/philox.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/throw_exception.hpp>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -47,13 +51,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return seed;
     }
 
-    std::uint32_t random::seed_ = 0;
-    std::mt19937 random::rng_{random::default_seed()};
+    constexpr std::size_t random::block_size;
+
+    std::atomic<std::uint32_t> random::seed_(random::default_seed());
+    std::atomic<std::uint64_t> random::sequence_(0);
 
     void random::set_seed(std::uint32_t seed)
     {
         seed_ = seed;
-        rng_.seed(seed_);
+        sequence_ = 0;
     }
 
     std::uint32_t random::get_seed()
@@ -61,6 +67,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return seed_;
     }
 
+    std::uint64_t random::next_key()
+    {
+        return (sequence_++ << 32) | seed_;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // extract the required dimensionality from argument 1
     std::array<std::size_t, 2> extract_dimensions(
@@ -235,10 +246,49 @@ namespace phylanx { namespace execution_tree { namespace primitives
     namespace detail
     {
         ///////////////////////////////////////////////////////////////////////
+        // Invoke f(i, value) for all indices i in [0, size), where value is
+        // drawn from the given distribution. The random numbers for each
+        // block of indices are generated from a separate stream of the
+        // counter based generator, the blocks are filled concurrently.
+        template <typename Dist, typename F>
+        void randomize_blocks(Dist const& dist, std::size_t size, F const& f)
+        {
+            std::uint64_t const key = primitives::random::next_key();
+            std::size_t const block_size = primitives::random::block_size;
+
+            auto fill_block = [&](std::size_t block)
+            {
+                util::philox4x32 gen(key, block);
+                Dist d(dist);
+
+                std::size_t const begin = block * block_size;
+                std::size_t const end = (std::min)(begin + block_size, size);
+                for (std::size_t i = begin; i != end; ++i)
+                {
+                    f(i, d(gen));
+                }
+            };
+
+            std::size_t const num_blocks =
+                (size + block_size - 1) / block_size;
+            if (num_blocks <= 1)
+            {
+                if (num_blocks != 0)
+                {
+                    fill_block(0);
+                }
+                return;
+            }
+
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), num_blocks, fill_block);
+        }
+
         template <typename Dist, typename T>
         primitive_argument_type randomize(Dist& dist, T& d)
         {
-            d = dist(primitives::random::rng_);
+            util::philox4x32 gen(primitives::random::next_key());
+            d = dist(gen);
             return primitive_argument_type{d};
         }
 
@@ -246,12 +296,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_argument_type randomize(
             Dist& dist, blaze::DynamicVector<T>& v)
         {
-            std::size_t const size = v.size();
-
-            for (std::size_t i = 0; i != size; ++i)
-            {
-                v[i] = dist(primitives::random::rng_);
-            }
+            randomize_blocks(dist, v.size(),
+                [&](std::size_t i, typename Dist::result_type val)
+                {
+                    v[i] = val;
+                });
 
             return primitive_argument_type{std::move(v)};
         }
@@ -260,16 +309,14 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_argument_type randomize(
             Dist& dist, blaze::DynamicMatrix<T>& m)
         {
-            std::size_t const rows = m.rows();
+            // the elements are generated in row-major order
             std::size_t const columns = m.columns();
 
-            for (std::size_t i = 0; i != rows; ++i)
-            {
-                for (std::size_t j = 0; j != columns; ++j)
+            randomize_blocks(dist, m.rows() * columns,
+                [&](std::size_t i, typename Dist::result_type val)
                 {
-                    m(i, j) = dist(primitives::random::rng_);
-                }
-            }
+                    m(i / columns, i % columns) = val;
+                });
 
             return primitive_argument_type{std::move(m)};
         }
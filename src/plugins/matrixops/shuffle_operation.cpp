@@ -5,16 +5,21 @@
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/plugins/matrixops/random.hpp>
 #include <phylanx/plugins/matrixops/shuffle_operation.hpp>
+#include <phylanx/util/philox.hpp>
 #include <phylanx/util/matrix_iterators.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/throw_exception.hpp>
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <memory>
 #include <numeric>
 #include <random>
@@ -74,29 +79,185 @@ namespace phylanx { namespace execution_tree { namespace primitives
     };
 
     ///////////////////////////////////////////////////////////////////////////
-    std::mt19937 shuffle_operation::rand_machine{std::random_device{}()};
-
     shuffle_operation::shuffle_operation(
             std::vector<primitive_argument_type>&& operands,
             std::string const& name, std::string const& codename)
       : primitive_component_base(std::move(operands), name, codename)
     {}
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // Merge the two adjacent, randomly shuffled ranges [first, middle)
+        // and [middle, last) into one randomly shuffled range (see: A. Bacher,
+        // O. Bodini, A. Hollender, and J. Lumbroso, "MergeShuffle: A Very
+        // Fast, Parallel Random Permutation Algorithm", 2015).
+        template <typename Iterator>
+        void merge_shuffle(Iterator first, Iterator middle, Iterator last,
+            util::philox4x32& gen)
+        {
+            Iterator i = first;
+            Iterator j = middle;
+
+            std::uint32_t bits = 0;
+            int num_bits = 0;
+            while (true)
+            {
+                if (num_bits == 0)
+                {
+                    bits = gen();
+                    num_bits = 32;
+                }
+
+                bool take_second = (bits & 1) != 0;
+                bits >>= 1;
+                --num_bits;
+
+                if (take_second)
+                {
+                    if (j == last)
+                    {
+                        break;
+                    }
+                    std::iter_swap(i, j++);
+                }
+                else if (i == j)
+                {
+                    break;
+                }
+                ++i;
+            }
+
+            // insert the remaining elements of the first range at random
+            // positions (Fisher-Yates)
+            for (/**/; i != last; ++i)
+            {
+                std::uniform_int_distribution<std::ptrdiff_t> dist(
+                    0, std::distance(first, i));
+                std::iter_swap(i, first + dist(gen));
+            }
+        }
+
+        // Generate a random permutation of the indices [0, size). The
+        // indices are shuffled in blocks which are then merged pairwise,
+        // each block and each merge step uses its own stream of random
+        // numbers. This makes the result independent of the number of
+        // threads used.
+        std::vector<std::size_t> random_permutation(std::size_t size)
+        {
+            std::uint64_t const key = random::next_key();
+            std::size_t const block_size = random::block_size;
+
+            std::vector<std::size_t> permutation(size);
+            std::iota(permutation.begin(), permutation.end(), std::size_t(0));
+
+            std::size_t const num_blocks = (size + block_size - 1) / block_size;
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), num_blocks,
+                [&](std::size_t block)
+                {
+                    util::philox4x32 gen(key, block);
+
+                    auto first = permutation.begin() + block * block_size;
+                    auto last = permutation.begin() +
+                        (std::min)((block + 1) * block_size, size);
+
+                    std::shuffle(first, last, gen);
+                });
+
+            // merge the shuffled blocks, doubling their size in each step
+            std::uint64_t stream = num_blocks;
+            for (std::size_t width = block_size; width < size; width *= 2)
+            {
+                std::size_t const num_merges =
+                    (size + 2 * width - 1) / (2 * width);
+
+                hpx::parallel::for_loop(hpx::parallel::execution::par,
+                    std::size_t(0), num_merges,
+                    [&](std::size_t merge)
+                    {
+                        std::size_t const first = merge * 2 * width;
+                        std::size_t const middle =
+                            (std::min)(first + width, size);
+                        std::size_t const last =
+                            (std::min)(first + 2 * width, size);
+
+                        if (middle != last)
+                        {
+                            util::philox4x32 gen(key, stream + merge);
+                            merge_shuffle(permutation.begin() + first,
+                                permutation.begin() + middle,
+                                permutation.begin() + last, gen);
+                        }
+                    });
+
+                stream += num_merges;
+            }
+
+            return permutation;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type shuffle_operation::shuffle_1d(arg_type && arg) const
     {
-        auto x = arg.vector();
-        std::shuffle(x.begin(), x.end(), rand_machine);
+        // shuffle a copy of referenced data, the referenced array (the value
+        // of a variable or an array passed in from Python) is left untouched
+        blaze::DynamicVector<double> x =
+            arg.is_ref() ? arg.vector_copy() : std::move(arg.vector_non_ref());
+        std::size_t const size = x.size();
+
+        if (size <= random::block_size)
+        {
+            util::philox4x32 gen(random::next_key());
+            std::shuffle(x.begin(), x.end(), gen);
+        }
+        else
+        {
+            // gather the elements into a temporary
+            std::vector<std::size_t> permutation =
+                detail::random_permutation(size);
+
+            blaze::DynamicVector<double> shuffled(size);
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), size,
+                [&](std::size_t i)
+                {
+                    shuffled[i] = x[permutation[i]];
+                });
+            x = std::move(shuffled);
+        }
 
         return primitive_argument_type{ir::node_data<double>{std::move(x)}};
     }
 
     primitive_argument_type shuffle_operation::shuffle_2d(arg_type&& arg) const
     {
-        auto x = arg.matrix();
-        auto x_begin = util::matrix_row_iterator<decltype(x)>(x);
-        auto x_end = util::matrix_row_iterator<decltype(x)>(x, x.rows());
-        std::shuffle(x_begin, x_end, rand_machine);
+        blaze::DynamicMatrix<double> x =
+            arg.is_ref() ? arg.matrix_copy() : std::move(arg.matrix_non_ref());
+        std::size_t const rows = x.rows();
+
+        if (rows <= random::block_size)
+        {
+            util::philox4x32 gen(random::next_key());
+            auto x_begin = util::matrix_row_iterator<decltype(x)>(x);
+            auto x_end = util::matrix_row_iterator<decltype(x)>(x, rows);
+            std::shuffle(x_begin, x_end, gen);
+        }
+        else
+        {
+            std::vector<std::size_t> permutation =
+                detail::random_permutation(rows);
+
+            blaze::DynamicMatrix<double> shuffled(rows, x.columns());
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), rows,
+                [&](std::size_t i)
+                {
+                    blaze::row(shuffled, i) = blaze::row(x, permutation[i]);
+                });
+            x = std::move(shuffled);
+        }
 
         return primitive_argument_type{ir::node_data<double>{std::move(x)}};
     }
@@ -24,7 +24,6 @@
 #include <vector>
 
 #include <blaze/Math.h>
-#include <blaze/math/Elements.h>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace phylanx {namespace execution_tree {    namespace primitives {
@@ -90,6 +89,108 @@ namespace phylanx {namespace execution_tree {    namespace primitives {
         return result;
     }
 
+    // Normalize the given start and stop indices and return the number of
+    // elements selected by the slice. This avoids materializing the list of
+    // indices for slicing numeric data.
+    std::size_t slicing_operation::slice_extent(std::int64_t& start,
+        std::int64_t& stop, std::int64_t step, std::size_t array_length) const
+    {
+        if (step == 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::"
+                    "slicing_operation::slice_extent",
+                generate_error_message("step can not be zero"));
+        }
+
+        if (start < 0)
+        {
+            start = array_length + start;
+        }
+
+        if (stop < 0)
+        {
+            stop = array_length + stop;
+        }
+
+        std::size_t count = 0;
+        if (step > 0 && start < stop)
+        {
+            count = std::size_t((stop - start + step - 1) / step);
+        }
+        else if (step < 0 && start > stop)
+        {
+            count = std::size_t((start - stop - step - 1) / -step);
+        }
+
+        // all selected indices have to refer to existing elements
+        if (count != 0)
+        {
+            std::int64_t last = start + std::int64_t(count - 1) * step;
+            if (start < 0 || last < 0 ||
+                std::size_t((std::max)(start, last)) >= array_length)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::execution_tree::primitives::"
+                        "slicing_operation::slice_extent",
+                    generate_error_message("slice indices are out of range"));
+            }
+        }
+
+        return count;
+    }
+
+    // Normalize the given (possibly negative) index of a single element and
+    // verify that it refers to an existing element. Single elements are
+    // accessed without bounds checks.
+    std::int64_t slicing_operation::single_index(
+        std::int64_t index, std::size_t array_length) const
+    {
+        if (index < 0)
+        {
+            index = array_length + index;
+        }
+
+        if (index < 0 || std::size_t(index) >= array_length)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::"
+                    "slicing_operation::single_index",
+                generate_error_message("index is out of range"));
+        }
+
+        return index;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // The referencing storage types of node_data require the referenced
+        // data to be aligned and padded (with zeros). A slice of a row-major
+        // matrix which selects a contiguous range of rows and all columns
+        // satisfies this, as does a suffix of a vector starting at a SIMD
+        // boundary. Such slices are returned as references to the sliced
+        // data instead of copying it. Consumers which modify their arguments
+        // create a copy of referenced data first.
+        constexpr std::size_t simd_size = blaze::SIMDTrait<double>::size;
+
+        inline bool is_vector_view(std::int64_t start, std::size_t count,
+            std::int64_t step, std::size_t size)
+        {
+            return step == 1 && count != 0 &&
+                std::size_t(start) % simd_size == 0 &&
+                std::size_t(start) + count == size;
+        }
+
+        template <typename Matrix>
+        bool is_row_view(Matrix const& m, std::int64_t col_start,
+            std::size_t col_count, std::int64_t col_step)
+        {
+            return col_step == 1 && col_start == 0 &&
+                col_count == m.columns() && m.spacing() % simd_size == 0;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     std::int64_t slicing_operation::extract_integer_value(
         primitive_argument_type const& val, std::int64_t default_value) const
@@ -122,11 +223,8 @@ namespace phylanx {namespace execution_tree {    namespace primitives {
         auto input_vector = arg.vector();
         if (extracted_row.size() == 1)
         {
-            std::int64_t index = extracted_row[0];
-            if (index < 0)
-            {
-                index = input_vector.size() + index;
-            }
+            std::int64_t index =
+                single_index(extracted_row[0], input_vector.size());
             return primitive_argument_type{input_vector[index]};
         }
 
@@ -137,22 +235,32 @@ namespace phylanx {namespace execution_tree {    namespace primitives {
         if (extracted_row.size() == 3)
         {
             step = extracted_row[2];
+        }
 
-            if (step == 0)
-            {
-                HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                    "phylanx::execution_tree::primitives::"
-                        "slicing_operation::slicing1d",
-                    generate_error_message("step can not be zero"));
-            }
+        std::size_t size = input_vector.size();
+        std::size_t count = slice_extent(row_start, row_stop, step, size);
+
+        // reference the sliced data if possible
+        if (arg.is_ref() &&
+            detail::is_vector_view(row_start, count, step, size))
+        {
+            return primitive_argument_type{ir::node_data<double>{
+                custom_storage1d_type{input_vector.data() + row_start, count,
+                    input_vector.spacing() - row_start}}};
         }
 
-        auto init_list =
-            create_list_slice(row_start, row_stop, step, arg.size());
+        if (step == 1)
+        {
+            storage1d_type v{blaze::subvector(input_vector, row_start, count)};
+            return primitive_argument_type{ir::node_data<double>{std::move(v)}};
+        }
 
-        auto sv = blaze::elements(input_vector, init_list);
-        storage1d_type v{sv};
-        return primitive_argument_type{ir::node_data<double>(std::move(v))};
+        storage1d_type v(count);
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            v[i] = input_vector[row_start + std::int64_t(i) * step];
+        }
+        return primitive_argument_type{ir::node_data<double>{std::move(v)}};
     }
 
     primitive_argument_type slicing_operation::slicing2d(
@@ -167,55 +275,75 @@ namespace phylanx {namespace execution_tree {    namespace primitives {
                 generate_error_message("columns/rows can not be empty"));
         }
 
-        blaze::DynamicMatrix<double> input_matrix = arg.matrix();
+        if (arg.is_sparse())
+        {
+            return slicing2d_sparse(
+                std::move(arg), extracted_row, extracted_column);
+        }
+
+        auto input_matrix = arg.matrix();
         std::size_t num_matrix_rows = input_matrix.rows();
         std::size_t num_matrix_cols = input_matrix.columns();
 
-        // return a value and not a vector if you are not given a list
-        if (extracted_row.size() == 1)
+        // extract the column slice, if any
+        std::int64_t col_start = extracted_column[0];
+        std::int64_t col_stop = 0;
+        std::int64_t step_col = 1;
+        std::size_t col_count = 0;
+
+        if (extracted_column.size() == 1)
         {
-            std::int64_t index = extracted_row[0];
-            if (index < 0)
+            col_start = single_index(col_start, num_matrix_cols);
+        }
+        else
+        {
+            col_stop = extracted_column[1];
+            if (extracted_column.size() == 3)
             {
-                index = num_matrix_rows + index;
+                step_col = extracted_column[2];
             }
+            col_count =
+                slice_extent(col_start, col_stop, step_col, num_matrix_cols);
+        }
 
-            auto sv = blaze::trans(blaze::row(input_matrix, index));
+        // return a value and not a vector if you are not given a list
+        if (extracted_row.size() == 1)
+        {
+            std::int64_t index =
+                single_index(extracted_row[0], num_matrix_rows);
+
+            auto row = blaze::row(input_matrix, index);
             if (extracted_column.size() == 1)
             {
-                std::int64_t index_col = extracted_column[0];
-                if (index_col < 0)
-                {
-                    index_col = num_matrix_cols + index_col;
-                }
-
-                double value = sv[index_col];
+                double value = row[col_start];
                 storage0d_type v{value};
                 return primitive_argument_type{
                     ir::node_data<double>{std::move(v)}};
             }
 
-            std::int64_t col_start = extracted_column[0];
-            std::int64_t col_stop = extracted_column[1];
-            std::int64_t step_col = 1;
-
-            if (extracted_column.size() == 3)
+            // reference the selected row if possible
+            if (arg.is_ref() &&
+                detail::is_row_view(
+                    input_matrix, col_start, col_count, step_col))
             {
-                step_col = extracted_column[2];
-                if (step_col == 0)
-                {
-                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                        "phylanx::execution_tree::primitives::"
-                            "slicing_operation::slicing2d",
-                        generate_error_message("step can not be zero"));
-                }
+                return primitive_argument_type{ir::node_data<double>{
+                    custom_storage1d_type{input_matrix.data(index), col_count,
+                        input_matrix.spacing()}}};
             }
 
-            auto init_list_col = create_list_slice(
-                col_start, col_stop, step_col, num_matrix_cols);
+            if (step_col == 1)
+            {
+                storage1d_type v{blaze::trans(
+                    blaze::subvector(row, col_start, col_count))};
+                return primitive_argument_type{
+                    ir::node_data<double>{std::move(v)}};
+            }
 
-            auto final_vec = blaze::elements(sv, init_list_col);
-            storage1d_type v{final_vec};
+            storage1d_type v(col_count);
+            for (std::size_t j = 0; j != col_count; ++j)
+            {
+                v[j] = row[col_start + std::int64_t(j) * step_col];
+            }
             return primitive_argument_type{ir::node_data<double>{std::move(v)}};
         }
 
@@ -226,52 +354,184 @@ namespace phylanx {namespace execution_tree {    namespace primitives {
         if (extracted_row.size() == 3)
         {
             step = extracted_row[2];
-            if (step == 0)
-            {
-                HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                    "phylanx::execution_tree::primitives::"
-                        "row_slicing_operation::row_slicing_operation",
-                    generate_error_message("step can not be zero"));
-            }
         }
 
-        auto init_list =
-            create_list_slice(row_start, row_stop, step, num_matrix_rows);
+        std::size_t row_count =
+            slice_extent(row_start, row_stop, step, num_matrix_rows);
 
-        auto sm = blaze::rows(input_matrix, init_list);
         if (extracted_column.size() == 1)
         {
-            std::int64_t index_col = extracted_column[0];
-            if (index_col < 0)
+            storage1d_type v(row_count);
+            for (std::size_t i = 0; i != row_count; ++i)
             {
-                index_col = num_matrix_cols + index_col;
+                v[i] = input_matrix(row_start + std::int64_t(i) * step,
+                    col_start);
             }
-            auto vec = blaze::column(sm, index_col);
-            storage1d_type v{vec};
             return primitive_argument_type{ir::node_data<double>{std::move(v)}};
         }
 
+        // reference a contiguous range of rows if possible
+        if (arg.is_ref() && step == 1 && row_count != 0 &&
+            detail::is_row_view(input_matrix, col_start, col_count, step_col))
+        {
+            return primitive_argument_type{ir::node_data<double>{
+                custom_storage2d_type{input_matrix.data(row_start), row_count,
+                    col_count, input_matrix.spacing()}}};
+        }
+
+        if (step == 1 && step_col == 1)
+        {
+            storage2d_type m{blaze::submatrix(
+                input_matrix, row_start, col_start, row_count, col_count)};
+            return primitive_argument_type{ir::node_data<double>{std::move(m)}};
+        }
+
+        storage2d_type m(row_count, col_count);
+        for (std::size_t i = 0; i != row_count; ++i)
+        {
+            std::int64_t row = row_start + std::int64_t(i) * step;
+            for (std::size_t j = 0; j != col_count; ++j)
+            {
+                m(i, j) =
+                    input_matrix(row, col_start + std::int64_t(j) * step_col);
+            }
+        }
+        return primitive_argument_type{ir::node_data<double>{std::move(m)}};
+    }
+
+    // Slicing sparse matrices selects elements without densifying the input.
+    // Selecting a single row or column results in a dense vector, selecting
+    // ranges of rows and columns results in a sparse matrix.
+    primitive_argument_type slicing_operation::slicing2d_sparse(
+        arg_type&& arg, std::vector<std::int64_t> const& extracted_row,
+        std::vector<std::int64_t> const& extracted_column) const
+    {
+        auto const& input_matrix = arg.sparse_matrix();
+        std::size_t num_matrix_rows = input_matrix.rows();
+        std::size_t num_matrix_cols = input_matrix.columns();
+
+        std::int64_t row_start = extracted_row[0];
+        std::int64_t row_stop = 0;
+        std::int64_t step = 1;
+        std::size_t row_count = 1;
+
+        if (extracted_row.size() == 1)
+        {
+            row_start = single_index(row_start, num_matrix_rows);
+        }
+        else
+        {
+            row_stop = extracted_row[1];
+            if (extracted_row.size() == 3)
+            {
+                step = extracted_row[2];
+            }
+            row_count =
+                slice_extent(row_start, row_stop, step, num_matrix_rows);
+        }
+
         std::int64_t col_start = extracted_column[0];
-        std::int64_t col_stop = extracted_column[1];
+        std::int64_t col_stop = 0;
         std::int64_t step_col = 1;
+        std::size_t col_count = 1;
 
-        if (extracted_column.size() == 3)
+        if (extracted_column.size() == 1)
         {
-            step_col = extracted_column[2];
-            if (step_col == 0)
+            col_start = single_index(col_start, num_matrix_cols);
+        }
+        else
+        {
+            col_stop = extracted_column[1];
+            if (extracted_column.size() == 3)
             {
-                HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                    "phylanx::execution_tree::primitives::"
-                        "slicing_operation::slicing2d",
-                    generate_error_message("step can not be zero"));
+                step_col = extracted_column[2];
+            }
+            col_count =
+                slice_extent(col_start, col_stop, step_col, num_matrix_cols);
+        }
+
+        if (extracted_row.size() == 1 && extracted_column.size() == 1)
+        {
+            arg_type const& input = arg;
+            return primitive_argument_type{ir::node_data<double>{
+                input.at(std::size_t(row_start), std::size_t(col_start))}};
+        }
+
+        if (extracted_row.size() == 1 || extracted_column.size() == 1)
+        {
+            bool single_row = extracted_row.size() == 1;
+            storage1d_type v(single_row ? col_count : row_count, 0.0);
+
+            if (single_row)
+            {
+                for (auto it = input_matrix.begin(row_start);
+                     it != input_matrix.end(row_start); ++it)
+                {
+                    std::int64_t j = std::int64_t(it->index()) - col_start;
+                    if (j % step_col == 0 && j / step_col >= 0 &&
+                        std::size_t(j / step_col) < col_count)
+                    {
+                        v[j / step_col] = it->value();
+                    }
+                }
             }
+            else
+            {
+                for (std::size_t i = 0; i != row_count; ++i)
+                {
+                    auto it = input_matrix.find(
+                        row_start + std::int64_t(i) * step, col_start);
+                    if (it != input_matrix.end(
+                                  row_start + std::int64_t(i) * step))
+                    {
+                        v[i] = it->value();
+                    }
+                }
+            }
+            return primitive_argument_type{ir::node_data<double>{std::move(v)}};
         }
 
-        auto init_list_col =
-            create_list_slice(col_start, col_stop, step_col, num_matrix_cols);
+        if (step == 1 && step_col == 1)
+        {
+            sparse_storage2d_type m{blaze::submatrix(
+                input_matrix, row_start, col_start, row_count, col_count)};
+            return primitive_argument_type{ir::node_data<double>{std::move(m)}};
+        }
 
-        auto final_mat = blaze::columns(sm, init_list_col);
-        storage2d_type m{final_mat};
+        // the elements of each row are visited in order of their column
+        // index, which allows to append them to the result
+        sparse_storage2d_type m(row_count, col_count);
+        m.reserve(input_matrix.nonZeros());
+        for (std::size_t i = 0; i != row_count; ++i)
+        {
+            std::int64_t row = row_start + std::int64_t(i) * step;
+            if (step_col > 0)
+            {
+                for (auto it = input_matrix.begin(row);
+                     it != input_matrix.end(row); ++it)
+                {
+                    std::int64_t j = std::int64_t(it->index()) - col_start;
+                    if (j % step_col == 0 && j / step_col >= 0 &&
+                        std::size_t(j / step_col) < col_count)
+                    {
+                        m.append(i, j / step_col, it->value());
+                    }
+                }
+            }
+            else
+            {
+                for (std::size_t j = 0; j != col_count; ++j)
+                {
+                    auto it = input_matrix.find(
+                        row, col_start + std::int64_t(j) * step_col);
+                    if (it != input_matrix.end(row))
+                    {
+                        m.append(i, j, it->value());
+                    }
+                }
+            }
+            m.finalize(i);
+        }
         return primitive_argument_type{ir::node_data<double>{std::move(m)}};
     }
 
@@ -386,8 +646,8 @@ namespace phylanx {namespace execution_tree {    namespace primitives {
                 std::vector<std::int64_t> extracted_row;
                 std::vector<std::int64_t> extracted_column;
                 extract_slicing_args_matrix(std::move(args), extracted_row,
-                    extracted_column, matrix_input.matrix().rows(),
-                    matrix_input.matrix().columns());
+                    extracted_column, matrix_input.dimension(0),
+                    matrix_input.dimension(1));
                 return slicing2d(
                     std::move(matrix_input), extracted_row, extracted_column);
             }
@@ -0,0 +1,271 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/matrixops/sparse_operation.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const sparse_operation::match_data =
+    {
+        hpx::util::make_tuple("sparse",
+            std::vector<std::string>{
+                "sparse(_1)", "sparse(_1, _2, _3, _4)"},
+            &create_sparse_operation, &create_primitive<sparse_operation>),
+
+        hpx::util::make_tuple("dense",
+            std::vector<std::string>{"dense(_1)"},
+            &create_sparse_operation, &create_primitive<sparse_operation>)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        bool is_dense_operation(std::string const& name)
+        {
+            compiler::primitive_name_parts name_parts;
+            if (!compiler::parse_primitive_name(name, name_parts))
+            {
+                return name.compare(0, name.find('$'), "dense") == 0;
+            }
+            return name_parts.primitive == "dense";
+        }
+    }
+
+    sparse_operation::sparse_operation(
+            std::vector<primitive_argument_type>&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , dense_(detail::is_dense_operation(name))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type sparse_operation::to_sparse(
+        std::vector<primitive_argument_type>&& args) const
+    {
+        using sparse_matrix_type = ir::node_data<double>::sparse_storage2d_type;
+
+        auto m = extract_numeric_value(std::move(args[0]), name_, codename_);
+        if (m.num_dimensions() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "sparse_operation::to_sparse",
+                generate_error_message(
+                    "the sparse primitive requires its argument to be a "
+                    "matrix"));
+        }
+
+        if (m.is_sparse())
+        {
+            return primitive_argument_type{std::move(m)};
+        }
+
+        // only the non-zero elements are stored
+        return primitive_argument_type{
+            ir::node_data<double>{sparse_matrix_type{m.matrix()}}};
+    }
+
+    primitive_argument_type sparse_operation::from_coordinates(
+        std::vector<primitive_argument_type>&& args) const
+    {
+        using sparse_matrix_type = ir::node_data<double>::sparse_storage2d_type;
+
+        auto rows = extract_integer_value(std::move(args[0]), name_, codename_);
+        auto columns =
+            extract_integer_value(std::move(args[1]), name_, codename_);
+        auto values =
+            extract_numeric_value(std::move(args[2]), name_, codename_);
+        auto shape = extract_list_value(std::move(args[3]), name_, codename_);
+
+        if (rows.num_dimensions() != 1 || columns.num_dimensions() != 1 ||
+            values.num_dimensions() != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "sparse_operation::from_coordinates",
+                generate_error_message(
+                    "the sparse primitive requires the row indices, the "
+                    "column indices, and the values to be vectors"));
+        }
+
+        std::size_t const count = values.size();
+        if (rows.size() != count || columns.size() != count)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "sparse_operation::from_coordinates",
+                generate_error_message(
+                    "the sparse primitive requires the row indices, the "
+                    "column indices, and the values to have the same size"));
+        }
+
+        if (shape.size() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "sparse_operation::from_coordinates",
+                generate_error_message(
+                    "the sparse primitive requires the shape to be a list "
+                    "of two elements"));
+        }
+
+        std::vector<std::int64_t> dims;
+        for (auto const& dim : shape)
+        {
+            dims.push_back(extract_scalar_integer_value(dim, name_, codename_));
+        }
+        if (dims[0] < 0 || dims[1] < 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "sparse_operation::from_coordinates",
+                generate_error_message(
+                    "the sparse primitive requires the shape to be "
+                    "non-negative"));
+        }
+
+        auto r = rows.vector();
+        auto c = columns.vector();
+        auto v = values.vector();
+
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            if (r[i] < 0 || r[i] >= dims[0] || c[i] < 0 || c[i] >= dims[1])
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "sparse_operation::from_coordinates",
+                    generate_error_message(
+                        "the sparse primitive was given an index which is "
+                        "out of bounds of the given shape"));
+            }
+        }
+
+        // order the elements by row and column, duplicates are summed up
+        std::vector<std::size_t> order(count);
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::stable_sort(order.begin(), order.end(),
+            [&](std::size_t lhs, std::size_t rhs)
+            {
+                return r[lhs] < r[rhs] || (r[lhs] == r[rhs] && c[lhs] < c[rhs]);
+            });
+
+        sparse_matrix_type result(static_cast<std::size_t>(dims[0]),
+            static_cast<std::size_t>(dims[1]));
+        result.reserve(count);
+
+        std::size_t k = 0;
+        for (std::int64_t row = 0; row != dims[0]; ++row)
+        {
+            while (k != count && r[order[k]] == row)
+            {
+                std::int64_t const column = c[order[k]];
+                double value = v[order[k]];
+                for (++k; k != count && r[order[k]] == row &&
+                     c[order[k]] == column; ++k)
+                {
+                    value += v[order[k]];
+                }
+
+                if (value != 0.0)
+                {
+                    result.append(static_cast<std::size_t>(row),
+                        static_cast<std::size_t>(column), value);
+                }
+            }
+            result.finalize(static_cast<std::size_t>(row));
+        }
+
+        return primitive_argument_type{
+            ir::node_data<double>{std::move(result)}};
+    }
+
+    primitive_argument_type sparse_operation::to_dense(
+        std::vector<primitive_argument_type>&& args) const
+    {
+        using matrix_type = ir::node_data<double>::storage2d_type;
+
+        auto m = extract_numeric_value(std::move(args[0]), name_, codename_);
+        if (!m.is_sparse())
+        {
+            return primitive_argument_type{std::move(m)};
+        }
+
+        return primitive_argument_type{
+            ir::node_data<double>{matrix_type{m.sparse_matrix()}}};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> sparse_operation::eval(
+        std::vector<primitive_argument_type> const& operands,
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands.size() != 1 && (dense_ || operands.size() != 4))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "sparse_operation::eval",
+                generate_error_message(dense_ ?
+                    "the dense primitive requires exactly one operand" :
+                    "the sparse primitive requires exactly one or four "
+                        "operands"));
+        }
+
+        for (auto const& operand : operands)
+        {
+            if (!valid(operand))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "sparse_operation::eval",
+                    generate_error_message(
+                        "the sparse primitive requires that the arguments "
+                        "given by the operands array are valid"));
+            }
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_](std::vector<primitive_argument_type>&& args)
+            ->  primitive_argument_type
+            {
+                if (this_->dense_)
+                {
+                    return this_->to_dense(std::move(args));
+                }
+                if (args.size() == 1)
+                {
+                    return this_->to_sparse(std::move(args));
+                }
+                return this_->from_coordinates(std::move(args));
+            }),
+            detail::map_operands(
+                operands, functional::value_operand{}, args,
+                name_, codename_));
+    }
+
+    hpx::future<primitive_argument_type> sparse_operation::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return eval(args, noargs);
+        }
+        return eval(operands_, args);
+    }
+}}}
@@ -7,7 +7,7 @@
 #include <phylanx/config.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/sum_operation.hpp>
-#include <phylanx/util/matrix_iterators.hpp>
+#include <phylanx/util/blocked_reductions.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -20,6 +20,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
@@ -112,14 +113,29 @@ namespace phylanx { namespace execution_tree { namespace primitives
     primitive_argument_type sum_operation::sum2d_flat(
         arg_type&& arg, bool keep_dims) const
     {
-        auto m = arg.matrix();
-        double result = 0.;
-        for (std::size_t i = 0; i < m.columns(); ++i)
+        if (arg.is_sparse())
         {
-            auto col = blaze::column(m, i);
-            result += std::accumulate(col.begin(), col.end(), 0.);
+            // only the non-zero elements contribute to the sum
+            auto const& sm = arg.sparse_matrix();
+            double result = 0.;
+            for (std::size_t i = 0; i != sm.rows(); ++i)
+            {
+                for (auto it = sm.begin(i); it != sm.end(i); ++it)
+                {
+                    result += it->value();
+                }
+            }
+
+            if (keep_dims)
+            {
+                return primitive_argument_type{
+                    blaze::DynamicMatrix<val_type>{{result}}};
+            }
+            return primitive_argument_type{result};
         }
 
+        double result = util::blocked_sum(arg.matrix(), parallel_eval());
+
         if (keep_dims)
         {
             return primitive_argument_type{
@@ -130,28 +146,42 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
     primitive_argument_type sum_operation::sum2d_axis0(arg_type&& arg) const
     {
-        auto m = arg.matrix();
-        blaze::DynamicVector<double> result(m.columns());
-        for (std::size_t i = 0; i < m.columns(); ++i)
+        if (arg.is_sparse())
         {
-            auto col = blaze::column(m, i);
-            result[i] = std::accumulate(col.begin(), col.end(), 0.);
+            auto const& sm = arg.sparse_matrix();
+            blaze::DynamicVector<double> result(sm.columns(), 0.);
+            for (std::size_t i = 0; i != sm.rows(); ++i)
+            {
+                for (auto it = sm.begin(i); it != sm.end(i); ++it)
+                {
+                    result[it->index()] += it->value();
+                }
+            }
+            return primitive_argument_type{result};
         }
 
-        return primitive_argument_type{result};
+        return primitive_argument_type{
+            util::column_sums(arg.matrix(), parallel_eval())};
     }
 
     primitive_argument_type sum_operation::sum2d_axis1(arg_type&& arg) const
     {
-        auto m = arg.matrix();
-        blaze::DynamicVector<double> result(m.rows());
-        for (std::size_t i = 0; i < m.rows(); ++i)
+        if (arg.is_sparse())
         {
-            auto col = blaze::row(m, i);
-            result[i] = std::accumulate(col.begin(), col.end(), 0.);
+            auto const& sm = arg.sparse_matrix();
+            blaze::DynamicVector<double> result(sm.rows(), 0.);
+            for (std::size_t i = 0; i != sm.rows(); ++i)
+            {
+                for (auto it = sm.begin(i); it != sm.end(i); ++it)
+                {
+                    result[i] += it->value();
+                }
+            }
+            return primitive_argument_type{result};
         }
 
-        return primitive_argument_type{result};
+        return primitive_argument_type{
+            util::row_sums(arg.matrix(), parallel_eval())};
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -102,6 +102,14 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
     primitive_argument_type transpose_operation::transpose2d(operands_type && ops) const
     {
+        if (ops[0].is_sparse())
+        {
+            // the result is stored in compressed row format as well
+            return primitive_argument_type{ir::node_data<double>{
+                ir::node_data<double>::sparse_storage2d_type{
+                    blaze::trans(ops[0].sparse_matrix())}}};
+        }
+
         if (ops[0].is_ref())
         {
             ops[0] = blaze::trans(ops[0].matrix());
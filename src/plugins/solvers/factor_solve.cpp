@@ -0,0 +1,210 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//  Copyright (c) 2018 Shahrzad Shirzad
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/ir/ranges.hpp>
+#include <phylanx/plugins/solvers/factor_solve.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const factor_solve::match_data = {
+        hpx::util::make_tuple("solve",
+            std::vector<std::string>{"solve(_1, _2)"},
+            &create_factor_solve, &create_primitive<factor_solve>)};
+
+    ///////////////////////////////////////////////////////////////////////////
+    factor_solve::factor_solve(
+            std::vector<primitive_argument_type>&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // All right hand sides are solved for by a single LAPACK call
+        template <typename F>
+        ir::node_data<double> solve_all(ir::node_data<double>&& b, F&& f)
+        {
+            if (b.num_dimensions() == 1)
+            {
+                blaze::DynamicVector<double> x = b.is_ref() ?
+                    b.vector_copy() : std::move(b.vector_non_ref());
+
+                f(1, x.data(), static_cast<int>(x.size()));
+                return ir::node_data<double>{std::move(x)};
+            }
+
+            // LAPACK expects the right hand sides to be stored in the
+            // columns of a column-major matrix
+            blaze::DynamicMatrix<double, blaze::columnMajor> x(b.matrix());
+
+            f(static_cast<int>(x.columns()), x.data(),
+                static_cast<int>(x.spacing()));
+            return ir::node_data<double>{blaze::DynamicMatrix<double>{x}};
+        }
+    }
+
+    primitive_argument_type factor_solve::solve(
+        ir::range&& factor, arg_type&& b) const
+    {
+        // the factor object is [kind, factors, pivots, uplo], see
+        // factorization.hpp, its elements are accessed in place
+        if (factor.size() != 4 || factor.index() == 0 ||
+            !is_string_operand(factor.at(0)))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "factor_solve::solve",
+                generate_error_message(
+                    "the first operand of solve must be a factor object "
+                    "as returned by lu_factor, cholesky_factor, or "
+                    "ldlt_factor",
+                    name_, codename_));
+        }
+
+        std::string kind =
+            extract_string_value(factor.at(0), name_, codename_);
+        arg_type A = extract_numeric_value(factor.at(1), name_, codename_);
+        char uplo =
+            extract_string_value(factor.at(3), name_, codename_).front();
+
+        auto m = A.matrix();
+        int n = static_cast<int>(m.rows());
+        int lda = static_cast<int>(m.spacing());
+
+        if (b.num_dimensions() == 0 || b.dimension(0) != m.rows())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "factor_solve::solve",
+                generate_error_message(
+                    "the number of rows of the right hand side must match "
+                    "the dimensions of the factorized matrix",
+                    name_, codename_));
+        }
+
+        std::vector<int> ipiv;
+        if (kind != "cholesky")
+        {
+            auto pivots =
+                extract_integer_value(factor.at(2), name_, codename_);
+
+            ipiv.reserve(pivots.size());
+            for (std::int64_t p : pivots.vector())
+            {
+                ipiv.push_back(static_cast<int>(p));
+            }
+        }
+
+        int info = 0;
+        arg_type result;
+        if (kind == "lu")
+        {
+            // the factors were computed for A^T
+            result = detail::solve_all(std::move(b),
+                [&](int nrhs, double* x, int ldx) {
+                    blaze::getrs('T', n, nrhs, m.data(), lda, ipiv.data(), x,
+                        ldx, &info);
+                });
+        }
+        else if (kind == "cholesky")
+        {
+            result = detail::solve_all(std::move(b),
+                [&](int nrhs, double* x, int ldx) {
+                    blaze::potrs(uplo, n, nrhs, m.data(), lda, x, ldx, &info);
+                });
+        }
+        else if (kind == "ldlt")
+        {
+            result = detail::solve_all(std::move(b),
+                [&](int nrhs, double* x, int ldx) {
+                    blaze::sytrs(uplo, n, nrhs, m.data(), lda, ipiv.data(), x,
+                        ldx, &info);
+                });
+        }
+        else
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "factor_solve::solve",
+                generate_error_message(
+                    "unknown factorization kind: " + kind, name_, codename_));
+        }
+
+        if (info != 0)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "factor_solve::solve",
+                generate_error_message(
+                    "LAPACK reported an invalid argument while solving",
+                    name_, codename_));
+        }
+
+        return primitive_argument_type{std::move(result)};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> factor_solve::eval(
+        std::vector<primitive_argument_type> const& operands,
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands.size() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "factor_solve::eval",
+                generate_error_message(
+                    "the solve primitive requires exactly two operands",
+                    name_, codename_));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "factor_solve::eval",
+                generate_error_message(
+                    "the solve primitive requires that the arguments given "
+                    "by the operands array are valid",
+                    name_, codename_));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping(
+                [this_](ir::range&& factor, arg_type&& b)
+                -> primitive_argument_type
+                {
+                    return this_->solve(std::move(factor), std::move(b));
+                }),
+            list_operand(operands[0], args, name_, codename_),
+            numeric_operand(operands[1], args, name_, codename_));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> factor_solve::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return eval(args, noargs);
+        }
+        return eval(operands_, args);
+    }
+}}}
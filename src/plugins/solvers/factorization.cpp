@@ -0,0 +1,287 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//  Copyright (c) 2018 Shahrzad Shirzad
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/solvers/factorization.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+///////////////////////////////////////////////////////////////////////////////
+#define PHYLANX_FACTORIZATION_MATCH_DATA(name)                                 \
+    hpx::util::make_tuple(name,                                                \
+        std::vector<std::string>{name "(_1)", name "(_1, _2)"},                \
+        &create_factorization, &create_primitive<factorization>)
+    /**/
+
+    std::vector<match_pattern_type> const factorization::match_data = {
+        hpx::util::make_tuple("lu_factor",
+            std::vector<std::string>{"lu_factor(_1)"},
+            &create_factorization, &create_primitive<factorization>),
+        PHYLANX_FACTORIZATION_MATCH_DATA("cholesky_factor"),
+        PHYLANX_FACTORIZATION_MATCH_DATA("ldlt_factor")};
+
+#undef PHYLANX_FACTORIZATION_MATCH_DATA
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        std::string factorization_kind(std::string const& name)
+        {
+            std::string kind = name;
+
+            compiler::primitive_name_parts name_parts;
+            if (compiler::parse_primitive_name(name, name_parts))
+            {
+                kind = name_parts.primitive;
+            }
+
+            // strip the trailing "_factor"
+            return kind.substr(0, kind.rfind("_factor"));
+        }
+
+        // The factorization is performed in place, avoid copying the matrix
+        // if we own it already
+        ir::node_data<double>::storage2d_type owned_matrix(
+            ir::node_data<double>&& A)
+        {
+            if (!A.is_ref() && !A.is_sparse())
+            {
+                return std::move(A.matrix_non_ref());
+            }
+            return A.matrix_copy();
+        }
+
+        // The matrix is stored in row-major order, LAPACK sees its transpose.
+        // Since the matrix is symmetric, its lower triangle is the upper
+        // triangle of the transposed matrix.
+        char lapack_uplo(std::string const& ul)
+        {
+            return ul == "L" ? 'U' : 'L';
+        }
+
+        // LAPACK reports invalid arguments by a negative info, a failure
+        // of the factorization at the given row/column by a positive one
+        void check_info(int info, char const* func, char const* failure,
+            std::string const& name, std::string const& codename)
+        {
+            if (info < 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, func,
+                    generate_error_message(
+                        "LAPACK reported an invalid value for argument " +
+                            std::to_string(-info),
+                        name, codename));
+            }
+            if (info > 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, func,
+                    generate_error_message(std::string(failure) +
+                            " (the factorization failed at row/column " +
+                            std::to_string(info) + ")",
+                        name, codename));
+            }
+        }
+
+        primitive_argument_type pivot_indices(std::vector<int> const& ipiv)
+        {
+            blaze::DynamicVector<std::int64_t> pivots(ipiv.size());
+            for (std::size_t i = 0; i != ipiv.size(); ++i)
+            {
+                pivots[i] = ipiv[i];
+            }
+            return primitive_argument_type{
+                ir::node_data<std::int64_t>{std::move(pivots)}};
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    factorization::factorization(
+        std::vector<primitive_argument_type>&& operands,
+        std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , kind_(detail::factorization_kind(name))
+    {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A^T = P * L * U
+    primitive_argument_type factorization::lu_factor(storage2d_type&& A) const
+    {
+        int n = static_cast<int>(A.rows());
+        int lda = static_cast<int>(A.spacing());
+        std::vector<int> ipiv(n);
+        int info = 0;
+
+        blaze::getrf(n, n, A.data(), lda, ipiv.data(), &info);
+        detail::check_info(info, "factorization::lu_factor",
+            "the given matrix is singular", name_, codename_);
+
+        return primitive_argument_type{std::vector<primitive_argument_type>{
+            primitive_argument_type{std::string("lu")},
+            primitive_argument_type{ir::node_data<double>{std::move(A)}},
+            detail::pivot_indices(ipiv),
+            primitive_argument_type{std::string("U")}}};
+    }
+
+    // A^T = U^T * U (uplo == 'U') or A^T = L * L^T (uplo == 'L')
+    primitive_argument_type factorization::cholesky_factor(
+        storage2d_type&& A, char uplo) const
+    {
+        int n = static_cast<int>(A.rows());
+        int lda = static_cast<int>(A.spacing());
+        int info = 0;
+
+        blaze::potrf(uplo, n, A.data(), lda, &info);
+        detail::check_info(info, "factorization::cholesky_factor",
+            "the given matrix is not positive definite", name_, codename_);
+
+        return primitive_argument_type{std::vector<primitive_argument_type>{
+            primitive_argument_type{std::string("cholesky")},
+            primitive_argument_type{ir::node_data<double>{std::move(A)}},
+            primitive_argument_type{},
+            primitive_argument_type{std::string(1, uplo)}}};
+    }
+
+    // A^T = U * D * U^T (uplo == 'U') or A^T = L * D * L^T (uplo == 'L')
+    primitive_argument_type factorization::ldlt_factor(
+        storage2d_type&& A, char uplo) const
+    {
+        int n = static_cast<int>(A.rows());
+        int lda = static_cast<int>(A.spacing());
+        std::vector<int> ipiv(n);
+        int info = 0;
+
+        // query the optimal size of the workspace first
+        double lwork = 0.0;
+        blaze::sytrf(
+            uplo, n, A.data(), lda, ipiv.data(), &lwork, -1, &info);
+        detail::check_info(info, "factorization::ldlt_factor",
+            "the given matrix is singular", name_, codename_);
+
+        std::vector<double> work((std::max)(1, static_cast<int>(lwork)));
+        blaze::sytrf(uplo, n, A.data(), lda, ipiv.data(), work.data(),
+            static_cast<int>(work.size()), &info);
+        detail::check_info(info, "factorization::ldlt_factor",
+            "the given matrix is singular", name_, codename_);
+
+        return primitive_argument_type{std::vector<primitive_argument_type>{
+            primitive_argument_type{std::string("ldlt")},
+            primitive_argument_type{ir::node_data<double>{std::move(A)}},
+            detail::pivot_indices(ipiv),
+            primitive_argument_type{std::string(1, uplo)}}};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> factorization::eval(
+        std::vector<primitive_argument_type> const& operands,
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands.empty() || operands.size() > 2 ||
+            (kind_ == "lu" && operands.size() != 1))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "factorization::eval",
+                generate_error_message(
+                    "the factorization primitives require one operand "
+                    "(cholesky_factor and ldlt_factor accept an additional "
+                    "operand selecting the referenced triangle)",
+                    name_, codename_));
+        }
+
+        if (!valid(operands[0]) ||
+            (operands.size() == 2 && !valid(operands[1])))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "factorization::eval",
+                generate_error_message(
+                    "the factorization primitive requires that the "
+                    "arguments given by the operands array are valid",
+                    name_, codename_));
+        }
+
+        auto this_ = this->shared_from_this();
+        auto f = [this_](arg_type&& arg, std::string ul)
+            -> primitive_argument_type
+        {
+            if (arg.num_dimensions() != 2 ||
+                arg.dimension(0) != arg.dimension(1))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "factorization::eval",
+                    generate_error_message(
+                        "the factorization primitive requires its first "
+                        "operand to be a square matrix",
+                        this_->name_, this_->codename_));
+            }
+            if (ul != "L" && ul != "U")
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "factorization::eval",
+                    generate_error_message(
+                        "the factorization primitive requires its second "
+                        "operand to be either 'L' or 'U'",
+                        this_->name_, this_->codename_));
+            }
+
+            storage2d_type A = detail::owned_matrix(std::move(arg));
+            if (this_->kind_ == "lu")
+            {
+                return this_->lu_factor(std::move(A));
+            }
+            if (this_->kind_ == "cholesky")
+            {
+                return this_->cholesky_factor(
+                    std::move(A), detail::lapack_uplo(ul));
+            }
+            return this_->ldlt_factor(std::move(A), detail::lapack_uplo(ul));
+        };
+
+        if (operands.size() == 2)
+        {
+            return hpx::dataflow(hpx::launch::sync,
+                hpx::util::unwrapping(std::move(f)),
+                numeric_operand(operands[0], args, name_, codename_),
+                string_operand(operands[1], args, name_, codename_));
+        }
+
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping(
+                [f](arg_type&& arg) -> primitive_argument_type
+                {
+                    return f(std::move(arg), "L");
+                }),
+            numeric_operand(operands[0], args, name_, codename_));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> factorization::eval(
+        std::vector<primitive_argument_type> const& args) const
+    {
+        if (operands_.empty())
+        {
+            return eval(args, noargs);
+        }
+        return eval(operands_, args);
+    }
+}}}
@@ -43,6 +43,21 @@ namespace phylanx { namespace plugin
             }
         }
     };
+
+    struct factorization_plugin : plugin_base
+    {
+        void register_known_primitives() override
+        {
+            namespace pet = phylanx::execution_tree;
+
+            std::string factorization_name("_factorization");
+            for (auto const& pattern :
+                pet::primitives::factorization::match_data)
+            {
+                pet::register_pattern(factorization_name, pattern);
+            }
+        }
+    };
 }}
 
 PHYLANX_REGISTER_PLUGIN_FACTORY(phylanx::plugin::linear_solver_plugin,
@@ -54,3 +69,11 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(phylanx::plugin::decomposition_plugin,
     decomposition_plugin,
     phylanx::execution_tree::primitives::make_list::match_data,
     "_decomposition");
+
+PHYLANX_REGISTER_PLUGIN_FACTORY(phylanx::plugin::factorization_plugin,
+    factorization_plugin,
+    phylanx::execution_tree::primitives::make_list::match_data,
+    "_factorization");
+
+PHYLANX_REGISTER_PLUGIN_FACTORY(factor_solve_plugin,
+    phylanx::execution_tree::primitives::factor_solve::match_data);
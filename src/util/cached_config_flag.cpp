@@ -0,0 +1,38 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/cached_config_flag.hpp>
+
+#include <hpx/runtime/config_entry.hpp>
+
+#include <atomic>
+
+namespace phylanx { namespace util { namespace detail
+{
+    bool cached_config_flag::get()
+    {
+        int enabled = value_.load();
+        if (enabled < 0)
+        {
+            int initial = hpx::get_config_entry(
+                name_, default_value_ ? "1" : "0") == "1";
+            value_.compare_exchange_strong(enabled, initial);
+            enabled = value_.load();
+        }
+        return enabled != 0;
+    }
+
+    bool cached_config_flag::set(bool enable)
+    {
+        int previous = value_.exchange(enable ? 1 : 0);
+        if (previous < 0)
+        {
+            return hpx::get_config_entry(
+                name_, default_value_ ? "1" : "0") == "1";
+        }
+        return previous != 0;
+    }
+}}}
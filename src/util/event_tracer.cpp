@@ -0,0 +1,288 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/event_tracer.hpp>
+
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Single producer ring buffer, only the owning thread records events
+        struct event_buffer
+        {
+            event_buffer()
+              : events_(event_tracer::buffer_size)
+              , recorded_(0)
+              , overwritten_base_(0)
+            {}
+
+            void record(trace_event const& event)
+            {
+                std::uint64_t n = recorded_.load(std::memory_order_relaxed);
+                events_[n % event_tracer::buffer_size] = event;
+                recorded_.store(n + 1, std::memory_order_release);
+            }
+
+            // all events beyond the size of the buffer have overwritten an
+            // older one
+            std::uint64_t overwritten() const
+            {
+                std::uint64_t recorded =
+                    recorded_.load(std::memory_order_relaxed);
+                return recorded > event_tracer::buffer_size ?
+                    recorded - event_tracer::buffer_size : 0;
+            }
+
+            std::vector<trace_event> events_;
+            std::atomic<std::uint64_t> recorded_;
+
+            // the number of overwritten events at the time of the last reset
+            // of the counter (protected by the mutex of event_buffers)
+            std::uint64_t overwritten_base_;
+        };
+
+        struct event_buffers
+        {
+            std::mutex mtx_;
+            std::vector<std::shared_ptr<event_buffer>> buffers_;
+        };
+
+        event_buffers& get_event_buffers()
+        {
+            static event_buffers buffers;
+            return buffers;
+        }
+
+        // the buffers are kept alive by the registry after the recording
+        // thread has exited
+        event_buffer& get_event_buffer()
+        {
+            static thread_local std::shared_ptr<event_buffer> buffer;
+            if (!buffer)
+            {
+                buffer = std::make_shared<event_buffer>();
+
+                auto& buffers = get_event_buffers();
+                std::lock_guard<std::mutex> l(buffers.mtx_);
+                buffers.buffers_.push_back(buffer);
+            }
+            return *buffer;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void write_json_string(std::ostream& os, char const* str)
+        {
+            os << '"';
+            for (/**/; *str != '\0'; ++str)
+            {
+                if (*str == '"' || *str == '\\')
+                {
+                    os << '\\';
+                }
+                os << *str;
+            }
+            os << '"';
+        }
+
+        void write_microseconds(std::ostream& os, std::uint64_t ns)
+        {
+            os << ns / 1000 << "." << std::setw(3) << std::setfill('0')
+               << ns % 1000 << std::setfill(' ');
+        }
+
+        void write_operands(std::ostream& os, trace_event const& event)
+        {
+            os << "[";
+            for (std::uint32_t i = 0; i != event.num_operands_; ++i)
+            {
+                if (i != 0)
+                {
+                    os << ",";
+                }
+                if (event.dimensions_[i] < 0)
+                {
+                    os << "null";
+                    continue;
+                }
+                os << "[";
+                for (std::int8_t d = 0; d != event.dimensions_[i]; ++d)
+                {
+                    if (d != 0)
+                    {
+                        os << ",";
+                    }
+                    os << event.extents_[i][d];
+                }
+                os << "]";
+            }
+            os << "]";
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::atomic<bool> event_tracer::enabled_(false);
+
+    bool event_tracer::enable(bool enable)
+    {
+        return enabled_.exchange(enable, std::memory_order_relaxed);
+    }
+
+    void event_tracer::record(trace_event const& event)
+    {
+        detail::get_event_buffer().record(event);
+    }
+
+    std::vector<trace_event> event_tracer::snapshot()
+    {
+        std::vector<trace_event> events;
+
+        auto& buffers = detail::get_event_buffers();
+        {
+            std::lock_guard<std::mutex> l(buffers.mtx_);
+            for (auto const& buffer : buffers.buffers_)
+            {
+                std::uint64_t recorded =
+                    buffer->recorded_.load(std::memory_order_acquire);
+                std::uint64_t first =
+                    recorded > buffer_size ? recorded - buffer_size : 0;
+
+                for (std::uint64_t i = first; i != recorded; ++i)
+                {
+                    events.push_back(buffer->events_[i % buffer_size]);
+                }
+            }
+        }
+
+        std::sort(events.begin(), events.end(),
+            [](trace_event const& lhs, trace_event const& rhs)
+            {
+                return lhs.begin_ < rhs.begin_;
+            });
+
+        return events;
+    }
+
+    std::int64_t event_tracer::overwritten_count(bool reset)
+    {
+        auto& buffers = detail::get_event_buffers();
+
+        std::int64_t result = 0;
+        std::lock_guard<std::mutex> l(buffers.mtx_);
+        for (auto const& buffer : buffers.buffers_)
+        {
+            std::uint64_t overwritten = buffer->overwritten();
+            result += static_cast<std::int64_t>(
+                overwritten - buffer->overwritten_base_);
+            if (reset)
+            {
+                buffer->overwritten_base_ = overwritten;
+            }
+        }
+        return result;
+    }
+
+    void event_tracer::clear()
+    {
+        auto& buffers = detail::get_event_buffers();
+
+        std::lock_guard<std::mutex> l(buffers.mtx_);
+        for (auto const& buffer : buffers.buffers_)
+        {
+            buffer->recorded_.store(0, std::memory_order_relaxed);
+            buffer->overwritten_base_ = 0;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Every evaluation is written as a complete event ("ph": "X"), the worker
+    // threads are shown as separate tracks of the locality. Evaluations which
+    // completed asynchronously are written as a pair of async events ("ph":
+    // "b" and "e") on the tracks of the worker threads which started and
+    // completed them.
+    void event_tracer::write_chrome_trace(std::ostream& os)
+    {
+        std::vector<trace_event> events = snapshot();
+        std::uint32_t locality = hpx::get_locality_id();
+
+        os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+        bool first = true;
+        std::uint64_t async_id = 0;
+        for (auto const& event : events)
+        {
+            if (!first)
+            {
+                os << ",";
+            }
+            first = false;
+
+            // time stamps are given in microseconds
+            os << "\n{\"ph\":\"" << (event.async_ ? "b" : "X")
+               << "\",\"cat\":\"primitive\",\"name\":";
+            detail::write_json_string(os, event.name_);
+            if (event.async_)
+            {
+                os << ",\"id\":" << async_id;
+            }
+            os << ",\"pid\":" << locality
+               << ",\"tid\":" << event.worker_
+               << ",\"ts\":";
+            detail::write_microseconds(os, event.begin_);
+            if (!event.async_)
+            {
+                os << ",\"dur\":";
+                detail::write_microseconds(os, event.end_ - event.begin_);
+            }
+            os << ",\"args\":{\"thread\":\"" << std::hex << event.thread_id_
+               << std::dec << "\",\"operands\":";
+            detail::write_operands(os, event);
+            os << "}}";
+
+            if (event.async_)
+            {
+                os << ",\n{\"ph\":\"e\",\"cat\":\"primitive\",\"name\":";
+                detail::write_json_string(os, event.name_);
+                os << ",\"id\":" << async_id++
+                   << ",\"pid\":" << locality
+                   << ",\"tid\":" << event.end_worker_
+                   << ",\"ts\":";
+                detail::write_microseconds(os, event.end_);
+                os << "}";
+            }
+        }
+
+        os << "\n]}\n";
+    }
+
+    void event_tracer::write_chrome_trace(std::string const& filename)
+    {
+        std::ofstream os(filename);
+        if (!os.is_open())
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "phylanx::util::event_tracer::write_chrome_trace",
+                "couldn't open the trace file: " + filename);
+        }
+        write_chrome_trace(os);
+    }
+}}
@@ -4,12 +4,17 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/ir/storage_pool.hpp>
 #include <phylanx/plugins/plugin_factory.hpp>
+#include <phylanx/util/event_tracer.hpp>
 
 #include <hpx/include/components.hpp>
+#include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/startup_function.hpp>
 #include <hpx/runtime/shutdown_function.hpp>
 
+#include <string>
+
 namespace phylanx
 {
     namespace performance_counters
@@ -30,10 +35,29 @@ namespace phylanx { namespace util
 
         // register performance counters for all discovered primitives
         performance_counters::startup_counters();
+
+        // free the storage cached by idle threads
+        ir::start_storage_pool_trimming();
+
+        // record all evaluations if a trace file was requested
+        if (!hpx::get_config_entry("phylanx.trace_file", "").empty())
+        {
+            event_tracer::enable(true);
+        }
     }
 
     void shutdown()
     {
+        ir::stop_storage_pool_trimming();
+
+        std::string trace_file =
+            hpx::get_config_entry("phylanx.trace_file", "");
+        if (!trace_file.empty())
+        {
+            event_tracer::enable(false);
+            event_tracer::write_chrome_trace(trace_file);
+        }
+
         // unload all plugin modules
         plugin_map.clear();
     }
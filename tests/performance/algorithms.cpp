@@ -0,0 +1,335 @@
+//   Copyright (c) 2018 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the time needed to run complete PhySL programs
+// (the algorithms used by the kmeans, LRA, and ALS examples) on randomly
+// generated data of different sizes. The LRA and ALS algorithms are measured
+// both, as PhySL code and using the corresponding algorithm primitives.
+
+#include "benchmark.hpp"
+
+#include <phylanx/phylanx.hpp>
+#include <hpx/hpx_init.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <boost/program_options.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const kmeans_code = R"(block(
+    define(initialize_centroids, points, k, block(
+        define(centroids, points),
+        shuffle(centroids),
+        slice(centroids, make_list(0, k))
+    )),
+    define(closest_centroids, points, centroids, block(
+        define(points_x, add_dim(slice_column(points, 0))),
+        define(points_y, add_dim(slice_column(points, 1))),
+        define(centroids_x, slice_column(centroids, 0)),
+        define(centroids_y, slice_column(centroids, 1)),
+        argmin(sqrt(
+            power(points_x - centroids_x, 2) + power(points_y - centroids_y, 2)
+        ), 0)
+    )),
+    define(move_centroids, points, closest, centroids,
+        map(lambda(k, block(
+                define(x, closest == k),
+                mean(points * add_dim(x), 1)
+            )),
+            range(shape(centroids, 0))
+        )
+    ),
+    define(kmeans, points, k, iterations, block(
+        define(centroids, initialize_centroids(points, k)),
+        for(define(i, 0), i < iterations, store(i, i + 1),
+            store(centroids,
+                apply(vstack,
+                    move_centroids(points,
+                        closest_centroids(points, centroids), centroids)))
+        ),
+        centroids
+    )),
+    kmeans
+))";
+
+char const* const lra_code = R"(block(
+    define(lra, x, y, alpha, iterations, block(
+        define(weights, constant(0.0, shape(x, 1))),
+        define(transx, transpose(x)),
+        define(pred, constant(0.0, shape(x, 0))),
+        define(error, constant(0.0, shape(x, 0))),
+        define(gradient, constant(0.0, shape(x, 1))),
+        define(step, 0),
+        while(step < iterations,
+            block(
+                store(pred, 1.0 / (1.0 + exp(-dot(x, weights)))),
+                store(error, pred - y),
+                store(gradient, dot(transx, error)),
+                parallel_block(
+                    store(weights, weights - (alpha * gradient)),
+                    store(step, step + 1)
+                )
+            )
+        ),
+        weights
+    )),
+    lra
+))";
+
+char const* const lra_primitive_code = R"(block(
+    define(lra_primitive, x, y, alpha, iterations,
+        lra(x, y, alpha, iterations)
+    ),
+    lra_primitive
+))";
+
+char const* const als_code = R"(block(
+    define(als, ratings, regularization, num_factors, iterations, alpha,
+        block(
+            define(num_users, shape(ratings, 0)),
+            define(num_items, shape(ratings, 1)),
+            define(conf, alpha * ratings),
+            define(conf_u, constant(0.0, make_list(num_items))),
+            define(conf_i, constant(0.0, make_list(num_users))),
+            define(c_u, constant(0.0, make_list(num_items, num_items))),
+            define(c_i, constant(0.0, make_list(num_users, num_users))),
+            define(p_u, constant(0.0, make_list(num_items))),
+            define(p_i, constant(0.0, make_list(num_users))),
+            set_seed(0),
+            define(X, random(make_list(num_users, num_factors))),
+            define(Y, random(make_list(num_items, num_factors))),
+            define(I_f, identity(num_factors)),
+            define(I_i, identity(num_items)),
+            define(I_u, identity(num_users)),
+            define(k, 0),
+            define(i, 0),
+            define(u, 0),
+            define(XtX, constant(0.0, make_list(num_factors, num_factors))),
+            define(YtY, constant(0.0, make_list(num_factors, num_factors))),
+            define(A, constant(0.0, make_list(num_factors, num_factors))),
+            define(b, constant(0.0, make_list(num_factors))),
+            while(k < iterations,
+                block(
+                    store(YtY, dot(transpose(Y), Y) + regularization * I_f),
+                    store(XtX, dot(transpose(X), X) + regularization * I_f),
+                    while(u < num_users,
+                        block(
+                            store(conf_u, slice_row(conf, u)),
+                            store(c_u, diag(conf_u)),
+                            store(p_u, __ne(conf_u, 0.0, true)),
+                            store(A, dot(dot(transpose(Y), c_u), Y) + YtY),
+                            store(b, dot(dot(transpose(Y), (c_u + I_i)),
+                                transpose(p_u))),
+                            set_row(X, u, u + 1, 1, dot(inverse(A), b)),
+                            store(u, u + 1)
+                        )
+                    ),
+                    store(u, 0),
+                    while(i < num_items,
+                        block(
+                            store(conf_i, slice_column(conf, i)),
+                            store(c_i, diag(conf_i)),
+                            store(p_i, __ne(conf_i, 0.0, true)),
+                            store(A, dot(dot(transpose(X), c_i), X) + XtX),
+                            store(b, dot(dot(transpose(X), (c_i + I_u)),
+                                transpose(p_i))),
+                            set_row(Y, i, i + 1, 1, dot(inverse(A), b)),
+                            store(i, i + 1)
+                        )
+                    ),
+                    store(i, 0),
+                    store(k, k + 1)
+                )
+            ),
+            make_list(X, Y)
+        )
+    ),
+    als
+))";
+
+char const* const als_primitive_code = R"(block(
+    define(als_primitive, ratings, regularization, num_factors, iterations,
+        alpha,
+        als(ratings, regularization, num_factors, iterations, alpha)
+    ),
+    als_primitive
+))";
+
+///////////////////////////////////////////////////////////////////////////////
+struct size_category
+{
+    char const* name;
+    std::size_t points;             // kmeans: number of points
+    std::size_t samples;            // lra: number of samples
+    std::size_t features;           // lra: number of features
+    std::size_t users;              // als: number of users
+    std::size_t items;              // als: number of items
+};
+
+size_category const sizes[] =
+{
+    {"small", 250, 569, 30, 10, 20},
+    {"medium", 10000, 10000, 100, 40, 80},
+    {"large", 100000, 100000, 100, 100, 200},
+};
+
+std::int64_t const iterations = 10;
+std::int64_t const als_iterations = 2;
+std::int64_t const als_factors = 5;
+
+///////////////////////////////////////////////////////////////////////////////
+// three clusters of two dimensional points
+phylanx::ir::node_data<double> generate_points(std::size_t num_points)
+{
+    blaze::DynamicMatrix<double> points(num_points, 2);
+    for (std::size_t i = 0; i != num_points; ++i)
+    {
+        double offset = (i % 3 == 0) ? 1.0 : -0.5;
+        points(i, 0) = offset + blaze::rand<double>(0.0, 0.5);
+        points(i, 1) = (i % 3 == 1 ? 0.5 : -0.5) + blaze::rand<double>(0.0, 0.5);
+    }
+    return phylanx::ir::node_data<double>{std::move(points)};
+}
+
+phylanx::ir::node_data<double> generate_labels(std::size_t num_samples)
+{
+    blaze::DynamicVector<double> labels(num_samples);
+    for (std::size_t i = 0; i != num_samples; ++i)
+    {
+        labels[i] = blaze::rand<double>() < 0.5 ? 0.0 : 1.0;
+    }
+    return phylanx::ir::node_data<double>{std::move(labels)};
+}
+
+// roughly 20% of the items are rated by each user
+phylanx::ir::node_data<double> generate_ratings(
+    std::size_t users, std::size_t items)
+{
+    blaze::DynamicMatrix<double> ratings(users, items, 0.0);
+    for (std::size_t u = 0; u != users; ++u)
+    {
+        for (std::size_t i = 0; i != items; ++i)
+        {
+            if (blaze::rand<double>() < 0.2)
+            {
+                ratings(u, i) = double(blaze::rand<std::int64_t>(1, 5));
+            }
+        }
+    }
+    return phylanx::ir::node_data<double>{std::move(ratings)};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct algorithm
+{
+    char const* name;
+    char const* code;
+};
+
+algorithm const algorithms[] =
+{
+    {"kmeans", kmeans_code},
+    {"lra", lra_code},
+    {"lra_primitive", lra_primitive_code},
+    {"als", als_code},
+    {"als_primitive", als_primitive_code},
+};
+
+std::vector<phylanx::execution_tree::primitive_argument_type> generate_args(
+    std::string const& name, size_category const& size,
+    std::vector<std::size_t>& shape)
+{
+    std::vector<phylanx::execution_tree::primitive_argument_type> args;
+    if (name == "kmeans")
+    {
+        shape = {size.points, 2};
+        args.emplace_back(generate_points(size.points));
+        args.emplace_back(phylanx::ir::node_data<std::int64_t>{3});
+        args.emplace_back(phylanx::ir::node_data<std::int64_t>{iterations});
+    }
+    else if (name == "lra" || name == "lra_primitive")
+    {
+        shape = {size.samples, size.features};
+        blaze::Rand<blaze::DynamicMatrix<double>> mgen{};
+        args.emplace_back(phylanx::ir::node_data<double>{
+            mgen.generate(size.samples, size.features, -1.0, 1.0)});
+        args.emplace_back(generate_labels(size.samples));
+        args.emplace_back(phylanx::ir::node_data<double>{1e-5});
+        args.emplace_back(phylanx::ir::node_data<std::int64_t>{iterations});
+    }
+    else
+    {
+        shape = {size.users, size.items};
+        args.emplace_back(generate_ratings(size.users, size.items));
+        args.emplace_back(phylanx::ir::node_data<double>{0.1});
+        args.emplace_back(phylanx::ir::node_data<std::int64_t>{als_factors});
+        args.emplace_back(
+            phylanx::ir::node_data<std::int64_t>{als_iterations});
+        args.emplace_back(phylanx::ir::node_data<double>{40.0});
+    }
+    return args;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    using arguments_type =
+        std::vector<phylanx::execution_tree::primitive_argument_type>;
+
+    auto params = phylanx::performance::get_measurement_parameters(vm);
+    auto selected_sizes = phylanx::performance::get_sizes(vm);
+
+    std::vector<phylanx::performance::benchmark_result> results;
+    for (auto const& alg : algorithms)
+    {
+        if (!phylanx::performance::is_selected(vm, alg.name))
+        {
+            continue;
+        }
+
+        phylanx::execution_tree::compiler::function_list snippets;
+        auto f = phylanx::execution_tree::compile(alg.name, alg.code, snippets);
+
+        for (auto const& size : sizes)
+        {
+            if (std::find(selected_sizes.begin(), selected_sizes.end(),
+                    size.name) == selected_sizes.end())
+            {
+                continue;
+            }
+
+            phylanx::performance::benchmark_result result;
+            result.family = "algorithms";
+            result.name = alg.name;
+            result.size = size.name;
+            result.operands = "ref";
+
+            arguments_type const args =
+                generate_args(alg.name, size, result.shape);
+
+            result.time = phylanx::performance::measure(
+                [&]() { f(args); }, params);
+
+            results.push_back(std::move(result));
+        }
+    }
+
+    phylanx::performance::report(vm, "algorithms", results);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    auto desc =
+        phylanx::performance::benchmark_options("usage: algorithms [options]");
+    return hpx::init(desc, argc, argv);
+}
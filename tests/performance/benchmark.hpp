@@ -0,0 +1,281 @@
+//   Copyright (c) 2018 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Minimal infrastructure shared by the benchmarks: timing of a callable
+// until enough samples have been collected, and a JSON report of the
+// collected results which can be compared between releases.
+
+#if !defined(PHYLANX_TESTS_PERFORMANCE_BENCHMARK_JUL_24_2018_0215PM)
+#define PHYLANX_TESTS_PERFORMANCE_BENCHMARK_JUL_24_2018_0215PM
+
+#include <phylanx/phylanx.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+namespace phylanx { namespace performance
+{
+    ///////////////////////////////////////////////////////////////////////////
+    struct statistics
+    {
+        std::size_t iterations = 0;
+        double min = 0.0;
+        double max = 0.0;
+        double mean = 0.0;
+        double stddev = 0.0;
+    };
+
+    struct measurement_parameters
+    {
+        double min_time = 0.5;              // [s]
+        std::size_t min_iterations = 3;
+        std::size_t max_iterations = 1000;
+    };
+
+    // Repeatedly invoke the given function until both, the minimal number
+    // of iterations has been executed and the minimal amount of time has
+    // been spent (or the maximal number of iterations has been reached). The
+    // function is invoked once more up front to warm up caches.
+    template <typename F>
+    statistics measure(F && f, measurement_parameters const& params)
+    {
+        f();
+
+        std::vector<double> samples;
+        hpx::util::high_resolution_timer total;
+        while (samples.size() < params.min_iterations ||
+            (total.elapsed() < params.min_time &&
+                samples.size() < params.max_iterations))
+        {
+            hpx::util::high_resolution_timer t;
+            f();
+            samples.push_back(t.elapsed());
+        }
+
+        statistics result;
+        result.iterations = samples.size();
+        result.min = *std::min_element(samples.begin(), samples.end());
+        result.max = *std::max_element(samples.begin(), samples.end());
+
+        double sum = 0.0;
+        for (double s : samples)
+        {
+            sum += s;
+        }
+        result.mean = sum / samples.size();
+
+        double variance = 0.0;
+        for (double s : samples)
+        {
+            variance += (s - result.mean) * (s - result.mean);
+        }
+        result.stddev = std::sqrt(variance / samples.size());
+
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct benchmark_result
+    {
+        std::string family;
+        std::string name;
+        std::string size;                   // small, medium, or large
+        std::vector<std::size_t> shape;     // empty for scalars
+        std::string operands;               // ref, owned, or n/a
+        statistics time;
+
+        // time needed to evaluate only the operands of the benchmarked
+        // expression, not reported if no iterations were measured
+        statistics baseline;
+    };
+
+    namespace detail
+    {
+        inline std::string json_string(std::string const& s)
+        {
+            std::string result("\"");
+            for (char c : s)
+            {
+                switch (c)
+                {
+                case '"':  result += "\\\""; break;
+                case '\\': result += "\\\\"; break;
+                case '\n': result += "\\n"; break;
+                case '\t': result += "\\t"; break;
+                default:   result += c; break;
+                }
+            }
+            return result + "\"";
+        }
+
+        inline void write_json(std::ostream& os, statistics const& s)
+        {
+            os << "{\"iterations\": " << s.iterations
+               << ", \"min\": " << s.min
+               << ", \"max\": " << s.max
+               << ", \"mean\": " << s.mean
+               << ", \"stddev\": " << s.stddev << "}";
+        }
+
+        inline std::string current_date()
+        {
+            std::time_t now = std::time(nullptr);
+            char buffer[32] = {0};
+            std::strftime(
+                buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+            return buffer;
+        }
+    }
+
+    // Write all results as a single JSON object of the form:
+    //
+    //  {
+    //      "suite": "<suite>",
+    //      "context": { "phylanx_version": ..., "threads": ..., ... },
+    //      "benchmarks": [
+    //          { "family": ..., "name": ..., "size": ..., "shape": [...],
+    //            "operands": ..., "time": { ... }, "baseline": { ... } },
+    //          ...
+    //      ]
+    //  }
+    //
+    // All times are given in seconds.
+    inline void write_json(std::ostream& os, std::string const& suite,
+        std::vector<benchmark_result> const& results)
+    {
+        os.precision(9);
+        os << "{\n"
+           << "  \"suite\": " << detail::json_string(suite) << ",\n"
+           << "  \"context\": {"
+           << "\"phylanx_version\": "
+           << detail::json_string(phylanx::full_version_as_string())
+           << ", \"localities\": " << hpx::get_num_localities(hpx::launch::sync)
+           << ", \"threads\": " << hpx::get_os_thread_count()
+           << ", \"date\": " << detail::json_string(detail::current_date())
+           << "},\n"
+           << "  \"benchmarks\": [";
+
+        bool first = true;
+        for (auto const& r : results)
+        {
+            os << (first ? "\n" : ",\n");
+            first = false;
+
+            os << "    {\"family\": " << detail::json_string(r.family)
+               << ", \"name\": " << detail::json_string(r.name)
+               << ", \"size\": " << detail::json_string(r.size)
+               << ", \"shape\": [";
+            for (std::size_t i = 0; i != r.shape.size(); ++i)
+            {
+                os << (i == 0 ? "" : ", ") << r.shape[i];
+            }
+            os << "], \"operands\": " << detail::json_string(r.operands)
+               << ", \"time\": ";
+            detail::write_json(os, r.time);
+            if (r.baseline.iterations != 0)
+            {
+                os << ", \"baseline\": ";
+                detail::write_json(os, r.baseline);
+            }
+            os << "}";
+        }
+        os << "\n  ]\n}\n";
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Command line options common to all benchmarks
+    inline boost::program_options::options_description
+    benchmark_options(std::string const& usage)
+    {
+        boost::program_options::options_description desc(usage);
+        desc.add_options()
+            ("output",
+                boost::program_options::value<std::string>(),
+                "write the JSON results to the given file (default: stdout)")
+            ("filter",
+                boost::program_options::value<std::string>()->default_value(""),
+                "run only benchmarks whose name contains the given string")
+            ("sizes",
+                boost::program_options::value<std::string>()
+                    ->default_value("small,medium,large"),
+                "comma separated list of problem sizes to run "
+                "(default: small,medium,large)")
+            ("min_time",
+                boost::program_options::value<double>()->default_value(0.5),
+                "minimal time spent measuring each benchmark [s] "
+                "(default: 0.5)")
+            ("min_iterations",
+                boost::program_options::value<std::size_t>()->default_value(3),
+                "minimal number of measured iterations (default: 3)")
+            ("max_iterations",
+                boost::program_options::value<std::size_t>()
+                    ->default_value(1000),
+                "maximal number of measured iterations (default: 1000)")
+        ;
+        return desc;
+    }
+
+    inline measurement_parameters get_measurement_parameters(
+        boost::program_options::variables_map& vm)
+    {
+        measurement_parameters params;
+        params.min_time = vm["min_time"].as<double>();
+        params.min_iterations =
+            (std::max)(std::size_t(1), vm["min_iterations"].as<std::size_t>());
+        params.max_iterations = (std::max)(
+            params.min_iterations, vm["max_iterations"].as<std::size_t>());
+        return params;
+    }
+
+    inline std::vector<std::string> get_sizes(
+        boost::program_options::variables_map& vm)
+    {
+        std::vector<std::string> sizes;
+        std::istringstream strm(vm["sizes"].as<std::string>());
+        std::string size;
+        while (std::getline(strm, size, ','))
+        {
+            if (!size.empty())
+            {
+                sizes.push_back(size);
+            }
+        }
+        return sizes;
+    }
+
+    inline bool is_selected(boost::program_options::variables_map& vm,
+        std::string const& name)
+    {
+        return name.find(vm["filter"].as<std::string>()) != std::string::npos;
+    }
+
+    inline void report(boost::program_options::variables_map& vm,
+        std::string const& suite, std::vector<benchmark_result> const& results)
+    {
+        if (vm.count("output") != 0)
+        {
+            std::ofstream os(vm["output"].as<std::string>());
+            write_json(os, suite, results);
+        }
+        else
+        {
+            write_json(std::cout, suite, results);
+        }
+    }
+}}
+
+#endif
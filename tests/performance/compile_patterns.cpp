@@ -0,0 +1,133 @@
+//   Copyright (c) 2018 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the time needed to compile a large PhySL program
+// using the indexed pattern list (the default) and using a plain list of
+// patterns which requires matching each expression against every known
+// pattern.
+
+#include <phylanx/phylanx.hpp>
+#include <hpx/hpx_init.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+std::string generate_program(std::size_t num_statements)
+{
+    std::ostringstream code;
+    code << "define(f, a, b, block(\n";
+    code << "    define(x0, a + b),\n";
+    for (std::size_t i = 1; i != num_statements; ++i)
+    {
+        std::string prev = "x" + std::to_string(i - 1);
+        code << "    define(x" << i << ", ";
+        switch (i % 6)
+        {
+        case 0:
+            code << prev << " * 2.0 - a / 3.0";
+            break;
+        case 1:
+            code << "if(" << prev << " < b, -" << prev << ", " << prev << ")";
+            break;
+        case 2:
+            code << "exp(" << prev << ") + sqrt(absolute(" << prev << "))";
+            break;
+        case 3:
+            code << "dot(" << prev << ", b) + sum(" << prev << ")";
+            break;
+        case 4:
+            code << "if(" << prev << " == a, " << prev << ", " << prev
+                 << " + 1.0)";
+            break;
+        default:
+            code << "(" << prev << " != a) || (" << prev << " > b)";
+            break;
+        }
+        code << "),\n";
+    }
+    code << "    x" << num_statements - 1 << "\n))\n";
+    return code.str();
+}
+
+double compile_program(std::vector<phylanx::ast::expression> const& exprs,
+    phylanx::execution_tree::compiler::expression_pattern_list const& patterns,
+    std::size_t iterations)
+{
+    hpx::util::high_resolution_timer t;
+    for (std::size_t i = 0; i != iterations; ++i)
+    {
+        phylanx::execution_tree::compiler::function_list snippets;
+        phylanx::execution_tree::compiler::environment env =
+            phylanx::execution_tree::compiler::default_environment(
+                hpx::find_here());
+
+        for (auto const& expr : exprs)
+        {
+            phylanx::execution_tree::compiler::compile(
+                "compile_patterns", expr, snippets, env, patterns,
+                hpx::find_here());
+        }
+    }
+    return t.elapsed() / iterations;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    auto num_statements = vm["num_statements"].as<std::size_t>();
+    auto iterations = vm["iterations"].as<std::size_t>();
+
+    auto exprs =
+        phylanx::ast::generate_ast(generate_program(num_statements));
+
+    // the indexed list of patterns as used by the compiler
+    phylanx::execution_tree::compiler::expression_pattern_list indexed =
+        phylanx::execution_tree::compiler::generate_patterns(
+            phylanx::execution_tree::get_all_known_patterns());
+
+    // the same patterns without the index, this forces the compiler to
+    // match each expression against all patterns
+    phylanx::execution_tree::compiler::expression_pattern_list unindexed =
+        indexed;
+    unindexed.clear_index();
+
+    // warm up
+    compile_program(exprs, indexed, 1);
+
+    double unindexed_time = compile_program(exprs, unindexed, iterations);
+    double indexed_time = compile_program(exprs, indexed, iterations);
+
+    std::cout << "patterns: " << indexed.size()
+              << ", statements: " << num_statements
+              << ", iterations: " << iterations << "\n"
+              << "linear pattern matching:  " << unindexed_time << " [s]\n"
+              << "indexed pattern matching: " << indexed_time << " [s]\n"
+              << "speedup: " << unindexed_time / indexed_time << "\n";
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description desc("usage: compile_patterns [options]");
+    desc.add_options()
+        ("num_statements",
+            boost::program_options::value<std::size_t>()->default_value(1000),
+            "number of statements in the generated PhySL program (default: 1000)")
+        ("iterations",
+            boost::program_options::value<std::size_t>()->default_value(10),
+            "number of times the program is compiled (default: 10)")
+    ;
+
+    return hpx::init(desc, argc, argv);
+}
@@ -0,0 +1,149 @@
+//   Copyright (c) 2018 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the overheads of the loop primitives (for, while)
+// and of block statements for loops with scalar counters whose condition
+// and body are evaluated synchronously. Each loop is run once with loop
+// trampolining enabled (iterations are executed in place as long as the
+// evaluated operands are ready) and once with it disabled (each step is
+// attached as a continuation to the future of the previous step).
+
+#include "benchmark.hpp"
+
+#include <phylanx/phylanx.hpp>
+#include <hpx/hpx_init.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const for_code = R"(block(
+    define(loop_for, n, block(
+        define(sum, 0),
+        for(define(i, 0), i < n, store(i, i + 1), store(sum, sum + i)),
+        sum
+    )),
+    loop_for
+))";
+
+char const* const while_code = R"(block(
+    define(loop_while, n, block(
+        define(i, 0),
+        while(i < n, store(i, i + 1)),
+        i
+    )),
+    loop_while
+))";
+
+char const* const while_block_code = R"(block(
+    define(loop_while_block, n, block(
+        define(i, 0),
+        define(sum, 0),
+        while(i < n,
+            block(
+                store(sum, sum + i),
+                store(i, i + 1)
+            )
+        ),
+        sum
+    )),
+    loop_while_block
+))";
+
+struct loop
+{
+    char const* name;
+    char const* code;
+};
+
+loop const loops[] =
+{
+    {"for", for_code},
+    {"while", while_code},
+    {"while_block", while_block_code},
+};
+
+///////////////////////////////////////////////////////////////////////////////
+struct size_category
+{
+    char const* name;
+    std::int64_t iterations;
+};
+
+size_category const sizes[] =
+{
+    {"small", 1000},
+    {"medium", 100000},
+    {"large", 1000000},
+};
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    auto params = phylanx::performance::get_measurement_parameters(vm);
+    auto selected_sizes = phylanx::performance::get_sizes(vm);
+
+    std::vector<phylanx::performance::benchmark_result> results;
+    for (auto const& l : loops)
+    {
+        if (!phylanx::performance::is_selected(vm, l.name))
+        {
+            continue;
+        }
+
+        phylanx::execution_tree::compiler::function_list snippets;
+        auto f = phylanx::execution_tree::compile(l.name, l.code, snippets);
+
+        for (auto const& size : sizes)
+        {
+            if (std::find(selected_sizes.begin(), selected_sizes.end(),
+                    size.name) == selected_sizes.end())
+            {
+                continue;
+            }
+
+            phylanx::execution_tree::primitive_argument_type const n{
+                phylanx::ir::node_data<std::int64_t>{size.iterations}};
+
+            for (bool trampoline : {true, false})
+            {
+                bool enabled =
+                    phylanx::execution_tree::enable_loop_trampolining(
+                        trampoline);
+
+                phylanx::performance::benchmark_result result;
+                result.family = "controls";
+                result.name = std::string(l.name) +
+                    (trampoline ? "_trampolined" : "_chained");
+                result.size = size.name;
+                result.shape = {std::size_t(size.iterations)};
+                result.operands = "n/a";
+                result.time = phylanx::performance::measure(
+                    [&]() { f(n); }, params);
+
+                results.push_back(std::move(result));
+
+                phylanx::execution_tree::enable_loop_trampolining(enabled);
+            }
+        }
+    }
+
+    phylanx::performance::report(vm, "loops", results);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    auto desc =
+        phylanx::performance::benchmark_options("usage: loops [options]");
+    return hpx::init(desc, argc, argv);
+}
@@ -0,0 +1,347 @@
+//   Copyright (c) 2018 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the time needed to evaluate the primitives of the
+// arithmetics, booleans, matrixops, solvers, and controls families for a
+// grid of operand shapes (0d/1d/2d, small/medium/large sizes). Each
+// expression is evaluated once with operands that are references to the
+// arguments passed to the compiled function (ref) and once with operands
+// that are temporaries owned by the evaluated primitive (owned).
+//
+// Temporaries can only be created by evaluating another expression. The time
+// needed to evaluate the operands alone is therefore reported as the
+// 'baseline' of each measurement.
+
+#include "benchmark.hpp"
+
+#include <phylanx/phylanx.hpp>
+#include <hpx/hpx_init.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#include <boost/program_options.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+enum class operands_layout
+{
+    numeric,            // all operands have the same shape
+    matrix_vector,      // symmetric positive definite matrix and a vector
+    list                // all operands are lists
+};
+
+struct operation
+{
+    char const* family;
+    char const* name;
+    char const* expr;           // expression using the operands {1} and {2}
+    std::size_t arity;
+    std::size_t dims_mask;      // (1 << dims) for each supported dimension
+    operands_layout layout;
+};
+
+std::size_t const d0 = 1 << 0;
+std::size_t const d1 = 1 << 1;
+std::size_t const d2 = 1 << 2;
+
+operation const operations[] =
+{
+    // arithmetics
+    {"arithmetics", "add", "{1} + {2}", 2, d0 | d1 | d2,
+        operands_layout::numeric},
+    {"arithmetics", "sub", "{1} - {2}", 2, d0 | d1 | d2,
+        operands_layout::numeric},
+    {"arithmetics", "mul", "{1} * {2}", 2, d0 | d1 | d2,
+        operands_layout::numeric},
+    {"arithmetics", "div", "{1} / {2}", 2, d0 | d1 | d2,
+        operands_layout::numeric},
+    {"arithmetics", "unary_minus", "-{1}", 1, d0 | d1 | d2,
+        operands_layout::numeric},
+
+    // booleans
+    {"booleans", "less", "{1} < {2}", 2, d0 | d1 | d2,
+        operands_layout::numeric},
+    {"booleans", "equal", "{1} == {2}", 2, d0 | d1 | d2,
+        operands_layout::numeric},
+    {"booleans", "and", "{1} && {2}", 2, d0 | d1 | d2,
+        operands_layout::numeric},
+    {"booleans", "not", "!{1}", 1, d0 | d1 | d2, operands_layout::numeric},
+
+    // matrixops
+    {"matrixops", "dot", "dot({1}, {2})", 2, d1 | d2,
+        operands_layout::numeric},
+    {"matrixops", "transpose", "transpose({1})", 1, d2,
+        operands_layout::numeric},
+    {"matrixops", "sum", "sum({1})", 1, d1 | d2, operands_layout::numeric},
+    {"matrixops", "argmax", "argmax({1})", 1, d1, operands_layout::numeric},
+    {"matrixops", "exp", "exp({1})", 1, d0 | d1 | d2,
+        operands_layout::numeric},
+    {"matrixops", "power", "power({1}, 2)", 1, d0 | d1 | d2,
+        operands_layout::numeric},
+    {"matrixops", "inverse", "inverse({1})", 1, d2,
+        operands_layout::numeric},
+    {"matrixops", "determinant", "determinant({1})", 1, d2,
+        operands_layout::numeric},
+
+    // solvers
+    {"solvers", "linear_solver_lu", "linear_solver_lu({1}, {2})", 2, d2,
+        operands_layout::matrix_vector},
+    {"solvers", "linear_solver_ldlt", "linear_solver_ldlt({1}, {2})", 2, d2,
+        operands_layout::matrix_vector},
+    {"solvers", "linear_solver_cholesky", "linear_solver_cholesky({1}, {2})",
+        2, d2, operands_layout::matrix_vector},
+    {"solvers", "lu", "lu({1})", 1, d2, operands_layout::matrix_vector},
+
+    // controls
+    {"controls", "map", "map(lambda(x, x + 1.0), {1})", 1, d1,
+        operands_layout::list},
+    {"controls", "parallel_map", "parallel_map(lambda(x, x + 1.0), {1})", 1,
+        d1, operands_layout::list},
+    {"controls", "fold_left", "fold_left(lambda(x, y, x + y), 0.0, {1})", 1,
+        d1, operands_layout::list},
+    {"controls", "filter", "filter(lambda(x, x < 0.5), {1})", 1, d1,
+        operands_layout::list},
+};
+
+///////////////////////////////////////////////////////////////////////////////
+struct size_category
+{
+    char const* name;
+    std::size_t vector_size;        // number of elements of 1d operands
+    std::size_t matrix_size;        // number of rows/columns of 2d operands
+    std::size_t list_size;          // number of elements of lists
+};
+
+size_category const sizes[] =
+{
+    {"small", 64, 8, 16},
+    {"medium", 16384, 128, 256},
+    {"large", 1048576, 1024, 4096},
+};
+
+std::vector<std::size_t> get_shape(
+    operation const& op, size_category const& size, std::size_t dims)
+{
+    if (op.layout == operands_layout::list)
+    {
+        return {size.list_size};
+    }
+
+    switch (dims)
+    {
+    case 1:
+        return {size.vector_size};
+
+    case 2:
+        return {size.matrix_size, size.matrix_size};
+
+    default:
+        break;
+    }
+    return {};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Generate the arguments for the given operation
+std::vector<phylanx::execution_tree::primitive_argument_type> generate_args(
+    operation const& op, std::vector<std::size_t> const& shape)
+{
+    std::vector<phylanx::execution_tree::primitive_argument_type> args;
+    args.reserve(op.arity);
+
+    switch (op.layout)
+    {
+    case operands_layout::numeric:
+        {
+            blaze::Rand<blaze::DynamicVector<double>> vgen{};
+            blaze::Rand<blaze::DynamicMatrix<double>> mgen{};
+            for (std::size_t i = 0; i != op.arity; ++i)
+            {
+                switch (shape.size())
+                {
+                case 0:
+                    args.emplace_back(phylanx::ir::node_data<double>{
+                        blaze::rand<double>(0.5, 1.0)});
+                    break;
+
+                case 1:
+                    args.emplace_back(phylanx::ir::node_data<double>{
+                        vgen.generate(shape[0], 0.5, 1.0)});
+                    break;
+
+                default:
+                    args.emplace_back(phylanx::ir::node_data<double>{
+                        mgen.generate(shape[0], shape[1], 0.5, 1.0)});
+                    break;
+                }
+            }
+        }
+        break;
+
+    case operands_layout::matrix_vector:
+        {
+            // make the matrix symmetric and diagonally dominant to allow
+            // using it with all solvers
+            blaze::Rand<blaze::DynamicMatrix<double>> mgen{};
+            blaze::DynamicMatrix<double> m = mgen.generate(shape[0], shape[1]);
+            blaze::DynamicMatrix<double> a = m * blaze::trans(m);
+            for (std::size_t i = 0; i != a.rows(); ++i)
+            {
+                a(i, i) += double(a.rows());
+            }
+            args.emplace_back(phylanx::ir::node_data<double>{std::move(a)});
+
+            if (op.arity == 2)
+            {
+                blaze::Rand<blaze::DynamicVector<double>> vgen{};
+                args.emplace_back(phylanx::ir::node_data<double>{
+                    vgen.generate(shape[0])});
+            }
+        }
+        break;
+
+    case operands_layout::list:
+        {
+            for (std::size_t i = 0; i != op.arity; ++i)
+            {
+                std::vector<phylanx::execution_tree::primitive_argument_type>
+                    elements;
+                elements.reserve(shape[0]);
+                for (std::size_t j = 0; j != shape[0]; ++j)
+                {
+                    elements.emplace_back(phylanx::ir::node_data<double>{
+                        blaze::rand<double>()});
+                }
+                args.emplace_back(phylanx::ir::range{std::move(elements)});
+            }
+        }
+        break;
+    }
+    return args;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Compose the PhySL code for the given operation. Owned operands are created
+// by evaluating an expression which returns a new temporary holding the same
+// values as the corresponding argument.
+std::string operand(operation const& op, char const* arg, bool owned)
+{
+    if (!owned)
+    {
+        return arg;
+    }
+    if (op.layout == operands_layout::list)
+    {
+        return hpx::util::format("apply(make_list, {1})", arg);
+    }
+    return hpx::util::format("({1} * 1.0)", arg);
+}
+
+std::string generate_code(operation const& op, bool owned, bool baseline)
+{
+    std::string a = operand(op, "a", owned);
+    std::string b = operand(op, "b", owned);
+
+    std::string params = op.arity == 1 ? "a" : "a, b";
+    std::string body;
+    if (baseline)
+    {
+        body = op.arity == 1 ? a : hpx::util::format("make_list({1}, {2})", a, b);
+    }
+    else
+    {
+        body = hpx::util::format(op.expr, a, b);
+    }
+    return hpx::util::format("define(f, {1}, {2})", params, body);
+}
+
+phylanx::execution_tree::compiler::function compile(std::string const& code)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    return phylanx::execution_tree::compile("primitives", code, snippets);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void run_benchmark(operation const& op, size_category const& size,
+    std::size_t dims, bool owned,
+    phylanx::performance::measurement_parameters const& params,
+    std::vector<phylanx::performance::benchmark_result>& results)
+{
+    using arguments_type =
+        std::vector<phylanx::execution_tree::primitive_argument_type>;
+
+    auto shape = get_shape(op, size, dims);
+    arguments_type const args = generate_args(op, shape);
+
+    auto f = compile(generate_code(op, owned, false));
+    auto baseline = compile(generate_code(op, owned, true));
+
+    phylanx::performance::benchmark_result result;
+    result.family = op.family;
+    result.name = op.name;
+    result.size = size.name;
+    result.shape = std::move(shape);
+    result.operands = owned ? "owned" : "ref";
+    result.time = phylanx::performance::measure(
+        [&]() { f(args); }, params);
+    result.baseline = phylanx::performance::measure(
+        [&]() { baseline(args); }, params);
+
+    results.push_back(std::move(result));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    auto params = phylanx::performance::get_measurement_parameters(vm);
+    auto selected_sizes = phylanx::performance::get_sizes(vm);
+
+    std::vector<phylanx::performance::benchmark_result> results;
+    for (auto const& op : operations)
+    {
+        if (!phylanx::performance::is_selected(vm, op.name))
+        {
+            continue;
+        }
+
+        for (auto const& size : sizes)
+        {
+            if (std::find(selected_sizes.begin(), selected_sizes.end(),
+                    size.name) == selected_sizes.end())
+            {
+                continue;
+            }
+
+            for (std::size_t dims = 0; dims != 3; ++dims)
+            {
+                // scalars are run only once, as part of the small sizes
+                if ((op.dims_mask & (std::size_t(1) << dims)) == 0 ||
+                    (dims == 0 && size.vector_size != sizes[0].vector_size))
+                {
+                    continue;
+                }
+
+                run_benchmark(op, size, dims, false, params, results);
+                run_benchmark(op, size, dims, true, params, results);
+            }
+        }
+    }
+
+    phylanx::performance::report(vm, "primitives", results);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    auto desc =
+        phylanx::performance::benchmark_options("usage: primitives [options]");
+    return hpx::init(desc, argc, argv);
+}
@@ -0,0 +1,160 @@
+//   Copyright (c) 2018 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <utility>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const ratings = R"([
+        [0, 0, 4, 0, 1, 0],
+        [5, 0, 0, 0, 0, 3],
+        [0, 1, 0, 2, 0, 0],
+        [0, 0, 0, 0, 5, 0],
+        [3, 0, 1, 0, 0, 4]
+    ])";
+
+using factors_type = std::pair<blaze::DynamicMatrix<double>,
+    blaze::DynamicMatrix<double>>;
+
+factors_type run_als(std::string const& ratings_expr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const als = phylanx::execution_tree::compile(
+        "als(" + ratings_expr + ", 0.1, 3, 5, 40.0)", snippets);
+
+    auto result = phylanx::execution_tree::extract_list_value(als());
+    HPX_TEST_EQ(result.size(), std::size_t(2));
+
+    auto it = result.begin();
+    auto X = phylanx::execution_tree::extract_numeric_value(*it++);
+    auto Y = phylanx::execution_tree::extract_numeric_value(*it);
+
+    return factors_type{X.matrix(), Y.matrix()};
+}
+
+bool almost_equal(blaze::DynamicMatrix<double> const& lhs,
+    blaze::DynamicMatrix<double> const& rhs, double eps = 1e-8)
+{
+    return lhs.rows() == rhs.rows() && lhs.columns() == rhs.columns() &&
+        blaze::maxNorm(lhs - rhs) < eps;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Straightforward implementation of the implicit feedback ALS algorithm, the
+// factors are initialized in the same way as done by the als primitive
+void baseline_update(blaze::DynamicMatrix<double>& X,
+    blaze::DynamicMatrix<double> const& Y,
+    blaze::DynamicMatrix<double> const& YtY,
+    blaze::DynamicMatrix<double> const& conf)
+{
+    for (std::size_t u = 0; u != X.rows(); ++u)
+    {
+        blaze::DynamicMatrix<double> A = YtY;
+        blaze::DynamicVector<double> b(Y.columns(), 0.0);
+
+        for (std::size_t j = 0; j != conf.columns(); ++j)
+        {
+            if (conf(u, j) != 0.0)
+            {
+                blaze::DynamicVector<double> y = blaze::trans(blaze::row(Y, j));
+                A += conf(u, j) * (y * blaze::trans(y));
+                b += (1.0 + conf(u, j)) * y;
+            }
+        }
+
+        blaze::row(X, u) = blaze::trans(blaze::inv(A) * b);
+    }
+}
+
+factors_type baseline_als(blaze::DynamicMatrix<double> const& ratings,
+    double regularization, std::size_t num_factors, std::size_t iterations,
+    double alpha)
+{
+    blaze::DynamicMatrix<double> conf = alpha * ratings;
+    blaze::DynamicMatrix<double> conf_t = blaze::trans(conf);
+
+    blaze::DynamicMatrix<double> X(ratings.rows(), num_factors);
+    blaze::DynamicMatrix<double> Y(ratings.columns(), num_factors);
+
+    std::mt19937 rng{0};
+    std::uniform_real_distribution<double> dist;
+
+    for (std::size_t i = 0; i != X.rows(); ++i)
+    {
+        for (std::size_t j = 0; j != X.columns(); ++j)
+        {
+            X(i, j) = dist(rng);
+        }
+    }
+    for (std::size_t i = 0; i != Y.rows(); ++i)
+    {
+        for (std::size_t j = 0; j != Y.columns(); ++j)
+        {
+            Y(i, j) = dist(rng);
+        }
+    }
+
+    blaze::IdentityMatrix<double> I(num_factors);
+    for (std::size_t step = 0; step != iterations; ++step)
+    {
+        blaze::DynamicMatrix<double> YtY =
+            blaze::trans(Y) * Y + regularization * I;
+        blaze::DynamicMatrix<double> XtX =
+            blaze::trans(X) * X + regularization * I;
+
+        baseline_update(X, Y, YtY, conf);
+        baseline_update(Y, X, XtX, conf_t);
+    }
+
+    return factors_type{std::move(X), std::move(Y)};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_als_sparse()
+{
+    factors_type dense = run_als(ratings);
+    factors_type sparse = run_als(std::string("sparse(") + ratings + ")");
+
+    HPX_TEST(almost_equal(dense.first, sparse.first));
+    HPX_TEST(almost_equal(dense.second, sparse.second));
+}
+
+void test_als_baseline()
+{
+    blaze::DynamicMatrix<double> ratings_matrix{
+        {0, 0, 4, 0, 1, 0},
+        {5, 0, 0, 0, 0, 3},
+        {0, 1, 0, 2, 0, 0},
+        {0, 0, 0, 0, 5, 0},
+        {3, 0, 1, 0, 0, 4}};
+
+    factors_type expected = baseline_als(ratings_matrix, 0.1, 3, 5, 40.0);
+
+    factors_type dense = run_als(ratings);
+    HPX_TEST(almost_equal(dense.first, expected.first, 1e-6));
+    HPX_TEST(almost_equal(dense.second, expected.second, 1e-6));
+
+    factors_type sparse = run_als(std::string("sparse(") + ratings + ")");
+    HPX_TEST(almost_equal(sparse.first, expected.first, 1e-6));
+    HPX_TEST(almost_equal(sparse.second, expected.second, 1e-6));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_als_sparse();
+    test_als_baseline();
+
+    return hpx::util::report_errors();
+}
@@ -30,6 +30,38 @@ void test_transform_ast(char const* matchstr, char const* rulestr,
     HPX_TEST_EQ(result, expected);
 }
 
+void test_rewrite_ast(char const* exprstr, char const* rulesstr,
+    char const* expectedstr)
+{
+    auto expr = phylanx::ast::generate_ast(exprstr);
+    auto rules = phylanx::ast::generate_transform_rules(rulesstr);
+
+    auto result = phylanx::ast::rewrite_ast(expr, rules);
+
+    std::cout << phylanx::ast::to_string(result[0]) << '\n';
+
+    auto expected = phylanx::ast::generate_ast(expectedstr);
+
+    HPX_TEST_EQ(result, expected);
+}
+
+void test_rewrite_ast_limit()
+{
+    auto expr = phylanx::ast::generate_ast("A + B");
+    auto rules = phylanx::ast::generate_transform_rules("_1 + _2 : _2 + _1");
+
+    bool caught_exception = false;
+    try
+    {
+        phylanx::ast::rewrite_ast(expr, rules, 10);
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
 int main(int argc, char* argv[])
 {
     // simple non-recursive transforms
@@ -61,6 +93,24 @@ int main(int argc, char* argv[])
     test_transform_ast("define(multiply, A, B, A * B)", "_1 * _2", "mul(_2, _1)",
         "define(multiply, A, B, mul(B, A))");
 
+    // rewriting using several rules until none of them applies anymore
+    test_rewrite_ast("A + B * C", "_1 * _2 : mul(_1, _2) _1 + _2 : add(_1, _2)",
+        "add(A, mul(B, C))");
+    test_rewrite_ast("neg(neg(neg(neg(A))))", "neg(neg(_1)) : _1", "A");
+    test_rewrite_ast("f(g(A), B)", "g(_1) : h(_1) h(_1) : k(_1)",
+        "f(k(A), B)");
+    test_rewrite_ast("define(f, A, B, A * B)", "_1 * _2 : mul(_2, _1)",
+        "define(f, A, B, mul(B, A))");
+
+    // the first matching rule is applied
+    test_rewrite_ast("f(A)", "f(_1) : g(_1) f(A) : h(A)", "g(A)");
+    test_rewrite_ast("f(A)", "f(A) : h(A) f(_1) : g(_1)", "h(A)");
+
+    // expressions not matching any rule are left alone
+    test_rewrite_ast("f(A, B + C)", "g(_1) : h(_1)", "f(A, B + C)");
+
+    test_rewrite_ast_limit();
+
     return hpx::util::report_errors();
 }
 
@@ -0,0 +1,133 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+blaze::DynamicMatrix<double> generate(std::size_t rows, std::size_t columns)
+{
+    blaze::Rand<blaze::DynamicMatrix<double>> gen{};
+    return gen.generate(rows, columns, 1.0, 2.0);
+}
+
+phylanx::ir::partitioned_array partition(
+    blaze::DynamicMatrix<double> const& m, std::size_t tile_rows,
+    std::size_t tile_columns)
+{
+    return phylanx::ir::partitioned_array::create(
+        phylanx::ir::node_data<double>{m}, tile_rows, tile_columns,
+        hpx::find_all_localities()).get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_create_gather()
+{
+    blaze::DynamicMatrix<double> m = generate(17, 9);
+
+    auto arr = partition(m, 4, 5);
+    HPX_TEST_EQ(arr.grid_rows(), std::size_t(5));
+    HPX_TEST_EQ(arr.grid_columns(), std::size_t(2));
+    HPX_TEST_EQ(arr.tile_rows(4), std::size_t(1));
+    HPX_TEST_EQ(arr.tile_columns(1), std::size_t(4));
+
+    HPX_TEST_EQ(arr.gather().get(), phylanx::ir::node_data<double>{m});
+
+    // one block of rows per locality
+    auto rows = phylanx::ir::partitioned_array::create(
+        phylanx::ir::node_data<double>{m}, hpx::find_all_localities()).get();
+    HPX_TEST_EQ(rows.grid_rows(), hpx::find_all_localities().size());
+    HPX_TEST_EQ(rows.grid_columns(), std::size_t(1));
+    HPX_TEST_EQ(rows.gather().get(), phylanx::ir::node_data<double>{m});
+}
+
+void test_elementwise()
+{
+    blaze::DynamicMatrix<double> m1 = generate(13, 11);
+    blaze::DynamicMatrix<double> m2 = generate(13, 11);
+
+    auto a = partition(m1, 5, 3);
+    auto b = partition(m2, 5, 3);
+
+    blaze::DynamicMatrix<double> expected = m1 + m2;
+    HPX_TEST_EQ(phylanx::ir::add(a, b).get().gather().get(),
+        phylanx::ir::node_data<double>{expected});
+
+    expected = m1 - m2;
+    HPX_TEST_EQ(phylanx::ir::sub(a, b).get().gather().get(),
+        phylanx::ir::node_data<double>{expected});
+
+    expected = m1 % m2;
+    HPX_TEST_EQ(phylanx::ir::mul(a, b).get().gather().get(),
+        phylanx::ir::node_data<double>{expected});
+
+    expected = blaze::map(m1, m2, [](double x, double y) { return x / y; });
+    HPX_TEST_EQ(phylanx::ir::div(a, b).get().gather().get(),
+        phylanx::ir::node_data<double>{expected});
+}
+
+void test_dot()
+{
+    blaze::DynamicMatrix<double> m1{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0},
+        {7.0, 8.0, 9.0}, {10.0, 11.0, 12.0}};
+    blaze::DynamicMatrix<double> m2{{1.0, 0.0}, {2.0, 1.0}, {0.0, 3.0}};
+
+    auto a = partition(m1, 2, 2);
+    auto b = partition(m2, 2, 1);
+
+    blaze::DynamicMatrix<double> expected = m1 * m2;
+    HPX_TEST_EQ(phylanx::ir::dot(a, b).get().gather().get(),
+        phylanx::ir::node_data<double>{expected});
+}
+
+void test_transpose()
+{
+    blaze::DynamicMatrix<double> m = generate(7, 12);
+
+    auto arr = phylanx::ir::transpose(partition(m, 3, 5)).get();
+    HPX_TEST_EQ(arr.rows(), std::size_t(12));
+    HPX_TEST_EQ(arr.columns(), std::size_t(7));
+
+    blaze::DynamicMatrix<double> expected = blaze::trans(m);
+    HPX_TEST_EQ(arr.gather().get(), phylanx::ir::node_data<double>{expected});
+}
+
+void test_sum_mean()
+{
+    blaze::DynamicMatrix<double> m{
+        {1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}, {7.0, 8.0, 9.0}};
+
+    auto arr = partition(m, 2, 2);
+    HPX_TEST_EQ(phylanx::ir::sum(arr).get(), 45.0);
+    HPX_TEST_EQ(phylanx::ir::mean(arr).get(), 5.0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    HPX_TEST(hpx::get_num_localities(hpx::launch::sync) >= 2);
+
+    test_create_gather();
+    test_elementwise();
+    test_dot();
+    test_transpose();
+    test_sum_mean();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
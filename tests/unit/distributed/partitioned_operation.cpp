@@ -0,0 +1,159 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& code)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    return phylanx::execution_tree::compile(code, snippets, env)();
+}
+
+phylanx::ir::node_data<double> run(std::string const& code)
+{
+    return phylanx::execution_tree::extract_numeric_value(
+        compile_and_run(code));
+}
+
+std::string const m1 = "[[1, 2, 3], [4, 5, 6], [7, 8, 9], [10, 11, 12]]";
+std::string const m2 = "[[2, 1, 4], [3, 5, 1], [1, 2, 2], [4, 2, 8]]";
+
+blaze::DynamicMatrix<double> const bm1{
+    {1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12}};
+blaze::DynamicMatrix<double> const bm2{
+    {2, 1, 4}, {3, 5, 1}, {1, 2, 2}, {4, 2, 8}};
+
+///////////////////////////////////////////////////////////////////////////////
+void test_partition_gather()
+{
+    auto result = compile_and_run("partition(" + m1 + ", 2, 2)");
+    HPX_TEST(phylanx::execution_tree::is_partitioned_array_operand(result));
+
+    auto arr = phylanx::execution_tree::extract_partitioned_array_value(result);
+    HPX_TEST_EQ(arr.rows(), std::size_t(4));
+    HPX_TEST_EQ(arr.columns(), std::size_t(3));
+    HPX_TEST_EQ(arr.grid_rows(), std::size_t(2));
+    HPX_TEST_EQ(arr.grid_columns(), std::size_t(2));
+
+    // the tiles are distributed over (at least) two localities
+    HPX_TEST(arr.locality(0, 0) != arr.locality(0, 1));
+
+    HPX_TEST_EQ(run("gather(partition(" + m1 + ", 2, 2))"),
+        phylanx::ir::node_data<double>{bm1});
+
+    // one block of rows for each locality
+    HPX_TEST_EQ(run("gather(partition(" + m1 + "))"),
+        phylanx::ir::node_data<double>{bm1});
+}
+
+void test_elementwise()
+{
+    std::string const code = "block("
+        "define(a, partition(" + m1 + ", 3, 2)),"
+        "define(b, partition(" + m2 + ", 3, 2)),"
+        "gather(tiled_%s(a, b)))";
+
+    auto run_op = [&](std::string const& op)
+    {
+        std::string c = code;
+        c.replace(c.find("%s"), 2, op);
+        return run(c);
+    };
+
+    blaze::DynamicMatrix<double> expected = bm1 + bm2;
+    HPX_TEST_EQ(run_op("add"), phylanx::ir::node_data<double>{expected});
+
+    expected = bm1 - bm2;
+    HPX_TEST_EQ(run_op("sub"), phylanx::ir::node_data<double>{expected});
+
+    expected = bm1 % bm2;
+    HPX_TEST_EQ(run_op("mul"), phylanx::ir::node_data<double>{expected});
+
+    expected = blaze::map(bm1, bm2, [](double x, double y) { return x / y; });
+    HPX_TEST_EQ(run_op("div"), phylanx::ir::node_data<double>{expected});
+}
+
+void test_dot_transpose()
+{
+    blaze::DynamicMatrix<double> expected = bm1 * blaze::trans(bm2);
+    HPX_TEST_EQ(run("block("
+            "define(a, partition(" + m1 + ", 2, 2)),"
+            "define(b, partition(" + m2 + ", 2, 2)),"
+            "gather(tiled_dot(a, tiled_transpose(b))))"),
+        phylanx::ir::node_data<double>{expected});
+
+    expected = blaze::trans(bm1);
+    HPX_TEST_EQ(run("gather(tiled_transpose(partition(" + m1 + ", 3, 2)))"),
+        phylanx::ir::node_data<double>{expected});
+}
+
+void test_sum_mean()
+{
+    HPX_TEST_EQ(run("tiled_sum(partition(" + m1 + ", 3, 2))")[0], 78.0);
+    HPX_TEST_EQ(run("tiled_mean(partition(" + m1 + ", 3, 2))")[0], 6.5);
+}
+
+void test_errors()
+{
+    bool caught_exception = false;
+    try
+    {
+        // the tiling of both operands differs
+        run("gather(tiled_add(partition(" + m1 + ", 2, 2), partition(" + m2 +
+            ", 3, 2)))");
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    caught_exception = false;
+    try
+    {
+        // gather requires a partitioned array
+        run("gather(" + m1 + ")");
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(int argc, char* argv[])
+{
+    HPX_TEST(hpx::get_num_localities(hpx::launch::sync) >= 2);
+
+    test_partition_gather();
+    test_elementwise();
+    test_dot_transpose();
+    test_sum_mean();
+    test_errors();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ(hpx::init(argc, argv), 0);
+    return hpx::util::report_errors();
+}
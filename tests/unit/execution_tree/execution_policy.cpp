@@ -0,0 +1,139 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using phylanx::execution_tree::execution_cost_model;
+using phylanx::execution_tree::execution_mode;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_cost_model()
+{
+    execution_cost_model model;
+    HPX_TEST_EQ(model.samples(), std::int64_t(0));
+    HPX_TEST_EQ(model.predict(), 0.0);
+
+    // the same amount of work results in the mean duration
+    model.update(100, 1000);
+    model.update(100, 3000);
+    HPX_TEST_EQ(model.samples(), std::int64_t(2));
+    HPX_TEST_EQ(model.last_work(), std::size_t(100));
+    HPX_TEST(model.predict() > 1000.0 && model.predict() < 3000.0);
+
+    // duration = 500 + 2 * work
+    execution_cost_model linear;
+    for (std::size_t work = 100; work <= 2000; work += 100)
+    {
+        linear.update(work, std::int64_t(500 + 2 * work));
+    }
+    HPX_TEST(std::abs(linear.predict(10000) - 20500.0) < 1.0);
+    HPX_TEST(std::abs(linear.predict(0) - 500.0) < 1.0);
+    HPX_TEST(std::abs(linear.predict() - 4500.0) < 1.0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+execution_cost_model make_model(std::int64_t duration)
+{
+    execution_cost_model model;
+    model.update(1000, duration);
+    return model;
+}
+
+void test_adaptive_policy()
+{
+    phylanx::execution_tree::adaptive_execution_policy::parameters params;
+    params.task_overhead = 1000.0;
+    params.direct_ratio = 10.0;
+    params.async_ratio = 20.0;
+    params.parallel_ratio = 100.0;
+    params.cores = 4;
+
+    phylanx::execution_tree::adaptive_execution_policy policy(params);
+
+    // nothing is known yet
+    HPX_TEST(policy.select(execution_cost_model{},
+        execution_mode::undecided) == execution_mode::undecided);
+
+    HPX_TEST(policy.select(make_model(5000), execution_mode::async) ==
+        execution_mode::direct);
+    HPX_TEST(policy.select(make_model(50000), execution_mode::direct) ==
+        execution_mode::async);
+    HPX_TEST(policy.select(make_model(500000), execution_mode::direct) ==
+        execution_mode::parallel);
+
+    // the previous decision is kept inside the hysteresis band
+    HPX_TEST(policy.select(make_model(15000), execution_mode::direct) ==
+        execution_mode::direct);
+    HPX_TEST(policy.select(make_model(15000), execution_mode::async) ==
+        execution_mode::async);
+
+    // everything runs directly on a single core
+    params.cores = 1;
+    phylanx::execution_tree::adaptive_execution_policy single_core(params);
+    HPX_TEST(single_core.select(make_model(500000), execution_mode::async) ==
+        execution_mode::direct);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct counting_policy : phylanx::execution_tree::execution_policy
+{
+    execution_mode select(execution_cost_model const& model,
+        execution_mode current) const override
+    {
+        ++count_;
+        return execution_mode::direct;
+    }
+
+    std::string name() const override
+    {
+        return "counting";
+    }
+
+    mutable std::atomic<std::size_t> count_{0};
+};
+
+void test_set_execution_policy()
+{
+    HPX_TEST_EQ(phylanx::execution_tree::get_execution_policy()->name(),
+        std::string("adaptive"));
+    HPX_TEST_EQ(
+        phylanx::execution_tree::create_execution_policy("threshold")->name(),
+        std::string("threshold"));
+
+    auto policy = std::make_shared<counting_policy>();
+    auto previous = phylanx::execution_tree::set_execution_policy(policy);
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(
+        "define(f, a, b, a + b)", snippets);
+
+    phylanx::ir::node_data<double> a(41.0), b(1.0);
+    HPX_TEST_EQ(
+        phylanx::execution_tree::extract_numeric_value(f(a, b))[0], 42.0);
+    HPX_TEST_NEQ(policy->count_.load(), std::size_t(0));
+
+    phylanx::execution_tree::set_execution_policy(previous);
+    HPX_TEST(phylanx::execution_tree::get_execution_policy() == previous);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_cost_model();
+    test_adaptive_policy();
+    test_set_execution_policy();
+
+    return hpx::util::report_errors();
+}
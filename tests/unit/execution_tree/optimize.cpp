@@ -0,0 +1,157 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type run(
+    std::vector<phylanx::ast::expression> const& exprs)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    return phylanx::execution_tree::compile(exprs, snippets)();
+}
+
+// compile and run the given code with and without optimizations, make sure
+// both produce the same result
+phylanx::execution_tree::optimization_report test_optimized(
+    std::string const& code)
+{
+    auto exprs = phylanx::ast::generate_ast(code);
+
+    phylanx::execution_tree::optimization_report report;
+    auto optimized = phylanx::execution_tree::optimize_ast(
+        exprs, phylanx::execution_tree::optimization_options{}, &report);
+
+    HPX_TEST_EQ(phylanx::execution_tree::extract_numeric_value(run(exprs)),
+        phylanx::execution_tree::extract_numeric_value(run(optimized)));
+
+    return report;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_constant_folding()
+{
+    auto exprs = phylanx::ast::generate_ast("(2.0 + 3.0) * 7.0");
+    auto optimized = phylanx::execution_tree::optimize_ast(exprs);
+
+    HPX_TEST_EQ(optimized.size(), std::size_t(1));
+    HPX_TEST(phylanx::ast::detail::is_literal_value(optimized[0]));
+    HPX_TEST_EQ(
+        phylanx::execution_tree::extract_numeric_value(run(optimized))[0],
+        35.0);
+
+    auto report = test_optimized(R"(
+        define(f, x, x * (2.0 + 3.0) + sum(constant(1.0, 3)))
+        f(2.0)
+    )");
+    HPX_TEST_EQ(report.folded_constants, std::size_t(2));
+    HPX_TEST_EQ(report.generated_functions, std::size_t(0));
+}
+
+void test_common_subexpressions()
+{
+    auto report = test_optimized(R"(
+        define(f, X, y,
+            dot(transpose(X), X) + dot(transpose(X), y) + shape(X, 0)
+                * shape(X, 0)
+        )
+        f([[1.0, 2.0], [3.0, 4.0]], [[0.0, 1.0], [1.0, 0.0]])
+    )");
+    HPX_TEST_EQ(report.generated_functions, std::size_t(1));
+    HPX_TEST_EQ(report.eliminated_subexpressions, std::size_t(2));
+
+    // the operands of store() are not evaluated together
+    report = test_optimized(R"(
+        define(g, x, block(
+            define(a, 0.0),
+            store(a, exp(x)),
+            store(a, a + exp(x)),
+            a
+        ))
+        g(1.0)
+    )");
+    HPX_TEST_EQ(report.generated_functions, std::size_t(0));
+}
+
+void test_large_constants()
+{
+    // the size of the constant is known to be too large before evaluating it
+    auto exprs = phylanx::ast::generate_ast(
+        "sum(constant(0.0, make_list(10000, 10000)))");
+
+    phylanx::execution_tree::optimization_report report;
+    auto optimized = phylanx::execution_tree::optimize_ast(
+        exprs, phylanx::execution_tree::optimization_options{}, &report);
+
+    HPX_TEST(optimized == exprs);
+    HPX_TEST_EQ(report.folded_constants, std::size_t(0));
+
+    // values of unknown size are not folded either
+    exprs = phylanx::ast::generate_ast(
+        "constant(1.0, shape([[1.0, 2.0], [3.0, 4.0]]))");
+    optimized = phylanx::execution_tree::optimize_ast(exprs);
+
+    HPX_TEST(!phylanx::ast::detail::is_literal_value(optimized[0]));
+}
+
+void test_folding_and_subexpressions()
+{
+    // the repeated subexpressions are found after folding their operands
+    auto report = test_optimized(R"(
+        define(f, x, exp(x * (2.0 + 3.0)) + exp(x * (2.0 + 3.0)))
+        f(1.0)
+    )");
+    HPX_TEST_EQ(report.folded_constants, std::size_t(2));
+    HPX_TEST_EQ(report.generated_functions, std::size_t(1));
+    HPX_TEST_EQ(report.eliminated_subexpressions, std::size_t(1));
+
+    // constants too large to be folded are evaluated only once instead
+    report = test_optimized(R"(
+        define(g, x,
+            x * sum(constant(1.0, make_list(100, 100))) +
+                sum(constant(1.0, make_list(100, 100)))
+        )
+        g(2.0)
+    )");
+    HPX_TEST_EQ(report.folded_constants, std::size_t(0));
+    HPX_TEST_EQ(report.generated_functions, std::size_t(1));
+}
+
+void test_redefined_builtins()
+{
+    // a user defined 'dot' is not known to be free of side effects
+    auto exprs = phylanx::ast::generate_ast(R"(
+        define(dot, a, b, a * b)
+        define(f, x, dot(x, x) + dot(x, x) + dot(2.0, 3.0))
+        f(3.0)
+    )");
+
+    phylanx::execution_tree::optimization_report report;
+    auto optimized = phylanx::execution_tree::optimize_ast(
+        exprs, phylanx::execution_tree::optimization_options{}, &report);
+
+    HPX_TEST(optimized == exprs);
+    HPX_TEST_EQ(report.folded_constants, std::size_t(0));
+    HPX_TEST_EQ(report.generated_functions, std::size_t(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_constant_folding();
+    test_common_subexpressions();
+    test_large_constants();
+    test_folding_and_subexpressions();
+    test_redefined_builtins();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,115 @@
+// Copyright (c) 2018 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& code)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    return phylanx::execution_tree::compile(code, snippets)();
+}
+
+void test_cached_patterns()
+{
+    std::size_t version = phylanx::execution_tree::get_patterns_version();
+
+    auto patterns1 =
+        phylanx::execution_tree::get_all_known_expression_patterns();
+    auto patterns2 =
+        phylanx::execution_tree::get_all_known_expression_patterns();
+
+    // the parsed patterns are reused as long as no patterns are registered
+    HPX_TEST(patterns1 == patterns2);
+    HPX_TEST(!patterns1->empty());
+    HPX_TEST_EQ(version, phylanx::execution_tree::get_patterns_version());
+
+    // compiling does not regenerate the list of patterns
+    HPX_TEST_EQ(phylanx::execution_tree::extract_numeric_value(
+        compile_and_run("1.0 + 41.0"))[0], 42.0);
+    HPX_TEST(patterns1 ==
+        phylanx::execution_tree::get_all_known_expression_patterns());
+}
+
+void test_register_pattern()
+{
+    std::size_t version = phylanx::execution_tree::get_patterns_version();
+    auto patterns =
+        phylanx::execution_tree::get_all_known_expression_patterns();
+    auto known_patterns = phylanx::execution_tree::get_all_known_patterns();
+
+    // register a new pattern creating an existing primitive
+    phylanx::execution_tree::register_pattern("my_add",
+        hpx::util::make_tuple(std::string("my_add"),
+            std::vector<std::string>{"my_add(_1, __2)"},
+            &phylanx::execution_tree::primitives::create_add_operation,
+            &phylanx::execution_tree::create_primitive<
+                phylanx::execution_tree::primitives::add_operation>));
+
+    HPX_TEST_EQ(version + 1, phylanx::execution_tree::get_patterns_version());
+
+    // the list of patterns is regenerated and includes the new pattern
+    auto new_patterns =
+        phylanx::execution_tree::get_all_known_expression_patterns();
+    HPX_TEST(patterns != new_patterns);
+    HPX_TEST_EQ(patterns->size() + 1, new_patterns->size());
+    HPX_TEST(new_patterns->find("my_add") != new_patterns->end());
+
+    // previously handed out lists stay valid
+    HPX_TEST(patterns->find("my_add") == patterns->end());
+    HPX_TEST_EQ(known_patterns.size() + 1,
+        phylanx::execution_tree::get_all_known_patterns().size());
+
+    HPX_TEST_EQ(phylanx::execution_tree::extract_numeric_value(
+        compile_and_run("my_add(1.0, 41.0)"))[0], 42.0);
+}
+
+void test_modify_indexed_patterns()
+{
+    using phylanx::execution_tree::compiler::expression_pattern_list;
+
+    expression_pattern_list patterns =
+        *phylanx::execution_tree::get_all_known_expression_patterns();
+    HPX_TEST(patterns.indexed());
+
+    auto expr = phylanx::ast::generate_ast("my_sub(1.0, 2.0)")[0];
+    auto const* candidates = patterns.candidates(expr);
+    HPX_TEST(candidates != nullptr);
+
+    std::size_t matching = candidates->size();
+
+    // the index is updated when patterns are inserted or erased
+    std::string const pattern("my_sub(_1, _2)");
+    patterns.insert(expression_pattern_list::value_type("my_sub",
+        hpx::util::make_tuple(pattern, phylanx::ast::generate_ast(pattern)[0],
+            &phylanx::execution_tree::primitives::create_sub_operation)));
+
+    HPX_TEST(patterns.indexed());
+    candidates = patterns.candidates(expr);
+    HPX_TEST(candidates != nullptr);
+    HPX_TEST_EQ(candidates->size(), matching + 1);
+
+    patterns.erase("my_sub");
+    candidates = patterns.candidates(expr);
+    HPX_TEST(candidates != nullptr);
+    HPX_TEST_EQ(candidates->size(), matching);
+}
+
+int main(int argc, char* argv[])
+{
+    test_cached_patterns();
+    test_register_pattern();
+    test_modify_indexed_patterns();
+
+    return hpx::util::report_errors();
+}
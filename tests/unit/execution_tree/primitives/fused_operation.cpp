@@ -0,0 +1,172 @@
+//   Copyright (c) 2018 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename... Ts>
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& code, bool fuse, std::string& newick, Ts&&... ts)
+{
+    bool enabled =
+        phylanx::execution_tree::compiler::enable_elementwise_fusion(fuse);
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(code, snippets);
+
+    phylanx::execution_tree::compiler::enable_elementwise_fusion(enabled);
+
+    newick = phylanx::execution_tree::newick_tree(
+        "test", snippets.get_expression_topology());
+
+    return f(std::forward<Ts>(ts)...);
+}
+
+template <typename... Ts>
+void test_fused_operation(std::string const& code, Ts const&... ts)
+{
+    std::string unfused_topology;
+    auto expected = compile_and_run(code, false, unfused_topology, ts...);
+
+    std::string fused_topology;
+    auto result = compile_and_run(code, true, fused_topology, ts...);
+
+    HPX_TEST(unfused_topology.find("__fused") == std::string::npos);
+    HPX_TEST(fused_topology.find("__fused") != std::string::npos);
+
+    HPX_TEST_EQ(expected.index(), result.index());
+    if (expected.index() != 4)
+    {
+        HPX_TEST_EQ(expected, result);
+        return;
+    }
+
+    // the fused expression may be evaluated using different instructions
+    auto expected_data =
+        phylanx::execution_tree::extract_numeric_value(expected);
+    auto result_data = phylanx::execution_tree::extract_numeric_value(result);
+
+    HPX_TEST(expected_data.dimensions() == result_data.dimensions());
+    for (std::size_t i = 0; i != expected_data.size(); ++i)
+    {
+        HPX_TEST(std::abs(expected_data[i] - result_data[i]) <=
+            1e-12 * (std::max)(1.0, std::abs(expected_data[i])));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_fused_arithmetics()
+{
+    std::string const code = R"(
+        define(f, a, b, c, d, exp(a * b + c) - d)
+    )";
+
+    // 0d
+    test_fused_operation(code,
+        phylanx::ir::node_data<double>{0.5},
+        phylanx::ir::node_data<double>{2.0},
+        phylanx::ir::node_data<double>{-1.0},
+        phylanx::ir::node_data<double>{3.0});
+
+    // 1d, larger than a single block of fused elements
+    blaze::Rand<blaze::DynamicVector<double>> gen{};
+    test_fused_operation(code,
+        phylanx::ir::node_data<double>{gen.generate(1007)},
+        phylanx::ir::node_data<double>{gen.generate(1007)},
+        phylanx::ir::node_data<double>{gen.generate(1007)},
+        phylanx::ir::node_data<double>{gen.generate(1007)});
+
+    // 2d, mixed with scalars
+    blaze::Rand<blaze::DynamicMatrix<double>> mgen{};
+    test_fused_operation(code,
+        phylanx::ir::node_data<double>{mgen.generate(33, 301)},
+        phylanx::ir::node_data<double>{2.0},
+        phylanx::ir::node_data<double>{mgen.generate(33, 301)},
+        phylanx::ir::node_data<double>{-1.0});
+
+    // integer operands
+    test_fused_operation(code,
+        phylanx::ir::node_data<std::int64_t>{
+            blaze::DynamicVector<std::int64_t>{1, 2, 3, 4}},
+        phylanx::ir::node_data<double>{gen.generate(4)},
+        phylanx::ir::node_data<std::int64_t>{-2},
+        phylanx::ir::node_data<double>{gen.generate(4)});
+}
+
+void test_fused_comparison()
+{
+    std::string const code = R"(
+        define(f, a, b, c, -sqrt(a) + b < c)
+    )";
+
+    blaze::Rand<blaze::DynamicVector<double>> gen{};
+    test_fused_operation(code,
+        phylanx::ir::node_data<double>{gen.generate(513)},
+        phylanx::ir::node_data<double>{gen.generate(513)},
+        phylanx::ir::node_data<double>{0.5});
+
+    blaze::Rand<blaze::DynamicMatrix<double>> mgen{};
+    test_fused_operation(code,
+        phylanx::ir::node_data<double>{mgen.generate(17, 17)},
+        phylanx::ir::node_data<double>{0.1},
+        phylanx::ir::node_data<double>{mgen.generate(17, 17)});
+}
+
+void test_fused_fallback()
+{
+    std::string const code = R"(
+        define(f, a, b, c, (a + b) * c)
+    )";
+
+    // operands requiring broadcasting are handled by the original primitives
+    blaze::Rand<blaze::DynamicVector<double>> gen{};
+    blaze::Rand<blaze::DynamicMatrix<double>> mgen{};
+    test_fused_operation(code,
+        phylanx::ir::node_data<double>{mgen.generate(5, 7)},
+        phylanx::ir::node_data<double>{
+            blaze::DynamicVector<double>(gen.generate(7))},
+        phylanx::ir::node_data<double>{mgen.generate(5, 7)});
+}
+
+void test_no_fusion()
+{
+    // user defined functions shadowing built-ins are never fused
+    std::string const code = R"(
+        define(exp, x, x)
+        define(f, a, b, exp(a + b) * 2.0)
+    )";
+
+    std::string topology;
+    auto result = compile_and_run(code, true, topology,
+        phylanx::ir::node_data<double>{1.0},
+        phylanx::ir::node_data<double>{2.0});
+
+    HPX_TEST(topology.find("__fused") == std::string::npos);
+    HPX_TEST_EQ(phylanx::execution_tree::extract_numeric_value(result)[0],
+        6.0);
+}
+
+int main(int argc, char* argv[])
+{
+    test_fused_arithmetics();
+    test_fused_comparison();
+    test_fused_fallback();
+    test_no_fusion();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,150 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <blaze/Math.h>
+
+using accounting = phylanx::ir::memory_accounting;
+using statistics = phylanx::ir::memory_statistics;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_allocation_and_copy()
+{
+    statistics stats;
+    {
+        accounting::scope s(stats);
+
+        phylanx::ir::node_data<double> v{blaze::DynamicVector<double>(16, 1.0)};
+        phylanx::ir::node_data<double> copy{v};
+        phylanx::ir::node_data<double> moved{std::move(copy)};
+    }
+
+    std::int64_t const bytes = 16 * sizeof(double);
+    HPX_TEST_EQ(stats.bytes_allocated_.load(), 2 * bytes);
+    HPX_TEST_EQ(stats.bytes_copied_.load(), bytes);
+    HPX_TEST_EQ(stats.copies_.load(), std::int64_t(1));
+    HPX_TEST_EQ(stats.max_allocated_per_eval_.load(), 2 * bytes);
+
+    // nothing is recorded outside of a scope
+    phylanx::ir::node_data<double> v{blaze::DynamicVector<double>(16, 1.0)};
+    phylanx::ir::node_data<double> copy{v};
+    HPX_TEST_EQ(stats.bytes_allocated_.load(), 2 * bytes);
+    HPX_TEST_EQ(stats.copies_.load(), std::int64_t(1));
+}
+
+void test_nested_scopes()
+{
+    statistics outer;
+    statistics inner;
+    {
+        accounting::scope s1(outer);
+        phylanx::ir::node_data<double> m{
+            blaze::DynamicMatrix<double>(4, 4, 1.0)};
+        {
+            accounting::scope s2(inner);
+            phylanx::ir::node_data<double> copy{m};
+        }
+        phylanx::ir::node_data<double> v{blaze::DynamicVector<double>(8)};
+    }
+
+    HPX_TEST_EQ(outer.bytes_copied_.load(), std::int64_t(0));
+    HPX_TEST_EQ(outer.bytes_allocated_.load(),
+        outer.max_allocated_per_eval_.load());
+    HPX_TEST(outer.bytes_allocated_.load() >=
+        std::int64_t((16 + 8) * sizeof(double)));
+
+    HPX_TEST_EQ(inner.copies_.load(), std::int64_t(1));
+    HPX_TEST(inner.bytes_copied_.load() >=
+        std::int64_t(16 * sizeof(double)));
+}
+
+void test_max_allocated_per_eval()
+{
+    statistics stats;
+    {
+        accounting::scope s(stats);
+        phylanx::ir::node_data<double> v{blaze::DynamicVector<double>(32)};
+    }
+    {
+        accounting::scope s(stats);
+        phylanx::ir::node_data<double> v{blaze::DynamicVector<double>(8)};
+    }
+
+    HPX_TEST_EQ(stats.bytes_allocated_.load(),
+        std::int64_t((32 + 8) * sizeof(double)));
+    HPX_TEST_EQ(stats.max_allocated_per_eval_.load(),
+        std::int64_t(32 * sizeof(double)));
+}
+
+void test_disabled()
+{
+    bool enabled = accounting::enable(false);
+
+    statistics stats;
+    {
+        accounting::scope s(stats);
+        phylanx::ir::node_data<double> v{blaze::DynamicVector<double>(16)};
+        phylanx::ir::node_data<double> copy{v};
+    }
+
+    accounting::enable(enabled);
+
+    HPX_TEST_EQ(stats.bytes_allocated_.load(), std::int64_t(0));
+    HPX_TEST_EQ(stats.copies_.load(), std::int64_t(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::int64_t counter_value(std::string const& name)
+{
+    hpx::performance_counters::performance_counter pc(
+        "/phylanx{locality#0/total}/primitives/constant/" + name);
+
+    auto values = pc.get_counter_values_array(hpx::launch::sync, false);
+
+    std::int64_t result = 0;
+    for (auto value : values.values_)
+    {
+        result += value;
+    }
+    return result;
+}
+
+void test_primitive_counters()
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const f =
+        phylanx::execution_tree::compile("constant(1.0, 8)", snippets);
+
+    f();
+
+    HPX_TEST_EQ(counter_value("memory/allocated"),
+        std::int64_t(8 * sizeof(double)));
+    HPX_TEST_EQ(counter_value("memory/max_allocated_per_eval"),
+        std::int64_t(8 * sizeof(double)));
+    HPX_TEST_EQ(counter_value("memory/copied"), std::int64_t(0));
+    HPX_TEST_EQ(counter_value("count/copies"), std::int64_t(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_allocation_and_copy();
+    test_nested_scopes();
+    test_max_allocated_per_eval();
+    test_disabled();
+    test_primitive_counters();
+
+    return hpx::util::report_errors();
+}
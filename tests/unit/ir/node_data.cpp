@@ -154,5 +154,130 @@ int main(int argc, char* argv[])
         test_serialization(array_value);
     }
 
+    {
+        blaze::CompressedMatrix<double> m(42UL, 101UL);
+        m(0, 0) = 1.0;
+        m(3, 17) = 2.0;
+        m(41, 100) = 3.0;
+
+        phylanx::ir::node_data<double> array_value(m);
+
+        HPX_TEST(array_value.is_sparse());
+        HPX_TEST(!array_value.is_ref());
+        HPX_TEST_EQ(array_value.num_dimensions(), std::size_t(2UL));
+        HPX_TEST(array_value.dimensions() ==
+            phylanx::ir::node_data<double>::dimensions_type(
+                {m.rows(), m.columns()}));
+
+        phylanx::ir::node_data<double> const& value = array_value;
+        HPX_TEST_EQ(value.at(3, 17), 2.0);
+        HPX_TEST_EQ(value.at(3, 18), 0.0);
+
+        blaze::DynamicMatrix<double> dense(m);
+        HPX_TEST_EQ(array_value, phylanx::ir::node_data<double>(dense));
+        HPX_TEST(array_value.matrix_copy() == dense);
+
+        phylanx::ir::node_data<double> ref_value = array_value.ref();
+        HPX_TEST(ref_value.is_sparse());
+        HPX_TEST(ref_value.is_ref());
+        HPX_TEST(!ref_value.copy().is_ref());
+        HPX_TEST_EQ(array_value, ref_value);
+
+        test_serialization(array_value);
+        test_serialization(ref_value);
+
+        // dense access to a sparse matrix is rejected, regardless of
+        // constness, the matrix is left untouched
+        bool caught_exception = false;
+        try
+        {
+            value.matrix();
+        }
+        catch (hpx::exception const&)
+        {
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+
+        phylanx::ir::node_data<double> sparse_value = array_value.copy();
+        caught_exception = false;
+        try
+        {
+            sparse_value.matrix();
+        }
+        catch (hpx::exception const&)
+        {
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+
+        caught_exception = false;
+        try
+        {
+            sparse_value.matrix_non_ref();
+        }
+        catch (hpx::exception const&)
+        {
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+        HPX_TEST(sparse_value.is_sparse());
+    }
+
+    {
+        blaze::Rand<blaze::DynamicMatrix<double>> gen{};
+        blaze::DynamicMatrix<double> m = gen.generate(7UL, 13UL);
+
+        phylanx::ir::node_data<double> array_value(m);
+        phylanx::ir::node_data<double> ref_value = array_value.ref();
+
+        // the iterators visit the elements in row-major order
+        std::vector<double> elements(ref_value.begin(), ref_value.end());
+        HPX_TEST_EQ(elements.size(), m.rows() * m.columns());
+        HPX_TEST_EQ(elements[3 * m.columns() + 5], m(3, 5));
+        HPX_TEST_EQ(*(ref_value.end() - 1), m(6, 12));
+        HPX_TEST_EQ(ref_value.begin()[m.columns()], m(1, 0));
+
+        std::size_t rows = 0;
+        ref_value.for_each_row(
+            [&](double const* data, std::size_t size)
+            {
+                HPX_TEST_EQ(size, m.columns());
+                HPX_TEST_EQ(data[size - 1], m(rows, size - 1));
+                ++rows;
+            });
+        HPX_TEST_EQ(rows, m.rows());
+
+        std::vector<double> visited;
+        ref_value.for_each([&](double d) { visited.push_back(d); });
+        HPX_TEST(visited == elements);
+    }
+
+    {
+        blaze::CompressedMatrix<double> m(3UL, 4UL);
+        m(1, 2) = 5.0;
+
+        phylanx::ir::node_data<double> array_value(m);
+
+        std::vector<double> visited;
+        array_value.for_each([&](double d) { visited.push_back(d); });
+        HPX_TEST_EQ(visited.size(), std::size_t(12));
+        HPX_TEST_EQ(visited[6], 5.0);
+        HPX_TEST_EQ(
+            std::count(visited.begin(), visited.end(), 0.0), std::ptrdiff_t(11));
+
+        std::vector<double> iterated(array_value.begin(), array_value.end());
+        HPX_TEST(iterated == visited);
+    }
+
+    {
+        phylanx::ir::node_data<double> single_value(42.0);
+
+        std::size_t count = 0;
+        single_value.for_each([&](double d) { HPX_TEST_EQ(d, 42.0); ++count; });
+        HPX_TEST_EQ(count, std::size_t(1));
+        HPX_TEST_EQ(*single_value.begin(), 42.0);
+    }
+
     return hpx::util::report_errors();
 }
@@ -0,0 +1,163 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+using pool = phylanx::ir::storage_pool<double>;
+using dimensions_type = phylanx::ir::node_data<double>::dimensions_type;
+
+void reset_statistics()
+{
+    pool::clear();
+    pool::hit_count(true);
+    pool::miss_count(true);
+    pool::release_count(true);
+    pool::discard_count(true);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_reuse_matrix()
+{
+    reset_statistics();
+
+    double const* data = nullptr;
+    {
+        phylanx::ir::node_data<double> m(dimensions_type{100, 100}, 1.0);
+        data = m.matrix().data();
+    }
+    HPX_TEST_EQ(pool::miss_count(true), std::int64_t(1));
+    HPX_TEST_EQ(pool::release_count(true), std::int64_t(1));
+    HPX_TEST_NEQ(pool::cached_bytes(false), std::int64_t(0));
+
+    // storage of the same size class is reused
+    {
+        phylanx::ir::node_data<double> m(dimensions_type{99, 101}, 2.0);
+        HPX_TEST_EQ(m.matrix().data(), data);
+        HPX_TEST_EQ(m.dimension(0), std::size_t(99));
+        HPX_TEST_EQ(m.dimension(1), std::size_t(101));
+        HPX_TEST_EQ(m[0], 2.0);
+    }
+    HPX_TEST_EQ(pool::hit_count(true), std::int64_t(1));
+    HPX_TEST_EQ(pool::miss_count(true), std::int64_t(0));
+
+    pool::clear();
+    HPX_TEST_EQ(pool::cached_bytes(false), std::int64_t(0));
+}
+
+void test_reuse_vector()
+{
+    reset_statistics();
+
+    for (int i = 0; i != 10; ++i)
+    {
+        phylanx::ir::node_data<double> v(dimensions_type{1000, 1});
+        HPX_TEST_EQ(v.dimension(0), std::size_t(1000));
+    }
+
+    // only the first iteration allocates memory
+    HPX_TEST_EQ(pool::miss_count(true), std::int64_t(1));
+    HPX_TEST_EQ(pool::hit_count(true), std::int64_t(9));
+}
+
+void test_expression_assignment()
+{
+    reset_statistics();
+
+    blaze::DynamicMatrix<double> a(50, 40, 1.0), b(50, 40, 2.0);
+    phylanx::ir::node_data<double> lhs(a), rhs(b);
+
+    // both operands refer to external memory, the result is evaluated into
+    // pooled storage
+    for (int i = 0; i != 5; ++i)
+    {
+        phylanx::ir::node_data<double> result = lhs.ref();
+        result = lhs.matrix() + rhs.matrix();
+
+        HPX_TEST(!result.is_ref());
+        HPX_TEST(result ==
+            phylanx::ir::node_data<double>{blaze::DynamicMatrix<double>(
+                50, 40, 3.0)});
+    }
+
+    HPX_TEST_EQ(pool::miss_count(true), std::int64_t(1));
+    HPX_TEST_EQ(pool::hit_count(true), std::int64_t(4));
+
+    // vector expressions
+    phylanx::ir::node_data<double> v(blaze::DynamicVector<double>(200, 1.0));
+    phylanx::ir::node_data<double> w = v.ref();
+    w = 2.0 * v.vector();
+    HPX_TEST(w == phylanx::ir::node_data<double>{
+        blaze::DynamicVector<double>(200, 2.0)});
+    HPX_TEST(v == phylanx::ir::node_data<double>{
+        blaze::DynamicVector<double>(200, 1.0)});
+}
+
+void test_size_class_slack()
+{
+    reset_statistics();
+
+    // storage is not rounded up to the next power of two
+    std::size_t const size = 1025;
+    std::size_t const required = size + blaze::SIMDTrait<double>::size;
+
+    pool::vector_type v = pool::acquire_vector(size);
+    HPX_TEST_EQ(v.size(), size);
+    HPX_TEST(v.capacity() >= required);
+    HPX_TEST(4 * v.capacity() <= 5 * required);
+}
+
+void test_trim()
+{
+    // don't let the periodic trimming interfere with the test
+    phylanx::ir::stop_storage_pool_trimming();
+
+    reset_statistics();
+    {
+        phylanx::ir::node_data<double> m(dimensions_type{100, 100});
+    }
+    HPX_TEST_NEQ(pool::cached_bytes(false), std::int64_t(0));
+
+    // the storage is kept as long as the pool has been used since the
+    // previous trimming
+    pool::trim();
+    HPX_TEST_NEQ(pool::cached_bytes(false), std::int64_t(0));
+
+    pool::trim();
+    HPX_TEST_EQ(pool::cached_bytes(false), std::int64_t(0));
+}
+
+void test_disabled()
+{
+    reset_statistics();
+
+    bool enabled = pool::enable(false);
+    for (int i = 0; i != 3; ++i)
+    {
+        phylanx::ir::node_data<double> m(dimensions_type{100, 100});
+    }
+    HPX_TEST_EQ(pool::hit_count(true), std::int64_t(0));
+    HPX_TEST_EQ(pool::release_count(true), std::int64_t(0));
+
+    pool::enable(enabled);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_reuse_matrix();
+    test_reuse_vector();
+    test_expression_assignment();
+    test_size_class_slack();
+    test_trim();
+    test_disabled();
+
+    return hpx::util::report_errors();
+}
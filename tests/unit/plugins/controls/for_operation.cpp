@@ -261,10 +261,18 @@ void test_for_operation_42_with_store()
 
 int main(int argc, char* argv[])
 {
-    test_for_operation_false();
-    test_for_operation_true();
-    test_for_operation_42();
-    test_for_operation_42_with_store();
+    for (bool trampoline : {true, false})
+    {
+        bool enabled =
+            phylanx::execution_tree::enable_loop_trampolining(trampoline);
+
+        test_for_operation_false();
+        test_for_operation_true();
+        test_for_operation_42();
+        test_for_operation_42_with_store();
+
+        phylanx::execution_tree::enable_loop_trampolining(enabled);
+    }
 
     return hpx::util::report_errors();
 }
@@ -103,9 +103,17 @@ void test_while_operation_true_return()
 
 int main(int argc, char* argv[])
 {
-    test_while_operation_false();
-    test_while_operation_true();
-    test_while_operation_true_return();
+    for (bool trampoline : {true, false})
+    {
+        bool enabled =
+            phylanx::execution_tree::enable_loop_trampolining(trampoline);
+
+        test_while_operation_false();
+        test_while_operation_true();
+        test_while_operation_true_return();
+
+        phylanx::execution_tree::enable_loop_trampolining(enabled);
+    }
 
     return hpx::util::report_errors();
 }
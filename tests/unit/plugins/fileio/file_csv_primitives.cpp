@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <fstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -91,6 +92,28 @@ void test_file_io(phylanx::ir::node_data<double> const& in)
     test_file_io_primitive(in);
 }
 
+void test_file_read_crlf()
+{
+    std::string filename = std::tmpnam(nullptr);
+
+    {
+        std::ofstream outfile(filename.c_str(), std::ios::binary);
+        outfile << "1.0,2.0,3.0\r\n4.0,5.0,6.0\r\n";
+    }
+
+    phylanx::execution_tree::primitive infile =
+        phylanx::execution_tree::primitives::create_file_read_csv(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                {filename}});
+
+    blaze::DynamicMatrix<double> expected{{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(infile.eval().get()));
+
+    std::remove(filename.c_str());
+}
+
 int main(int argc, char* argv[])
 {
     blaze::Rand<blaze::DynamicVector<double>> gen{};
@@ -109,5 +132,11 @@ int main(int argc, char* argv[])
     blaze::DynamicMatrix<double> m = gen2.generate(101UL, 101UL);
     test_file_io(phylanx::ir::node_data<double>(std::move(m)));
 
+    // large enough to be split into several chunks
+    blaze::DynamicMatrix<double> large = gen2.generate(5000UL, 50UL);
+    test_file_io(phylanx::ir::node_data<double>(std::move(large)));
+
+    test_file_read_crlf();
+
     return hpx::util::report_errors();
 }
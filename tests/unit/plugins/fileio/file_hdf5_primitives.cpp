@@ -10,6 +10,8 @@
 #include <hpx/util/lightweight_test.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <string>
 #include <utility>
@@ -93,6 +95,92 @@ void test_file_io(phylanx::ir::node_data<double> const& in)
     test_file_io_primitive(in);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type run(std::string const& code)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    return phylanx::execution_tree::compile(code, snippets)();
+}
+
+void write_file(std::string const& filename,
+    phylanx::ir::node_data<double> const& data)
+{
+    phylanx::execution_tree::primitive outfile =
+        phylanx::execution_tree::primitives::create_file_write_hdf5(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                filename, std::string("dataset"), data});
+    outfile.eval().get();
+}
+
+void test_file_read_hyperslab()
+{
+    std::string filename = std::tmpnam(nullptr);
+
+    blaze::Rand<blaze::DynamicMatrix<double>> gen{};
+    blaze::DynamicMatrix<double> m = gen.generate(31UL, 17UL);
+    write_file(filename, phylanx::ir::node_data<double>{m});
+
+    // rows 10 to 14
+    auto result = phylanx::execution_tree::extract_numeric_value(
+        run("file_read_hdf5(\"" + filename + "\", \"dataset\", 10, 5)"));
+    HPX_TEST(result == phylanx::ir::node_data<double>{
+        blaze::DynamicMatrix<double>{blaze::submatrix(m, 10, 0, 5, 17)}});
+
+    // all rows starting at row 20, every other column starting at column 3
+    result = phylanx::execution_tree::extract_numeric_value(
+        run("file_read_hdf5(\"" + filename +
+            "\", \"dataset\", '(20, 3), nil, '(1, 2))"));
+
+    blaze::DynamicMatrix<double> expected(11, 7);
+    for (std::size_t i = 0; i != expected.rows(); ++i)
+    {
+        for (std::size_t j = 0; j != expected.columns(); ++j)
+        {
+            expected(i, j) = m(20 + i, 3 + 2 * j);
+        }
+    }
+    HPX_TEST(result == phylanx::ir::node_data<double>{std::move(expected)});
+
+    // overwrite rows 2 and 3 of the existing dataset
+    blaze::DynamicMatrix<double> rows(2, 17, 42.0);
+    phylanx::execution_tree::primitive outfile =
+        phylanx::execution_tree::primitives::create_file_write_hdf5(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                filename, std::string("dataset"),
+                phylanx::ir::node_data<double>{rows},
+                phylanx::ir::node_data<std::int64_t>{std::int64_t(2)}});
+    outfile.eval().get();
+
+    blaze::submatrix(m, 2, 0, 2, 17) = rows;
+    result = phylanx::execution_tree::extract_numeric_value(
+        run("file_read_hdf5(\"" + filename + "\", \"dataset\")"));
+    HPX_TEST(result == phylanx::ir::node_data<double>{std::move(m)});
+
+    std::remove(filename.c_str());
+}
+
+void test_file_fold(phylanx::ir::node_data<double> const& in,
+    std::string const& block_rows)
+{
+    std::string filename = std::tmpnam(nullptr);
+    write_file(filename, in);
+
+    auto result = phylanx::execution_tree::extract_numeric_value(run(
+        "file_fold_hdf5(lambda(acc, block, acc + sum(block)), 0.0, \"" +
+        filename + "\", \"dataset\"" + block_rows + ")"));
+
+    double expected = 0.0;
+    for (double v : in)
+    {
+        expected += v;
+    }
+    HPX_TEST(std::abs(result[0] - expected) < 1e-9 * std::abs(expected) + 1e-9);
+
+    std::remove(filename.c_str());
+}
+
 int main(int argc, char* argv[])
 {
     test_file_io(phylanx::ir::node_data<double>(42.0));
@@ -110,5 +198,15 @@ int main(int argc, char* argv[])
     blaze::DynamicMatrix<double> m = gen2.generate(101UL, 102UL);
     test_file_io(phylanx::ir::node_data<double>(std::move(m)));
 
+    test_file_read_hyperslab();
+
+    test_file_fold(phylanx::ir::node_data<double>(42.0), "");
+    test_file_fold(
+        phylanx::ir::node_data<double>(gen.generate(1007UL)), ", 100");
+    test_file_fold(
+        phylanx::ir::node_data<double>(gen2.generate(101UL, 102UL)), ", 7");
+    test_file_fold(
+        phylanx::ir::node_data<double>(gen2.generate(101UL, 102UL)), "");
+
     return hpx::util::report_errors();
 }
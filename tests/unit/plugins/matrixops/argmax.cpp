@@ -10,8 +10,10 @@
 #include <hpx/include/lcos.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -148,6 +150,73 @@ void test_argmax_2d_y_axis()
     HPX_TEST_EQ(expected, actual);
 }
 
+// large enough to be split into several blocks, all values are negative
+void test_argmax_2d_large()
+{
+    blaze::DynamicMatrix<double> subject(700UL, 301UL);
+    for (std::size_t i = 0; i != subject.rows(); ++i)
+    {
+        for (std::size_t j = 0; j != subject.columns(); ++j)
+        {
+            subject(i, j) = -double((i * 31 + j * 17) % 997) - 1.;
+        }
+    }
+
+    auto argmax = [&](std::int64_t axis)
+    {
+        std::vector<phylanx::execution_tree::primitive_argument_type> operands;
+        operands.emplace_back(
+            phylanx::execution_tree::primitives::create_variable(
+                hpx::find_here(), phylanx::ir::node_data<double>(subject)));
+        if (axis != -3)
+        {
+            operands.emplace_back(
+                phylanx::execution_tree::primitives::create_variable(
+                    hpx::find_here(),
+                    phylanx::ir::node_data<std::int64_t>(axis)));
+        }
+
+        phylanx::execution_tree::primitive p =
+            phylanx::execution_tree::primitives::create_argmax(
+                hpx::find_here(), std::move(operands));
+        return p.eval().get();
+    };
+
+    // first occurrence of the maximum in row-major order
+    std::size_t expected = 0;
+    for (std::size_t k = 1; k != subject.rows() * subject.columns(); ++k)
+    {
+        if (subject(k / subject.columns(), k % subject.columns()) >
+            subject(expected / subject.columns(),
+                expected % subject.columns()))
+        {
+            expected = k;
+        }
+    }
+    HPX_TEST_EQ(double(expected),
+        phylanx::execution_tree::extract_numeric_value(argmax(-3))[0]);
+
+    blaze::DynamicVector<double> expected_rows(subject.rows());
+    for (std::size_t i = 0; i != subject.rows(); ++i)
+    {
+        auto row = blaze::row(subject, i);
+        expected_rows[i] = double(
+            std::distance(row.begin(), std::max_element(row.begin(), row.end())));
+    }
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected_rows),
+        phylanx::execution_tree::extract_numeric_value(argmax(0)));
+
+    blaze::DynamicVector<double> expected_columns(subject.columns());
+    for (std::size_t j = 0; j != subject.columns(); ++j)
+    {
+        auto column = blaze::column(subject, j);
+        expected_columns[j] = double(std::distance(column.begin(),
+            std::max_element(column.begin(), column.end())));
+    }
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected_columns),
+        phylanx::execution_tree::extract_numeric_value(argmax(1)));
+}
+
 int main(int argc, char* argv[])
 {
     test_argmax_0d();
@@ -155,6 +224,7 @@ int main(int argc, char* argv[])
     test_argmax_2d_flat();
     test_argmax_2d_x_axis();
     test_argmax_2d_y_axis();
+    test_argmax_2d_large();
 
     return hpx::util::report_errors();
 }
@@ -724,6 +724,36 @@ void test_dot_operation_2d2d_numpy()
         phylanx::execution_tree::extract_numeric_value(f.get()));
 }
 
+void test_dot_operation_2d1d_sparse()
+{
+    blaze::CompressedMatrix<double> m(3UL, 4UL);
+    m(0, 0) = 4.0;
+    m(1, 2) = 3.0;
+    m(2, 3) = 5.0;
+    blaze::DynamicVector<double> v{1.0, 2.0, 3.0, 4.0};
+
+    phylanx::execution_tree::primitive lhs =
+        phylanx::execution_tree::primitives::create_variable(
+            hpx::find_here(), phylanx::ir::node_data<double>(m));
+
+    phylanx::execution_tree::primitive rhs =
+        phylanx::execution_tree::primitives::create_variable(
+            hpx::find_here(), phylanx::ir::node_data<double>(v));
+
+    phylanx::execution_tree::primitive dot =
+        phylanx::execution_tree::primitives::create_dot_operation(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                std::move(lhs), std::move(rhs)});
+
+    hpx::future<phylanx::execution_tree::primitive_argument_type> f =
+        dot.eval();
+
+    blaze::DynamicVector<double> expected{4.0, 9.0, 20.0};
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
 int main(int argc, char* argv[])
 {
     test_dot_operation_0d();
@@ -754,6 +784,7 @@ int main(int argc, char* argv[])
     test_dot_operation_2d2d();
     test_dot_operation_2d2d_lit();
     test_dot_operation_2d2d_numpy();
+    test_dot_operation_2d1d_sparse();
 
     return hpx::util::report_errors();
 }
@@ -10,6 +10,8 @@
 #include <hpx/include/lcos.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <cstdint>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -85,11 +87,50 @@ void test_random_2d()
     HPX_TEST_EQ(result.dimension(1), 105);
 }
 
+phylanx::execution_tree::primitive_argument_type generate_random(
+    std::uint32_t seed, std::string const& dims)
+{
+    std::string const code = "block(set_seed(" + std::to_string(seed) +
+        "), random(" + dims + "))";
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    return phylanx::execution_tree::compile(code, snippets)();
+}
+
+void test_random_reproducible()
+{
+    // arrays spanning several blocks are generated concurrently, the result
+    // depends on the seed only
+    auto m1 = phylanx::execution_tree::extract_numeric_value(
+        generate_random(42, "make_list(301, 107)"));
+    auto m2 = phylanx::execution_tree::extract_numeric_value(
+        generate_random(42, "make_list(301, 107)"));
+    auto m3 = phylanx::execution_tree::extract_numeric_value(
+        generate_random(43, "make_list(301, 107)"));
+
+    HPX_TEST_EQ(m1.num_dimensions(), 2);
+    HPX_TEST_EQ(m1, m2);
+    HPX_TEST_NEQ(m1, m3);
+
+    auto v1 = phylanx::execution_tree::extract_numeric_value(
+        generate_random(42, "make_list(10007)"));
+    auto v2 = phylanx::execution_tree::extract_numeric_value(
+        generate_random(42, "make_list(10007)"));
+
+    HPX_TEST_EQ(v1.num_dimensions(), 1);
+    HPX_TEST_EQ(v1, v2);
+
+    // the blocks are not copies of each other
+    HPX_TEST_NEQ(v1[0], v1[phylanx::execution_tree::primitives::random::
+        block_size]);
+}
+
 int main(int argc, char* argv[])
 {
     test_random_0d();
     test_random_1d();
     test_random_2d();
+    test_random_reproducible();
 
     return hpx::util::report_errors();
 }
@@ -4,6 +4,7 @@
 //   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/phylanx.hpp>
+#include <phylanx/util/philox.hpp>
 
 #include <hpx/hpx_main.hpp>
 #include <hpx/util/lightweight_test.hpp>
@@ -52,6 +53,26 @@ void set_seed(std::uint32_t seed)
 
     call(static_cast<std::int64_t>(seed));
 }
+///////////////////////////////////////////////////////////////////////////////
+// Each invocation of the random primitive generates its numbers from a new
+// sequence of the counter based generator. All arrays used below are smaller
+// than random::block_size, i.e. they are generated from a single stream.
+struct generator
+{
+    explicit generator(std::uint32_t seed)
+      : seed_(seed)
+      , sequence_(0)
+    {}
+
+    phylanx::util::philox4x32 next()
+    {
+        return phylanx::util::philox4x32((sequence_++ << 32) | seed_);
+    }
+
+    std::uint64_t seed_;
+    std::uint64_t sequence_;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // generate single random double value
 template <typename T, typename Gen, typename Dist>
@@ -65,8 +86,9 @@ void generate_0d(phylanx::execution_tree::compiler::function const& call,
 
     auto result = call(dims);
 
+    auto g = gen.next();
     HPX_TEST_EQ(
-        static_cast<T>(dist(gen)),
+        static_cast<T>(dist(g)),
         static_cast<T>(
             phylanx::execution_tree::extract_numeric_value(result)[0]));
 }
@@ -83,10 +105,11 @@ void generate_1d(phylanx::execution_tree::compiler::function const& call,
 
     auto result = call(dims);
 
+    auto g = gen.next();
     blaze::DynamicVector<T> v(32);
     for (auto& val : v)
     {
-        val = dist(gen);
+        val = dist(g);
     }
 
     HPX_TEST_EQ(phylanx::ir::node_data<T>(std::move(v)),
@@ -105,12 +128,13 @@ void generate_2d(phylanx::execution_tree::compiler::function const& call,
 
     auto result = call(dims);
 
+    auto g = gen.next();
     blaze::DynamicMatrix<T> m(32, 16);
     for (std::size_t row = 0; row != blaze::rows(m); ++row)
     {
         for (auto& val : blaze::row(m, row))
         {
-            val = dist(gen);
+            val = dist(g);
         }
     }
 
@@ -119,7 +143,7 @@ void generate_2d(phylanx::execution_tree::compiler::function const& call,
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_normal_distribution_implicit(std::mt19937& gen)
+void test_normal_distribution_implicit(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size)),
@@ -142,7 +166,7 @@ void test_normal_distribution_implicit(std::mt19937& gen)
     }
 }
 
-void test_uniform_distribution_explicit(std::mt19937& gen)
+void test_uniform_distribution_explicit(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "uniform")),
@@ -165,7 +189,7 @@ void test_uniform_distribution_explicit(std::mt19937& gen)
     }
 }
 
-void test_uniform_distribution_explicit_params(std::mt19937& gen)
+void test_uniform_distribution_explicit_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("uniform", 2.0, 4.0))),
@@ -189,7 +213,7 @@ void test_uniform_distribution_explicit_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_bernoulli_distribution(std::mt19937& gen)
+void test_bernoulli_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "bernoulli")),
@@ -212,7 +236,7 @@ void test_bernoulli_distribution(std::mt19937& gen)
     }
 }
 
-void test_bernoulli_distribution_params(std::mt19937& gen)
+void test_bernoulli_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("bernoulli", 0.8))),
@@ -236,7 +260,7 @@ void test_bernoulli_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_binomial_distribution(std::mt19937& gen)
+void test_binomial_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "binomial")),
@@ -259,7 +283,7 @@ void test_binomial_distribution(std::mt19937& gen)
     }
 }
 
-void test_binomial_distribution_params(std::mt19937& gen)
+void test_binomial_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("binomial", 10, 0.8))),
@@ -283,7 +307,7 @@ void test_binomial_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_negative_binomial_distribution(std::mt19937& gen)
+void test_negative_binomial_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "negative_binomial")),
@@ -306,7 +330,7 @@ void test_negative_binomial_distribution(std::mt19937& gen)
     }
 }
 
-void test_negative_binomial_distribution_params(std::mt19937& gen)
+void test_negative_binomial_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("negative_binomial", 10, 0.8))),
@@ -330,7 +354,7 @@ void test_negative_binomial_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_geometric_distribution(std::mt19937& gen)
+void test_geometric_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "geometric")),
@@ -353,7 +377,7 @@ void test_geometric_distribution(std::mt19937& gen)
     }
 }
 
-void test_geometric_distribution_params(std::mt19937& gen)
+void test_geometric_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("geometric", 0.8))),
@@ -377,7 +401,7 @@ void test_geometric_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_poisson_distribution(std::mt19937& gen)
+void test_poisson_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "poisson")),
@@ -400,7 +424,7 @@ void test_poisson_distribution(std::mt19937& gen)
     }
 }
 
-void test_poisson_distribution_params(std::mt19937& gen)
+void test_poisson_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("poisson", 4))),
@@ -424,7 +448,7 @@ void test_poisson_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_exponential_distribution(std::mt19937& gen)
+void test_exponential_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "exponential")),
@@ -447,7 +471,7 @@ void test_exponential_distribution(std::mt19937& gen)
     }
 }
 
-void test_exponential_distribution_params(std::mt19937& gen)
+void test_exponential_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("exponential", 2.0))),
@@ -471,7 +495,7 @@ void test_exponential_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_gamma_distribution(std::mt19937& gen)
+void test_gamma_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "gamma")),
@@ -494,7 +518,7 @@ void test_gamma_distribution(std::mt19937& gen)
     }
 }
 
-void test_gamma_distribution_params(std::mt19937& gen)
+void test_gamma_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("gamma", 0.8, 1.2))),
@@ -518,7 +542,7 @@ void test_gamma_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_weibull_distribution(std::mt19937& gen)
+void test_weibull_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "weibull")),
@@ -541,7 +565,7 @@ void test_weibull_distribution(std::mt19937& gen)
     }
 }
 
-void test_weibull_distribution_params(std::mt19937& gen)
+void test_weibull_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("weibull", 0.8, 1.2))),
@@ -565,7 +589,7 @@ void test_weibull_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_extreme_value_distribution(std::mt19937& gen)
+void test_extreme_value_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "extreme_value")),
@@ -588,7 +612,7 @@ void test_extreme_value_distribution(std::mt19937& gen)
     }
 }
 
-void test_extreme_value_distribution_params(std::mt19937& gen)
+void test_extreme_value_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("extreme_value", 0.8, 1.2))),
@@ -612,7 +636,7 @@ void test_extreme_value_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_normal_distribution(std::mt19937& gen)
+void test_normal_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "normal")),
@@ -635,7 +659,7 @@ void test_normal_distribution(std::mt19937& gen)
     }
 }
 
-void test_normal_distribution_params(std::mt19937& gen)
+void test_normal_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("normal", 0.8, 1.2))),
@@ -659,7 +683,7 @@ void test_normal_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_lognormal_distribution(std::mt19937& gen)
+void test_lognormal_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "lognormal")),
@@ -682,7 +706,7 @@ void test_lognormal_distribution(std::mt19937& gen)
     }
 }
 
-void test_lognormal_distribution_params(std::mt19937& gen)
+void test_lognormal_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("lognormal", 0.8, 1.2))),
@@ -706,7 +730,7 @@ void test_lognormal_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_chi_squared_distribution(std::mt19937& gen)
+void test_chi_squared_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "chi_squared")),
@@ -729,7 +753,7 @@ void test_chi_squared_distribution(std::mt19937& gen)
     }
 }
 
-void test_chi_squared_distribution_params(std::mt19937& gen)
+void test_chi_squared_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("chi_squared", 0.8))),
@@ -753,7 +777,7 @@ void test_chi_squared_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_cauchy_distribution(std::mt19937& gen)
+void test_cauchy_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "cauchy")),
@@ -776,7 +800,7 @@ void test_cauchy_distribution(std::mt19937& gen)
     }
 }
 
-void test_cauchy_distribution_params(std::mt19937& gen)
+void test_cauchy_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("cauchy", 0.6, 0.8))),
@@ -800,7 +824,7 @@ void test_cauchy_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_fisher_f_distribution(std::mt19937& gen)
+void test_fisher_f_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "fisher_f")),
@@ -823,7 +847,7 @@ void test_fisher_f_distribution(std::mt19937& gen)
     }
 }
 
-void test_fisher_f_distribution_params(std::mt19937& gen)
+void test_fisher_f_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("fisher_f", 0.6, 0.8))),
@@ -847,7 +871,7 @@ void test_fisher_f_distribution_params(std::mt19937& gen)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_student_t_distribution(std::mt19937& gen)
+void test_student_t_distribution(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "student_t")),
@@ -870,7 +894,7 @@ void test_student_t_distribution(std::mt19937& gen)
     }
 }
 
-void test_student_t_distribution_params(std::mt19937& gen)
+void test_student_t_distribution_params(generator& gen)
 {
     std::string const code = R"(block(
             define(call, size, random(size, '("student_t", 0.8))),
@@ -901,7 +925,7 @@ int main(int argc, char* argv[])
     set_seed(seed);
     HPX_TEST_EQ(get_seed(), seed);
 
-    std::mt19937 gen(seed);
+    generator gen(seed);
 
     test_normal_distribution_implicit(gen);
 
@@ -13,6 +13,10 @@
 #include <hpx/util/lightweight_test.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
 #include <utility>
 #include <vector>
 #include <blaze/Math.h>
@@ -43,8 +47,8 @@ void test_shuffle_operation_1d()
     auto actual = phylanx::execution_tree::extract_numeric_value(f.get());
     auto actual_val = actual.vector();
 
-    // Does it have the same value as the p?
-    HPX_TEST_EQ(actual_val, v2);
+    // The variable is left unchanged
+    HPX_TEST_EQ(v2, v1);
 
     // Has it changed?
     HPX_TEST_NEQ(actual_val, v1);
@@ -87,8 +91,8 @@ void test_shuffle_operation_2d()
     auto actual = phylanx::execution_tree::extract_numeric_value(f.get());
     auto actual_val = actual.matrix();
 
-    // Does it have the same value as the p?
-    HPX_TEST_EQ(actual_val, m2);
+    // The variable is left unchanged
+    HPX_TEST_EQ(m2, m1);
 
     // Has it changed?
     HPX_TEST_NEQ(actual_val, m1);
@@ -113,11 +117,71 @@ void test_shuffle_operation_2d()
     }
 }
 
+phylanx::execution_tree::primitive_argument_type shuffle(
+    std::uint32_t seed, phylanx::ir::node_data<double>&& arg)
+{
+    std::string const code = "define(f, x, block(set_seed(" +
+        std::to_string(seed) + "), shuffle(x)))";
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto f = phylanx::execution_tree::compile(code, snippets);
+    return f(std::move(arg));
+}
+
+void test_shuffle_operation_large()
+{
+    // large arrays are shuffled concurrently in blocks
+    blaze::DynamicVector<double> v(20011);
+    std::iota(v.begin(), v.end(), 0.0);
+
+    auto v1 = phylanx::execution_tree::extract_numeric_value(
+        shuffle(42, phylanx::ir::node_data<double>{v}));
+    auto v2 = phylanx::execution_tree::extract_numeric_value(
+        shuffle(42, phylanx::ir::node_data<double>{v}));
+    auto v3 = phylanx::execution_tree::extract_numeric_value(
+        shuffle(43, phylanx::ir::node_data<double>{v}));
+
+    // the result depends on the seed only
+    HPX_TEST_EQ(v1, v2);
+    HPX_TEST_NEQ(v1, v3);
+
+    // the result is a permutation of the input
+    blaze::DynamicVector<double> sorted = v1.vector();
+    HPX_TEST_NEQ(sorted, v);
+    std::sort(sorted.begin(), sorted.end());
+    HPX_TEST_EQ(sorted, v);
+
+    blaze::DynamicMatrix<double> m(9001, 3);
+    for (std::size_t i = 0; i != m.rows(); ++i)
+    {
+        blaze::row(m, i) = double(i);
+    }
+
+    auto m1 = phylanx::execution_tree::extract_numeric_value(
+        shuffle(42, phylanx::ir::node_data<double>{m}));
+
+    std::vector<double> rows;
+    auto m1_val = m1.matrix();
+    for (std::size_t i = 0; i != m1_val.rows(); ++i)
+    {
+        // rows are moved as a whole
+        HPX_TEST_EQ(m1_val(i, 0), m1_val(i, 2));
+        rows.push_back(m1_val(i, 0));
+    }
+    std::sort(rows.begin(), rows.end());
+    for (std::size_t i = 0; i != rows.size(); ++i)
+    {
+        HPX_TEST_EQ(rows[i], double(i));
+    }
+}
+
 int main(int argc, char* argv[])
 {
     test_shuffle_operation_1d();
 
     test_shuffle_operation_2d();
 
+    test_shuffle_operation_large();
+
     return hpx::util::report_errors();
 }
@@ -9,6 +9,8 @@
 #include <hpx/include/lcos.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -420,6 +422,95 @@ void test_slicing_operation_2d_negative_index_neg_step()
     HPX_TEST_EQ(result, expected);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type slice_list(
+    std::int64_t start, std::int64_t stop, std::int64_t step = 1)
+{
+    return phylanx::execution_tree::primitive_argument_type{
+        phylanx::ir::range{
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                phylanx::execution_tree::primitive_argument_type{start},
+                phylanx::execution_tree::primitive_argument_type{stop},
+                phylanx::execution_tree::primitive_argument_type{step}}}};
+}
+
+phylanx::ir::node_data<double> evaluate_slice(
+    phylanx::execution_tree::primitive const& input,
+    phylanx::execution_tree::primitive_argument_type&& rows,
+    phylanx::execution_tree::primitive_argument_type&& columns)
+{
+    phylanx::execution_tree::primitive p =
+        phylanx::execution_tree::primitives::create_slicing_operation(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+                input, std::move(rows), std::move(columns)});
+
+    return phylanx::execution_tree::extract_numeric_value(
+        p.eval(hpx::launch::sync));
+}
+
+void test_slicing_operation_2d_views()
+{
+    blaze::Rand<blaze::DynamicMatrix<double>> gen{};
+    blaze::DynamicMatrix<double> m = gen.generate(42, 16);
+
+    phylanx::execution_tree::primitive input =
+        phylanx::execution_tree::primitives::create_variable(
+            hpx::find_here(), phylanx::ir::node_data<double>{m});
+
+    auto data = phylanx::execution_tree::extract_numeric_value(
+        input.eval(hpx::launch::sync));
+    HPX_TEST(data.is_ref());
+
+    // a contiguous range of rows references the sliced data
+    {
+        auto result =
+            evaluate_slice(input, slice_list(8, 40), slice_list(0, 16));
+
+        HPX_TEST(result.is_ref());
+        HPX_TEST(result.matrix().data() == data.matrix().data(8));
+        blaze::DynamicMatrix<double> expected =
+            blaze::submatrix(m, 8, 0, 32, 16);
+        HPX_TEST_EQ(result, phylanx::ir::node_data<double>{expected});
+    }
+
+    // so does a single row
+    {
+        auto result = evaluate_slice(input,
+            phylanx::execution_tree::primitive_argument_type{std::int64_t(-1)},
+            slice_list(0, 16));
+
+        HPX_TEST(result.is_ref());
+        HPX_TEST(result.vector().data() == data.matrix().data(41));
+        blaze::DynamicVector<double> expected = blaze::trans(blaze::row(m, 41));
+        HPX_TEST_EQ(result, phylanx::ir::node_data<double>{expected});
+    }
+
+    // selecting a subset of the columns or strided rows creates a copy
+    {
+        auto result =
+            evaluate_slice(input, slice_list(8, 40), slice_list(1, 15));
+
+        HPX_TEST(!result.is_ref());
+        blaze::DynamicMatrix<double> expected =
+            blaze::submatrix(m, 8, 1, 32, 14);
+        HPX_TEST_EQ(result, phylanx::ir::node_data<double>{expected});
+    }
+    {
+        auto result =
+            evaluate_slice(input, slice_list(40, 7, -2), slice_list(0, 16));
+
+        blaze::DynamicMatrix<double> expected(17, 16);
+        for (std::size_t i = 0; i != 17; ++i)
+        {
+            blaze::row(expected, i) = blaze::row(m, 40 - 2 * i);
+        }
+
+        HPX_TEST(!result.is_ref());
+        HPX_TEST_EQ(result, phylanx::ir::node_data<double>{expected});
+    }
+}
+
 int main(int argc, char* argv[])
 {
     test_slicing_operation_0d();
@@ -449,5 +540,8 @@ int main(int argc, char* argv[])
     test_slicing_operation_2d_negative_index_zero_start();
     test_slicing_operation_2d_negative_index_neg_step();
 
+    test_slicing_operation_2d_views();
+    test_slicing_operation_2d_index_out_of_range();
+
     return hpx::util::report_errors();
 }
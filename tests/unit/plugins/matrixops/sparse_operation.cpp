@@ -0,0 +1,116 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::compiler::function compile(std::string const& code)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    return phylanx::execution_tree::compile(code, snippets, env);
+}
+
+phylanx::ir::node_data<double> run(std::string const& code)
+{
+    return phylanx::execution_tree::extract_numeric_value(compile(code)());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_sparse_from_dense()
+{
+    auto result = run("sparse([[1, 0, 0], [0, 0, 2]])");
+
+    HPX_TEST(result.is_sparse());
+    HPX_TEST_EQ(result.sparse_matrix().nonZeros(), std::size_t(2));
+
+    blaze::DynamicMatrix<double> expected{{1, 0, 0}, {0, 0, 2}};
+    HPX_TEST(blaze::DynamicMatrix<double>{result.sparse_matrix()} == expected);
+}
+
+void test_sparse_from_coordinates()
+{
+    // the duplicate element (0, 1) is summed up, (1, 0) cancels out
+    auto result = run(R"(
+            sparse([1, 0, 0, 1, 1], [2, 1, 1, 0, 0], [3, 1, 2, 4, -4],
+                list(2, 3))
+        )");
+
+    HPX_TEST(result.is_sparse());
+    HPX_TEST_EQ(result.sparse_matrix().nonZeros(), std::size_t(2));
+
+    blaze::DynamicMatrix<double> expected{{0, 3, 0}, {0, 0, 3}};
+    HPX_TEST(blaze::DynamicMatrix<double>{result.sparse_matrix()} == expected);
+}
+
+void test_sparse_out_of_bounds()
+{
+    bool caught_exception = false;
+    try
+    {
+        run("sparse([0, 2], [0, 0], [1, 1], list(2, 2))");
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_dense()
+{
+    auto result = run("dense(sparse([[1, 0], [0, 2]]))");
+
+    HPX_TEST(!result.is_sparse());
+    HPX_TEST(result.matrix() == (blaze::DynamicMatrix<double>{{1, 0}, {0, 2}}));
+
+    // dense data is passed through unchanged
+    result = run("dense([[1, 2], [3, 4]])");
+    HPX_TEST(result.matrix() == (blaze::DynamicMatrix<double>{{1, 2}, {3, 4}}));
+}
+
+void test_sparse_operand()
+{
+    // primitives which are not aware of sparse data reject it, it has to be
+    // converted explicitly
+    bool caught_exception = false;
+    try
+    {
+        run("inverse(sparse([[2, 0], [0, 4]]))");
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    auto result = run("inverse(dense(sparse([[2, 0], [0, 4]])))");
+
+    HPX_TEST(!result.is_sparse());
+    HPX_TEST(result.matrix() ==
+        (blaze::DynamicMatrix<double>{{0.5, 0}, {0, 0.25}}));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_sparse_from_dense();
+    test_sparse_from_coordinates();
+    test_sparse_out_of_bounds();
+    test_dense();
+    test_sparse_operand();
+
+    return hpx::util::report_errors();
+}
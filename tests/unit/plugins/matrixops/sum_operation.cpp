@@ -297,6 +297,83 @@ void test_2d_keep_dims_false()
         phylanx::execution_tree::extract_numeric_value(f.get()));
 }
 
+void test_2d_sparse_axis0()
+{
+    blaze::CompressedMatrix<double> subject(3UL, 4UL);
+    subject(0, 1) = 6.;
+    subject(1, 1) = 13.;
+    subject(2, 3) = 54.;
+
+    phylanx::execution_tree::primitive arg0 =
+        phylanx::execution_tree::primitives::create_variable(
+            hpx::find_here(), phylanx::ir::node_data<double>(subject));
+    phylanx::execution_tree::primitive arg1 =
+        phylanx::execution_tree::primitives::create_variable(
+            hpx::find_here(), phylanx::ir::node_data<std::int64_t>(0));
+
+    phylanx::execution_tree::primitive sum =
+        phylanx::execution_tree::primitives::create_sum_operation(
+            hpx::find_here(),
+            std::vector<phylanx::execution_tree::primitive_argument_type>{
+        std::move(arg0), std::move(arg1)});
+
+    hpx::future<phylanx::execution_tree::primitive_argument_type> f =
+        sum.eval();
+
+    blaze::DynamicVector<double> expected{0., 19., 0., 54.};
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+// large enough to be split into several blocks, the values are integers to
+// make the result independent of the summation order
+phylanx::execution_tree::primitive_argument_type sum_large(
+    blaze::DynamicMatrix<double> const& subject, std::int64_t axis)
+{
+    std::vector<phylanx::execution_tree::primitive_argument_type> operands;
+    operands.emplace_back(phylanx::execution_tree::primitives::create_variable(
+        hpx::find_here(), phylanx::ir::node_data<double>(subject)));
+    if (axis != -3)
+    {
+        operands.emplace_back(
+            phylanx::execution_tree::primitives::create_variable(
+                hpx::find_here(), phylanx::ir::node_data<std::int64_t>(axis)));
+    }
+
+    phylanx::execution_tree::primitive sum =
+        phylanx::execution_tree::primitives::create_sum_operation(
+            hpx::find_here(), std::move(operands));
+
+    return sum.eval().get();
+}
+
+void test_2d_large()
+{
+    blaze::DynamicMatrix<double> subject(1000UL, 3001UL);
+    blaze::DynamicVector<double> expected_axis0(subject.columns(), 0.);
+    blaze::DynamicVector<double> expected_axis1(subject.rows(), 0.);
+    double expected = 0.;
+    for (std::size_t i = 0; i != subject.rows(); ++i)
+    {
+        for (std::size_t j = 0; j != subject.columns(); ++j)
+        {
+            double value = double((i * 7 + j * 13) % 101) - 50.;
+            subject(i, j) = value;
+            expected_axis0[j] += value;
+            expected_axis1[i] += value;
+            expected += value;
+        }
+    }
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected),
+        phylanx::execution_tree::extract_numeric_value(sum_large(subject, -3)));
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected_axis0),
+        phylanx::execution_tree::extract_numeric_value(sum_large(subject, 0)));
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(expected_axis1),
+        phylanx::execution_tree::extract_numeric_value(sum_large(subject, 1)));
+}
+
 int main(int argc, char* argv[])
 {
     test_0d();
@@ -308,6 +385,8 @@ int main(int argc, char* argv[])
     test_2d_axis1();
     test_2d_keep_dims_true();
     test_2d_keep_dims_false();
+    test_2d_sparse_axis0();
+    test_2d_large();
 
     return hpx::util::report_errors();
 }
@@ -0,0 +1,167 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::compiler::function compile(std::string const& code)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    return phylanx::execution_tree::compile(code, snippets, env);
+}
+
+phylanx::ir::node_data<double> run(std::string const& code)
+{
+    return phylanx::execution_tree::extract_numeric_value(compile(code)());
+}
+
+template <typename T>
+bool almost_equal(T const& lhs, T const& rhs)
+{
+    return blaze::maxNorm(lhs - rhs) < 1e-12;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_lu_factor()
+{
+    auto result = run(R"(block(
+            define(a, [[3,1,-1],[2,-1,1],[-1,3,-2]]),
+            define(f, lu_factor(a)),
+            solve(f, [2, 3, -1])
+        ))");
+
+    HPX_TEST(almost_equal(
+        result.vector(), blaze::DynamicVector<double>{1, 2, 3}));
+}
+
+void test_cholesky_factor()
+{
+    // the matrix is symmetric positive definite
+    std::string const a = "[[4,2,-2],[2,10,2],[-2,2,5]]";
+
+    auto result = run("block(define(f, cholesky_factor(" + a +
+        ")), solve(f, [2, 28, 17]))");
+    HPX_TEST(almost_equal(
+        result.vector(), blaze::DynamicVector<double>{1, 2, 3}));
+
+    // only the given triangle of the matrix is referenced
+    result = run(R"(block(
+            define(f, cholesky_factor([[4,2,-2],[0,10,2],[0,0,5]], "U")),
+            solve(f, [2, 28, 17])
+        ))");
+    HPX_TEST(almost_equal(
+        result.vector(), blaze::DynamicVector<double>{1, 2, 3}));
+
+    result = run(R"(block(
+            define(f, cholesky_factor([[4,0,0],[2,10,0],[-2,2,5]], "L")),
+            solve(f, [2, 28, 17])
+        ))");
+    HPX_TEST(almost_equal(
+        result.vector(), blaze::DynamicVector<double>{1, 2, 3}));
+}
+
+void test_ldlt_factor()
+{
+    // the matrix is symmetric indefinite
+    auto result = run(R"(block(
+            define(f, ldlt_factor([[2,-1,0],[-1,2,-1],[0,-1,1]])),
+            solve(f, [0, 0, 1])
+        ))");
+    HPX_TEST(almost_equal(
+        result.vector(), blaze::DynamicVector<double>{1, 2, 3}));
+
+    result = run(R"(block(
+            define(f, ldlt_factor([[1,2,3],[2,-1,0],[3,0,1]], "U")),
+            solve(f, [14, 0, 6])
+        ))");
+    HPX_TEST(almost_equal(
+        result.vector(), blaze::DynamicVector<double>{1, 2, 3}));
+}
+
+// a factorization can be reused for any number of right hand sides, given
+// one at a time or as the columns of a matrix
+void test_multiple_rhs()
+{
+    blaze::DynamicMatrix<double> expected{{1, 4}, {2, 5}, {3, 6}};
+
+    auto result = run(R"(block(
+            define(f, lu_factor([[3,1,-1],[2,-1,1],[-1,3,-2]])),
+            define(x, solve(f, [2, 3, -1])),
+            solve(f, [11, 9, -1]) - x
+        ))");
+    HPX_TEST(almost_equal(
+        result.vector(), blaze::DynamicVector<double>{3, 3, 3}));
+
+    result = run(R"(block(
+            define(f, lu_factor([[3,1,-1],[2,-1,1],[-1,3,-2]])),
+            solve(f, [[2, 11], [3, 9], [-1, -1]])
+        ))");
+    HPX_TEST(almost_equal(result.matrix(), expected));
+
+    result = run(R"(block(
+            define(f, cholesky_factor([[4,2,-2],[2,10,2],[-2,2,5]])),
+            solve(f, [[2, 14], [28, 70], [17, 32]])
+        ))");
+    HPX_TEST(almost_equal(result.matrix(), expected));
+}
+
+void test_singular()
+{
+    bool caught_exception = false;
+    try
+    {
+        compile("lu_factor([[1, 2], [2, 4]])")();
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    caught_exception = false;
+    try
+    {
+        compile("cholesky_factor([[1, 2], [2, 1]])")();
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    caught_exception = false;
+    try
+    {
+        compile("ldlt_factor([[0, 0], [0, 0]])")();
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_lu_factor();
+    test_cholesky_factor();
+    test_ldlt_factor();
+    test_multiple_rhs();
+    test_singular();
+
+    return hpx::util::report_errors();
+}
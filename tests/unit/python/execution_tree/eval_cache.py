@@ -0,0 +1,48 @@
+#  Copyright (c) 2018 Hartmut Kaiser
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+import phylanx
+
+et = phylanx.execution_tree
+cs = phylanx.compiler_state(cache_size=2)
+
+assert cs.cache_capacity == 2
+assert cs.cache_size == 0
+
+et.compile("define(f, n, n + 1)", cs)
+et.compile("define(g, n, n * 2)", cs)
+et.compile("define(h, n, n - 1)", cs)
+
+# the first evaluation compiles the expression, all others reuse it
+assert et.eval("f", cs, 1) == 2.0
+assert cs.cache_misses == 1 and cs.cache_hits == 0
+
+for i in range(10):
+    assert et.eval("f", cs, i) == i + 1.0
+
+assert cs.cache_misses == 1 and cs.cache_hits == 10
+assert cs.cache_size == 1
+
+# exceeding the capacity evicts the least recently used expression
+assert et.eval("g", cs, 2) == 4.0
+assert et.eval("f", cs, 2) == 3.0
+assert et.eval("h", cs, 2) == 1.0
+
+assert cs.cache_size == 2
+assert cs.cache_evictions == 1
+
+# redefining a function invalidates all cached expressions
+et.compile("define(f, n, n + 2)", cs)
+assert et.eval("f", cs, 1) == 3.0
+
+# expressions other than function references are never cached
+x = et.eval("block(define(x, 41), x + 1)", cs)
+assert x == 42.0
+size = cs.cache_size
+assert et.eval("block(define(x, 41), x + 1)", cs) == 42.0
+assert cs.cache_size == size
+
+cs.clear_cache()
+assert cs.cache_size == 0
@@ -0,0 +1,62 @@
+#  Copyright (c) 2018 Hartmut Kaiser
+#
+#  Distributed under the Boost Software License, Version 1.0. (See accompanying
+#  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# C-contiguous float64 arrays are passed to PhySL without copying their data.
+# Make sure their contents are never modified and that the returned arrays
+# don't alias the arguments.
+
+import numpy as np
+
+import phylanx
+from phylanx.ast import Phylanx
+
+v = np.arange(64, dtype=np.float64)
+m = np.arange(64 * 64, dtype=np.float64).reshape(64, 64)
+
+
+@Phylanx
+def identity(x):
+    return x
+
+
+@Phylanx
+def add_one(x):
+    x = x + 1
+    return x
+
+
+v_orig = v.copy()
+m_orig = m.copy()
+
+assert (add_one(v) == v_orig + 1).all()
+assert (add_one(m) == m_orig + 1).all()
+assert (v == v_orig).all()
+assert (m == m_orig).all()
+
+r = identity(m)
+assert (r == m_orig).all()
+r[0, 0] = -1.0
+assert m[0, 0] == m_orig[0, 0]
+
+# arrays which can't be referenced directly are still copied
+assert (identity(m[:, 1:]) == m_orig[:, 1:]).all()
+assert (identity(m.T) == m_orig.T).all()
+
+
+@Phylanx
+def shuffled(x):
+    return shuffle(x)
+
+
+# primitives modifying their argument work on a copy
+s = shuffled(m)
+assert (m == m_orig).all()
+assert (np.sort(s[:, 0]) == m_orig[:, 0]).all()
+
+# read-only arrays are always copied
+ro = m.copy()
+ro.setflags(write=False)
+assert (add_one(ro) == m_orig + 1).all()
+assert (identity(ro) == m_orig).all()
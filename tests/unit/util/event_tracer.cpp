@@ -0,0 +1,170 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using tracer = phylanx::util::event_tracer;
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type run(std::string const& code)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    return phylanx::execution_tree::compile(code, snippets)();
+}
+
+std::size_t count_events(std::vector<phylanx::util::trace_event> const& events,
+    std::string const& name)
+{
+    std::size_t count = 0;
+    for (auto const& event : events)
+    {
+        if (std::string(event.name_).find(name) != std::string::npos)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_disabled()
+{
+    tracer::clear();
+    tracer::enable(false);
+
+    run("block(define(x, 1), x + 1)");
+    HPX_TEST(tracer::snapshot().empty());
+}
+
+void test_record()
+{
+    tracer::clear();
+    bool enabled = tracer::enable(true);
+
+    run("block(define(x, [1.0, 2.0, 3.0]), x * x + 1)");
+
+    tracer::enable(enabled);
+
+    auto events = tracer::snapshot();
+    HPX_TEST(!events.empty());
+    HPX_TEST_NEQ(count_events(events, "__add"), std::size_t(0));
+    HPX_TEST_NEQ(count_events(events, "__mul"), std::size_t(0));
+
+    for (std::size_t i = 0; i != events.size(); ++i)
+    {
+        HPX_TEST(events[i].begin_ <= events[i].end_);
+        HPX_TEST(events[i].num_operands_ <=
+            phylanx::util::trace_event::max_operands);
+        if (i != 0)
+        {
+            HPX_TEST(events[i - 1].begin_ <= events[i].begin_);
+        }
+    }
+
+    tracer::clear();
+    HPX_TEST(tracer::snapshot().empty());
+}
+
+void test_enable_tracing_primitive()
+{
+    tracer::clear();
+
+    run(R"(block(
+            enable_tracing(true, "events"),
+            define(x, 42),
+            x * 2,
+            enable_tracing(false, "events")
+        ))");
+
+    HPX_TEST(!tracer::enabled());
+    HPX_TEST_NEQ(count_events(tracer::snapshot(), "__mul"), std::size_t(0));
+}
+
+void test_chrome_trace()
+{
+    tracer::clear();
+    bool enabled = tracer::enable(true);
+
+    run("block(define(x, [[1.0, 2.0], [3.0, 4.0]]), x - 1)");
+
+    tracer::enable(enabled);
+
+    std::ostringstream os;
+    tracer::write_chrome_trace(os);
+
+    std::string trace = os.str();
+    HPX_TEST_EQ(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["),
+        std::size_t(0));
+    HPX_TEST_NEQ(trace.find("\"ph\":\"X\""), std::string::npos);
+    HPX_TEST_NEQ(trace.find("__sub"), std::string::npos);
+    HPX_TEST_EQ(trace.substr(trace.size() - 4), std::string("\n]}\n"));
+}
+
+phylanx::util::trace_event make_event(std::uint64_t begin, bool async)
+{
+    phylanx::util::trace_event event{};
+    event.begin_ = begin;
+    event.end_ = begin + 1000;
+    event.worker_ = 0;
+    event.end_worker_ = 1;
+    event.async_ = async;
+    std::string("test").copy(event.name_, 4);
+    return event;
+}
+
+void test_overwritten()
+{
+    tracer::clear();
+
+    for (std::size_t i = 0; i != tracer::buffer_size + 5; ++i)
+    {
+        tracer::record(make_event(i, false));
+    }
+    HPX_TEST_EQ(tracer::overwritten_count(true), std::int64_t(5));
+    HPX_TEST_EQ(tracer::overwritten_count(false), std::int64_t(0));
+
+    tracer::clear();
+    HPX_TEST_EQ(tracer::overwritten_count(false), std::int64_t(0));
+}
+
+void test_async_events()
+{
+    tracer::clear();
+    tracer::record(make_event(0, true));
+
+    std::ostringstream os;
+    tracer::write_chrome_trace(os);
+    tracer::clear();
+
+    // the evaluation is written as a begin and an end event on the tracks
+    // of the threads which started and completed it
+    std::string trace = os.str();
+    HPX_TEST_EQ(trace.find("\"ph\":\"X\""), std::string::npos);
+    HPX_TEST_NEQ(trace.find("\"ph\":\"b\""), std::string::npos);
+    HPX_TEST_NEQ(trace.find("\"ph\":\"e\""), std::string::npos);
+    HPX_TEST_NEQ(trace.find("\"tid\":1"), std::string::npos);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_disabled();
+    test_record();
+    test_enable_tracing_primitive();
+    test_chrome_trace();
+    test_overwritten();
+    test_async_events();
+
+    return hpx::util::report_errors();
+}
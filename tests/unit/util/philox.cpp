@@ -0,0 +1,81 @@
+//  Copyright (c) 2018 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/util/philox.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// known answers for Philox-4x32-10 taken from the Random123 distribution
+void test_known_answers()
+{
+    {
+        phylanx::util::philox4x32 gen;
+        HPX_TEST_EQ(gen(), 0x6627e8d5u);
+        HPX_TEST_EQ(gen(), 0xe169c58du);
+        HPX_TEST_EQ(gen(), 0xbc57ac4cu);
+        HPX_TEST_EQ(gen(), 0x9b00dbd8u);
+    }
+
+    {
+        // key: a4093822 299f31d0,
+        // counter: 243f6a88 85a308d3 13198a2e 03707344
+        phylanx::util::philox4x32 gen(
+            0x299f31d0a4093822ull, 0x0370734413198a2eull);
+
+        // skip to the block with the lower half of the counter given above
+        std::uint64_t const counter = 0x85a308d3243f6a88ull;
+        for (int i = 0; i != 4; ++i)
+        {
+            gen.discard(counter);
+        }
+
+        HPX_TEST_EQ(gen(), 0xd16cfe09u);
+        HPX_TEST_EQ(gen(), 0x94fdccebu);
+        HPX_TEST_EQ(gen(), 0x5001e420u);
+        HPX_TEST_EQ(gen(), 0x24126ea1u);
+    }
+}
+
+void test_streams()
+{
+    // generators with the same key and stream produce the same sequence
+    phylanx::util::philox4x32 gen1(42, 1);
+    phylanx::util::philox4x32 gen2(42, 1);
+    HPX_TEST(gen1 == gen2);
+
+    std::vector<std::uint32_t> values;
+    for (std::size_t i = 0; i != 16; ++i)
+    {
+        values.push_back(gen1());
+        HPX_TEST_EQ(values.back(), gen2());
+    }
+
+    // discard skips values
+    phylanx::util::philox4x32 gen3(42, 1);
+    gen3.discard(7);
+    HPX_TEST_EQ(gen3(), values[7]);
+    gen3.discard(5);
+    HPX_TEST_EQ(gen3(), values[13]);
+
+    // different streams produce different sequences
+    phylanx::util::philox4x32 gen4(42, 2);
+    HPX_TEST(gen4 != phylanx::util::philox4x32(42, 1));
+    HPX_TEST_NEQ(gen4(), values[0]);
+}
+
+int main(int argc, char* argv[])
+{
+    test_known_answers();
+    test_streams();
+
+    return hpx::util::report_errors();
+}